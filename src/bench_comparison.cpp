@@ -0,0 +1,285 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "bench_comparison.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <QHash>
+#include <QThread>
+
+#include "bench_statistics.h"
+
+/**************************************************************************************************
+ *
+ * Tests
+ *
+ **************************************************************************************************/
+
+// Largest total sample count for exact Mann-Whitney distribution (counts stay exact in doubles)
+static constexpr qsizetype kMaxExactSamples = 50;
+
+// Two-sided p-value of U statistic from exact distribution (no ties)
+static double mannWhitneyExact(qsizetype countA, qsizetype countB, double uStat) {
+  // Counts of U values: gaussian binomial coefficient, prod (1 - q^(countB+i)) / (1 - q^i)
+  const qsizetype maxU = countA * countB;
+  std::vector<double> counts(maxU + 1, 0.);
+  counts[0] = 1.;
+  for (qsizetype i = 1; i <= countA; ++i)
+    for (qsizetype k = maxU; k >= countB + i; --k)
+      counts[k] -= counts[k - (countB + i)];
+  for (qsizetype i = 1; i <= countA; ++i)
+    for (qsizetype k = i; k <= maxU; ++k)
+      counts[k] += counts[k - i];
+
+  double total = 0., lowCount = 0., highCount = 0.;
+  for (qsizetype u = 0; u <= maxU; ++u) {
+    total += counts[u];
+    if (u <= uStat)
+      lowCount += counts[u];
+    if (u >= uStat)
+      highCount += counts[u];
+  }
+  return std::min(1., 2. * std::min(lowCount, highCount) / total);
+}
+
+double mannWhitneyTest(const QVector<double>& samplesA, const QVector<double>& samplesB) {
+  const qsizetype countA = samplesA.size(), countB = samplesB.size();
+  const qsizetype count = countA + countB;
+  if (countA < 2 || countB < 2)
+    return -1.;
+
+  // Ranks of pooled samples (average rank for ties)
+  std::vector<std::pair<double, bool>> pooled;  // value, is from A
+  pooled.reserve(count);
+  for (double value : samplesA)
+    pooled.push_back({value, true});
+  for (double value : samplesB)
+    pooled.push_back({value, false});
+  std::sort(pooled.begin(), pooled.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  double rankSumA = 0., tieTerm = 0.;
+  for (qsizetype begin = 0; begin < count;) {
+    qsizetype end = begin + 1;
+    while (end < count && pooled[end].first == pooled[begin].first)
+      ++end;
+    const double rank = (begin + end + 1) / 2.;  // 1-based average
+    for (qsizetype idx = begin; idx < end; ++idx)
+      if (pooled[idx].second)
+        rankSumA += rank;
+    const double ties = end - begin;
+    tieTerm += ties * ties * ties - ties;
+    begin = end;
+  }
+  const double uStat = rankSumA - countA * (countA + 1) / 2.;
+
+  if (tieTerm == 0. && count <= kMaxExactSamples)
+    return mannWhitneyExact(countA, countB, uStat);
+
+  // Normal approximation with tie and continuity corrections
+  const double mean = countA * countB / 2.;
+  const double variance =
+      countA * countB / 12. * ((count + 1) - tieTerm / (static_cast<double>(count) * (count - 1)));
+  if (variance <= 0.)
+    return 1.;
+  const double z = std::max(0., std::abs(uStat - mean) - 0.5) / std::sqrt(variance);
+  return std::min(1., std::erfc(z / std::sqrt(2.)));
+}
+
+// Continued fraction of incomplete beta function (modified Lentz)
+static double incompleteBetaFraction(double a, double b, double x) {
+  constexpr int kMaxIterations = 300;
+  constexpr double kEpsilon = 1e-14, kTiny = 1e-300;
+
+  double c = 1., d = 1. - (a + b) * x / (a + 1.);
+  if (std::abs(d) < kTiny)
+    d = kTiny;
+  d = 1. / d;
+  double fraction = d;
+  for (int m = 1; m <= kMaxIterations; ++m) {
+    // Even step
+    double coef = m * (b - m) * x / ((a + 2. * m - 1.) * (a + 2. * m));
+    d = 1. + coef * d;
+    d = (std::abs(d) < kTiny) ? 1. / kTiny : 1. / d;
+    c = 1. + coef / c;
+    if (std::abs(c) < kTiny)
+      c = kTiny;
+    fraction *= d * c;
+    // Odd step
+    coef = -(a + m) * (a + b + m) * x / ((a + 2. * m) * (a + 2. * m + 1.));
+    d = 1. + coef * d;
+    d = (std::abs(d) < kTiny) ? 1. / kTiny : 1. / d;
+    c = 1. + coef / c;
+    if (std::abs(c) < kTiny)
+      c = kTiny;
+    const double delta = d * c;
+    fraction *= delta;
+    if (std::abs(delta - 1.) < kEpsilon)
+      break;
+  }
+  return fraction;
+}
+
+// Regularized incomplete beta function I_x(a, b)
+static double incompleteBeta(double a, double b, double x) {
+  if (x <= 0.)
+    return 0.;
+  if (x >= 1.)
+    return 1.;
+  const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                a * std::log(x) + b * std::log1p(-x));
+  if (x < (a + 1.) / (a + b + 2.))
+    return front * incompleteBetaFraction(a, b, x) / a;
+  return 1. - front * incompleteBetaFraction(b, a, 1. - x) / b;
+}
+
+double welchTest(const QVector<double>& samplesA, const QVector<double>& samplesB) {
+  const qsizetype countA = samplesA.size(), countB = samplesB.size();
+  if (countA < 2 || countB < 2)
+    return -1.;
+
+  const double meanA = sumReduce(samplesA.constData(), countA) / countA;
+  const double meanB = sumReduce(samplesB.constData(), countB) / countB;
+  const double errA = squaredDevReduce(samplesA.constData(), countA, meanA) / (countA - 1) / countA;
+  const double errB = squaredDevReduce(samplesB.constData(), countB, meanB) / (countB - 1) / countB;
+  const double err = errA + errB;
+  if (err <= 0.)
+    return (meanA == meanB) ? 1. : 0.;
+
+  // Student distribution with Welch-Satterthwaite degrees of freedom
+  const double t = (meanA - meanB) / std::sqrt(err);
+  const double dof = err * err / (errA * errA / (countA - 1) + errB * errB / (countB - 1));
+  return std::min(1., incompleteBeta(dof / 2., 0.5, dof / (dof + t * t)));
+}
+
+/**************************************************************************************************
+ *
+ * Comparison
+ *
+ **************************************************************************************************/
+
+// Minimum number of candidates per comparison thread
+static constexpr qsizetype kMinBenchPerThread = 256;
+
+bool isYLowerBetter(PlotValueType yType) {
+  switch (yType) {
+    case BytesType:
+    case BytesMinType:
+    case BytesMeanType:
+    case BytesMedianType:
+    case ItemsType:
+    case ItemsMinType:
+    case ItemsMeanType:
+    case ItemsMedianType:
+    case IterationsType:
+      return false;
+    default:  // Times/dispersion
+      return true;
+  }
+}
+
+int getSignificance(const BenchComparison& cmp, bool lowerBetter, double alpha) {
+  if (cmp.ratio < 0. || cmp.ratio == 1. || cmp.pValue < 0. || cmp.pValue >= alpha)
+    return 0;
+  return ((cmp.ratio > 1.) == lowerBetter) ? 1 : -1;
+}
+
+// Y-value samples in common unit (copied only if rescaled)
+static const QVector<double>* getScaledSamples(const BenchData& bchData, PlotValueType yType,
+                                               QVector<double>& scaled) {
+  double factor = 1.;
+  const QVector<double>* samples = getYPlotSamples(bchData, yType, factor);
+  if (samples == nullptr || factor == 1.)
+    return samples;
+
+  scaled.resize(samples->size());
+  std::transform(samples->cbegin(), samples->cend(), scaled.begin(),
+                 [factor](double value) { return value * factor; });
+  return &scaled;
+}
+
+ResultsComparison compareResults(const BenchResults& baseline, const BenchResults& candidate,
+                                 PlotValueType yType, CompareTest test) {
+  ResultsComparison comparison;
+
+  // Hash join on run names (built on baseline, probed by candidates)
+  QHash<QString, int> baseIndexes;
+  baseIndexes.reserve(baseline.benchmarks.size());
+  for (int idx = 0; idx < baseline.benchmarks.size(); ++idx)
+    baseIndexes.insert(baseline.benchmarks[idx].run_name, idx);
+
+  const qsizetype candCount = candidate.benchmarks.size();
+  QVector<BenchComparison> probed(candCount);
+  BenchComparison* results = probed.data();  // detached once, before threads
+  auto compareRange = [&](qsizetype begin, qsizetype end) {
+    QVector<double> scaledA, scaledB;
+    for (qsizetype idx = begin; idx < end; ++idx) {
+      const BenchData& candData = candidate.benchmarks[idx];
+      BenchComparison& result = results[idx];
+      result.candIdx = idx;
+      result.baseIdx = std::as_const(baseIndexes).value(candData.run_name, -1);
+      if (result.baseIdx < 0)
+        continue;
+
+      const BenchData& baseData = baseline.benchmarks[result.baseIdx];
+      result.baseValue = getYPlotValue(baseData, yType);
+      result.candValue = getYPlotValue(candData, yType);
+      if (result.baseValue > 0. && result.candValue >= 0.)
+        result.ratio = result.candValue / result.baseValue;
+
+      const QVector<double>* samplesA = getScaledSamples(baseData, yType, scaledA);
+      const QVector<double>* samplesB = getScaledSamples(candData, yType, scaledB);
+      if (samplesA != nullptr && samplesB != nullptr)
+        result.pValue = (test == WelchTest) ? welchTest(*samplesA, *samplesB)
+                                            : mannWhitneyTest(*samplesA, *samplesB);
+    }
+  };
+
+  // Candidates spread on all cores
+  const qsizetype numThreads = std::clamp<qsizetype>(
+      std::min<qsizetype>(QThread::idealThreadCount(), candCount / kMinBenchPerThread), 1,
+      std::max<qsizetype>(candCount, 1));
+  if (numThreads > 1) {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    const qsizetype chunkSize = (candCount + numThreads - 1) / numThreads;
+    for (qsizetype begin = 0; begin < candCount; begin += chunkSize)
+      threads.emplace_back(compareRange, begin, std::min(begin + chunkSize, candCount));
+    for (auto& thread : threads)
+      thread.join();
+  } else
+    compareRange(0, candCount);
+
+  // Gather matches in candidate order
+  std::vector<bool> baseMatched(baseline.benchmarks.size(), false);
+  comparison.matched.reserve(candCount);
+  for (const auto& result : std::as_const(probed)) {
+    if (result.baseIdx < 0) {
+      comparison.candOnly.append(candidate.benchmarks[result.candIdx].run_name);
+      continue;
+    }
+    baseMatched[result.baseIdx] = true;
+    comparison.matched.append(result);
+  }
+  for (int idx = 0; idx < baseline.benchmarks.size(); ++idx)
+    if (!baseMatched[idx])
+      comparison.baseOnly.append(baseline.benchmarks[idx].run_name);
+
+  return comparison;
+}
@@ -0,0 +1,283 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "bench_search.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#include <QRegularExpression>
+
+#include "benchmark_results.h"
+
+// Candidates checked directly below this count (no more intersections)
+static constexpr int kMinIntersectCandidates = 64;
+
+/**************************************************************************************************
+ *
+ * Query
+ *
+ **************************************************************************************************/
+
+// Parameter predicate operators
+enum SearchOperator { OpEqual, OpNotEqual, OpLess, OpLessEqual, OpGreater, OpGreaterEqual };
+
+// Query term
+struct SearchTerm {
+  enum Kind { TextTerm, GlobTerm, RegexTerm, ParamTerm };
+  Kind kind = TextTerm;
+  QString text;              // lowercase substring, or predicate value
+  QRegularExpression regex;  // glob or regex
+  QStringList literals;      // fixed parts (trigrams)
+
+  // Parameter predicate
+  bool isArgument = true;
+  int paramIdx = 0;
+  SearchOperator op = OpEqual;
+  BenchParam value;
+};
+
+static inline quint64 trigramKey(const QChar* chars) {
+  return (quint64(chars[0].unicode()) << 32) | (quint64(chars[1].unicode()) << 16) |
+         chars[2].unicode();
+}
+
+// Parse space separated terms
+static bool parseQuery(const QStringList& words, QVector<SearchTerm>& terms, QString& errorMsg) {
+  static const QRegularExpression paramRegex("^([at])(\\d+)(<=|>=|!=|=|<|>)(.+)$",
+                                             QRegularExpression::CaseInsensitiveOption);
+  static const QRegularExpression wildcardRegex("[*?]");
+  static const QStringList operators{"=", "!=", "<", "<=", ">", ">="};
+
+  for (const auto& word : words) {
+    SearchTerm term;
+    // Regex
+    if (word.size() >= 2 && word.startsWith('/') && word.endsWith('/')) {
+      term.kind = SearchTerm::RegexTerm;
+      term.regex.setPattern(word.sliced(1, word.size() - 2));
+      term.regex.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+      if (!term.regex.isValid()) {
+        errorMsg = "Invalid regex: " + term.regex.errorString();
+        return false;
+      }
+    }
+    // Parameter predicate
+    else if (auto match = paramRegex.match(word); match.hasMatch()) {
+      term.kind = SearchTerm::ParamTerm;
+      term.isArgument = match.captured(1).compare("a", Qt::CaseInsensitive) == 0;
+      term.paramIdx = match.captured(2).toInt() - 1;
+      if (term.paramIdx < 0) {
+        errorMsg = "Invalid parameter index: " + word;
+        return false;
+      }
+      term.op = static_cast<SearchOperator>(operators.indexOf(match.captured(3)));
+      term.text = match.captured(4);
+      term.value = BenchResults::parseParam(term.text);
+    }
+    // Glob ('*' and '?' also match '/')
+    else if (word.contains(wildcardRegex)) {
+      term.kind = SearchTerm::GlobTerm;
+      QString regex = QRegularExpression::escape(word.toLower());
+      regex.replace("\\*", ".*").replace("\\?", ".");
+      term.regex.setPattern(regex);
+      term.literals = word.toLower().split(wildcardRegex, Qt::SkipEmptyParts);
+    }
+    // Substring
+    else {
+      term.text = word.toLower();
+      term.literals = QStringList{term.text};
+    }
+    terms.append(std::move(term));
+  }
+  return true;
+}
+
+// Compare parameter to predicate value (numerically if both are)
+static bool paramMatches(const BenchParam& param, const QString& name, const SearchTerm& term) {
+  int cmp = 0;
+  if (param.kind != BenchParam::TextParam && term.value.kind != BenchParam::TextParam)
+    cmp = (param.value < term.value.value) ? -1 : (param.value > term.value.value) ? 1 : 0;
+  else
+    cmp = QString::compare(name, term.text, Qt::CaseInsensitive);
+
+  switch (term.op) {
+    case OpEqual:
+      return cmp == 0;
+    case OpNotEqual:
+      return cmp != 0;
+    case OpLess:
+      return cmp < 0;
+    case OpLessEqual:
+      return cmp <= 0;
+    case OpGreater:
+      return cmp > 0;
+    case OpGreaterEqual:
+      return cmp >= 0;
+  }
+  return false;
+}
+
+static bool termMatches(const SearchTerm& term, const BenchData& bchData, const QString& text) {
+  switch (term.kind) {
+    case SearchTerm::TextTerm:
+      return text.contains(term.text);  // both lowercase
+    case SearchTerm::GlobTerm:
+    case SearchTerm::RegexTerm:
+      return term.regex.match(text).hasMatch();
+    case SearchTerm::ParamTerm: {
+      const QStringList& names = term.isArgument ? bchData.arguments : bchData.templates;
+      const QVector<BenchParam>& values = term.isArgument ? bchData.argValues : bchData.tpltValues;
+      if (term.paramIdx >= names.size() || term.paramIdx >= values.size())
+        return false;
+      return paramMatches(values[term.paramIdx], names[term.paramIdx], term);
+    }
+  }
+  return false;
+}
+
+// Keep candidates found in sorted posting list
+static void intersect(QVector<int>& candidates, const QVector<int>& postings) {
+  if (candidates.size() * 16 < postings.size()) {
+    candidates.removeIf([&postings](int idx) {
+      return !std::binary_search(postings.cbegin(), postings.cend(), idx);
+    });
+    return;
+  }
+  QVector<int> common;
+  common.reserve(std::min(candidates.size(), postings.size()));
+  std::set_intersection(candidates.cbegin(), candidates.cend(), postings.cbegin(),
+                        postings.cend(), std::back_inserter(common));
+  candidates.swap(common);
+}
+
+/**************************************************************************************************
+ *
+ * Index
+ *
+ **************************************************************************************************/
+
+void BenchSearchIndex::clear() {
+  mBchResults = nullptr;
+  mTexts.clear();
+  mPostings.clear();
+  mLastWords.clear();
+  mLastExtensible = false;
+  mLastMatches.clear();
+}
+
+void BenchSearchIndex::build(const BenchResults* bchResults) {
+  clear();
+  mBchResults = bchResults;
+  if (mBchResults == nullptr)
+    return;
+
+  // Names include family, container, templates and arguments
+  const QVector<BenchData>& benchmarks = mBchResults->benchmarks;
+  mTexts.reserve(benchmarks.size());
+  for (int idx = 0; idx < benchmarks.size(); ++idx) {
+    QString text = benchmarks[idx].name.toLower();
+    for (qsizetype pos = 0; pos + 3 <= text.size(); ++pos) {
+      QVector<int>& postings = mPostings[trigramKey(text.constData() + pos)];
+      if (postings.isEmpty() || postings.constLast() != idx)
+        postings.append(idx);
+    }
+    mTexts.append(std::move(text));
+  }
+}
+
+bool BenchSearchIndex::search(const QString& query, QVector<int>& bchIdxs, QString& errorMsg) {
+  bchIdxs.clear();
+  if (mBchResults == nullptr)
+    return true;
+
+  const QStringList words = query.split(' ', Qt::SkipEmptyParts);
+  QVector<SearchTerm> terms;
+  if (!parseQuery(words, terms, errorMsg)) {
+    mLastWords.clear();
+    return false;
+  }
+
+  // Typed on: previous matches as candidates (same terms, last one extended or new ones)
+  bool refine = !mLastWords.isEmpty() && words.size() >= mLastWords.size();
+  for (int idx = 0; refine && idx < mLastWords.size(); ++idx) {
+    if (words[idx] == mLastWords[idx])
+      continue;
+    const bool isLast = idx == mLastWords.size() - 1;
+    refine = isLast && mLastExtensible && words[idx].startsWith(mLastWords[idx]) &&
+             (terms[idx].kind == SearchTerm::TextTerm || terms[idx].kind == SearchTerm::GlobTerm);
+  }
+
+  QVector<int> candidates;
+  bool allCandidates = !refine;
+  if (refine)
+    candidates = mLastMatches;
+
+  QVector<const QVector<int>*> postings;
+  for (const auto& term : terms) {
+    if (!allCandidates && candidates.isEmpty())
+      break;
+
+    // Narrow by trigrams of fixed parts, rarest first
+    postings.clear();
+    bool missing = false;
+    for (const auto& literal : term.literals) {
+      for (qsizetype pos = 0; !missing && pos + 3 <= literal.size(); ++pos) {
+        auto it = mPostings.constFind(trigramKey(literal.constData() + pos));
+        missing = it == mPostings.cend();
+        if (!missing)
+          postings.append(&it.value());
+      }
+    }
+    if (missing) {
+      candidates.clear();
+      allCandidates = false;
+      break;
+    }
+    std::sort(postings.begin(), postings.end(), [](const auto* lhs, const auto* rhs) {
+      return (lhs->size() != rhs->size()) ? lhs->size() < rhs->size() : std::less<>()(lhs, rhs);
+    });
+    postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+    for (const auto* list : std::as_const(postings)) {
+      if (allCandidates) {
+        candidates = *list;
+        allCandidates = false;
+      } else if (candidates.size() > kMinIntersectCandidates)
+        intersect(candidates, *list);
+    }
+
+    // Check remaining ones
+    if (allCandidates) {
+      candidates.resize(mTexts.size());
+      std::iota(candidates.begin(), candidates.end(), 0);
+      allCandidates = false;
+    }
+    candidates.removeIf([&](int idx) {
+      return !termMatches(term, mBchResults->benchmarks[idx], mTexts[idx]);
+    });
+  }
+  if (allCandidates) {  // no terms
+    candidates.resize(mTexts.size());
+    std::iota(candidates.begin(), candidates.end(), 0);
+  }
+
+  mLastWords = words;
+  mLastExtensible = !terms.isEmpty() && (terms.constLast().kind == SearchTerm::TextTerm ||
+                                         terms.constLast().kind == SearchTerm::GlobTerm);
+  mLastMatches = candidates;
+  bchIdxs = std::move(candidates);
+
+  return true;
+}
@@ -0,0 +1,464 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "bench_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+#include <QHash>
+#include <QStringList>
+#include <QThread>
+
+/**************************************************************************************************
+ *
+ * Reductions
+ *
+ **************************************************************************************************/
+
+// Independent accumulators, so that reductions vectorize without reassociation
+static constexpr qsizetype kReduceLanes = 8;
+
+double sumReduce(const double* data, qsizetype count) {
+  const qsizetype vecCount = count - count % kReduceLanes;
+
+  double lanes[kReduceLanes] = {};
+  for (qsizetype idx = 0; idx < vecCount; idx += kReduceLanes)
+    for (qsizetype lane = 0; lane < kReduceLanes; ++lane)
+      lanes[lane] += data[idx + lane];
+
+  double sum = 0.;
+  for (qsizetype idx = vecCount; idx < count; ++idx)
+    sum += data[idx];
+  for (double laneSum : lanes)
+    sum += laneSum;
+
+  return sum;
+}
+
+double squaredDevReduce(const double* data, qsizetype count, double mean) {
+  const qsizetype vecCount = count - count % kReduceLanes;
+
+  double lanes[kReduceLanes] = {};
+  for (qsizetype idx = 0; idx < vecCount; idx += kReduceLanes)
+    for (qsizetype lane = 0; lane < kReduceLanes; ++lane) {
+      const double dev = data[idx + lane] - mean;
+      lanes[lane] += dev * dev;
+    }
+
+  double sum = 0.;
+  for (qsizetype idx = vecCount; idx < count; ++idx) {
+    const double dev = data[idx] - mean;
+    sum += dev * dev;
+  }
+  for (double laneSum : lanes)
+    sum += laneSum;
+
+  return sum;
+}
+
+/**************************************************************************************************
+ *
+ * Outliers
+ *
+ **************************************************************************************************/
+
+double getOutlierDefaultFactor(OutlierMethod method) {
+  switch (method) {
+    case OutlierIqr:
+      return 1.5;  // Tukey fences
+    case OutlierMad:
+      return 3.5;  // Iglewicz and Hoaglin modified z-score
+    case OutlierTrim:
+      return 5.;  // percent per side
+    default:
+      return 0.;
+  }
+}
+
+bool parseOutlierFilter(const QString& text, OutlierFilter& filter) {
+  const QStringList parts = text.trimmed().toLower().split(':');
+  if (parts.size() > 2)
+    return false;
+
+  OutlierFilter parsed;
+  const QString& method = parts[0];
+  if (method == "none" || method.isEmpty())
+    parsed.method = OutlierNone;
+  else if (method == "iqr")
+    parsed.method = OutlierIqr;
+  else if (method == "mad")
+    parsed.method = OutlierMad;
+  else if (method == "trim")
+    parsed.method = OutlierTrim;
+  else
+    return false;
+
+  parsed.factor = getOutlierDefaultFactor(parsed.method);
+  if (parts.size() == 2 && parsed.method != OutlierNone) {
+    bool ok = false;
+    parsed.factor = parts[1].toDouble(&ok);
+    if (!ok || parsed.factor <= 0. || (parsed.method == OutlierTrim && parsed.factor >= 50.))
+      return false;
+  }
+
+  filter = parsed;
+  return true;
+}
+
+QString getOutlierFilterName(const OutlierFilter& filter) {
+  QString name;
+  switch (filter.method) {
+    case OutlierIqr:
+      name = "iqr";
+      break;
+    case OutlierMad:
+      name = "mad";
+      break;
+    case OutlierTrim:
+      name = "trim";
+      break;
+    default:
+      return "none";
+  }
+  return name + ":" + QString::number(filter.factor);
+}
+
+const BenchFiltered* getYPlotFiltered(const BenchData& bchData, PlotValueType yType) {
+  const BenchFiltered* filtered = nullptr;
+  switch (yType) {
+    case CpuTimeType:
+    case CpuTimeMinType:
+    case CpuTimeMeanType:
+    case CpuTimeMedianType:
+    case CpuTimeStddevType:
+    case CpuTimeCvType:
+      filtered = &bchData.cpu_filtered;
+      break;
+    case RealTimeType:
+    case RealTimeMinType:
+    case RealTimeMeanType:
+    case RealTimeMedianType:
+    case RealTimeStddevType:
+    case RealTimeCvType:
+      filtered = &bchData.real_filtered;
+      break;
+    case BytesType:
+    case BytesMinType:
+    case BytesMeanType:
+    case BytesMedianType:
+    case BytesStddevType:
+    case BytesCvType:
+      filtered = &bchData.kbytes_filtered;
+      break;
+    case ItemsType:
+    case ItemsMinType:
+    case ItemsMeanType:
+    case ItemsMedianType:
+    case ItemsStddevType:
+    case ItemsCvType:
+      filtered = &bchData.kitems_filtered;
+      break;
+    default:  // Iterations
+      return nullptr;
+  }
+  return (filtered->mean >= 0.) ? filtered : nullptr;
+}
+
+/**************************************************************************************************
+ *
+ * Bootstrap
+ *
+ **************************************************************************************************/
+
+const QVector<double>* getYPlotSamples(const BenchData& bchData, PlotValueType yType,
+                                       double& factor) {
+  factor = 1.;
+  switch (yType) {
+    case CpuTimeType:
+    case CpuTimeMinType:
+    case CpuTimeMeanType:
+    case CpuTimeMedianType:
+      factor = normalizeTimeUs(bchData, 1.);
+      return &bchData.cpu_time;
+    case RealTimeType:
+    case RealTimeMinType:
+    case RealTimeMeanType:
+    case RealTimeMedianType:
+      factor = normalizeTimeUs(bchData, 1.);
+      return &bchData.real_time;
+    case BytesType:
+    case BytesMinType:
+    case BytesMeanType:
+    case BytesMedianType:
+      return &bchData.kbytes_sec;
+    case ItemsType:
+    case ItemsMinType:
+    case ItemsMeanType:
+    case ItemsMedianType:
+      return &bchData.kitems_sec;
+    default:  // Dispersion/iterations
+      return nullptr;
+  }
+}
+
+BootstrapStatistic getYPlotStatistic(PlotValueType yType) {
+  switch (yType) {
+    case CpuTimeMeanType:
+    case RealTimeMeanType:
+    case BytesMeanType:
+    case ItemsMeanType:
+      return BootstrapMean;
+    case CpuTimeMedianType:
+    case RealTimeMedianType:
+    case BytesMedianType:
+    case ItemsMedianType:
+      return BootstrapMedian;
+    default:  // Min/first repetition: no matching bootstrap estimator
+      return BootstrapNone;
+  }
+}
+
+// Counter-based random index in [0, count)
+// Stateless (SplitMix64 finalizer) so that resampling loops have no dependency chain.
+static inline uint32_t randomIndex(uint64_t counter, uint32_t count) {
+  uint64_t z = counter + 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  z ^= z >> 31;
+  return static_cast<uint32_t>(((z >> 32) * count) >> 32);
+}
+
+// Percentile interval of statistic over resamples (buffers reused between calls)
+static ConfidenceInterval bootstrapSamples(const QVector<double>& samples, double factor,
+                                           BootstrapStatistic statistic, double confidence,
+                                           int resamples, uint64_t seed,
+                                           std::vector<double>& resample,
+                                           std::vector<double>& estimates) {
+  ConfidenceInterval interval;
+  const uint32_t count = static_cast<uint32_t>(samples.size());
+  if (count < 2 || resamples < 1)
+    return interval;
+
+  resample.resize(count);
+  estimates.resize(resamples);
+  const double* data = samples.constData();
+  double* draw = resample.data();
+
+  for (int resIdx = 0; resIdx < resamples; ++resIdx) {
+    const uint64_t base = seed + static_cast<uint64_t>(resIdx) * count;
+    for (uint32_t idx = 0; idx < count; ++idx)
+      draw[idx] = data[randomIndex(base + idx, count)];
+
+    if (statistic == BootstrapMean)
+      estimates[resIdx] = sumReduce(draw, count) / count;
+    else {
+      auto mid = resample.begin() + count / 2;
+      std::nth_element(resample.begin(), mid, resample.end());
+      estimates[resIdx] =
+          (count % 2) ? *mid : (*std::max_element(resample.begin(), mid) + *mid) / 2.;
+    }
+  }
+
+  // Percentiles of estimates
+  const double alpha = (1. - confidence) / 2.;
+  const qsizetype lowRank =
+      std::clamp<qsizetype>(std::floor(alpha * resamples), 0, resamples - 1);
+  const qsizetype highRank =
+      std::clamp<qsizetype>(std::ceil((1. - alpha) * resamples) - 1, lowRank, resamples - 1);
+  auto lowIt = estimates.begin() + lowRank;
+  std::nth_element(estimates.begin(), lowIt, estimates.end());
+  auto highIt = estimates.begin() + highRank;
+  std::nth_element(lowIt, highIt, estimates.end());
+
+  interval.low = *lowIt * factor;
+  interval.high = *highIt * factor;
+  interval.isValid = true;
+
+  return interval;
+}
+
+// Run func on [begin, end) chunks of [0, count) spread on all cores
+template <class Func>
+static void parallelRanges(qsizetype count, const Func& func) {
+  const qsizetype numThreads = std::clamp<qsizetype>(QThread::idealThreadCount(), 1, count);
+  if (numThreads > 1) {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    const qsizetype chunkSize = (count + numThreads - 1) / numThreads;
+    for (qsizetype begin = 0; begin < count; begin += chunkSize)
+      threads.emplace_back(func, begin, std::min(begin + chunkSize, count));
+    for (auto& thread : threads)
+      thread.join();
+  } else
+    func(0, count);
+}
+
+QVector<ConfidenceInterval> bootstrapIntervals(const BenchResults& bchResults,
+                                               const QVector<int>& bchIdxs,
+                                               PlotValueType yType, double confidence,
+                                               int resamples) {
+  QVector<ConfidenceInterval> intervals(bchIdxs.size());
+  const BootstrapStatistic statistic = getYPlotStatistic(yType);
+  if (statistic == BootstrapNone || bchIdxs.isEmpty())
+    return intervals;
+
+  ConfidenceInterval* results = intervals.data();  // detached once, before threads
+  auto bootstrapRange = [&](qsizetype begin, qsizetype end) {
+    std::vector<double> resample, estimates;
+    QVector<double> kept;
+    for (qsizetype idx = begin; idx < end; ++idx) {
+      const BenchData& bchData = bchResults.benchmarks[bchIdxs[idx]];
+      double factor = 1.;
+      const QVector<double>* samples = getYPlotSamples(bchData, yType, factor);
+      if (samples == nullptr)
+        continue;
+
+      // Only samples within filter fences
+      const BenchFiltered* filtered = getYPlotFiltered(bchData, yType);
+      if (filtered != nullptr && !filtered->outliers.isEmpty()) {
+        kept.clear();
+        for (double sample : *samples)
+          if (sample * factor >= filtered->lowFence && sample * factor <= filtered->highFence)
+            kept.append(sample);
+        samples = &kept;
+      }
+      results[idx] = bootstrapSamples(*samples, factor, statistic, confidence, resamples,
+                                      qHash(bchData.run_name), resample, estimates);
+    }
+  };
+
+  parallelRanges(bchIdxs.size(), bootstrapRange);
+
+  return intervals;
+}
+
+/**************************************************************************************************
+ *
+ * Density
+ *
+ **************************************************************************************************/
+
+// Kernel truncation (in bandwidths), neglected tails mass is below 1e-4
+static constexpr double kKernelRadius = 4.;
+
+// Density of samples on grid (buffers reused between calls)
+static DensityEstimate estimateDensity(const QVector<double>& samples, double factor,
+                                       DensityMethod method, double bandwidthScale, int gridSize,
+                                       std::vector<double>& sorted, std::vector<double>& bins) {
+  DensityEstimate estimate;
+  const qsizetype count = samples.size();
+  if (count < 2 || gridSize < 2)
+    return estimate;
+
+  sorted.assign(samples.cbegin(), samples.cend());
+  std::sort(sorted.begin(), sorted.end());
+  const double low = sorted.front(), high = sorted.back();
+  if (!(high > low))
+    return estimate;  // No spread
+
+  const double iqr = sorted[(3 * count) / 4] - sorted[count / 4];
+  if (method == DensityHistogram) {
+    // Counts in bins of Freedman-Diaconis width (2 IQR n^(-1/3)), at most grid size bins
+    const double fdWidth = 2. * iqr * std::cbrt(1. / count);
+    const int binCount =
+        (fdWidth > 0.)
+            ? std::clamp(static_cast<int>(std::ceil((high - low) / fdWidth)), 1, gridSize)
+            : std::clamp(static_cast<int>(std::ceil(std::sqrt(count))), 1, gridSize);
+    const double step = (high - low) / binCount;
+    bins.assign(binCount, 0.);
+    for (double value : sorted)
+      bins[std::min(static_cast<int>((value - low) / step), binCount - 1)] += 1.;
+
+    estimate.low = (low + step / 2.) * factor;  // Bin centers
+    estimate.step = step * factor;
+    estimate.density.resize(binCount);
+    const double norm = 1. / (count * estimate.step);
+    for (int idx = 0; idx < binCount; ++idx)
+      estimate.density[idx] = bins[idx] * norm;
+
+    return estimate;
+  }
+
+  // Silverman's rule of thumb: 0.9 min(sd, IQR / 1.34) n^(-1/5)
+  const double mean = sumReduce(sorted.data(), count) / count;
+  const double sd = std::sqrt(squaredDevReduce(sorted.data(), count, mean) / (count - 1));
+  const double spread = (iqr > 0.) ? std::min(sd, iqr / 1.34) : sd;
+  const double bandwidth = 0.9 * spread * std::pow(static_cast<double>(count), -0.2) *
+                           bandwidthScale;
+  if (!(bandwidth > 0.))
+    return estimate;
+
+  // Linear binning on grid covering kernel tails
+  const double gridLow = low - kKernelRadius * bandwidth;
+  const double step = (high - low + 2. * kKernelRadius * bandwidth) / (gridSize - 1);
+  bins.assign(gridSize, 0.);
+  for (double value : sorted) {
+    const double pos = (value - gridLow) / step;
+    const int idx = std::min(static_cast<int>(pos), gridSize - 2);
+    const double frac = pos - idx;
+    bins[idx] += 1. - frac;
+    bins[idx + 1] += frac;
+  }
+
+  // Convolution of bins with kernel weights, one contiguous (vectorized) loop per offset
+  const int radius =
+      std::min(gridSize - 1, static_cast<int>(std::ceil(kKernelRadius * bandwidth / step)));
+  const double norm = 1. / (count * bandwidth * factor * std::sqrt(2. * std::numbers::pi));
+  estimate.density.fill(0., gridSize);
+  double* density = estimate.density.data();
+  const double* binData = bins.data();
+  for (int offset = -radius; offset <= radius; ++offset) {
+    const double dist = offset * step / bandwidth;
+    const double weight = std::exp(-0.5 * dist * dist) * norm;
+    const int begin = std::max(0, -offset), end = std::min(gridSize, gridSize - offset);
+    for (int idx = begin; idx < end; ++idx)
+      density[idx] += weight * binData[idx + offset];
+  }
+
+  estimate.low = gridLow * factor;
+  estimate.step = step * factor;
+
+  return estimate;
+}
+
+QVector<DensityEstimate> densityEstimates(const BenchResults& bchResults,
+                                          const QVector<int>& bchIdxs, PlotValueType yType,
+                                          DensityMethod method, double bandwidthScale,
+                                          int gridSize) {
+  QVector<DensityEstimate> estimates(bchIdxs.size());
+  if (bchIdxs.isEmpty())
+    return estimates;
+
+  DensityEstimate* results = estimates.data();  // detached once, before threads
+  auto densityRange = [&](qsizetype begin, qsizetype end) {
+    std::vector<double> sorted, bins;
+    for (qsizetype idx = begin; idx < end; ++idx) {
+      const BenchData& bchData = bchResults.benchmarks[bchIdxs[idx]];
+      double factor = 1.;
+      const QVector<double>* samples = getYPlotSamples(bchData, yType, factor);
+      if (samples != nullptr)
+        results[idx] = estimateDensity(*samples, factor, method, bandwidthScale, gridSize,
+                                       sorted, bins);
+    }
+  };
+  parallelRanges(bchIdxs.size(), densityRange);
+
+  return estimates;
+}
@@ -0,0 +1,665 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "bench_tree_model.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <utility>
+
+#include <QCollator>
+#include <QHash>
+
+#include "benchmark_results.h"
+
+enum BenchTreeColumn { NameColumn, TemplatesColumn, ArgumentsColumn, RealColumn, CpuColumn };
+
+BenchTreeModel::BenchTreeModel(QObject* parent) : QAbstractItemModel(parent) {
+  mNodes.append(Node());  // root
+  mNodes[0].leafCount = 0;
+}
+
+/**************************************************************************************************
+ *
+ * Bitset
+ *
+ **************************************************************************************************/
+
+// Mask of bits [begin, begin + count) within a word (count <= 64 - begin)
+static inline quint64 wordMask(int begin, int count) {
+  return (count >= 64) ? ~quint64(0) : (((quint64(1) << count) - 1) << begin);
+}
+
+// Set or clear bits of [begin, end) range (only those also set in mask if any), a word at a time
+static void setBitRange(QVector<quint64>& bits, int begin, int end, bool value,
+                        const QVector<quint64>* mask = nullptr) {
+  quint64* words = bits.data();
+  while (begin < end) {
+    const int bitIdx = begin % 64;
+    const int count = std::min(64 - bitIdx, end - begin);
+    quint64 bitsMask = wordMask(bitIdx, count);
+    if (mask != nullptr)
+      bitsMask &= (*mask)[begin / 64];
+    if (value)
+      words[begin / 64] |= bitsMask;
+    else
+      words[begin / 64] &= ~bitsMask;
+    begin += count;
+  }
+}
+
+// Number of set bits in [begin, end) range
+static int countBitRange(const QVector<quint64>& bits, int begin, int end) {
+  const quint64* words = bits.constData();
+  int setCount = 0;
+  while (begin < end) {
+    const int bitIdx = begin % 64;
+    const int count = std::min(64 - bitIdx, end - begin);
+    setCount += std::popcount(words[begin / 64] & wordMask(bitIdx, count));
+    begin += count;
+  }
+  return setCount;
+}
+
+static inline bool testBit(const QVector<quint64>& bits, int pos) {
+  return (bits[pos / 64] >> (pos % 64)) & 1u;
+}
+
+/**************************************************************************************************
+ *
+ * Tree
+ *
+ **************************************************************************************************/
+
+int BenchTreeModel::addNode(int parent, int bchIdx, const QString& name) {
+  Node node;
+  node.parent = parent;
+  node.bchIdx = bchIdx;
+  node.name = name;
+  if (bchIdx < 0) {
+    node.leafBegin = std::numeric_limits<int>::max();  // from children
+    node.leafCount = 0;
+  } else {
+    node.leafBegin = mLeafHashes.size();
+    mBenchSlots[bchIdx] = node.leafBegin;
+    mLeafHashes.append(qHash(mBchResults->getBenchName(bchIdx)));
+    mLeafValues.append(valuesHash(mBchResults->benchmarks[bchIdx]));
+  }
+  mNodes.append(node);
+
+  return mNodes.size() - 1;
+}
+
+void BenchTreeModel::setChildren(int parent, const QVector<int>& children) {
+  Node& parentNode = mNodes[parent];
+  parentNode.childBegin = mChildren.size();
+  parentNode.childCount = children.size();
+  mChildren.append(children);
+}
+
+void BenchTreeModel::updateRows() {
+  mRows.clear();
+  mRows.reserve(mChildren.size());
+  for (int nodeIdx = 0; nodeIdx < mNodes.size(); ++nodeIdx) {
+    const int childBegin = mNodes[nodeIdx].childBegin, childCount = mNodes[nodeIdx].childCount;
+    const int rowBegin = mRows.size();
+    for (int child = childBegin; child < childBegin + childCount; ++child) {
+      Node& childNode = mNodes[mChildren[child]];
+      if (!isShown(childNode))
+        continue;
+      childNode.row = mRows.size() - rowBegin;
+      mRows.append(mChildren[child]);
+    }
+    mNodes[nodeIdx].rowBegin = rowBegin;
+    mNodes[nodeIdx].rowCount = mRows.size() - rowBegin;
+  }
+}
+
+bool BenchTreeModel::isShown(const Node& node) const {
+  return !mFiltered ||
+         countBitRange(mMatched, node.leafBegin, node.leafBegin + node.leafCount) > 0;
+}
+
+// Identity across reloads (benchmark name, or group names path)
+size_t BenchTreeModel::nodeKey(int nodeIdx) const {
+  const Node& node = mNodes[nodeIdx];
+  if (node.bchIdx >= 0)
+    return mLeafHashes[node.leafBegin];
+  return (node.parent > 0) ? qHashMulti(nodeKey(node.parent), node.name) : qHash(node.name);
+}
+
+size_t BenchTreeModel::valuesHash(const BenchData& bchData) const {
+  size_t seed = 0;
+  for (int column = RealColumn; column < mHeaders.size(); ++column)
+    seed = qHashMulti(seed, columnValue(bchData, column));
+  return seed;
+}
+
+void BenchTreeModel::setResults(const BenchResults* bchResults, bool keepSelection) {
+  beginResetModel();
+
+  mBchResults = bchResults;
+  buildTree(keepSelection);
+  sortChildren(mSortColumn, mSortOrder);
+  updateRows();
+
+  endResetModel();
+}
+
+void BenchTreeModel::reloadResults(const BenchResults* bchResults) {
+  // No more results or new columns: reset
+  if (bchResults == nullptr || bchResults->benchmarks.isEmpty() ||
+      bchResults->meta.hasBytesSec != (mBytesColumn >= 0) ||
+      bchResults->meta.hasItemsSec != (mItemsColumn >= 0)) {
+    setResults(bchResults, true);
+    return;
+  }
+  mBchResults = bchResults;
+  const QStringList prevHeaders = mHeaders;
+
+  // Same benchmarks (by names, in same order): changed rows only
+  const int bchCount = mBchResults->benchmarks.size();
+  bool sameBenchmarks = bchCount == mBenchSlots.size();
+  for (int bchIdx = 0; sameBenchmarks && bchIdx < bchCount; ++bchIdx)
+    sameBenchmarks = mBenchSlots[bchIdx] >= 0 &&
+                     mLeafHashes[mBenchSlots[bchIdx]] == qHash(mBchResults->getBenchName(bchIdx));
+  if (sameBenchmarks) {
+    updateColumns();
+    if (mHeaders != prevHeaders)
+      emit headerDataChanged(Qt::Horizontal, 0, mHeaders.size() - 1);
+
+    bool changed = false;
+    for (int nodeIdx = 1; nodeIdx < mNodes.size(); ++nodeIdx) {
+      const Node& node = mNodes[nodeIdx];
+      if (node.bchIdx < 0)
+        continue;
+      const size_t values = valuesHash(mBchResults->benchmarks[node.bchIdx]);
+      if (values == mLeafValues[node.leafBegin])
+        continue;
+      mLeafValues[node.leafBegin] = values;
+      changed = true;
+      if (isShown(node)) {
+        const QModelIndex parent = nodeIndex(node.parent);
+        emit dataChanged(index(node.row, RealColumn, parent),
+                         index(node.row, mHeaders.size() - 1, parent), {Qt::DisplayRole});
+      }
+    }
+    if (changed && mSortColumn >= RealColumn)
+      sort(mSortColumn, mSortOrder);
+    return;
+  }
+
+  // Added/removed benchmarks: rows matched by identity (filter re-applied by caller)
+  emit layoutAboutToBeChanged();
+  const QModelIndexList prevIndexes = persistentIndexList();
+  QVector<size_t> indexKeys;
+  QHash<size_t, int> keyNodes;  // previous key -> new node
+  indexKeys.reserve(prevIndexes.size());
+  for (const auto& prevIndex : prevIndexes) {
+    indexKeys.append(nodeKey(static_cast<int>(prevIndex.internalId())));
+    keyNodes.insert(indexKeys.constLast(), -1);
+  }
+
+  buildTree(true);
+  sortChildren(mSortColumn, mSortOrder);
+  updateRows();
+
+  if (!keyNodes.isEmpty()) {
+    for (int nodeIdx = 1; nodeIdx < mNodes.size(); ++nodeIdx) {
+      auto it = keyNodes.find(nodeKey(nodeIdx));
+      if (it != keyNodes.end())
+        it.value() = nodeIdx;
+    }
+  }
+  QModelIndexList newIndexes;
+  newIndexes.reserve(prevIndexes.size());
+  for (int idx = 0; idx < prevIndexes.size(); ++idx) {
+    const int nodeIdx = keyNodes.value(indexKeys[idx], -1);
+    newIndexes.append((nodeIdx > 0) ? nodeIndex(nodeIdx, prevIndexes[idx].column())
+                                    : QModelIndex());
+  }
+  changePersistentIndexList(prevIndexes, newIndexes);
+
+  emit layoutChanged();
+  if (mHeaders != prevHeaders)
+    emit headerDataChanged(Qt::Horizontal, 0, mHeaders.size() - 1);
+}
+
+void BenchTreeModel::updateColumns() {
+  const BenchMeta& meta = mBchResults->meta;
+
+  mBytesColumn = mItemsColumn = -1;
+  mTimeFactor = 1.;
+  if (meta.time_unit == "ns")
+    mTimeFactor = 1000.;
+  else if (meta.time_unit == "ms")
+    mTimeFactor = 0.001;
+
+  mHeaders = QStringList{"Benchmark", "Templates", "Arguments"};
+  if (!meta.hasAggregate) {
+    mHeaders << "Real time (" + meta.time_unit + ")"
+             << "CPU time (" + meta.time_unit + ")";
+  } else if (!meta.onlyAggregate) {
+    mHeaders << "Real min time (" + meta.time_unit + ")"
+             << "CPU min time (" + meta.time_unit + ")";
+  } else {
+    mHeaders << "Real mean time (" + meta.time_unit + ")"
+             << "CPU mean time (" + meta.time_unit + ")";
+  }
+  if (meta.hasBytesSec) {
+    mBytesColumn = mHeaders.size();
+    mHeaders << (meta.hasAggregate ? "Bytes/s min (k)" : "Bytes/s (k)");
+  }
+  if (meta.hasItemsSec) {
+    mItemsColumn = mHeaders.size();
+    mHeaders << (meta.hasAggregate ? "Items/s min (k)" : "Items/s (k)");
+  }
+}
+
+void BenchTreeModel::buildTree(bool keepSelection) {
+  // Previously unchecked identities
+  QVector<size_t> unselected;
+  if (keepSelection) {
+    for (int slot = 0; slot < mLeafHashes.size(); ++slot)
+      if (!testBit(mChecked, slot))
+        unselected.append(mLeafHashes[slot]);
+    std::sort(unselected.begin(), unselected.end());
+  }
+
+  mNodes.clear();
+  mChildren.clear();
+  mRows.clear();
+  mLeafHashes.clear();
+  mLeafValues.clear();
+  mBenchSlots.clear();
+  mChecked.clear();
+  mMatched.clear();
+  mFiltered = false;
+  mHeaders.clear();
+  mBytesColumn = mItemsColumn = -1;
+  addNode(-1, -1);  // root
+
+  if (mBchResults == nullptr || mBchResults->benchmarks.isEmpty())
+    return;
+  updateColumns();
+
+  // Structure only (families listed last first, as before)
+  const QVector<BenchSubset> bchFamilies = mBchResults->segmentFamilies();
+  mNodes.reserve(mBchResults->benchmarks.size() + bchFamilies.size() + 1);
+  mChildren.reserve(mBchResults->benchmarks.size() + bchFamilies.size());
+  mLeafHashes.reserve(mBchResults->benchmarks.size());
+  mLeafValues.reserve(mBchResults->benchmarks.size());
+  mBenchSlots.fill(-1, mBchResults->benchmarks.size());
+
+  QVector<int> topNodes, midNodes, leafNodes;
+  topNodes.reserve(bchFamilies.size());
+  for (auto it = bchFamilies.crbegin(); it != bchFamilies.crend(); ++it) {
+    const bool isSingle = it->idxs.size() == 1 &&
+                          mBchResults->benchmarks[it->idxs[0]].container.isEmpty();
+    topNodes.append(isSingle ? addNode(0, it->idxs[0]) : addNode(0, -1, it->name));
+  }
+  setChildren(0, topNodes);
+
+  auto addLeaves = [&](int parent, const QVector<int>& bchIdxs) {
+    leafNodes.clear();
+    for (int idx : bchIdxs)
+      leafNodes.append(addNode(parent, idx));
+    setChildren(parent, leafNodes);
+  };
+  for (int row = 0; row < topNodes.size(); ++row) {
+    const int topNode = topNodes[row];
+    if (mNodes[topNode].bchIdx >= 0)
+      continue;
+    const BenchSubset& bchFamily = bchFamilies[bchFamilies.size() - 1 - row];
+
+    // JOMT: family + container
+    if (!mBchResults->benchmarks[bchFamily.idxs[0]].container.isEmpty()) {
+      const QVector<BenchSubset> bchContainers = mBchResults->segmentContainers(bchFamily.idxs);
+      midNodes.clear();
+      for (const auto& bchContainer : bchContainers)
+        midNodes.append(addNode(topNode, -1, bchContainer.name));
+      setChildren(topNode, midNodes);
+      for (int midRow = 0; midRow < bchContainers.size(); ++midRow)
+        addLeaves(mChildren[mNodes[topNode].childBegin + midRow], bchContainers[midRow].idxs);
+    }
+    // Classic
+    else
+      addLeaves(topNode, bchFamily.idxs);
+  }
+
+  // Leaf ranges, children being created after their parent
+  for (int nodeIdx = mNodes.size() - 1; nodeIdx > 0; --nodeIdx) {
+    const Node& node = mNodes[nodeIdx];
+    Node& parentNode = mNodes[node.parent];
+    parentNode.leafBegin = std::min(parentNode.leafBegin, node.leafBegin);
+    parentNode.leafCount += node.leafCount;
+  }
+  mNodes[0].leafBegin = 0;
+
+  // All checked, but kept unchecked ones
+  const int leafCount = mLeafHashes.size();
+  mChecked.fill(0, (leafCount + 63) / 64);
+  setBitRange(mChecked, 0, leafCount, true);
+  if (!unselected.isEmpty())
+    for (int slot = 0; slot < leafCount; ++slot)
+      if (std::binary_search(unselected.cbegin(), unselected.cend(), mLeafHashes[slot]))
+        setBitRange(mChecked, slot, slot + 1, false);
+}
+
+/**************************************************************************************************
+ *
+ * Selection
+ *
+ **************************************************************************************************/
+
+QVector<int> BenchTreeModel::selectedBenchmarks() const {
+  QVector<int> bchIdxs;
+
+  auto collect = [this, &bchIdxs](auto& self, int nodeIdx) -> void {
+    const Node& node = mNodes[nodeIdx];
+    if (node.bchIdx >= 0) {
+      if (testBit(mChecked, node.leafBegin))
+        bchIdxs.append(node.bchIdx);
+      return;
+    }
+    if (countBitRange(mChecked, node.leafBegin, node.leafBegin + node.leafCount) == 0)
+      return;  // whole subtree unchecked
+    for (int child = node.childBegin; child < node.childBegin + node.childCount; ++child)
+      self(self, mChildren[child]);
+  };
+  collect(collect, 0);
+
+  return bchIdxs;
+}
+
+bool BenchTreeModel::anyChecked() const {
+  return std::any_of(mChecked.cbegin(), mChecked.cend(), [](quint64 word) { return word != 0; });
+}
+
+void BenchTreeModel::setAllChecked(bool checked) {
+  setBitRange(mChecked, 0, mLeafHashes.size(), checked, mFiltered ? &mMatched : nullptr);
+  emitSubtreeChanged(0);
+  emit checkedChanged();
+}
+
+void BenchTreeModel::emitSubtreeChanged(int nodeIdx) {
+  const int rowBegin = mNodes[nodeIdx].rowBegin, rowCount = mNodes[nodeIdx].rowCount;
+  if (rowCount <= 0)
+    return;
+
+  const QModelIndex parent = nodeIndex(nodeIdx);
+  emit dataChanged(index(0, NameColumn, parent), index(rowCount - 1, NameColumn, parent),
+                   {Qt::CheckStateRole});
+  for (int row = rowBegin; row < rowBegin + rowCount; ++row)
+    emitSubtreeChanged(mRows[row]);
+}
+
+/**************************************************************************************************
+ *
+ * Filter
+ *
+ **************************************************************************************************/
+
+void BenchTreeModel::setFilter(const QVector<int>& bchIdxs) {
+  emit layoutAboutToBeChanged();
+  const QModelIndexList prevIndexes = persistentIndexList();
+
+  mFiltered = true;
+  mMatched.fill(0, mChecked.size());
+  for (int bchIdx : bchIdxs) {
+    const int slot = (bchIdx >= 0 && bchIdx < mBenchSlots.size()) ? mBenchSlots[bchIdx] : -1;
+    if (slot >= 0)
+      mMatched[slot / 64] |= quint64(1) << (slot % 64);
+  }
+  updateRows();
+  updateShownIndexes(prevIndexes);
+
+  emit layoutChanged();
+}
+
+void BenchTreeModel::clearFilter() {
+  if (!mFiltered)
+    return;
+  emit layoutAboutToBeChanged();
+  const QModelIndexList prevIndexes = persistentIndexList();
+
+  mFiltered = false;
+  mMatched.clear();
+  updateRows();
+  updateShownIndexes(prevIndexes);
+
+  emit layoutChanged();
+}
+
+// Same nodes at their new rows (expanded/selected ones kept), hidden ones invalidated
+void BenchTreeModel::updateShownIndexes(const QModelIndexList& prevIndexes) {
+  QModelIndexList newIndexes;
+  newIndexes.reserve(prevIndexes.size());
+  for (const auto& prevIndex : prevIndexes) {
+    const int nodeIdx = static_cast<int>(prevIndex.internalId());
+    newIndexes.append(isShown(mNodes[nodeIdx]) ? nodeIndex(nodeIdx, prevIndex.column())
+                                                : QModelIndex());
+  }
+  changePersistentIndexList(prevIndexes, newIndexes);
+}
+
+/**************************************************************************************************/
+
+Qt::CheckState BenchTreeModel::nodeCheckState(const Node& node) const {
+  const int checkedCount = countBitRange(mChecked, node.leafBegin, node.leafBegin + node.leafCount);
+  if (checkedCount <= 0)
+    return Qt::Unchecked;
+  return (checkedCount < node.leafCount) ? Qt::PartiallyChecked : Qt::Checked;
+}
+
+/**************************************************************************************************
+ *
+ * Model
+ *
+ **************************************************************************************************/
+
+QModelIndex BenchTreeModel::nodeIndex(int nodeIdx, int column) const {
+  if (nodeIdx <= 0)
+    return QModelIndex();  // root
+  return createIndex(mNodes[nodeIdx].row, column, static_cast<quintptr>(nodeIdx));
+}
+
+QModelIndex BenchTreeModel::index(int row, int column, const QModelIndex& parent) const {
+  const int parentIdx = parent.isValid() ? static_cast<int>(parent.internalId()) : 0;
+  const Node& parentNode = mNodes[parentIdx];
+  if (row < 0 || row >= parentNode.rowCount || column < 0 || column >= mHeaders.size())
+    return QModelIndex();
+
+  return createIndex(row, column, static_cast<quintptr>(mRows[parentNode.rowBegin + row]));
+}
+
+QModelIndex BenchTreeModel::parent(const QModelIndex& child) const {
+  if (!child.isValid())
+    return QModelIndex();
+  return nodeIndex(mNodes[static_cast<int>(child.internalId())].parent);
+}
+
+int BenchTreeModel::rowCount(const QModelIndex& parent) const {
+  if (parent.column() > 0)
+    return 0;
+  const int parentIdx = parent.isValid() ? static_cast<int>(parent.internalId()) : 0;
+  return mNodes[parentIdx].rowCount;
+}
+
+int BenchTreeModel::columnCount(const QModelIndex& /*parent*/) const { return mHeaders.size(); }
+
+double BenchTreeModel::columnValue(const BenchData& bchData, int column) const {
+  const bool onlyAggregate = mBchResults->meta.onlyAggregate;
+  if (column == RealColumn)
+    return (!onlyAggregate ? bchData.real_time_us : bchData.mean_real) * mTimeFactor;
+  if (column == CpuColumn)
+    return (!onlyAggregate ? bchData.cpu_time_us : bchData.mean_cpu) * mTimeFactor;
+  if (column == mBytesColumn && !bchData.kbytes_sec.isEmpty())
+    return bchData.kbytes_sec_dflt;
+  if (column == mItemsColumn && !bchData.kitems_sec.isEmpty())
+    return bchData.kitems_sec_dflt;
+
+  return std::numeric_limits<double>::lowest();  // none, sorted first
+}
+
+QString BenchTreeModel::columnText(const BenchData& bchData, int column) const {
+  switch (column) {
+    case NameColumn:
+      return bchData.base_name;
+    case TemplatesColumn:
+      return bchData.templates.join(", ");
+    case ArgumentsColumn:
+      return bchData.arguments.join("/");
+    default: {
+      const double value = columnValue(bchData, column);
+      if (value == std::numeric_limits<double>::lowest())
+        return QString();
+      return QString::number(value);
+    }
+  }
+}
+
+QVariant BenchTreeModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid())
+    return QVariant();
+  const Node& node = mNodes[static_cast<int>(index.internalId())];
+  const int column = index.column();
+
+  if (role == Qt::CheckStateRole)
+    return (column == NameColumn) ? QVariant(static_cast<int>(nodeCheckState(node))) : QVariant();
+  if (node.bchIdx < 0)  // group
+    return (role == Qt::DisplayRole && column == NameColumn) ? QVariant(node.name) : QVariant();
+
+  const BenchData& bchData = mBchResults->benchmarks[node.bchIdx];
+  if (role == Qt::DisplayRole)
+    return columnText(bchData, column);
+  if (role == Qt::ToolTipRole && column == NameColumn)
+    return bchData.name;
+  if (role == Qt::UserRole && column == NameColumn)
+    return node.bchIdx;
+
+  return QVariant();
+}
+
+bool BenchTreeModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+  if (!index.isValid() || index.column() != NameColumn || role != Qt::CheckStateRole)
+    return false;
+
+  const int nodeIdx = static_cast<int>(index.internalId());
+  const Node& node = mNodes[nodeIdx];
+  setBitRange(mChecked, node.leafBegin, node.leafBegin + node.leafCount,
+              value.toInt() != Qt::Unchecked, mFiltered ? &mMatched : nullptr);  // shown ones
+  emit dataChanged(index, index, {Qt::CheckStateRole});
+  emitSubtreeChanged(nodeIdx);
+
+  // Parents tri-state from their bit ranges
+  for (int parentIdx = node.parent; parentIdx > 0; parentIdx = mNodes[parentIdx].parent) {
+    const QModelIndex parentIndex = nodeIndex(parentIdx);
+    emit dataChanged(parentIndex, parentIndex, {Qt::CheckStateRole});
+  }
+  emit checkedChanged();
+
+  return true;
+}
+
+Qt::ItemFlags BenchTreeModel::flags(const QModelIndex& index) const {
+  Qt::ItemFlags itemFlags = QAbstractItemModel::flags(index);
+  if (index.isValid() && index.column() == NameColumn)
+    itemFlags |= Qt::ItemIsUserCheckable;
+
+  return itemFlags;
+}
+
+QVariant BenchTreeModel::headerData(int section, Qt::Orientation orientation, int role) const {
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section < 0 ||
+      section >= mHeaders.size())
+    return QAbstractItemModel::headerData(section, orientation, role);
+
+  return mHeaders[section];
+}
+
+void BenchTreeModel::sort(int column, Qt::SortOrder order) {
+  mSortColumn = column;  // also kept for next results
+  mSortOrder = order;
+  if (mBchResults == nullptr || column >= mHeaders.size())
+    return;
+
+  emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+  const QModelIndexList prevIndexes = persistentIndexList();
+
+  sortChildren(column, order);
+  updateRows();
+
+  QModelIndexList newIndexes;
+  newIndexes.reserve(prevIndexes.size());
+  for (const auto& prevIndex : prevIndexes)
+    newIndexes.append(nodeIndex(static_cast<int>(prevIndex.internalId()), prevIndex.column()));
+  changePersistentIndexList(prevIndexes, newIndexes);
+
+  emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void BenchTreeModel::sortChildren(int column, Qt::SortOrder order) {
+  if (mBchResults == nullptr || column >= mHeaders.size())
+    column = -1;
+
+  // Siblings sorted in place (numeric collation of texts, as values otherwise)
+  QCollator collator;
+  collator.setNumericMode(true);
+  QVector<std::pair<QString, int>> textKeys;
+  QVector<std::pair<double, int>> valueKeys;
+  const bool ascending = order == Qt::AscendingOrder;
+
+  for (const auto& node : std::as_const(mNodes)) {
+    if (node.childCount < 2)
+      continue;
+    auto first = mChildren.begin() + node.childBegin;
+    auto last = first + node.childCount;
+
+    if (column < 0)  // unsorted: creation order
+      std::sort(first, last);
+    else if (column <= ArgumentsColumn) {
+      textKeys.clear();
+      for (auto it = first; it != last; ++it) {
+        const Node& child = mNodes[*it];
+        QString text = (child.bchIdx < 0) ? ((column == NameColumn) ? child.name : QString())
+                                          : columnText(mBchResults->benchmarks[child.bchIdx],
+                                                       column);
+        textKeys.append({std::move(text), *it});
+      }
+      std::stable_sort(textKeys.begin(), textKeys.end(), [&](const auto& lhs, const auto& rhs) {
+        const int cmp = collator.compare(lhs.first, rhs.first);
+        return ascending ? cmp < 0 : cmp > 0;
+      });
+      for (const auto& key : std::as_const(textKeys))
+        *first++ = key.second;
+    } else {
+      valueKeys.clear();
+      for (auto it = first; it != last; ++it) {
+        const Node& child = mNodes[*it];
+        const double value = (child.bchIdx < 0)
+                                 ? std::numeric_limits<double>::lowest()
+                                 : columnValue(mBchResults->benchmarks[child.bchIdx], column);
+        valueKeys.append({value, *it});
+      }
+      std::stable_sort(valueKeys.begin(), valueKeys.end(), [&](const auto& lhs, const auto& rhs) {
+        return ascending ? lhs.first < rhs.first : lhs.first > rhs.first;
+      });
+      for (const auto& key : std::as_const(valueKeys))
+        *first++ = key.second;
+    }
+  }
+}
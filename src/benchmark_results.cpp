@@ -15,7 +15,13 @@
 
 #include "benchmark_results.h"
 
+#include "bench_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
 #include <QDebug>
+#include <QHash>
 #include <QMap>
 
 #define BCHRES_DEBUG false
@@ -95,58 +101,90 @@ QString BenchResults::extractData(const BenchData& data, int argIdx, int tpltIdx
 QPair<double, QString> BenchResults::convertCustomDataSize(const QString& tplt) {
   QPair<double, QString> res(0., "");
 
+  const BenchParam param = parseParam(tplt);
+  if (param.kind == BenchParam::DataSizeParam) {
+    res.first = param.value;
+    res.second = "Data (bytes)";
+  }
+
+  return res;
+}
+
+/**************************************************************************************************/
+
+BenchParam BenchResults::parseParam(QStringView name) {
+  BenchParam param;
+
+  // Number
+  bool ok = false;
+  param.value = name.toDouble(&ok);
+  if (ok) {
+    param.kind = BenchParam::NumberParam;
+    return param;
+  }
+  param.value = 0.;
+
+  // Custom data size (JOMT)
   double mult = 0.;
-  if (tplt.startsWith("data8"))
+  if (name.startsWith(u"data8"))
     mult = 1.;
-  else if (tplt.startsWith("data16"))
+  else if (name.startsWith(u"data16"))
     mult = 2.;
-  else if (tplt.startsWith("data32"))
+  else if (name.startsWith(u"data32"))
     mult = 4.;
-  else if (tplt.startsWith("data64"))
+  else if (name.startsWith(u"data64"))
     mult = 8.;
 
   if (mult > 0.) {
-    int in = tplt.indexOf('<');
-    int out = tplt.lastIndexOf('>');
+    qsizetype in = name.indexOf(u'<');
+    qsizetype out = name.lastIndexOf(u'>');
 
     if (in > 0 && out > in) {
-      QString val = tplt.mid(in + 1, out - in - 1);
-      bool ok = false;
-      res.first = val.toDouble(&ok);
+      double count = name.sliced(in + 1, out - in - 1).toDouble(&ok);
       if (ok) {
-        res.first *= mult;
-        res.second = "Data (bytes)";
+        param.kind = BenchParam::DataSizeParam;
+        param.value = count * mult;
       }
     }
   }
 
-  return res;
+  return param;
 }
 
 /**************************************************************************************************/
 
-double BenchResults::getParamValue(const QString& name, QString& custDataName, bool& custDataAxis,
-                                   double& fallbackIdx) {
-  bool ok = false;
-  double val = name.toDouble(&ok);
-  if (!ok) {
-    if (custDataAxis) {
-      // Check if custom data size template
-      const auto& custData = convertCustomDataSize(name);
-      if (!custData.second.isEmpty()) {
-        val = custData.first;
+double BenchResults::getTimeFactorUs(QStringView timeUnit) {
+  if (timeUnit == u"ns")
+    return 0.001;
+  if (timeUnit == u"ms")
+    return 1000.;
+  if (timeUnit == u"s")
+    return 1000000.;
+  return 1.;
+}
+
+/**************************************************************************************************/
+
+double BenchResults::getParamValue(const BenchParam& param, QString& custDataName,
+                                   bool& custDataAxis, double& fallbackIdx) {
+  switch (param.kind) {
+    case BenchParam::NumberParam:
+      custDataAxis = false;
+      return param.value;
+    case BenchParam::DataSizeParam:
+      // Custom data size template
+      if (custDataAxis) {
         if (custDataName.isEmpty())
-          custDataName = custData.second;
-      } else {
-        val = fallbackIdx++;
-        custDataAxis = false;
+          custDataName = "Data (bytes)";
+        return param.value;
       }
-    } else
-      val = fallbackIdx++;
-  } else
-    custDataAxis = false;
+      break;
+    case BenchParam::TextParam:
+      custDataAxis = false;
+      break;
+  }
 
-  return val;
+  return fallbackIdx++;
 }
 
 /**************************************************************************************************
@@ -155,6 +193,231 @@ double BenchResults::getParamValue(const QString& name, QString& custDataName, b
  *
  **************************************************************************************************/
 
+// Median of [begin, end) range, with its elements only reordered inside it
+static double rangeMedian(QVector<double>::iterator begin, QVector<double>::iterator end) {
+  const qsizetype size = end - begin;
+  if (size <= 0)
+    return 0.;
+  auto mid = begin + size / 2;
+  std::nth_element(begin, mid, end);
+  if (size % 2)
+    return *mid;
+  return (*std::max_element(begin, mid) + *mid) / 2.;
+}
+
+// Samples distribution by selection (scratch buffer reused between calls)
+static BenchStats computeStats(const QVector<double>& samples, double factor,
+                               QVector<double>& scratch) {
+  BenchStats stats;
+  const qsizetype count = samples.size();
+  if (count <= 0)
+    return stats;
+
+  scratch = samples;
+  auto first = scratch.begin(), last = scratch.end();
+  // Value at sorted rank within [begin, end) range
+  auto rangeRank = [](QVector<double>::iterator begin, QVector<double>::iterator end,
+                      qsizetype rank) {
+    std::nth_element(begin, begin + rank, end);
+    return *(begin + rank);
+  };
+
+  const auto minMax = std::minmax_element(first, last);
+  stats.min = *minMax.first;
+  stats.max = *minMax.second;
+
+  // Halves are partitioned by median selection, then handled independently
+  stats.median = rangeMedian(first, last);
+  auto uppFirst = first + count / 2 + (count % 2);
+  stats.lowQuart = rangeMedian(first, first + count / 2);
+  stats.uppQuart = rangeMedian(uppFirst, last);
+
+  // Nearest rank
+  auto percentile = [&](double ratio) {
+    qsizetype rank = std::clamp<qsizetype>(std::ceil(ratio * count) - 1, 0, count - 1);
+    return rangeRank(first, last, rank);
+  };
+  stats.p90 = percentile(0.90);
+  stats.p99 = percentile(0.99);
+
+  stats.min *= factor;
+  stats.max *= factor;
+  stats.median *= factor;
+  stats.lowQuart *= factor;
+  stats.uppQuart *= factor;
+  stats.p90 *= factor;
+  stats.p99 *= factor;
+
+  return stats;
+}
+
+// Fill aggregates not reported in results from repetitions (same definitions as Google benchmark)
+// Returns true if cv was computed
+static bool computeAggregates(const QVector<double>& samples, double factor,
+                              const BenchStats& stats, double& mean, double& median,
+                              double& stddev, double& cv) {
+  const qsizetype count = samples.size();
+  if (count < 2)
+    return false;
+
+  const double rawMean = sumReduce(samples.constData(), count) / count;
+  if (mean < 0.)
+    mean = rawMean * factor;
+  if (median < 0.)
+    median = stats.median;
+  if (stddev < 0.) {
+    const double sqDev = squaredDevReduce(samples.constData(), count, rawMean);
+    stddev = std::sqrt(sqDev / (count - 1)) * factor;
+  }
+  if (cv < 0. && mean > 0.) {
+    cv = stddev / mean * 100.;  // percent
+    return true;
+  }
+
+  return false;
+}
+
+// Keep-range of samples according to filter (from precomputed distribution, in us)
+// Returns false if filter does not apply
+static bool computeFences(const QVector<double>& samples, double factor, const BenchStats& stats,
+                          const OutlierFilter& filter, double& low, double& high,
+                          QVector<double>& scratch) {
+  const qsizetype count = samples.size();
+  if (count < 3 || filter.factor <= 0.)
+    return false;
+
+  switch (filter.method) {
+    case OutlierIqr: {
+      const double iqr = stats.uppQuart - stats.lowQuart;
+      low = stats.lowQuart - filter.factor * iqr;
+      high = stats.uppQuart + filter.factor * iqr;
+      return true;
+    }
+    case OutlierMad: {
+      // Median absolute deviation, scaled to stddev of normal distribution
+      const double median = stats.median / factor;
+      scratch.resize(count);
+      const double* data = samples.constData();
+      double* dev = scratch.data();
+      for (qsizetype idx = 0; idx < count; ++idx)
+        dev[idx] = std::abs(data[idx] - median);
+      auto mid = scratch.begin() + count / 2;
+      std::nth_element(scratch.begin(), mid, scratch.end());
+      double mad = *mid;
+      if (count % 2 == 0)
+        mad = (*std::max_element(scratch.begin(), mid) + mad) / 2.;
+      if (mad <= 0.)
+        return false;  // more than half identical samples
+      const double limit = filter.factor * 1.4826 * mad * factor;
+      low = stats.median - limit;
+      high = stats.median + limit;
+      return true;
+    }
+    case OutlierTrim: {
+      const qsizetype rank = static_cast<qsizetype>(std::floor(filter.factor / 100. * count));
+      if (rank <= 0 || 2 * rank >= count)
+        return false;
+      scratch = samples;
+      auto lowIt = scratch.begin() + rank;
+      std::nth_element(scratch.begin(), lowIt, scratch.end());
+      low = *lowIt * factor;
+      auto highIt = scratch.end() - 1 - rank;
+      std::nth_element(lowIt, highIt, scratch.end());
+      high = *highIt * factor;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Aggregates of samples within filter fences (scratch buffer reused between calls)
+static void computeFiltered(const QVector<double>& samples, double factor, const BenchStats& stats,
+                            const OutlierFilter& filter, BenchFiltered& filtered,
+                            QVector<double>& scratch) {
+  filtered = BenchFiltered();
+  double low = 0., high = 0.;
+  if (!computeFences(samples, factor, stats, filter, low, high, scratch))
+    return;
+
+  // Kept samples first, outliers last
+  scratch = samples;
+  auto keptEnd = std::partition(scratch.begin(), scratch.end(), [&](double sample) {
+    return sample * factor >= low && sample * factor <= high;
+  });
+  const qsizetype count = keptEnd - scratch.begin();
+  if (count <= 0)
+    return;
+  for (auto it = keptEnd; it != scratch.end(); ++it)
+    filtered.outliers.append(*it * factor);
+
+  const double mean = sumReduce(scratch.constData(), count) / count;
+  const auto minMax = std::minmax_element(scratch.begin(), keptEnd);
+
+  // Same halves as samples distribution, partitioned by median selection
+  auto first = scratch.begin();
+  const double median = rangeMedian(first, keptEnd);
+  const double lowQuart = rangeMedian(first, first + count / 2);
+  const double uppQuart = rangeMedian(first + count / 2 + (count % 2), keptEnd);
+
+  filtered.lowFence = low;
+  filtered.highFence = high;
+  filtered.min = *minMax.first * factor;
+  filtered.max = *minMax.second * factor;
+  filtered.mean = mean * factor;
+  filtered.median = median * factor;
+  filtered.lowQuart = lowQuart * factor;
+  filtered.uppQuart = uppQuart * factor;
+  if (count >= 2) {
+    const double sqDev = squaredDevReduce(scratch.constData(), count, mean);
+    filtered.stddev = std::sqrt(sqDev / (count - 1)) * factor;
+    if (filtered.mean > 0.)
+      filtered.cv = filtered.stddev / filtered.mean * 100.;  // percent
+  }
+}
+
+void BenchResults::updateStats(const OutlierFilter& filter) {
+  meta.outlierFilter = filter;
+  QVector<double> scratch;
+  for (auto& bchData : benchmarks) {
+    const double timeFactor = getTimeFactorUs(bchData.time_unit);
+
+    bchData.real_stats = computeStats(bchData.real_time, timeFactor, scratch);
+    bchData.cpu_stats = computeStats(bchData.cpu_time, timeFactor, scratch);
+    bchData.kbytes_stats = computeStats(bchData.kbytes_sec, 1., scratch);
+    bchData.kitems_stats = computeStats(bchData.kitems_sec, 1., scratch);
+
+    // Aggregates from repetitions (only folded iterations have multiple samples)
+    if (!bchData.hasAggregate)
+      continue;
+    bool hasCv = false;
+    hasCv |= computeAggregates(bchData.real_time, timeFactor, bchData.real_stats,
+                               bchData.mean_real, bchData.median_real, bchData.stddev_real,
+                               bchData.cv_real);
+    hasCv |= computeAggregates(bchData.cpu_time, timeFactor, bchData.cpu_stats, bchData.mean_cpu,
+                               bchData.median_cpu, bchData.stddev_cpu, bchData.cv_cpu);
+    hasCv |= computeAggregates(bchData.kbytes_sec, 1., bchData.kbytes_stats, bchData.mean_kbytes,
+                               bchData.median_kbytes, bchData.stddev_kbytes, bchData.cv_kbytes);
+    hasCv |= computeAggregates(bchData.kitems_sec, 1., bchData.kitems_stats, bchData.mean_kitems,
+                               bchData.median_kitems, bchData.stddev_kitems, bchData.cv_kitems);
+    meta.hasCv |= hasCv;
+
+    // Aggregates without outliers, raw ones kept
+    if (filter.method == OutlierNone)
+      continue;
+    computeFiltered(bchData.real_time, timeFactor, bchData.real_stats, filter,
+                    bchData.real_filtered, scratch);
+    computeFiltered(bchData.cpu_time, timeFactor, bchData.cpu_stats, filter, bchData.cpu_filtered,
+                    scratch);
+    computeFiltered(bchData.kbytes_sec, 1., bchData.kbytes_stats, filter, bchData.kbytes_filtered,
+                    scratch);
+    computeFiltered(bchData.kitems_sec, 1., bchData.kitems_stats, filter, bchData.kitems_filtered,
+                    scratch);
+  }
+}
+
+/**************************************************************************************************/
+
 QVector<int> BenchResults::segmentAll() const {
   QVector<int> allRes;
   allRes.reserve(benchmarks.size());
@@ -297,6 +560,45 @@ QVector<BenchSubset> BenchResults::segmentBaseNames(const QVector<int>& subset)
 
 /**************************************************************************************************/
 
+QVector<BenchSubset> BenchResults::segmentThreads(const QVector<int>& subset) const {
+  QVector<BenchSubset> nameRes;
+  QMap<QString, int> nameMap;
+
+  for (int idx : subset) {
+    if (idx >= benchmarks.size())
+      continue;  // No longer exists
+
+    // Run name without thread count (e.g. "BM_Foo/8/threads:4/real_time" -> "BM_Foo/8/real_time")
+    const BenchData& bchData = benchmarks[idx];
+    QString difName = bchData.run_name;
+    const int thrdIdx = difName.indexOf("/threads:");
+    if (thrdIdx >= 0) {
+      int thrdEnd = difName.indexOf('/', thrdIdx + 1);
+      if (thrdEnd < 0)
+        thrdEnd = difName.size();
+      difName.remove(thrdIdx, thrdEnd - thrdIdx);
+    }
+
+    if (!nameMap.contains(difName)) {
+      nameMap[difName] = nameRes.size();
+      nameRes.push_back(BenchSubset(difName));
+    }
+    // Append to associated entry
+    nameRes[nameMap[difName]].idxs.push_back(idx);
+  }
+  for (auto& sub : nameRes)
+    std::stable_sort(sub.idxs.begin(), sub.idxs.end(), [this](int lhs, int rhs) {
+      return benchmarks[lhs].threads < benchmarks[rhs].threads;
+    });
+  for (const BenchSubset& sub : std::as_const(nameRes))
+    if (BCHRES_DEBUG)
+      qDebug() << "threadSub:" << sub.name << "->" << sub.idxs;
+
+  return nameRes;
+}
+
+/**************************************************************************************************/
+
 QVector<BenchSubset> BenchResults::segment2DNames(const QVector<int>& subset, bool isArg1, int idx1,
                                                   bool isArg2, int idx2) const {
   QVector<BenchSubset> nameRes;
@@ -495,7 +797,56 @@ QString BenchResults::getParamName(bool isArgument, int benchIdx, int paramIdx)
   return benchmarks[benchIdx].templates[paramIdx];
 }
 
+const BenchParam& BenchResults::getParam(bool isArgument, int benchIdx, int paramIdx) const {
+  static const BenchParam noParam;
+  if (paramIdx < 0)
+    return noParam;
+
+  // Argument
+  if (isArgument) {
+    Q_ASSERT(benchmarks[benchIdx].argValues.size() > paramIdx);
+    return benchmarks[benchIdx].argValues[paramIdx];
+  }
+  // Template
+  Q_ASSERT(benchmarks[benchIdx].tpltValues.size() > paramIdx);
+  return benchmarks[benchIdx].tpltValues[paramIdx];
+}
+
 /**************************************************************************************************/
+int BenchResults::getComplexityIndex(int benchIdx) const {
+  if (complexities.isEmpty())
+    return -1;
+
+  // Family run name is the run name without its arguments (e.g. "/threads:2" kept)
+  const QStringList benchParts = benchmarks[benchIdx].run_name.split('/');
+  for (int idx = 0; idx < complexities.size(); ++idx) {
+    const QStringList parts = complexities[idx].run_name.split('/');
+    if (parts.constFirst() != benchParts.constFirst())
+      continue;
+    if (std::all_of(parts.cbegin() + 1, parts.cend(),
+                    [&benchParts](const QString& part) { return benchParts.contains(part); }))
+      return idx;
+  }
+  return -1;
+}
+
+/**************************************************************************************************/
+QVector<int> BenchResults::matchBenchmarks(const BenchResults& other,
+                                           const QVector<int>& otherIdxs) const {
+  QHash<QString, int> nameIdxs;
+  nameIdxs.reserve(benchmarks.size());
+  for (int idx = 0; idx < benchmarks.size(); ++idx)
+    nameIdxs.insert(benchmarks[idx].name, idx);
+
+  QVector<int> idxs;
+  idxs.reserve(otherIdxs.size());
+  for (int otherIdx : otherIdxs) {
+    if (auto it = nameIdxs.constFind(other.benchmarks[otherIdx].name); it != nameIdxs.cend())
+      idxs.append(it.value());
+  }
+  return idxs;
+}
+
 /**************************************************************************************************/
 
 void BenchResults::appendResults(const BenchResults& bchRes) {
@@ -533,11 +884,22 @@ void BenchResults::appendResults(const BenchResults& bchRes) {
       qDebug() << "newBench:" << newBench.name << "|" << tempName;
   }
 
+  // Complexities (known families keep their first results)
+  for (const auto& newComplexity : std::as_const(bchRes.complexities)) {
+    auto it = std::find_if(complexities.cbegin(), complexities.cend(), [&](const auto& cplx) {
+      return cplx.run_name == newComplexity.run_name;
+    });
+    if (it == complexities.cend())
+      complexities.append(newComplexity);
+  }
+
   // Meta
   if (this->meta.maxArguments < bchRes.meta.maxArguments)
     this->meta.maxArguments = bchRes.meta.maxArguments;
   if (this->meta.maxTemplates < bchRes.meta.maxTemplates)
     this->meta.maxTemplates = bchRes.meta.maxTemplates;
+  if (this->meta.maxThreads < bchRes.meta.maxThreads)
+    this->meta.maxThreads = bchRes.meta.maxThreads;
   if (this->meta.time_unit != bchRes.meta.time_unit)
     this->meta.time_unit = "us";
 
@@ -564,11 +926,24 @@ void BenchResults::overwriteResults(const BenchResults& bchRes) {
       this->benchmarks[idx] = newBench;
   }
 
+  // Complexities
+  for (const auto& newComplexity : std::as_const(bchRes.complexities)) {
+    auto it = std::find_if(complexities.begin(), complexities.end(), [&](const auto& cplx) {
+      return cplx.run_name == newComplexity.run_name;
+    });
+    if (it == complexities.end())
+      complexities.append(newComplexity);
+    else
+      *it = newComplexity;
+  }
+
   // Meta
   if (this->meta.maxArguments < bchRes.meta.maxArguments)
     this->meta.maxArguments = bchRes.meta.maxArguments;
   if (this->meta.maxTemplates < bchRes.meta.maxTemplates)
     this->meta.maxTemplates = bchRes.meta.maxTemplates;
+  if (this->meta.maxThreads < bchRes.meta.maxThreads)
+    this->meta.maxThreads = bchRes.meta.maxThreads;
   if (this->meta.time_unit != bchRes.meta.time_unit)
     this->meta.time_unit = "us";
 
@@ -0,0 +1,85 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "change_points.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Minimum reference sigma relative to mean (avoids infinite sensitivity on stable values)
+static constexpr double kMinRelativeSigma = 0.01;
+
+ChangePointDetector::ChangePointDetector(double threshold, double drift, int warmup)
+    : mThreshold(threshold)
+    , mDrift(drift)
+    , mWarmup(std::max(warmup, 2)) {
+  startSegment(0);
+}
+
+bool ChangePointDetector::append(double value) {
+  mValues.append(value);
+  return process(mValues.size() - 1);
+}
+
+void ChangePointDetector::clear() {
+  mValues.clear();
+  mChangePoints.clear();
+  startSegment(0);
+}
+
+void ChangePointDetector::startSegment(int begin) {
+  mSegBegin = begin;
+  mCount = 0;
+  mMean = mM2 = 0.;
+  mHighSum = mLowSum = 0.;
+  mHighStart = mLowStart = begin + mWarmup;
+}
+
+bool ChangePointDetector::process(int idx) {
+  const double value = mValues[idx];
+
+  if (mCount >= mWarmup) {
+    // Deviation from previous values, scaled to unit variance
+    const double sigma =
+        std::max(std::sqrt(mM2 / (mCount - 1)), kMinRelativeSigma * std::abs(mMean));
+    const double z = (sigma > 0.) ? (value - mMean) / sigma * std::sqrt(mCount / (mCount + 1.))
+                                  : 0.;
+
+    // Cumulative sums of deviations beyond drift
+    mHighSum = std::max(0., mHighSum + z - mDrift);
+    if (mHighSum == 0.)
+      mHighStart = idx + 1;
+    mLowSum = std::max(0., mLowSum - z - mDrift);
+    if (mLowSum == 0.)
+      mLowStart = idx + 1;
+
+    if (mHighSum > mThreshold || mLowSum > mThreshold) {
+      // New segment from change, process its values again
+      const int changeIdx = (mHighSum > mThreshold) ? mHighStart : mLowStart;
+      mChangePoints.append(changeIdx);
+      startSegment(changeIdx);
+      for (int reIdx = changeIdx; reIdx <= idx; ++reIdx)
+        process(reIdx);
+      return true;
+    }
+  }
+
+  // Segment statistics (Welford)
+  ++mCount;
+  const double delta = value - mMean;
+  mMean += delta / mCount;
+  mM2 += delta * (value - mMean);
+  return false;
+}
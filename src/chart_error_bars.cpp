@@ -0,0 +1,87 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "chart_error_bars.h"
+
+#include <utility>
+
+#include <QAbstractBarSeries>
+#include <QBarSet>
+#include <QChart>
+#include <QPainter>
+#include <QXYSeries>
+
+// Whisker cap half-width (pixels)
+static constexpr qreal kCapSize = 3.;
+
+ChartErrorBars::ChartErrorBars(QChart* chart) : ChartOverlay(chart) {}
+
+void ChartErrorBars::addBar(QXYSeries* series, double x, double low, double high) {
+  mBars.append({series, -1, x, low, high});
+  update();
+}
+
+void ChartErrorBars::addBar(QAbstractBarSeries* series, int setIdx, int category, double low,
+                            double high) {
+  mBars.append({series, setIdx, static_cast<double>(category), low, high});
+  update();
+}
+
+void ChartErrorBars::clearItems() { mBars.clear(); }
+
+void ChartErrorBars::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*option*/,
+                           QWidget* /*widget*/) {
+  if (mBars.isEmpty())
+    return;
+
+  painter->save();
+  painter->setClipRect(mChart->plotArea());
+
+  for (const auto& bar : std::as_const(mBars)) {
+    if (!bar.series->isVisible())
+      continue;
+
+    QColor color;
+    double pos = bar.pos;
+    bool horizontal = false;
+    if (bar.setIdx < 0) {
+      color = static_cast<QXYSeries*>(bar.series)->color();
+    } else {
+      // Bar center inside its category group (same layout as Qt bar series)
+      const auto barSeries = static_cast<QAbstractBarSeries*>(bar.series);
+      const auto barSets = barSeries->barSets();
+      if (bar.setIdx >= barSets.size())
+        continue;
+      color = barSets[bar.setIdx]->color();
+      const double groupWidth = barSeries->barWidth();
+      pos += -groupWidth / 2. + (bar.setIdx + 0.5) * groupWidth / barSets.size();
+      horizontal = barSeries->type() == QAbstractSeries::SeriesTypeHorizontalBar;
+    }
+
+    const double low = bar.low * mScale, high = bar.high * mScale;
+    const QPointF lowPos =
+        mChart->mapToPosition(horizontal ? QPointF(low, pos) : QPointF(pos, low), bar.series);
+    const QPointF highPos =
+        mChart->mapToPosition(horizontal ? QPointF(high, pos) : QPointF(pos, high), bar.series);
+    const QPointF cap = horizontal ? QPointF(0., kCapSize) : QPointF(kCapSize, 0.);
+
+    painter->setPen(QPen(color.darker(150), 1.5));
+    painter->drawLine(lowPos, highPos);
+    painter->drawLine(lowPos - cap, lowPos + cap);
+    painter->drawLine(highPos - cap, highPos + cap);
+  }
+
+  painter->restore();
+}
@@ -0,0 +1,230 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "chart_hover.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <QAbstractSeries>
+#include <QChart>
+#include <QChartView>
+#include <QMouseEvent>
+
+#include "bench_statistics.h"
+#include "benchmark_results.h"
+
+// Hit distance around items (pixels)
+static constexpr qreal kHitRadius = 8.;
+// Bins per axis (at most)
+static constexpr qsizetype kMaxBins = 1024;
+
+// Lower bounds of bins with equal counts of values (duplicates merged)
+static QVector<double> getBinEdges(QVector<double> values) {
+  std::sort(values.begin(), values.end());
+  const qsizetype binCount = std::clamp<qsizetype>(
+      (qsizetype)std::ceil(std::sqrt((double)values.size())), 1, kMaxBins);
+  QVector<double> edges;
+  edges.reserve(binCount);
+  for (qsizetype bin = 0; bin < binCount; ++bin) {
+    const double edge = values[bin * values.size() / binCount];
+    if (edges.isEmpty() || edge > edges.constLast())
+      edges.append(edge);
+  }
+  return edges;
+}
+
+// Bin of value (first one if below lowest edge)
+static int getBin(const QVector<double>& edges, double value) {
+  const auto it = std::upper_bound(edges.cbegin(), edges.cend(), value);
+  return std::max(0, (int)(it - edges.cbegin()) - 1);
+}
+
+ChartHover::ChartHover(QChartView* view) : QObject(view), mView(view) {
+  mView->viewport()->setMouseTracking(true);
+  mView->viewport()->installEventFilter(this);
+}
+
+void ChartHover::addItem(QAbstractSeries* series, const QRectF& extent, int key) {
+  if (!std::isfinite(extent.left()) || !std::isfinite(extent.right()) ||
+      !std::isfinite(extent.top()) || !std::isfinite(extent.bottom()))
+    return;
+  mItems.append({series, extent.normalized(), key});
+  mBuilt = false;
+}
+
+void ChartHover::clear() {
+  mItems.clear();
+  mBuilt = false;
+  setHovered(-1);
+}
+
+bool ChartHover::eventFilter(QObject* watched, QEvent* event) {
+  if (event->type() == QEvent::MouseMove) {
+    const auto mouseEvent = static_cast<QMouseEvent*>(event);
+    if (mouseEvent->buttons() == Qt::NoButton) {
+      const QPointF scenePos = mView->mapToScene(mouseEvent->position().toPoint());
+      setHovered(itemAt(mView->chart()->mapFromScene(scenePos)));
+    }
+  } else if (event->type() == QEvent::Leave)
+    setHovered(-1);
+
+  return QObject::eventFilter(watched, event);
+}
+
+/**************************************************************************************************/
+
+void ChartHover::build() {
+  mBuilt = true;
+  mXEdges.clear();
+  mYEdges.clear();
+  mCellStarts.clear();
+  mCellItems.clear();
+  mHalfWidth = mHalfHeight = 0.;
+  if (mItems.isEmpty())
+    return;
+
+  QVector<double> xs, ys;
+  xs.reserve(mItems.size());
+  ys.reserve(mItems.size());
+  for (const auto& item : std::as_const(mItems)) {
+    const QPointF center = item.extent.center();
+    xs.append(center.x());
+    ys.append(center.y());
+    mHalfWidth = std::max(mHalfWidth, item.extent.width() / 2.);
+    mHalfHeight = std::max(mHalfHeight, item.extent.height() / 2.);
+  }
+  mXEdges = getBinEdges(xs);
+  mYEdges = getBinEdges(ys);
+
+  // Counting sort of items by cell
+  const qsizetype columns = mXEdges.size();
+  QVector<int> cells(mItems.size());
+  mCellStarts.fill(0, columns * mYEdges.size() + 1);
+  for (qsizetype idx = 0; idx < mItems.size(); ++idx) {
+    cells[idx] = getBin(mYEdges, ys[idx]) * columns + getBin(mXEdges, xs[idx]);
+    ++mCellStarts[cells[idx] + 1];
+  }
+  std::partial_sum(mCellStarts.begin(), mCellStarts.end(), mCellStarts.begin());
+
+  QVector<int> cellEnds = mCellStarts;
+  mCellItems.resize(mItems.size());
+  for (qsizetype idx = 0; idx < mItems.size(); ++idx)
+    mCellItems[cellEnds[cells[idx]]++] = idx;
+}
+
+int ChartHover::itemAt(const QPointF& pos) {
+  if (!mBuilt)
+    build();
+  QChart* chart = mView->chart();
+  const QRectF plotArea = chart->plotArea();
+  if (mItems.isEmpty() || !plotArea.contains(pos))
+    return -1;
+
+  // Search window in values: hit radius around cursor, widened by item extents
+  QAbstractSeries* series = mItems.constFirst().series;
+  const QPointF hitSize(kHitRadius, kHitRadius);
+  const QRectF window = QRectF(chart->mapToValue(pos - hitSize, series),
+                               chart->mapToValue(pos + hitSize, series))
+                            .normalized()
+                            .adjusted(-mHalfWidth, -mHalfHeight, mHalfWidth, mHalfHeight);
+
+  // Item position in pixels (baseline outside of log axes range clamped to plot area)
+  auto toPosition = [&](const QPointF& value, QAbstractSeries* itemSeries) {
+    const QPointF point = chart->mapToPosition(value, itemSeries);
+    return QPointF(std::isfinite(point.x()) ? point.x() : plotArea.left(),
+                   std::isfinite(point.y()) ? point.y() : plotArea.bottom());
+  };
+
+  // Nearest item extent in cells overlapping window
+  const qsizetype columns = mXEdges.size();
+  const int colBegin = getBin(mXEdges, window.left()), colEnd = getBin(mXEdges, window.right());
+  const int rowBegin = getBin(mYEdges, window.top()), rowEnd = getBin(mYEdges, window.bottom());
+  int bestKey = -1;
+  qreal bestDist = kHitRadius;
+  for (int row = rowBegin; row <= rowEnd; ++row) {
+    for (int col = colBegin; col <= colEnd; ++col) {
+      const qsizetype cell = row * columns + col;
+      for (int itemPos = mCellStarts[cell]; itemPos < mCellStarts[cell + 1]; ++itemPos) {
+        const Item& item = mItems[mCellItems[itemPos]];
+        if (!item.series->isVisible() || !window.contains(item.extent.center()))
+          continue;
+
+        // Distance to extent (0 inside)
+        const QRectF rect = QRectF(toPosition(item.extent.topLeft(), item.series),
+                                   toPosition(item.extent.bottomRight(), item.series))
+                                .normalized();
+        const qreal dx = std::max({rect.left() - pos.x(), 0., pos.x() - rect.right()});
+        const qreal dy = std::max({rect.top() - pos.y(), 0., pos.y() - rect.bottom()});
+        const qreal dist = std::hypot(dx, dy);
+        if (dist < bestDist || (bestKey < 0 && dist <= bestDist)) {
+          bestDist = dist;
+          bestKey = item.key;
+        }
+      }
+    }
+  }
+
+  return bestKey;
+}
+
+void ChartHover::setHovered(int key) {
+  if (key == mHoveredKey)
+    return;
+  mHoveredKey = key;
+  emit hovered(key);
+}
+
+/**************************************************************************************************/
+
+const ConfidenceInterval& getBenchInterval(QHash<int, ConfidenceInterval>& intervals,
+                                           const BenchResults& bchResults, int benchIdx,
+                                           PlotValueType yType) {
+  auto it = intervals.find(benchIdx);
+  if (it == intervals.end())
+    it = intervals.insert(benchIdx,
+                          bootstrapIntervals(bchResults, {benchIdx}, yType).constFirst());
+  return it.value();
+}
+
+QString getBenchHoverText(const BenchResults& bchResults, int benchIdx, PlotValueType yType,
+                          double timeFactor, const ConfidenceInterval& interval) {
+  const BenchData& bchData = bchResults.benchmarks[benchIdx];
+  const bool timeBased = isYTimeBased(yType);
+  const double scale = timeBased ? timeFactor : 1.;
+  QString timeUnit = "us";
+  if (timeFactor > 1.)
+    timeUnit = "ns";
+  else if (timeFactor < 1.)
+    timeUnit = "ms";
+
+  QString text = bchResults.getBenchName(benchIdx) + "\n" +
+                 getYPlotName(yType, timeBased ? timeUnit : QString()) + ": " +
+                 QString::number(getYPlotValue(bchData, yType) * scale, 'g', 6);
+
+  // Interval of Y-value estimator (as error bars)
+  if (interval.isValid)
+    text += "\n95% CI: [" + QString::number(interval.low * scale, 'g', 6) + ", " +
+            QString::number(interval.high * scale, 'g', 6) + "]";
+
+  double factor = 1.;
+  const QVector<double>* samples = getYPlotSamples(bchData, yType, factor);
+  const int repetitions = (samples != nullptr) ? samples->size() : bchData.repetitions;
+  if (repetitions > 0)
+    text += "\nRepetitions: " + QString::number(repetitions);
+
+  return text;
+}
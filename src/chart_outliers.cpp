@@ -0,0 +1,69 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "chart_outliers.h"
+
+#include <utility>
+
+#include <QBoxPlotSeries>
+#include <QChart>
+#include <QPainter>
+
+// Marker radius (pixels)
+static constexpr qreal kMarkerRadius = 3.;
+
+ChartOutliers::ChartOutliers(QChart* chart) : ChartOverlay(chart) {}
+
+void ChartOutliers::addOutliers(QBoxPlotSeries* series, int setIdx, const QVector<double>& values) {
+  for (double value : values)
+    mMarkers.append({series, setIdx, value});
+  update();
+}
+
+void ChartOutliers::clearItems() { mMarkers.clear(); }
+
+void ChartOutliers::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*option*/,
+                          QWidget* /*widget*/) {
+  if (mMarkers.isEmpty())
+    return;
+
+  // Box series sharing categories, side by side (same layout as Qt box plot series)
+  QVector<QBoxPlotSeries*> boxSeries;
+  const auto chartSeries = mChart->series();
+  for (auto series : chartSeries)
+    if (series->type() == QAbstractSeries::SeriesTypeBoxPlot && series->isVisible())
+      boxSeries.append(static_cast<QBoxPlotSeries*>(series));
+  if (boxSeries.isEmpty())
+    return;
+
+  painter->save();
+  painter->setClipRect(mChart->plotArea());
+  painter->setBrush(Qt::NoBrush);
+
+  for (const auto& marker : std::as_const(mMarkers)) {
+    const int seriesIdx = boxSeries.indexOf(marker.series);
+    if (seriesIdx < 0)
+      continue;
+
+    const double pos = marker.setIdx - 0.5 + (seriesIdx + 0.5) / boxSeries.size();
+    const QPointF center =
+        mChart->mapToPosition(QPointF(pos, marker.value * mScale), marker.series);
+
+    painter->setPen(QPen(marker.series->brush().color().darker(150), 1.5));
+    painter->drawEllipse(center, kMarkerRadius, kMarkerRadius);
+  }
+
+  painter->restore();
+}
@@ -0,0 +1,37 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "chart_overlay.h"
+
+#include <QChart>
+
+ChartOverlay::ChartOverlay(QChart* chart) : QGraphicsItem(chart), mChart(chart) {
+  setZValue(10);  // above series
+  QObject::connect(chart, &QChart::plotAreaChanged, chart, [this](const QRectF&) {
+    prepareGeometryChange();
+  });
+}
+
+void ChartOverlay::clear() {
+  clearItems();
+  update();
+}
+
+void ChartOverlay::setScale(double scale) {
+  mScale = scale;
+  update();
+}
+
+QRectF ChartOverlay::boundingRect() const { return mChart->plotArea(); }
@@ -0,0 +1,103 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "chart_violins.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QChart>
+#include <QPainter>
+#include <QPolygonF>
+#include <QTransform>
+#include <QXYSeries>
+
+// Fill opacity of violins (outline opaque)
+static constexpr int kFillAlpha = 96;
+
+ChartViolins::ChartViolins(QChart* chart) : ChartOverlay(chart) {}
+
+void ChartViolins::addViolin(QXYSeries* series, double pos, const DensityEstimate& estimate,
+                             double halfWidth, bool steps) {
+  const auto& density = estimate.density;
+  if (density.isEmpty())
+    return;
+  const double maxDensity = *std::max_element(density.cbegin(), density.cend());
+  if (!(maxDensity > 0.))
+    return;
+
+  // Right side upwards, then mirrored left side downwards
+  const double widthFactor = halfWidth / maxDensity;
+  const qsizetype count = density.size();
+  QPolygonF outline;
+  if (steps) {
+    outline.reserve(4 * count + 4);
+    outline.append(QPointF(0., -0.5));
+    for (qsizetype idx = 0; idx < count; ++idx) {
+      const double width = density[idx] * widthFactor;
+      outline.append(QPointF(width, idx - 0.5));
+      outline.append(QPointF(width, idx + 0.5));
+    }
+    outline.append(QPointF(0., count - 0.5));
+  } else {
+    outline.reserve(2 * count);
+    for (qsizetype idx = 0; idx < count; ++idx)
+      outline.append(QPointF(density[idx] * widthFactor, idx));
+  }
+  for (qsizetype idx = outline.size() - 1; idx >= 0; --idx)
+    outline.append(QPointF(-outline[idx].x(), outline[idx].y()));
+
+  Violin violin{series, pos, estimate.low, estimate.step, QPainterPath()};
+  violin.path.addPolygon(outline);
+  violin.path.closeSubpath();
+  mViolins.append(std::move(violin));
+  update();
+}
+
+void ChartViolins::clearItems() { mViolins.clear(); }
+
+void ChartViolins::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*option*/,
+                         QWidget* /*widget*/) {
+  if (mViolins.isEmpty())
+    return;
+
+  painter->save();
+  painter->setClipRect(mChart->plotArea());
+
+  for (const auto& violin : std::as_const(mViolins)) {
+    if (!violin.series->isVisible())
+      continue;
+
+    // Linear axes: grid units placed from origin and one unit step on each axis
+    const double low = violin.low * mScale;
+    const QPointF origin = mChart->mapToPosition(QPointF(violin.pos, low), violin.series);
+    const QPointF xUnit =
+        mChart->mapToPosition(QPointF(violin.pos + 1., low), violin.series) - origin;
+    const QPointF yUnit =
+        mChart->mapToPosition(QPointF(violin.pos, low + violin.step * mScale), violin.series) -
+        origin;
+    const QTransform transform(xUnit.x(), xUnit.y(), yUnit.x(), yUnit.y(), origin.x(),
+                               origin.y());
+
+    QColor fill = violin.series->color();
+    const QColor outline = fill.darker(150);
+    fill.setAlpha(kFillAlpha);
+    painter->setPen(QPen(outline, 1.));
+    painter->setBrush(fill);
+    painter->drawPath(transform.map(violin.path));
+  }
+
+  painter->restore();
+}
@@ -15,17 +15,33 @@
 
 #include "commandline_handler.h"
 
+#include <cstring>
+
 #include <QApplication>
 #include <QDebug>
 #include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QXmlStreamWriter>
 
+#include "bench_comparison.h"
+#include "bench_statistics.h"
 #include "benchmark_results.h"
+#include "history_store.h"
 #include "plot_parameters.h"
 #include "plotter_3dbars.h"
 #include "plotter_3dsurface.h"
 #include "plotter_barchart.h"
 #include "plotter_boxchart.h"
+#include "plotter_heatmap.h"
+#include "plotter_historychart.h"
 #include "plotter_linechart.h"
+#include "plotter_scalingchart.h"
+#include "plotter_violinchart.h"
 #include "result_parser.h"
 
 const char* ct_name = "chart-type";
@@ -34,13 +50,26 @@ const char* cy_name = "chart-y";
 const char* cz_name = "chart-z";
 const char* fa_name = "append";
 const char* fo_name = "overwrite";
+const char* ol_name = "outliers";
+
+const char* compare_cmd = "compare";
+const char* record_cmd = "record";
+const char* lb_name = "label";
+const char* st_name = "store";
+const char* th_name = "threshold";
+const char* tf_name = "threshold-for";
+const char* te_name = "test";
+const char* al_name = "alpha";
+const char* fm_name = "format";
+const char* out_name = "output";
 
 CommandLineHandler::CommandLineHandler() {
   // Parser configuration
   mParser.setApplicationDescription("JOMT - Help");
   mParser.addHelpOption();
   mParser.addVersionOption();
-  mParser.addPositionalArgument("file", "Benchmark results file in json to parse.", "[file]");
+  mParser.addPositionalArgument(
+      "file", "Benchmark results file (json, csv or console output) to parse.", "[file]");
 
   QCommandLineOption chartTypeOption(QStringList() << "ct" << ct_name,
                                      "Chart type (e.g. Lines, Boxes, 3DBars)", "chart_type",
@@ -69,6 +98,11 @@ CommandLineHandler::CommandLineHandler() {
                                      "Files to append by overwriting (uses ';' as separator)",
                                      "files...");
   mParser.addOption(overwriteOption);
+
+  QCommandLineOption outliersOption(QStringList() << "ol" << ol_name,
+                                    "Repetitions outlier filter (e.g. none, iqr, mad:3, trim:10)",
+                                    "filter");
+  mParser.addOption(outliersOption);
 }
 
 bool CommandLineHandler::process(const QApplication& app) {
@@ -77,6 +111,15 @@ bool CommandLineHandler::process(const QApplication& app) {
 
   const QStringList args = mParser.positionalArguments();
 
+  // Outlier filter overriding preference
+  if (mParser.isSet(ol_name)) {
+    OutlierFilter filter;
+    if (parseOutlierFilter(mParser.value(ol_name), filter))
+      ResultParser::setOutlierFilter(filter);
+    else
+      qWarning() << "[CmdLine] Ignoring invalid outlier filter:" << mParser.value(ol_name);
+  }
+
   if (args.empty())
     return false;  // Not handled
   else if (args.size() > 1)
@@ -84,7 +127,7 @@ bool CommandLineHandler::process(const QApplication& app) {
 
   // Parse results
   QString errorMsg;
-  BenchResults bchResults = ResultParser::parseJsonFile(args[0], errorMsg);
+  BenchResults bchResults = ResultParser::parseResultsFile(args[0], errorMsg);
 
   if (bchResults.benchmarks.isEmpty()) {
     qCritical() << "[CmdLine] Error parsing file: " << args[0] << " -> " << errorMsg;
@@ -111,7 +154,7 @@ bool CommandLineHandler::process(const QApplication& app) {
     for (const auto& fileName : std::as_const(apList)) {
       if (QFile::exists(fileName)) {
         QString errorMsg;
-        BenchResults newResults = ResultParser::parseJsonFile(fileName, errorMsg);
+        BenchResults newResults = ResultParser::parseResultsFile(fileName, errorMsg);
         if (newResults.benchmarks.size() <= 0) {
           qCritical() << "[CmdLine] Error parsing append file: " << fileName << " -> " << errorMsg;
           return true;
@@ -128,7 +171,7 @@ bool CommandLineHandler::process(const QApplication& app) {
     for (const auto& fileName : std::as_const(owList)) {
       if (QFile::exists(fileName)) {
         QString errorMsg;
-        BenchResults newResults = ResultParser::parseJsonFile(fileName, errorMsg);
+        BenchResults newResults = ResultParser::parseResultsFile(fileName, errorMsg);
         if (newResults.benchmarks.size() <= 0) {
           qCritical() << "[CmdLine] Error parsing overwrite file: " << fileName << " -> "
                       << errorMsg;
@@ -156,6 +199,14 @@ bool CommandLineHandler::process(const QApplication& app) {
     plotParams.type = Chart3DBarsType;
   else if (chartType == "3dsurface")
     plotParams.type = Chart3DSurfaceType;
+  else if (chartType == "history")
+    plotParams.type = ChartHistoryType;
+  else if (chartType == "scaling")
+    plotParams.type = ChartScalingType;
+  else if (chartType == "heatmap")
+    plotParams.type = ChartHeatmapType;
+  else if (chartType == "violins")
+    plotParams.type = ChartViolinType;
   else {
     plotParams.type = ChartLineType;
     qWarning() << "[CmdLine] Unknown chart-type:" << chartType;
@@ -328,8 +379,398 @@ bool CommandLineHandler::process(const QApplication& app) {
       plot3DSurface->show();
       break;
     }
+    case ChartHistoryType: {
+      PlotterHistoryChart* plotHistory =
+          new PlotterHistoryChart(bchResults, bchIdxs, plotParams, fileName, addFilenames);
+      plotHistory->show();
+      break;
+    }
+    case ChartScalingType: {
+      PlotterScalingChart* plotScaling =
+          new PlotterScalingChart(bchResults, bchIdxs, plotParams, fileName, addFilenames);
+      plotScaling->show();
+      break;
+    }
+    case ChartHeatmapType: {
+      PlotterHeatmap* plotHeatmap =
+          new PlotterHeatmap(bchResults, bchIdxs, plotParams, fileName, addFilenames);
+      plotHeatmap->show();
+      break;
+    }
+    case ChartViolinType: {
+      PlotterViolinChart* plotViolins =
+          new PlotterViolinChart(bchResults, bchIdxs, plotParams, fileName, addFilenames);
+      plotViolins->show();
+      break;
+    }
   }
 
   // Handled
   return true;
 }
+
+/**************************************************************************************************
+ *
+ * Compare
+ *
+ **************************************************************************************************/
+
+// Exit codes
+static constexpr int kExitOk = 0;
+static constexpr int kExitRegression = 1;
+static constexpr int kExitError = 2;
+
+// Glob threshold (first matching pattern applies)
+struct CompareThreshold {
+  QRegularExpression pattern;
+  double percent;
+};
+
+// Benchmark verdict
+enum CompareStatus { CompareSame, CompareImproved, CompareRegressed, CompareUntested };
+
+static const char* getStatusName(CompareStatus status) {
+  switch (status) {
+    case CompareImproved:
+      return "improved";
+    case CompareRegressed:
+      return "regressed";
+    case CompareUntested:
+      return "untested";
+    default:
+      return "same";
+  }
+}
+
+// Y-value from command line name (e.g. RealTime, CPUMeanTime, ItemsMedian)
+static bool parseValueType(const QString& name, PlotValueType& yType) {
+  static const QHash<QString, PlotValueType> valueTypes{
+      {"cputime", CpuTimeType},           {"cpumintime", CpuTimeMinType},
+      {"cpumeantime", CpuTimeMeanType},   {"cpumediantime", CpuTimeMedianType},
+      {"realtime", RealTimeType},         {"realmintime", RealTimeMinType},
+      {"realmeantime", RealTimeMeanType}, {"realmediantime", RealTimeMedianType},
+      {"iterations", IterationsType},     {"bytes", BytesType},
+      {"bytesmin", BytesMinType},         {"bytesmean", BytesMeanType},
+      {"bytesmedian", BytesMedianType},   {"items", ItemsType},
+      {"itemsmin", ItemsMinType},         {"itemsmean", ItemsMeanType},
+      {"itemsmedian", ItemsMedianType}};
+
+  auto it = valueTypes.constFind(name.toLower());
+  if (it == valueTypes.cend())
+    return false;
+  yType = it.value();
+  return true;
+}
+
+// Parse "glob=percent" list (uses ';' as separator), '*' and '?' also match '/'
+static bool parseThresholds(const QString& list, QVector<CompareThreshold>& thresholds) {
+  const QStringList items = list.split(';', Qt::SkipEmptyParts);
+  for (const auto& item : items) {
+    const qsizetype sepIdx = item.lastIndexOf('=');
+    bool ok = false;
+    const double percent = (sepIdx > 0) ? item.mid(sepIdx + 1).toDouble(&ok) : 0.;
+    if (!ok || percent < 0.) {
+      qCritical() << "[CmdLine] Invalid threshold:" << item;
+      return false;
+    }
+    QString regex = QRegularExpression::escape(item.left(sepIdx).trimmed());
+    regex.replace("\\*", ".*").replace("\\?", ".");
+    thresholds.append({QRegularExpression(QRegularExpression::anchoredPattern(regex)), percent});
+  }
+  return true;
+}
+
+// Parse headless command options (help/version exit with kExitOk, errors reported to caller)
+static bool parseHeadlessArgs(QCommandLineParser& parser, const QCoreApplication& app) {
+  if (!parser.parse(app.arguments())) {
+    qCritical() << "[CmdLine]" << parser.errorText();
+    return false;
+  }
+  if (parser.isSet("help") || parser.isSet("help-all"))
+    parser.showHelp(kExitOk);
+  if (parser.isSet("version"))
+    parser.showVersion();
+  return true;
+}
+
+bool CommandLineHandler::isHeadlessCommand(int argc, char* argv[]) {
+  return argc > 1 &&
+         (std::strcmp(argv[1], compare_cmd) == 0 || std::strcmp(argv[1], record_cmd) == 0);
+}
+
+int CommandLineHandler::processHeadless(const QCoreApplication& app) {
+  const QStringList args = app.arguments();
+  if (args.size() > 1 && args[1] == record_cmd)
+    return processRecord(app);
+  return processCompare(app);
+}
+
+int CommandLineHandler::processCompare(const QCoreApplication& app) {
+  QCommandLineParser parser;
+  parser.setApplicationDescription("JOMT - Compare candidate results against baseline");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument(compare_cmd, "Compare command.", compare_cmd);
+  parser.addPositionalArgument("baseline", "Baseline results file.");
+  parser.addPositionalArgument("candidate", "Candidate results file.");
+
+  parser.addOption(QCommandLineOption(QStringList() << "cy" << cy_name,
+                                      "Compared value (e.g. RealTime, CPUMeanTime, ItemsMedian)",
+                                      "value", "RealTime"));
+  parser.addOption(QCommandLineOption(QStringList() << "th" << th_name,
+                                      "Default regression threshold in percent", "percent", "5"));
+  parser.addOption(QCommandLineOption(
+      QStringList() << "tf" << tf_name,
+      "Per-benchmark thresholds as glob=percent (uses ';' as separator, first match applies)",
+      "thresholds"));
+  parser.addOption(QCommandLineOption(QStringList() << "te" << te_name,
+                                      "Statistical test on repetitions (mwu, welch)", "test",
+                                      "mwu"));
+  parser.addOption(QCommandLineOption(QStringList() << "al" << al_name,
+                                      "Significance level of test", "alpha", "0.05"));
+  parser.addOption(QCommandLineOption(QStringList() << "fm" << fm_name,
+                                      "Report format (text, json, junit)", "format", "text"));
+  parser.addOption(QCommandLineOption(QStringList() << "o" << out_name,
+                                      "Report file (standard output otherwise)", "file"));
+  parser.addOption(QCommandLineOption(QStringList() << "ol" << ol_name,
+                                      "Repetitions outlier filter (none, iqr, mad, trim[:factor])",
+                                      "filter", "none"));
+  if (!parseHeadlessArgs(parser, app))
+    return kExitError;
+
+  const QStringList args = parser.positionalArguments();
+  if (args.size() != 3) {
+    qCritical() << "[CmdLine] Expected baseline and candidate files";
+    return kExitError;
+  }
+
+  // Params
+  PlotValueType yType;
+  if (!parseValueType(parser.value(cy_name), yType)) {
+    qCritical() << "[CmdLine] Unknown compared value:" << parser.value(cy_name);
+    return kExitError;
+  }
+  bool ok = false;
+  const double defaultThreshold = parser.value(th_name).toDouble(&ok);
+  if (!ok || defaultThreshold < 0.) {
+    qCritical() << "[CmdLine] Invalid threshold:" << parser.value(th_name);
+    return kExitError;
+  }
+  QVector<CompareThreshold> thresholds;
+  if (!parseThresholds(parser.value(tf_name), thresholds))
+    return kExitError;
+
+  const QString testName = parser.value(te_name).toLower();
+  CompareTest test;
+  if (testName == "mwu")
+    test = MannWhitneyTest;
+  else if (testName == "welch")
+    test = WelchTest;
+  else {
+    qCritical() << "[CmdLine] Unknown test:" << testName;
+    return kExitError;
+  }
+  const double alpha = parser.value(al_name).toDouble(&ok);
+  if (!ok || alpha <= 0. || alpha >= 1.) {
+    qCritical() << "[CmdLine] Invalid alpha:" << parser.value(al_name);
+    return kExitError;
+  }
+  const QString format = parser.value(fm_name).toLower();
+  if (format != "text" && format != "json" && format != "junit") {
+    qCritical() << "[CmdLine] Unknown report format:" << format;
+    return kExitError;
+  }
+  OutlierFilter filter;
+  if (!parseOutlierFilter(parser.value(ol_name), filter)) {
+    qCritical() << "[CmdLine] Invalid outlier filter:" << parser.value(ol_name);
+    return kExitError;
+  }
+  ResultParser::setOutlierFilter(filter);
+
+  // Parse results
+  BenchResults bchResults[2];
+  for (int i = 0; i < 2; ++i) {
+    QString errorMsg;
+    bchResults[i] = ResultParser::parseResultsFile(args[i + 1], errorMsg);
+    if (bchResults[i].benchmarks.isEmpty()) {
+      qCritical() << "[CmdLine] Error parsing file: " << args[i + 1] << " -> " << errorMsg;
+      return kExitError;
+    }
+  }
+  const BenchResults& baseline = bchResults[0];
+  const BenchResults& candidate = bchResults[1];
+  const ResultsComparison comparison = compareResults(baseline, candidate, yType, test);
+
+  // Verdicts: change beyond threshold, and significant if repetitions allow testing
+  const bool lowerBetter = isYLowerBetter(yType);
+  QVector<CompareStatus> statuses(comparison.matched.size(), CompareSame);
+  QVector<double> changes(comparison.matched.size(), 0.), limits(comparison.matched.size());
+  int regressions = 0, improvements = 0, untested = 0;
+  for (int idx = 0; idx < comparison.matched.size(); ++idx) {
+    const BenchComparison& cmp = comparison.matched[idx];
+    const QString& name = candidate.benchmarks[cmp.candIdx].run_name;
+
+    limits[idx] = defaultThreshold;
+    for (const auto& threshold : std::as_const(thresholds)) {
+      if (threshold.pattern.match(name).hasMatch()) {
+        limits[idx] = threshold.percent;
+        break;
+      }
+    }
+    if (cmp.ratio < 0.) {
+      statuses[idx] = CompareUntested;
+      ++untested;
+      continue;
+    }
+    changes[idx] = (lowerBetter ? cmp.ratio - 1. : 1. - cmp.ratio) * 100.;  // positive if worse
+    const bool significant = cmp.pValue < 0. || cmp.pValue < alpha;
+    if (significant && changes[idx] > limits[idx]) {
+      statuses[idx] = CompareRegressed;
+      ++regressions;
+    } else if (significant && -changes[idx] > limits[idx]) {
+      statuses[idx] = CompareImproved;
+      ++improvements;
+    }
+  }
+
+  // Report
+  QFile outFile;
+  if (parser.isSet(out_name)) {
+    outFile.setFileName(parser.value(out_name));
+    if (!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+      qCritical() << "[CmdLine] Cannot write report file:" << outFile.fileName();
+      return kExitError;
+    }
+  } else
+    outFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+
+  const QString valueName = getYPlotName(yType);
+  if (format == "json") {
+    QJsonArray benchmarks;
+    for (int idx = 0; idx < comparison.matched.size(); ++idx) {
+      const BenchComparison& cmp = comparison.matched[idx];
+      QJsonObject bench{{"name", candidate.benchmarks[cmp.candIdx].run_name},
+                        {"baseline", cmp.baseValue},
+                        {"candidate", cmp.candValue},
+                        {"change_percent", changes[idx]},
+                        {"threshold_percent", limits[idx]},
+                        {"status", getStatusName(statuses[idx])}};
+      if (cmp.ratio >= 0.)
+        bench.insert("ratio", cmp.ratio);
+      if (cmp.pValue >= 0.)
+        bench.insert("p_value", cmp.pValue);
+      benchmarks.append(bench);
+    }
+    QJsonObject report{{"baseline", args[1]},
+                       {"candidate", args[2]},
+                       {"value", valueName},
+                       {"test", testName},
+                       {"alpha", alpha},
+                       {"regressions", regressions},
+                       {"improvements", improvements},
+                       {"benchmarks", benchmarks},
+                       {"baseline_only", QJsonArray::fromStringList(comparison.baseOnly)},
+                       {"candidate_only", QJsonArray::fromStringList(comparison.candOnly)}};
+    outFile.write(QJsonDocument(report).toJson());
+  } else if (format == "junit") {
+    QXmlStreamWriter xml(&outFile);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("testsuites");
+    xml.writeStartElement("testsuite");
+    xml.writeAttribute("name", "jomt.compare");
+    xml.writeAttribute("tests", QString::number(comparison.matched.size()));
+    xml.writeAttribute("failures", QString::number(regressions));
+    xml.writeAttribute("skipped", QString::number(untested));
+    for (int idx = 0; idx < comparison.matched.size(); ++idx) {
+      const BenchComparison& cmp = comparison.matched[idx];
+      xml.writeStartElement("testcase");
+      xml.writeAttribute("classname", "jomt.compare");
+      xml.writeAttribute("name", candidate.benchmarks[cmp.candIdx].run_name);
+      if (statuses[idx] == CompareRegressed) {
+        xml.writeStartElement("failure");
+        xml.writeAttribute("message", QString::asprintf("%s worse by %.2f%% (threshold %g%%)",
+                                                        qPrintable(valueName), changes[idx],
+                                                        limits[idx]));
+        xml.writeCharacters(QString::asprintf("baseline=%g candidate=%g p=%g", cmp.baseValue,
+                                              cmp.candValue, cmp.pValue));
+        xml.writeEndElement();
+      } else if (statuses[idx] == CompareUntested) {
+        xml.writeEmptyElement("skipped");
+      }
+      xml.writeEndElement();
+    }
+    xml.writeEndElement();
+    xml.writeEndElement();
+    xml.writeEndDocument();
+  } else {  // text
+    QTextStream out(&outFile);
+    out << "Comparing " << valueName << ": " << args[1] << " -> " << args[2] << "\n";
+    for (int idx = 0; idx < comparison.matched.size(); ++idx) {
+      if (statuses[idx] == CompareSame)
+        continue;
+      const BenchComparison& cmp = comparison.matched[idx];
+      const QString pValue = (cmp.pValue < 0.) ? "-" : QString::number(cmp.pValue, 'g', 3);
+      out << QString::asprintf("%-10s %+8.2f%%  p=%-8s ", getStatusName(statuses[idx]),
+                               changes[idx], qPrintable(pValue))
+          << candidate.benchmarks[cmp.candIdx].run_name << "\n";
+    }
+    out << comparison.matched.size() << " compared, " << regressions << " regressed, "
+        << improvements << " improved, " << comparison.baseOnly.size() << " baseline only, "
+        << comparison.candOnly.size() << " candidate only\n";
+  }
+
+  return (regressions > 0) ? kExitRegression : kExitOk;
+}
+
+/**************************************************************************************************
+ *
+ * Record
+ *
+ **************************************************************************************************/
+
+int CommandLineHandler::processRecord(const QCoreApplication& app) {
+  QCommandLineParser parser;
+  parser.setApplicationDescription("JOMT - Record results in history store");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument(record_cmd, "Record command.", record_cmd);
+  parser.addPositionalArgument("files", "Benchmark results files to record (one run each).",
+                               "files...");
+
+  parser.addOption(QCommandLineOption(QStringList() << "lb" << lb_name,
+                                      "Run label, e.g. commit (file name otherwise)", "label"));
+  parser.addOption(QCommandLineOption(QStringList() << "st" << st_name,
+                                      "History store directory", "dir",
+                                      HistoryStore::defaultPath()));
+  if (!parseHeadlessArgs(parser, app))
+    return kExitError;
+
+  const QStringList args = parser.positionalArguments();
+  if (args.size() < 2) {
+    qCritical() << "[CmdLine] Expected results files to record";
+    return kExitError;
+  }
+
+  QString errorMsg;
+  HistoryStore store(parser.value(st_name));
+  if (!store.open(errorMsg)) {
+    qCritical() << "[CmdLine] Error opening history:" << errorMsg;
+    return kExitError;
+  }
+
+  for (int i = 1; i < args.size(); ++i) {
+    errorMsg.clear();
+    BenchResults bchResults = ResultParser::parseResultsFile(args[i], errorMsg);
+    if (bchResults.benchmarks.isEmpty()) {
+      qCritical() << "[CmdLine] Error parsing file: " << args[i] << " -> " << errorMsg;
+      return kExitError;
+    }
+    if (!store.addRun(bchResults, args[i], parser.value(lb_name), errorMsg)) {
+      qCritical() << "[CmdLine] Error recording file: " << args[i] << " -> " << errorMsg;
+      return kExitError;
+    }
+  }
+
+  return kExitOk;
+}
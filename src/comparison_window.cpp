@@ -0,0 +1,386 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "comparison_window.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QAbstractTableModel>
+#include <QFileInfo>
+#include <QSettings>
+#include <QtCharts>
+
+#include "ui_comparison_window.h"
+
+// Number of chart points above which series are rendered with OpenGL
+static constexpr int kOpenGLPoints = 10000;
+
+/**************************************************************************************************
+ *
+ * Model
+ *
+ **************************************************************************************************/
+
+//
+// Sortable table of comparisons (rows permuted in place, no proxy)
+class ComparisonModel : public QAbstractTableModel {
+ public:
+  enum Column {
+    NameColumn,
+    BaselineColumn,
+    CandidateColumn,
+    DeltaColumn,
+    RatioColumn,
+    PValueColumn,
+    ColumnCount
+  };
+
+  ComparisonModel(const BenchResults& candidate, PlotValueType yType, QObject* parent)
+      : QAbstractTableModel(parent)
+      , mCandidate(candidate)
+      , mYType(yType)
+      , mLowerBetter(isYLowerBetter(yType)) {}
+
+  void setComparisons(const QVector<BenchComparison>& comparisons, double alpha) {
+    beginResetModel();
+    mComparisons = comparisons;
+    mAlpha = alpha;
+    mOrder.resize(mComparisons.size());
+    std::iota(mOrder.begin(), mOrder.end(), 0);
+    endResetModel();
+  }
+
+  void setAlpha(double alpha) {
+    mAlpha = alpha;
+    if (!mComparisons.isEmpty())
+      emit dataChanged(index(0, 0), index(rowCount() - 1, ColumnCount - 1),
+                       {Qt::ForegroundRole});
+  }
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override {
+    return parent.isValid() ? 0 : mOrder.size();
+  }
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override {
+    return parent.isValid() ? 0 : ColumnCount;
+  }
+
+  QVariant data(const QModelIndex& index, int role) const override {
+    if (!index.isValid() || index.row() >= mOrder.size())
+      return QVariant();
+    const BenchComparison& cmp = mComparisons[mOrder[index.row()]];
+
+    if (role == Qt::DisplayRole) {
+      switch (index.column()) {
+        case NameColumn:
+          return mCandidate.benchmarks[cmp.candIdx].run_name;
+        case BaselineColumn:
+          return QString::number(cmp.baseValue, 'g', 6);
+        case CandidateColumn:
+          return QString::number(cmp.candValue, 'g', 6);
+        case DeltaColumn:
+          if (cmp.ratio < 0.)
+            return "-";
+          return QString::asprintf("%+.2f %%", (cmp.ratio - 1.) * 100.);
+        case RatioColumn:
+          if (cmp.ratio < 0.)
+            return "-";
+          return QString::number(cmp.ratio, 'f', 3);
+        case PValueColumn:
+          if (cmp.pValue < 0.)
+            return "-";
+          return QString::number(cmp.pValue, 'g', 3);
+      }
+    } else if (role == Qt::ToolTipRole && index.column() == NameColumn)
+      return mCandidate.benchmarks[cmp.candIdx].run_name;
+    else if (role == Qt::TextAlignmentRole && index.column() != NameColumn)
+      return int(Qt::AlignRight | Qt::AlignVCenter);
+    else if (role == Qt::ForegroundRole && index.column() >= DeltaColumn) {
+      const int significance = getSignificance(cmp, mLowerBetter, mAlpha);
+      if (significance > 0)
+        return QColor(Qt::red);
+      if (significance < 0)
+        return QColor(Qt::darkGreen);
+    }
+    return QVariant();
+  }
+
+  QVariant headerData(int section, Qt::Orientation orientation, int role) const override {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+      return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+      case NameColumn:
+        return "Benchmark";
+      case BaselineColumn:
+        return "Baseline " + getYPlotName(mYType);
+      case CandidateColumn:
+        return "Candidate " + getYPlotName(mYType);
+      case DeltaColumn:
+        return "Delta";
+      case RatioColumn:
+        return "Ratio";
+      case PValueColumn:
+        return "p-value";
+    }
+    return QVariant();
+  }
+
+  void sort(int column, Qt::SortOrder order) override {
+    auto key = [this, column](int idx) -> double {
+      const BenchComparison& cmp = mComparisons[idx];
+      switch (column) {
+        case BaselineColumn:
+          return cmp.baseValue;
+        case CandidateColumn:
+          return cmp.candValue;
+        case PValueColumn:
+          return cmp.pValue;
+        default:  // Delta/Ratio
+          return cmp.ratio;
+      }
+    };
+
+    beginResetModel();
+    if (column == NameColumn)
+      std::stable_sort(mOrder.begin(), mOrder.end(), [this](int lhs, int rhs) {
+        return mCandidate.benchmarks[mComparisons[lhs].candIdx].run_name <
+               mCandidate.benchmarks[mComparisons[rhs].candIdx].run_name;
+      });
+    else
+      std::stable_sort(mOrder.begin(), mOrder.end(),
+                       [&key](int lhs, int rhs) { return key(lhs) < key(rhs); });
+    if (order == Qt::DescendingOrder)
+      std::reverse(mOrder.begin(), mOrder.end());
+    endResetModel();
+  }
+
+ private:
+  const BenchResults mCandidate;
+  const PlotValueType mYType;
+  const bool mLowerBetter;
+
+  QVector<BenchComparison> mComparisons;
+  QVector<int> mOrder;  // row -> comparison index
+  double mAlpha = 0.05;
+};
+
+/**************************************************************************************************
+ *
+ * Window
+ *
+ **************************************************************************************************/
+
+ComparisonWindow::ComparisonWindow(const BenchResults& baseline, const BenchResults& candidate,
+                                   PlotValueType yType, const QString& baseFilename,
+                                   const QString& candFilename, QWidget* parent)
+    : QWidget(parent)
+    , ui(new Ui::ComparisonWindow)
+    , mBaseline(baseline)
+    , mCandidate(candidate)
+    , mYType(yType) {
+  // UI
+  ui->setupUi(this);
+  this->setAttribute(Qt::WA_DeleteOnClose);
+  this->setWindowTitle("Compare - " + QFileInfo(baseFilename).fileName() + " / " +
+                       QFileInfo(candFilename).fileName());
+
+  mModel = new ComparisonModel(mCandidate, mYType, this);
+  ui->tableView->setModel(mModel);
+  ui->tableView->horizontalHeader()->setSectionResizeMode(ComparisonModel::NameColumn,
+                                                          QHeaderView::Stretch);
+  ui->tableView->verticalHeader()->setVisible(false);
+
+  QChart* chart = new QChart();
+  chart->legend()->setAlignment(Qt::AlignTop);
+  mChartView = new QChartView(chart, this);
+  mChartView->setRenderHint(QPainter::Antialiasing);
+  ui->splitter->insertWidget(0, mChartView);
+
+  connectUI();
+  loadConfig();
+
+  // Init (worst changes first)
+  ui->tableView->horizontalHeader()->setSortIndicator(
+      ComparisonModel::RatioColumn,
+      isYLowerBetter(mYType) ? Qt::DescendingOrder : Qt::AscendingOrder);
+  updateComparison();
+}
+
+ComparisonWindow::~ComparisonWindow() {
+  // Save options to file
+  saveConfig();
+
+  delete ui;
+}
+
+void ComparisonWindow::connectUI() {
+  ui->comboBoxTest->addItem("Mann-Whitney U", MannWhitneyTest);
+  ui->comboBoxTest->addItem("Welch t-test", WelchTest);
+  connect(ui->comboBoxTest, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &ComparisonWindow::onComboTestChanged);
+  connect(ui->doubleSpinBoxAlpha, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this,
+          &ComparisonWindow::onSpinAlphaChanged);
+}
+
+void ComparisonWindow::loadConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("comparison");
+
+  mIgnoreEvents = true;  // applied by first comparison
+  if (auto value = settings.value("test"); value.isValid())
+    ui->comboBoxTest->setCurrentText(value.toString());
+  if (auto value = settings.value("alpha"); value.isValid())
+    ui->doubleSpinBoxAlpha->setValue(value.toDouble());
+  mIgnoreEvents = false;
+
+  settings.endGroup();
+}
+
+void ComparisonWindow::saveConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("comparison");
+
+  settings.setValue("test", ui->comboBoxTest->currentText());
+  settings.setValue("alpha", ui->doubleSpinBoxAlpha->value());
+
+  settings.endGroup();
+}
+
+void ComparisonWindow::updateComparison() {
+  const auto test = static_cast<CompareTest>(ui->comboBoxTest->currentData().toInt());
+  mComparison = compareResults(mBaseline, mCandidate, mYType, test);
+
+  mModel->setComparisons(mComparison.matched, ui->doubleSpinBoxAlpha->value());
+  const QHeaderView* header = ui->tableView->horizontalHeader();
+  mModel->sort(header->sortIndicatorSection(), header->sortIndicatorOrder());
+
+  updateChart();
+}
+
+void ComparisonWindow::updateChart() {
+  const bool lowerBetter = isYLowerBetter(mYType);
+  const double alpha = ui->doubleSpinBoxAlpha->value();
+
+  // Ratios by increasing order
+  QVector<const BenchComparison*> sorted;
+  sorted.reserve(mComparison.matched.size());
+  for (const auto& cmp : std::as_const(mComparison.matched))
+    if (cmp.ratio > 0.)
+      sorted.append(&cmp);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const BenchComparison* lhs, const BenchComparison* rhs) {
+              return lhs->ratio < rhs->ratio;
+            });
+
+  QList<QPointF> ratioPoints, regressPoints, improvePoints;
+  ratioPoints.reserve(sorted.size());
+  int regressions = 0, improvements = 0;
+  for (int rank = 0; rank < sorted.size(); ++rank) {
+    const QPointF point(rank, sorted[rank]->ratio);
+    ratioPoints.append(point);
+
+    const int significance = getSignificance(*sorted[rank], lowerBetter, alpha);
+    if (significance > 0) {
+      regressPoints.append(point);
+      ++regressions;
+    } else if (significance < 0) {
+      improvePoints.append(point);
+      ++improvements;
+    }
+  }
+
+  // Summary
+  ui->labelSummary->setText(QString("Matched: %1 | Regressions: %2 | Improvements: %3 | "
+                                    "Baseline only: %4 | Candidate only: %5")
+                                .arg(mComparison.matched.size())
+                                .arg(regressions)
+                                .arg(improvements)
+                                .arg(mComparison.baseOnly.size())
+                                .arg(mComparison.candOnly.size()));
+
+  // Series
+  QChart* chart = mChartView->chart();
+  chart->removeAllSeries();
+  for (auto axis : chart->axes())
+    chart->removeAxis(axis);
+  if (ratioPoints.isEmpty()) {
+    chart->setTitle("No comparable benchmarks");
+    return;
+  }
+  chart->setTitle("");
+  const bool useOpenGL = ratioPoints.size() > kOpenGLPoints;
+
+  QLineSeries* refSeries = new QLineSeries();
+  refSeries->setName("Baseline");
+  refSeries->append(0., 1.);
+  refSeries->append(ratioPoints.size() - 1, 1.);
+  refSeries->setPen(QPen(Qt::gray, 1., Qt::DashLine));
+
+  QLineSeries* ratioSeries = new QLineSeries();
+  ratioSeries->setName("Candidate / baseline");
+  ratioSeries->replace(ratioPoints);
+  ratioSeries->setUseOpenGL(useOpenGL);
+
+  QScatterSeries* regressSeries = new QScatterSeries();
+  regressSeries->setName("Significant regressions");
+  regressSeries->setColor(Qt::red);
+  regressSeries->setMarkerSize(6.);
+  regressSeries->replace(regressPoints);
+  regressSeries->setUseOpenGL(useOpenGL);
+
+  QScatterSeries* improveSeries = new QScatterSeries();
+  improveSeries->setName("Significant improvements");
+  improveSeries->setColor(Qt::darkGreen);
+  improveSeries->setMarkerSize(6.);
+  improveSeries->replace(improvePoints);
+  improveSeries->setUseOpenGL(useOpenGL);
+
+  // Axes
+  QValueAxis* xAxis = new QValueAxis();
+  xAxis->setTitleText("Benchmarks (by ratio)");
+  xAxis->setLabelFormat("%d");
+  xAxis->setRange(0., std::max<qsizetype>(ratioPoints.size() - 1, 1));
+  chart->addAxis(xAxis, Qt::AlignBottom);
+
+  QLogValueAxis* yAxis = new QLogValueAxis();
+  yAxis->setTitleText("Ratio (" + getYPlotName(mYType, "") + ")");
+  yAxis->setBase(2.);
+  yAxis->setLabelFormat("%g");
+  const double minRatio = std::min(ratioPoints.constFirst().y(), 1.);
+  const double maxRatio = std::max(ratioPoints.constLast().y(), 1.);
+  yAxis->setRange(minRatio / 1.1, maxRatio * 1.1);
+  chart->addAxis(yAxis, Qt::AlignLeft);
+
+  for (QXYSeries* series : {(QXYSeries*)refSeries, (QXYSeries*)ratioSeries,
+                            (QXYSeries*)regressSeries, (QXYSeries*)improveSeries}) {
+    chart->addSeries(series);
+    series->attachAxis(xAxis);
+    series->attachAxis(yAxis);
+  }
+}
+
+void ComparisonWindow::onComboTestChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+  updateComparison();
+}
+
+void ComparisonWindow::onSpinAlphaChanged(double d) {
+  if (mIgnoreEvents)
+    return;
+  mModel->setAlpha(d);
+  updateChart();
+}
@@ -0,0 +1,424 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "complexity_fit.h"
+
+#include <cmath>
+#include <limits>
+
+#include <QVarLengthArray>
+
+/**************************************************************************************************
+ *
+ * Expression
+ *
+ **************************************************************************************************/
+
+static double absFunc(double x) { return std::abs(x); }
+static double expFunc(double x) { return std::exp(x); }
+static double lnFunc(double x) { return std::log(x); }
+static double log2Func(double x) { return std::log2(x); }
+static double log10Func(double x) { return std::log10(x); }
+static double sqrtFunc(double x) { return std::sqrt(x); }
+
+//
+// Recursive descent parser to postfix operations
+//   expr    := term (('+' | '-') term)*
+//   term    := power (('*' | '/')? power)*       (implicit product, e.g. "n log n")
+//   power   := unary ('^' power)?
+//   unary   := '-' unary | primary
+//   primary := number | 'n' | func power | '(' expr ')'
+class ComplexityParser {
+ public:
+  ComplexityParser(const QString& text, std::vector<ComplexityExpression::Op>& ops)
+      : mText(text), mOps(ops) {}
+
+  bool parse(QString& errorMsg, int& maxDepth) {
+    skipSpaces();
+    if (!parseExpr())
+      return fail(errorMsg);
+    if (mPos < mText.size()) {
+      mError = "unexpected '" + QString(mText[mPos]) + "'";
+      return fail(errorMsg);
+    }
+    maxDepth = mMaxDepth;
+    return true;
+  }
+
+ private:
+  using Op = ComplexityExpression::Op;
+
+  bool fail(QString& errorMsg) {
+    errorMsg = "Invalid expression at position " + QString::number(mPos + 1) + ": " + mError;
+    return false;
+  }
+
+  void skipSpaces() {
+    while (mPos < mText.size() && mText[mPos].isSpace())
+      ++mPos;
+  }
+  bool accept(QChar c) {
+    if (mPos >= mText.size() || mText[mPos] != c)
+      return false;
+    ++mPos;
+    skipSpaces();
+    return true;
+  }
+  bool startsPrimary() const {
+    if (mPos >= mText.size())
+      return false;
+    const QChar c = mText[mPos];
+    return c.isLetterOrNumber() || c == '.' || c == '(';
+  }
+
+  // Stack depth tracking: values pushed/popped by operation
+  void pushOp(Op op) {
+    if (op.kind == Op::Number || op.kind == Op::Variable)
+      mMaxDepth = std::max(mMaxDepth, ++mDepth);
+    else if (op.kind != Op::Neg && op.kind != Op::Func)
+      --mDepth;
+    mOps.push_back(op);
+  }
+
+  bool parseExpr() {
+    if (!parseTerm())
+      return false;
+    while (true) {
+      if (accept('+')) {
+        if (!parseTerm())
+          return false;
+        pushOp({Op::Add});
+      } else if (accept('-')) {
+        if (!parseTerm())
+          return false;
+        pushOp({Op::Sub});
+      } else
+        return true;
+    }
+  }
+
+  bool parseTerm() {
+    if (!parsePower())
+      return false;
+    while (true) {
+      if (accept('*')) {
+        if (!parsePower())
+          return false;
+        pushOp({Op::Mul});
+      } else if (accept('/')) {
+        if (!parsePower())
+          return false;
+        pushOp({Op::Div});
+      } else if (startsPrimary()) {
+        if (!parsePower())
+          return false;
+        pushOp({Op::Mul});
+      } else
+        return true;
+    }
+  }
+
+  bool parsePower() {
+    if (!parseUnary())
+      return false;
+    // Superscripts as exponents (e.g. "n²")
+    if (mPos < mText.size() && (mText[mPos] == QChar(0x00B2) || mText[mPos] == QChar(0x00B3))) {
+      pushOp({Op::Number, mText[mPos] == QChar(0x00B2) ? 2. : 3.});
+      pushOp({Op::Pow});
+      ++mPos;
+      skipSpaces();
+      return true;
+    }
+    if (accept('^')) {
+      if (!parsePower())
+        return false;
+      pushOp({Op::Pow});
+    }
+    return true;
+  }
+
+  bool parseUnary() {
+    if (accept('-')) {
+      if (!parseUnary())
+        return false;
+      pushOp({Op::Neg});
+      return true;
+    }
+    return parsePrimary();
+  }
+
+  bool parsePrimary() {
+    if (mPos >= mText.size()) {
+      mError = "unexpected end";
+      return false;
+    }
+
+    // Parenthesis
+    if (accept('(')) {
+      if (!parseExpr())
+        return false;
+      if (!accept(')')) {
+        mError = "missing ')'";
+        return false;
+      }
+      return true;
+    }
+
+    // Number
+    const QChar c = mText[mPos];
+    if (c.isDigit() || c == '.') {
+      qsizetype end = mPos;
+      while (end < mText.size() && (mText[end].isDigit() || mText[end] == '.'))
+        ++end;
+      if (end < mText.size() && (mText[end] == 'e' || mText[end] == 'E')) {  // exponent
+        qsizetype expEnd = end + 1;
+        if (expEnd < mText.size() && (mText[expEnd] == '+' || mText[expEnd] == '-'))
+          ++expEnd;
+        if (expEnd < mText.size() && mText[expEnd].isDigit()) {
+          end = expEnd;
+          while (end < mText.size() && mText[end].isDigit())
+            ++end;
+        }
+      }
+      bool ok = false;
+      const double value = QStringView(mText).mid(mPos, end - mPos).toDouble(&ok);
+      if (!ok) {
+        mError = "invalid number";
+        return false;
+      }
+      mPos = end;
+      skipSpaces();
+      pushOp({Op::Number, value});
+      return true;
+    }
+
+    // Variable or function
+    if (c.isLetter()) {
+      qsizetype end = mPos;
+      while (end < mText.size() && mText[end].isLetterOrNumber())
+        ++end;
+      const QString name = mText.mid(mPos, end - mPos).toLower();
+      if (name == "n") {
+        mPos = end;
+        skipSpaces();
+        pushOp({Op::Variable});
+        return true;
+      }
+
+      double (*func)(double) = nullptr;
+      if (name == "lg" || name == "log2" || name == "log")  // base 2 as Google benchmark
+        func = log2Func;
+      else if (name == "ln")
+        func = lnFunc;
+      else if (name == "log10")
+        func = log10Func;
+      else if (name == "sqrt")
+        func = sqrtFunc;
+      else if (name == "exp")
+        func = expFunc;
+      else if (name == "abs")
+        func = absFunc;
+      if (func == nullptr) {
+        mError = "unknown name '" + name + "'";
+        return false;
+      }
+      mPos = end;
+      skipSpaces();
+      if (!parsePower())
+        return false;
+      Op op{Op::Func};
+      op.func = func;
+      pushOp(op);
+      return true;
+    }
+
+    mError = "unexpected '" + QString(c) + "'";
+    return false;
+  }
+
+  const QString& mText;
+  std::vector<Op>& mOps;
+  qsizetype mPos = 0;
+  int mDepth = 0, mMaxDepth = 0;
+  QString mError;
+};
+
+bool ComplexityExpression::parse(const QString& text, QString& errorMsg) {
+  mText = text.trimmed();
+  mOps.clear();
+  mMaxDepth = 0;
+
+  ComplexityParser parser(mText, mOps);
+  if (!parser.parse(errorMsg, mMaxDepth)) {
+    mOps.clear();
+    return false;
+  }
+  return true;
+}
+
+double ComplexityExpression::evaluate(double n) const {
+  if (mOps.empty())
+    return std::numeric_limits<double>::quiet_NaN();
+
+  QVarLengthArray<double, 16> stack(mMaxDepth);
+  int top = -1;
+  for (const auto& op : mOps) {
+    switch (op.kind) {
+      case Op::Number:
+        stack[++top] = op.value;
+        break;
+      case Op::Variable:
+        stack[++top] = n;
+        break;
+      case Op::Add:
+        stack[top - 1] += stack[top];
+        --top;
+        break;
+      case Op::Sub:
+        stack[top - 1] -= stack[top];
+        --top;
+        break;
+      case Op::Mul:
+        stack[top - 1] *= stack[top];
+        --top;
+        break;
+      case Op::Div:
+        stack[top - 1] /= stack[top];
+        --top;
+        break;
+      case Op::Pow:
+        stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+        --top;
+        break;
+      case Op::Neg:
+        stack[top] = -stack[top];
+        break;
+      case Op::Func:
+        stack[top] = op.func(stack[top]);
+        break;
+    }
+  }
+  return stack[0];
+}
+
+/**************************************************************************************************
+ *
+ * Fitting
+ *
+ **************************************************************************************************/
+
+double getComplexityValue(ComplexityModel model, double n, const ComplexityExpression* custom) {
+  switch (model) {
+    case ComplexityO1:
+      return 1.;
+    case ComplexityOLogN:
+      return std::log2(n);
+    case ComplexityON:
+      return n;
+    case ComplexityONLogN:
+      return n * std::log2(n);
+    case ComplexityON2:
+      return n * n;
+    case ComplexityON3:
+      return n * n * n;
+    case ComplexityCustom:
+      return (custom != nullptr) ? custom->evaluate(n)
+                                 : std::numeric_limits<double>::quiet_NaN();
+  }
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+QString getComplexityName(ComplexityModel model, const ComplexityExpression* custom) {
+  switch (model) {
+    case ComplexityO1:
+      return "1";
+    case ComplexityOLogN:
+      return "log n";
+    case ComplexityON:
+      return "n";
+    case ComplexityONLogN:
+      return "n log n";
+    case ComplexityON2:
+      return "n²";
+    case ComplexityON3:
+      return "n³";
+    case ComplexityCustom:
+      return (custom != nullptr) ? custom->text() : "f(n)";
+  }
+  return "";
+}
+
+bool parseBigO(const QString& bigO, ComplexityModel& model) {
+  if (bigO == "(1)")
+    model = ComplexityO1;
+  else if (bigO == "lgN")
+    model = ComplexityOLogN;
+  else if (bigO == "N")
+    model = ComplexityON;
+  else if (bigO == "NlgN")
+    model = ComplexityONLogN;
+  else if (bigO == "N^2")
+    model = ComplexityON2;
+  else if (bigO == "N^3")
+    model = ComplexityON3;
+  else
+    return false;  // lambda
+  return true;
+}
+
+// Same estimator as Google benchmark (minimal least squares through origin)
+ComplexityFit fitComplexity(const QVector<QPointF>& points, ComplexityModel model,
+                            const ComplexityExpression* custom) {
+  ComplexityFit fit;
+  fit.model = model;
+  if (points.size() < 2)
+    return fit;
+
+  double sumYF = 0., sumFF = 0., sumY = 0.;
+  for (const auto& point : points) {
+    const double f = getComplexityValue(model, point.x(), custom);
+    if (!std::isfinite(f))
+      return fit;
+    sumYF += point.y() * f;
+    sumFF += f * f;
+    sumY += point.y();
+  }
+  if (sumFF <= 0.)
+    return fit;
+  fit.coefficient = sumYF / sumFF;
+
+  double sumSquares = 0.;
+  for (const auto& point : points) {
+    const double residual =
+        point.y() - fit.coefficient * getComplexityValue(model, point.x(), custom);
+    sumSquares += residual * residual;
+  }
+  const double mean = sumY / points.size();
+  fit.rms = (mean != 0.) ? std::sqrt(sumSquares / points.size()) / std::abs(mean) : 0.;
+  fit.isValid = true;
+
+  return fit;
+}
+
+ComplexityFit fitBestComplexity(const QVector<QPointF>& points) {
+  ComplexityFit best;
+  for (auto model : {ComplexityO1, ComplexityOLogN, ComplexityON, ComplexityONLogN, ComplexityON2,
+                     ComplexityON3}) {
+    const ComplexityFit fit = fitComplexity(points, model);
+    if (fit.isValid && (!best.isValid || fit.rms < best.rms))
+      best = fit;
+  }
+  return best;
+}
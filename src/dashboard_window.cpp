@@ -0,0 +1,614 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "dashboard_window.h"
+
+#include <QDateTime>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QGroupBox>
+#include <QHash>
+#include <QLabel>
+#include <QMessageBox>
+#include <QMouseEvent>
+#include <QSettings>
+#include <QToolButton>
+#include <QVBoxLayout>
+#include <QtCharts>
+
+#include "plotter_barchart.h"
+#include "plotter_boxchart.h"
+#include "plotter_heatmap.h"
+#include "plotter_linechart.h"
+#include "plotter_scalingchart.h"
+#include "plotter_violinchart.h"
+#include "result_parser.h"
+#include "ui_dashboard_window.h"
+
+// Minimum tile height (scrolled beyond)
+static constexpr int kMinTileHeight = 320;
+
+/**************************************************************************************************
+ *
+ * Helpers
+ *
+ **************************************************************************************************/
+
+// Plotter embedded in dashboard (reloaded by it)
+template <class Plotter>
+static QWidget* newPlotter(const BenchResults& bchResults, const QVector<int>& bchIdxs,
+                           const PlotParams& plotParams, const QString& origFilename,
+                           const QVector<FileReload>& addFilenames, QWidget* parent) {
+  auto plotter = new Plotter(bchResults, bchIdxs, plotParams, origFilename, addFilenames, parent);
+  plotter->setSharedReload();
+  return plotter;
+}
+
+static QWidget* createPlotter(const BenchResults& bchResults, const QVector<int>& bchIdxs,
+                              const PlotParams& plotParams, const QString& origFilename,
+                              const QVector<FileReload>& addFilenames, QWidget* parent) {
+  switch (plotParams.type) {
+    case ChartLineType:
+    case ChartSplineType:
+      return newPlotter<PlotterLineChart>(bchResults, bchIdxs, plotParams, origFilename,
+                                          addFilenames, parent);
+    case ChartBarType:
+    case ChartHBarType:
+      return newPlotter<PlotterBarChart>(bchResults, bchIdxs, plotParams, origFilename,
+                                         addFilenames, parent);
+    case ChartBoxType:
+      return newPlotter<PlotterBoxChart>(bchResults, bchIdxs, plotParams, origFilename,
+                                         addFilenames, parent);
+    case ChartScalingType:
+      return newPlotter<PlotterScalingChart>(bchResults, bchIdxs, plotParams, origFilename,
+                                             addFilenames, parent);
+    case ChartHeatmapType:
+      return newPlotter<PlotterHeatmap>(bchResults, bchIdxs, plotParams, origFilename,
+                                        addFilenames, parent);
+    case ChartViolinType:
+      return newPlotter<PlotterViolinChart>(bchResults, bchIdxs, plotParams, origFilename,
+                                            addFilenames, parent);
+    default:
+      return nullptr;
+  }
+}
+
+static void reloadPlotter(QWidget* plotter, PlotChartType type, const BenchResults& bchResults) {
+  switch (type) {
+    case ChartLineType:
+    case ChartSplineType:
+      static_cast<PlotterLineChart*>(plotter)->reloadResults(bchResults);
+      break;
+    case ChartBarType:
+    case ChartHBarType:
+      static_cast<PlotterBarChart*>(plotter)->reloadResults(bchResults);
+      break;
+    case ChartBoxType:
+      static_cast<PlotterBoxChart*>(plotter)->reloadResults(bchResults);
+      break;
+    case ChartScalingType:
+      static_cast<PlotterScalingChart*>(plotter)->reloadResults(bchResults);
+      break;
+    case ChartHeatmapType:
+      static_cast<PlotterHeatmap*>(plotter)->reloadResults(bchResults);
+      break;
+    case ChartViolinType:
+      static_cast<PlotterViolinChart*>(plotter)->reloadResults(bchResults);
+      break;
+    default:
+      break;
+  }
+}
+
+// Key of linked X-axes (empty if not a value axis of parameters)
+static QString getLinkKey(const PlotParams& plotParams) {
+  switch (plotParams.type) {
+    case ChartLineType:
+    case ChartSplineType:
+      return QString("%1:%2").arg(plotParams.xType).arg(plotParams.xIdx);
+    case ChartScalingType:
+      return "threads";
+    default:
+      return QString();
+  }
+}
+
+// Check saved parameter exists in results
+static bool isParamValid(const BenchResults& bchResults, PlotParamType type, int idx) {
+  if (type == PlotArgumentType)
+    return idx >= 0 && idx < bchResults.meta.maxArguments;
+  if (type == PlotTemplateType)
+    return idx >= 0 && idx < bchResults.meta.maxTemplates;
+  return true;
+}
+
+// Benchmark indexes of names (missing ones ignored)
+static QVector<int> getBenchIdxs(const BenchResults& bchResults, const QStringList& names) {
+  QHash<QString, int> nameIdxs;
+  nameIdxs.reserve(bchResults.benchmarks.size());
+  for (int idx = 0; idx < bchResults.benchmarks.size(); ++idx)
+    nameIdxs.insert(bchResults.benchmarks[idx].name, idx);
+
+  QVector<int> idxs;
+  for (const auto& name : names) {
+    if (auto it = nameIdxs.constFind(name); it != nameIdxs.cend())
+      idxs.append(it.value());
+  }
+  return idxs;
+}
+
+/**************************************************************************************************
+ *
+ * Window
+ *
+ **************************************************************************************************/
+
+DashboardWindow::DashboardWindow(const BenchResults& bchResults, const QString& origFilename,
+                                 const QVector<FileReload>& addFilenames, QWidget* parent)
+    : QWidget(parent)
+    , ui(new Ui::DashboardWindow)
+    , mBchResults(bchResults)
+    , mOrigFilename(origFilename)
+    , mAddFilenames(addFilenames)
+    , mWatcher(parent) {
+  // UI
+  ui->setupUi(this);
+  this->setAttribute(Qt::WA_DeleteOnClose);
+
+  QFileInfo fileInfo(origFilename);
+  this->setWindowTitle("Dashboard - " + fileInfo.fileName());
+
+  connectUI();
+  loadConfig();
+}
+
+DashboardWindow::~DashboardWindow() {
+  // Save options and layout to file
+  saveConfig();
+
+  // No more links and pans while charts are deleted
+  for (const auto& connection : std::as_const(mLinkConnections))
+    disconnect(connection);
+  for (const auto& tile : std::as_const(mTiles)) {
+    if (tile.view)
+      tile.view->viewport()->removeEventFilter(this);
+  }
+  delete ui;
+}
+
+bool DashboardWindow::isChartSupported(PlotChartType type) {
+  switch (type) {
+    case ChartLineType:
+    case ChartSplineType:
+    case ChartBarType:
+    case ChartHBarType:
+    case ChartBoxType:
+    case ChartScalingType:
+    case ChartHeatmapType:
+    case ChartViolinType:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void DashboardWindow::connectUI() {
+  connect(ui->spinBoxColumns, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          &DashboardWindow::onSpinColumnsChanged);
+  connect(ui->checkBoxLinkX, &QCheckBox::stateChanged, this, &DashboardWindow::onCheckLinkX);
+  connect(ui->checkBoxOptions, &QCheckBox::stateChanged, this, &DashboardWindow::onCheckOptions);
+  connect(ui->pushButtonRestore, &QPushButton::clicked, this, &DashboardWindow::onRestoreClicked);
+
+  connect(&mWatcher, &QFileSystemWatcher::fileChanged, this, &DashboardWindow::onAutoReload);
+  connect(ui->checkBoxAutoReload, &QCheckBox::stateChanged, this,
+          &DashboardWindow::onCheckAutoReload);
+  connect(ui->pushButtonReload, &QPushButton::clicked, this, &DashboardWindow::onReloadClicked);
+  connect(ui->pushButtonSnapshot, &QPushButton::clicked, this,
+          &DashboardWindow::onSnapshotClicked);
+}
+
+void DashboardWindow::loadConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("dashboard");
+
+  if (auto value = settings.value("columns"); value.isValid())
+    ui->spinBoxColumns->setValue(value.toInt());
+  if (auto value = settings.value("linkX"); value.isValid())
+    ui->checkBoxLinkX->setChecked(value.toBool());
+  if (auto value = settings.value("options"); value.isValid())
+    ui->checkBoxOptions->setChecked(value.toBool());
+  if (auto value = settings.value("autoReload"); value.isValid())
+    ui->checkBoxAutoReload->setChecked(value.toBool());
+
+  // Saved layout
+  ui->pushButtonRestore->setEnabled(settings.beginReadArray("charts") > 0);
+  settings.endArray();
+
+  settings.endGroup();
+}
+
+void DashboardWindow::saveConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("dashboard");
+
+  settings.setValue("columns", ui->spinBoxColumns->value());
+  settings.setValue("linkX", ui->checkBoxLinkX->isChecked());
+  settings.setValue("options", ui->checkBoxOptions->isChecked());
+  settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
+
+  // Layout (previous one kept if no charts)
+  if (!mTiles.isEmpty()) {
+    settings.remove("charts");
+    settings.beginWriteArray("charts", mTiles.size());
+    for (int tileIdx = 0; tileIdx < mTiles.size(); ++tileIdx) {
+      const Tile& tile = mTiles[tileIdx];
+      settings.setArrayIndex(tileIdx);
+      settings.setValue("type", tile.params.type);
+      settings.setValue("xType", tile.params.xType);
+      settings.setValue("xIdx", tile.params.xIdx);
+      settings.setValue("yType", tile.params.yType);
+      settings.setValue("zType", tile.params.zType);
+      settings.setValue("zIdx", tile.params.zIdx);
+
+      QStringList names;  // empty for all benchmarks
+      if (!tile.allIndexes) {
+        for (int idx : tile.bchIdxs)
+          names.append(mBchResults.benchmarks[idx].name);
+      }
+      settings.setValue("benchmarks", names);
+    }
+    settings.endArray();
+  }
+
+  settings.endGroup();
+}
+
+/**************************************************************************************************
+ *
+ * Tiles
+ *
+ **************************************************************************************************/
+
+void DashboardWindow::addChart(const BenchResults& srcResults, const QVector<int>& srcIdxs,
+                               const PlotParams& plotParams) {
+  // Same benchmarks in dashboard snapshot
+  QVector<int> bchIdxs = (srcIdxs.size() == srcResults.benchmarks.size())
+                             ? mBchResults.segmentAll()
+                             : mBchResults.matchBenchmarks(srcResults, srcIdxs);
+  if (bchIdxs.isEmpty()) {
+    QMessageBox::warning(this, "Dashboard", "No benchmarks of chart in dashboard results");
+    return;
+  }
+
+  addTile(bchIdxs, plotParams);
+  updateGrid();
+  linkAxes();
+}
+
+void DashboardWindow::addTile(const QVector<int>& bchIdxs, const PlotParams& plotParams) {
+  auto frame = new QFrame(ui->widgetTiles);
+  frame->setFrameShape(QFrame::StyledPanel);
+  frame->setMinimumHeight(kMinTileHeight);
+
+  QWidget* plotter =
+      createPlotter(mBchResults, bchIdxs, plotParams, mOrigFilename, mAddFilenames, frame);
+  if (!plotter) {
+    qWarning() << "Chart type not supported by dashboard:" << plotParams.type;
+    delete frame;
+    return;
+  }
+
+  // Header: chart type and Y-value, removal
+  auto label = new QLabel(plotter->windowTitle().section(" - ", 0, 0) + " - " +
+                              getYPlotName(plotParams.yType, mBchResults.meta.time_unit),
+                          frame);
+  auto removeButton = new QToolButton(frame);
+  removeButton->setText("x");
+  removeButton->setToolTip("Remove chart");
+  removeButton->setAutoRaise(true);
+  connect(removeButton, &QToolButton::clicked, this, [this, frame]() { removeTile(frame); });
+
+  auto headerLayout = new QHBoxLayout();
+  headerLayout->addWidget(label);
+  headerLayout->addStretch();
+  headerLayout->addWidget(removeButton);
+
+  auto layout = new QVBoxLayout(frame);
+  layout->setContentsMargins(2, 2, 2, 2);
+  layout->addLayout(headerLayout);
+  layout->addWidget(plotter, 1);
+
+  // Chart options on demand (same group name in all plotters forms)
+  if (auto options = plotter->findChild<QGroupBox*>("groupBoxOptions"))
+    options->setVisible(ui->checkBoxOptions->isChecked());
+
+  // Zoom and pan of linkable charts
+  QChartView* view = nullptr;
+  if (!getLinkKey(plotParams).isEmpty()) {
+    view = plotter->findChild<QChartView*>();
+    if (view) {
+      view->setRubberBand(ui->checkBoxLinkX->isChecked() ? QChartView::HorizontalRubberBand
+                                                         : QChartView::NoRubberBand);
+      view->viewport()->installEventFilter(this);
+    }
+  }
+
+  mTiles.append({plotParams, bchIdxs, bchIdxs.size() == mBchResults.benchmarks.size(), frame,
+                 plotter, view});
+}
+
+void DashboardWindow::removeTile(QWidget* frame) {
+  for (int tileIdx = 0; tileIdx < mTiles.size(); ++tileIdx) {
+    if (mTiles[tileIdx].frame == frame) {
+      mTiles.remove(tileIdx);
+      break;
+    }
+  }
+  frame->hide();
+  frame->deleteLater();  // from its own button
+
+  updateGrid();
+  linkAxes();
+}
+
+void DashboardWindow::clearTiles() {
+  for (const auto& tile : std::as_const(mTiles))
+    delete tile.frame;
+  mTiles.clear();
+  linkAxes();
+}
+
+void DashboardWindow::updateGrid() {
+  QGridLayout* grid = ui->gridLayoutTiles;
+  while (grid->count() > 0)
+    delete grid->takeAt(0);  // layout item only
+
+  const int columns = ui->spinBoxColumns->value();
+  for (int tileIdx = 0; tileIdx < mTiles.size(); ++tileIdx)
+    grid->addWidget(mTiles[tileIdx].frame, tileIdx / columns, tileIdx % columns);
+  for (int col = 0; col < ui->spinBoxColumns->maximum(); ++col)
+    grid->setColumnStretch(col, col < columns ? 1 : 0);
+}
+
+/**************************************************************************************************
+ *
+ * Linked axes
+ *
+ **************************************************************************************************/
+
+// Connect X-axes of same parameter (again after axes were replaced by charts)
+void DashboardWindow::linkAxes() {
+  for (const auto& connection : std::as_const(mLinkConnections))
+    disconnect(connection);
+  mLinkConnections.clear();
+  mLinkedAxes.clear();
+  if (!ui->checkBoxLinkX->isChecked())
+    return;
+
+  for (const auto& tile : std::as_const(mTiles)) {
+    if (!tile.view)
+      continue;
+    const QString key = getLinkKey(tile.params);
+    const auto axes = tile.view->chart()->axes(Qt::Horizontal);
+    for (auto axis : axes) {
+      QMetaObject::Connection connection;
+      if (axis->type() == QAbstractAxis::AxisTypeValue)
+        connection = connect((QValueAxis*)axis, &QValueAxis::rangeChanged, this,
+                             [this, axis](qreal min, qreal max) { syncAxes(axis, min, max); });
+      else if (axis->type() == QAbstractAxis::AxisTypeLogValue)
+        connection = connect((QLogValueAxis*)axis, &QLogValueAxis::rangeChanged, this,
+                             [this, axis](qreal min, qreal max) { syncAxes(axis, min, max); });
+      else
+        continue;
+      mLinkConnections.append(connection);
+      mLinkedAxes.append({axis, key});
+    }
+  }
+}
+
+void DashboardWindow::syncAxes(QAbstractAxis* srcAxis, qreal min, qreal max) {
+  if (mSyncingAxes)
+    return;
+
+  QString key;
+  for (const auto& linked : std::as_const(mLinkedAxes)) {
+    if (linked.axis == srcAxis)
+      key = linked.key;
+  }
+
+  mSyncingAxes = true;
+  for (const auto& linked : std::as_const(mLinkedAxes)) {
+    if (!linked.axis || linked.axis == srcAxis || linked.key != key)
+      continue;
+    if (linked.axis->type() == QAbstractAxis::AxisTypeLogValue && min <= 0.)
+      continue;
+    linked.axis->setRange(min, max);
+  }
+  mSyncingAxes = false;
+}
+
+bool DashboardWindow::eventFilter(QObject* watched, QEvent* event) {
+  if (!ui->checkBoxLinkX->isChecked())
+    return QWidget::eventFilter(watched, event);
+
+  // Axes may have been replaced by chart options since last link
+  if (event->type() == QEvent::MouseButtonPress)
+    linkAxes();
+
+  // Middle-drag pan
+  if (event->type() == QEvent::MouseButtonPress || event->type() == QEvent::MouseMove) {
+    const auto mouseEvent = static_cast<QMouseEvent*>(event);
+    auto view = qobject_cast<QChartView*>(watched->parent());
+    if (view && (mouseEvent->buttons() & Qt::MiddleButton)) {
+      const QPoint pos = mouseEvent->position().toPoint();
+      if (event->type() == QEvent::MouseMove)
+        view->chart()->scroll(mPanPos.x() - pos.x(), 0.);
+      mPanPos = pos;
+      return true;
+    }
+  }
+
+  return QWidget::eventFilter(watched, event);
+}
+
+/**************************************************************************************************
+ *
+ * Options
+ *
+ **************************************************************************************************/
+
+void DashboardWindow::onSpinColumnsChanged(int /*i*/) { updateGrid(); }
+
+void DashboardWindow::onCheckLinkX(int state) {
+  for (const auto& tile : std::as_const(mTiles)) {
+    if (tile.view)
+      tile.view->setRubberBand(state == Qt::Checked ? QChartView::HorizontalRubberBand
+                                                    : QChartView::NoRubberBand);
+  }
+  linkAxes();
+}
+
+void DashboardWindow::onCheckOptions(int state) {
+  for (const auto& tile : std::as_const(mTiles)) {
+    if (auto options = tile.plotter->findChild<QGroupBox*>("groupBoxOptions"))
+      options->setVisible(state == Qt::Checked);
+  }
+}
+
+void DashboardWindow::onRestoreClicked() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("dashboard");
+
+  // Saved charts, benchmarks matched by names
+  QVector<QPair<PlotParams, QVector<int>>> charts;
+  int skipped = 0;
+  const int count = settings.beginReadArray("charts");
+  for (int chartIdx = 0; chartIdx < count; ++chartIdx) {
+    settings.setArrayIndex(chartIdx);
+    PlotParams plotParams;
+    plotParams.type = (PlotChartType)settings.value("type").toInt();
+    plotParams.xType = (PlotParamType)settings.value("xType").toInt();
+    plotParams.xIdx = settings.value("xIdx").toInt();
+    plotParams.yType = (PlotValueType)settings.value("yType").toInt();
+    plotParams.zType = (PlotParamType)settings.value("zType").toInt();
+    plotParams.zIdx = settings.value("zIdx").toInt();
+
+    const QStringList names = settings.value("benchmarks").toStringList();
+    const QVector<int> bchIdxs =
+        names.isEmpty() ? mBchResults.segmentAll() : getBenchIdxs(mBchResults, names);
+    if (bchIdxs.isEmpty() || !isChartSupported(plotParams.type) ||
+        !isParamValid(mBchResults, plotParams.xType, plotParams.xIdx) ||
+        !isParamValid(mBchResults, plotParams.zType, plotParams.zIdx)) {
+      ++skipped;
+      continue;
+    }
+    charts.append({plotParams, bchIdxs});
+  }
+  settings.endArray();
+  settings.endGroup();
+
+  clearTiles();
+  for (const auto& chart : std::as_const(charts))
+    addTile(chart.second, chart.first);
+  updateGrid();
+  linkAxes();
+
+  if (skipped > 0)
+    QMessageBox::warning(this, "Dashboard layout",
+                         QString::number(skipped) + " chart(s) not matching current results");
+}
+
+/**************************************************************************************************
+ *
+ * Actions
+ *
+ **************************************************************************************************/
+
+void DashboardWindow::onCheckAutoReload(int state) {
+  if (state == Qt::Checked) {
+    if (mWatcher.files().empty()) {
+      mWatcher.addPath(mOrigFilename);
+      for (const auto& addFilename : std::as_const(mAddFilenames))
+        mWatcher.addPath(addFilename.filename);
+    }
+  } else {
+    if (!mWatcher.files().empty())
+      mWatcher.removePaths(mWatcher.files());
+  }
+}
+
+void DashboardWindow::onAutoReload(const QString& path) {
+  QFileInfo fi(path);
+  if (fi.exists() && fi.isReadable() && fi.size() > 0)
+    onReloadClicked();
+  else
+    qWarning() << "Unable to auto-reload file: " << path;
+}
+
+void DashboardWindow::onReloadClicked() {
+  // Load new results (once for all charts)
+  QString errorMsg;
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
+
+  if (newBchResults.benchmarks.isEmpty()) {
+    QMessageBox::critical(this, "Dashboard reload",
+                          "Error parsing original file: " + mOrigFilename + " -> " + errorMsg);
+    return;
+  }
+  for (const auto& addFile : std::as_const(mAddFilenames)) {
+    errorMsg.clear();
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
+    if (newAddResults.benchmarks.isEmpty()) {
+      QMessageBox::critical(
+          this, "Dashboard reload",
+          "Error parsing additional file: " + addFile.filename + " -> " + errorMsg);
+      return;
+    }
+    if (addFile.isAppend)
+      newBchResults.appendResults(newAddResults);
+    else
+      newBchResults.overwriteResults(newAddResults);
+  }
+
+  // Charts updated from shared results, benchmarks matched by names as charts do
+  for (auto& tile : mTiles) {
+    QVector<int> newBenchIdxs = tile.allIndexes
+                                    ? newBchResults.segmentAll()
+                                    : newBchResults.matchBenchmarks(mBchResults, tile.bchIdxs);
+    if (!newBenchIdxs.isEmpty())
+      tile.bchIdxs = newBenchIdxs;
+    reloadPlotter(tile.plotter, tile.params.type, newBchResults);
+  }
+  mBchResults = newBchResults;
+  linkAxes();  // axes of reset charts
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void DashboardWindow::onSnapshotClicked() {
+  QString fileName =
+      QFileDialog::getSaveFileName(this, tr("Save snapshot"), "", tr("Images (*.png)"));
+
+  if (!fileName.isEmpty()) {
+    QPixmap pixmap = ui->widgetTiles->grab();
+
+    bool ok = pixmap.save(fileName, "PNG");
+    if (!ok)
+      QMessageBox::warning(this, "Dashboard snapshot", "Error saving snapshot file.");
+  }
+}
@@ -0,0 +1,233 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "decompress_device.h"
+
+#include <algorithm>
+
+#ifdef JOMT_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef JOMT_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+// Compressed chunk read from source at once
+static constexpr qint64 kChunkSize = 256 * 1024;
+// Max output per decompression call (zlib sizes are 32 bits)
+static constexpr qint64 kMaxOutput = 1 << 30;
+
+DecompressDevice::DecompressDevice(QIODevice* source, Compression compression, QObject* parent)
+    : QIODevice(parent)
+    , mSource(source)
+    , mCompression(compression) {}
+
+DecompressDevice::~DecompressDevice() { close(); }
+
+DecompressDevice::Compression DecompressDevice::detectCompression(QIODevice& source) {
+  const QByteArray magic = source.peek(4);
+
+  if (magic.startsWith("\x1f\x8b"))
+    return GzipCompression;
+  if (magic.startsWith("\x28\xb5\x2f\xfd"))
+    return ZstdCompression;
+
+  return NoCompression;
+}
+
+bool DecompressDevice::open(OpenMode mode) {
+  if ((mode & QIODevice::WriteOnly) || mSource == nullptr || !mSource->isReadable()) {
+    setErrorString("Invalid decompression source");
+    return false;
+  }
+
+  switch (mCompression) {
+    case GzipCompression: {
+#ifdef JOMT_WITH_ZLIB
+      mGzStream = new z_stream();
+      if (inflateInit2(mGzStream, 15 + 32) != Z_OK) {  // Gzip or zlib header
+        delete mGzStream;
+        mGzStream = nullptr;
+        setErrorString("Unable to initialize gzip decompression");
+        return false;
+      }
+      break;
+#else
+      setErrorString("Gzip support not available (built without zlib)");
+      return false;
+#endif
+    }
+    case ZstdCompression: {
+#ifdef JOMT_WITH_ZSTD
+      mZstdStream = ZSTD_createDStream();
+      if (mZstdStream == nullptr || ZSTD_isError(ZSTD_initDStream(mZstdStream))) {
+        ZSTD_freeDStream(mZstdStream);
+        mZstdStream = nullptr;
+        setErrorString("Unable to initialize zstd decompression");
+        return false;
+      }
+      break;
+#else
+      setErrorString("Zstd support not available (built without zstd)");
+      return false;
+#endif
+    }
+    case NoCompression:
+      break;
+  }
+
+  mInput.clear();
+  mInputPos = 0;
+  mFinished = false;
+  mFailed = false;
+
+  return QIODevice::open(mode);
+}
+
+void DecompressDevice::close() {
+#ifdef JOMT_WITH_ZLIB
+  if (mGzStream != nullptr) {
+    inflateEnd(mGzStream);
+    delete mGzStream;
+    mGzStream = nullptr;
+  }
+#endif
+#ifdef JOMT_WITH_ZSTD
+  if (mZstdStream != nullptr) {
+    ZSTD_freeDStream(mZstdStream);
+    mZstdStream = nullptr;
+  }
+#endif
+  mInput.clear();
+
+  QIODevice::close();
+}
+
+bool DecompressDevice::atEnd() const { return mFinished && QIODevice::atEnd(); }
+
+qint64 DecompressDevice::readData(char* data, qint64 maxSize) {
+  if (mFinished)
+    return -1;
+
+  switch (mCompression) {
+    case GzipCompression:
+      return readGzip(data, maxSize);
+    case ZstdCompression:
+      return readZstd(data, maxSize);
+    case NoCompression:
+      break;
+  }
+
+  qint64 read = mSource->read(data, maxSize);
+  if (read <= 0)
+    mFinished = true;
+
+  return read;
+}
+
+qint64 DecompressDevice::writeData(const char* /*data*/, qint64 /*maxSize*/) { return -1; }
+
+// Read next compressed chunk if current one is consumed (false if source exhausted)
+bool DecompressDevice::fillInput() {
+  if (mInputPos < mInput.size())
+    return true;
+
+  mInput = mSource->read(kChunkSize);
+  mInputPos = 0;
+
+  return !mInput.isEmpty();
+}
+
+qint64 DecompressDevice::readGzip(char* data, qint64 maxSize) {
+#ifdef JOMT_WITH_ZLIB
+  qint64 total = 0;
+  while (total < maxSize && !mFinished) {
+    const bool hasInput = fillInput();
+    mGzStream->next_in =
+        hasInput ? reinterpret_cast<Bytef*>(mInput.data() + mInputPos) : Z_NULL;
+    mGzStream->avail_in = hasInput ? static_cast<uInt>(mInput.size() - mInputPos) : 0;
+    mGzStream->next_out = reinterpret_cast<Bytef*>(data + total);
+    mGzStream->avail_out = static_cast<uInt>(std::min(maxSize - total, kMaxOutput));
+
+    int ret = inflate(mGzStream, Z_NO_FLUSH);
+    const qint64 produced = reinterpret_cast<char*>(mGzStream->next_out) - (data + total);
+    total += produced;
+    if (hasInput)
+      mInputPos = mInput.size() - mGzStream->avail_in;
+
+    if (ret == Z_STREAM_END) {
+      // Concatenated members
+      if (fillInput())
+        inflateReset(mGzStream);
+      else
+        mFinished = true;
+    } else if (ret == Z_BUF_ERROR || (!hasInput && produced == 0)) {
+      if (!hasInput) {
+        setErrorString("Gzip decompression error: truncated stream");
+        mFinished = mFailed = true;
+      }
+    } else if (ret != Z_OK) {
+      setErrorString(QString("Gzip decompression error: ") +
+                     (mGzStream->msg != nullptr ? mGzStream->msg : "corrupted data"));
+      mFinished = true;
+      mFailed = true;
+      return total > 0 ? total : -1;
+    }
+  }
+
+  return (total > 0 || !mFinished) ? total : -1;
+#else
+  Q_UNUSED(data);
+  Q_UNUSED(maxSize);
+  return -1;
+#endif
+}
+
+qint64 DecompressDevice::readZstd(char* data, qint64 maxSize) {
+#ifdef JOMT_WITH_ZSTD
+  qint64 total = 0;
+  while (total < maxSize && !mFinished) {
+    const bool hasInput = fillInput();
+    ZSTD_inBuffer inBuffer = {hasInput ? mInput.constData() + mInputPos : nullptr,
+                              hasInput ? static_cast<size_t>(mInput.size() - mInputPos) : 0, 0};
+    ZSTD_outBuffer outBuffer = {data + total, static_cast<size_t>(maxSize - total), 0};
+
+    size_t ret = ZSTD_decompressStream(mZstdStream, &outBuffer, &inBuffer);
+    if (ZSTD_isError(ret)) {
+      setErrorString(QString("Zstd decompression error: ") + ZSTD_getErrorName(ret));
+      mFinished = true;
+      mFailed = true;
+      return total > 0 ? total : -1;
+    }
+    total += static_cast<qint64>(outBuffer.pos);
+    mInputPos += static_cast<qint64>(inBuffer.pos);
+
+    // Nothing left to flush (frame must be complete)
+    if (!hasInput && outBuffer.pos == 0) {
+      if (ret != 0) {
+        setErrorString("Zstd decompression error: truncated stream");
+        mFailed = true;
+      }
+      mFinished = true;
+    }
+  }
+
+  return (total > 0 || !mFinished) ? total : -1;
+#else
+  Q_UNUSED(data);
+  Q_UNUSED(maxSize);
+  return -1;
+#endif
+}
@@ -0,0 +1,303 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "heatmap_view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QFontMetrics>
+#include <QMouseEvent>
+#include <QPainter>
+
+// Layout (pixels)
+static constexpr int kMargin = 8;
+static constexpr int kTickGap = 6;
+static constexpr int kBarGap = 12;
+static constexpr int kBarWidth = 16;
+static constexpr int kMaxLabelWidth = 160;
+static constexpr int kScaleTicks = 5;
+
+HeatmapView::HeatmapView(QWidget* parent) : QWidget(parent) {
+  setBackgroundRole(QPalette::Base);
+  setAutoFillBackground(true);
+  setMouseTracking(true);
+  setMinimumSize(240, 160);
+}
+
+void HeatmapView::setGrid(const QVector<double>& values, const QStringList& rowLabels,
+                          const QStringList& colLabels) {
+  Q_ASSERT(values.size() == (qsizetype)rowLabels.size() * colLabels.size());
+  mValues = values;
+  mRowLabels = rowLabels;
+  mColLabels = colLabels;
+  mHoverRow = mHoverCol = -1;
+
+  // Widest labels (elided beyond)
+  const QFontMetrics fm(font());
+  mRowLabelWidth = mColLabelWidth = 0;
+  for (const auto& label : std::as_const(mRowLabels))
+    mRowLabelWidth = std::max(mRowLabelWidth, fm.horizontalAdvance(label));
+  for (const auto& label : std::as_const(mColLabels))
+    mColLabelWidth = std::max(mColLabelWidth, fm.horizontalAdvance(label));
+  mRowLabelWidth = std::min(mRowLabelWidth, kMaxLabelWidth);
+  mColLabelWidth = std::min(mColLabelWidth, kMaxLabelWidth);
+
+  rasterize();
+  update();
+}
+
+void HeatmapView::setColorTable(const QVector<QRgb>& colors) {
+  mColors = colors;
+  rasterize();
+  update();
+}
+
+void HeatmapView::setLogScale(bool log) {
+  if (mLog == log)
+    return;
+  mLog = log;
+  rasterize();
+  update();
+}
+
+void HeatmapView::setValueScale(double scale) {
+  mScale = scale;
+  update();
+}
+
+void HeatmapView::setTitles(const QString& xTitle, const QString& yTitle,
+                            const QString& valueTitle) {
+  mXTitle = xTitle;
+  mYTitle = yTitle;
+  mValueTitle = valueTitle;
+  mScaled = QPixmap();  // grid size may change
+  update();
+}
+
+void HeatmapView::setMessage(const QString& message) {
+  mMessage = message;
+  update();
+}
+
+double HeatmapView::value(int row, int col) const {
+  if (row < 0 || row >= rowCount() || col < 0 || col >= columnCount())
+    return std::numeric_limits<double>::quiet_NaN();
+  return mValues[(qsizetype)row * columnCount() + col] * mScale;
+}
+
+/**************************************************************************************************/
+
+void HeatmapView::rasterize() {
+  mScaled = QPixmap();
+  const int rows = rowCount(), cols = columnCount();
+  if (rows == 0 || cols == 0 || mColors.isEmpty()) {
+    mImage = QImage();
+    return;
+  }
+
+  // Range of mappable values
+  bool hasRange = false;
+  mMin = mMax = 0.;
+  for (double value : std::as_const(mValues)) {
+    if (!std::isfinite(value) || (mLog && value <= 0.))
+      continue;
+    mMin = hasRange ? std::min(mMin, value) : value;
+    mMax = hasRange ? std::max(mMax, value) : value;
+    hasRange = true;
+  }
+
+  // One pixel per cell, written line by line
+  mImage = QImage(cols, rows, QImage::Format_RGB32);
+  const QRgb missingColor = palette().color(QPalette::Mid).rgb();
+  const int lastColor = mColors.size() - 1;
+  for (int row = 0; row < rows; ++row) {
+    QRgb* line = reinterpret_cast<QRgb*>(mImage.scanLine(row));
+    const double* values = mValues.constData() + (qsizetype)row * cols;
+    for (int col = 0; col < cols; ++col) {
+      const double t = normalized(values[col]);
+      line[col] = std::isnan(t) ? missingColor : mColors[(int)(t * lastColor + 0.5)];
+    }
+  }
+}
+
+double HeatmapView::normalized(double value) const {
+  if (!std::isfinite(value) || (mLog && value <= 0.))
+    return std::numeric_limits<double>::quiet_NaN();
+  if (mMax <= mMin)
+    return 0.5;
+  const double t = mLog ? std::log(value / mMin) / std::log(mMax / mMin)
+                        : (value - mMin) / (mMax - mMin);
+  return std::clamp(t, 0., 1.);
+}
+
+QRect HeatmapView::gridRect() const {
+  const QFontMetrics fm(font());
+  const int textHeight = fm.height();
+
+  int left = kMargin + mRowLabelWidth + kTickGap;
+  if (!mYTitle.isEmpty())
+    left += textHeight + kTickGap;
+  int right = kMargin + kBarGap + kBarWidth + kTickGap + fm.horizontalAdvance("-0.000e-00");
+  if (!mValueTitle.isEmpty())
+    right += textHeight + kTickGap;
+  int bottom = kMargin + textHeight + kTickGap;
+  if (!mXTitle.isEmpty())
+    bottom += textHeight;
+
+  return QRect(left, kMargin, std::max(1, width() - left - right),
+               std::max(1, height() - kMargin - bottom));
+}
+
+QRect HeatmapView::cellRect(int row, int col) const {
+  const QRect grid = gridRect();
+  const int rows = rowCount(), cols = columnCount();
+  const int x0 = grid.left() + (int)((qint64)col * grid.width() / cols);
+  const int x1 = grid.left() + (int)((qint64)(col + 1) * grid.width() / cols);
+  const int y0 = grid.top() + (int)((qint64)row * grid.height() / rows);
+  const int y1 = grid.top() + (int)((qint64)(row + 1) * grid.height() / rows);
+  return QRect(x0, y0, std::max(1, x1 - x0), std::max(1, y1 - y0));
+}
+
+void HeatmapView::setHoveredCell(int row, int col) {
+  if (row == mHoverRow && col == mHoverCol)
+    return;
+
+  // Repaint previous and new highlights only
+  if (mHoverRow >= 0)
+    update(cellRect(mHoverRow, mHoverCol).adjusted(-3, -3, 3, 3));
+  mHoverRow = row;
+  mHoverCol = col;
+  if (mHoverRow >= 0)
+    update(cellRect(mHoverRow, mHoverCol).adjusted(-3, -3, 3, 3));
+
+  emit cellHovered(row, col);
+}
+
+/**************************************************************************************************/
+
+void HeatmapView::paintEvent(QPaintEvent* /*event*/) {
+  QPainter painter(this);
+  painter.setPen(palette().color(QPalette::Text));
+  if (mImage.isNull()) {
+    painter.drawText(rect(), Qt::AlignCenter, mMessage);
+    return;
+  }
+
+  // Grid image, scaled once per size
+  const QRect grid = gridRect();
+  if (mScaled.size() != grid.size())
+    mScaled = QPixmap::fromImage(
+        mImage.scaled(grid.size(), Qt::IgnoreAspectRatio, Qt::FastTransformation));
+  painter.drawPixmap(grid.topLeft(), mScaled);
+
+  const QFontMetrics fm(font());
+  const int textHeight = fm.height();
+  const int rows = rowCount(), cols = columnCount();
+
+  // Row labels (spaced not to overlap)
+  const double cellHeight = (double)grid.height() / rows;
+  const int rowStep = std::max(1, (int)std::ceil(textHeight / cellHeight));
+  for (int row = 0; row < rows; row += rowStep) {
+    const int y = cellRect(row, 0).center().y();
+    painter.drawText(QRect(grid.left() - kTickGap - mRowLabelWidth, y - textHeight / 2,
+                           mRowLabelWidth, textHeight),
+                     Qt::AlignRight | Qt::AlignVCenter,
+                     fm.elidedText(mRowLabels[row], Qt::ElideMiddle, mRowLabelWidth));
+  }
+
+  // Column labels
+  const double cellWidth = (double)grid.width() / cols;
+  const int colStep = std::max(1, (int)std::ceil((mColLabelWidth + kTickGap) / cellWidth));
+  const int colLabelWidth = std::max(1, (int)(colStep * cellWidth) - kTickGap);
+  for (int col = 0; col < cols; col += colStep) {
+    const int x = cellRect(0, col).center().x();
+    painter.drawText(
+        QRect(x - colLabelWidth / 2, grid.bottom() + kTickGap, colLabelWidth, textHeight),
+        Qt::AlignCenter, fm.elidedText(mColLabels[col], Qt::ElideMiddle, colLabelWidth));
+  }
+
+  // Axes titles
+  if (!mXTitle.isEmpty())
+    painter.drawText(
+        QRect(grid.left(), grid.bottom() + kTickGap + textHeight, grid.width(), textHeight),
+        Qt::AlignCenter, mXTitle);
+  if (!mYTitle.isEmpty()) {
+    painter.save();
+    painter.translate(kMargin, grid.center().y());
+    painter.rotate(-90.);
+    painter.drawText(QRect(-grid.height() / 2, 0, grid.height(), textHeight), Qt::AlignCenter,
+                     mYTitle);
+    painter.restore();
+  }
+
+  // Color scale (maximum on top)
+  const QRect bar(grid.right() + kBarGap, grid.top(), kBarWidth, grid.height());
+  QImage barImage(1, mColors.size(), QImage::Format_RGB32);
+  for (int idx = 0; idx < mColors.size(); ++idx)
+    barImage.setPixel(0, mColors.size() - 1 - idx, mColors[idx]);
+  painter.drawImage(bar, barImage);
+  painter.drawRect(bar.adjusted(0, 0, -1, -1));
+  for (int tick = 0; tick < kScaleTicks; ++tick) {
+    const double t = (double)tick / (kScaleTicks - 1);
+    const double value =
+        mLog && mMin > 0. ? mMin * std::pow(mMax / mMin, t) : mMin + t * (mMax - mMin);
+    const int y = bar.bottom() - (int)std::lround(t * (bar.height() - 1));
+    painter.drawLine(bar.right() + 1, y, bar.right() + kTickGap / 2, y);
+    painter.drawText(QRect(bar.right() + kTickGap, y - textHeight / 2,
+                           width() - bar.right() - kTickGap, textHeight),
+                     Qt::AlignLeft | Qt::AlignVCenter, QString::number(value * mScale, 'g', 4));
+  }
+  if (!mValueTitle.isEmpty()) {
+    painter.save();
+    painter.translate(width() - kMargin - textHeight, grid.center().y());
+    painter.rotate(-90.);
+    painter.drawText(QRect(-grid.height() / 2, 0, grid.height(), textHeight), Qt::AlignCenter,
+                     mValueTitle);
+    painter.restore();
+  }
+
+  // Hovered cell
+  if (mHoverRow >= 0) {
+    painter.setPen(QPen(palette().color(QPalette::Highlight), 2));
+    painter.setBrush(Qt::NoBrush);
+    const QRect cell = cellRect(mHoverRow, mHoverCol);
+    painter.drawRect(cell.adjusted(-1, -1, 1, 1));
+  }
+}
+
+void HeatmapView::resizeEvent(QResizeEvent* event) {
+  mScaled = QPixmap();
+  QWidget::resizeEvent(event);
+}
+
+void HeatmapView::mouseMoveEvent(QMouseEvent* event) {
+  int row = -1, col = -1;
+  const QRect grid = gridRect();
+  const QPoint pos = event->position().toPoint();
+  if (!mImage.isNull() && grid.contains(pos)) {
+    const QPoint offset = pos - grid.topLeft();
+    col = std::min(columnCount() - 1, (int)((qint64)offset.x() * columnCount() / grid.width()));
+    row = std::min(rowCount() - 1, (int)((qint64)offset.y() * rowCount() / grid.height()));
+  }
+  setHoveredCell(row, col);
+  QWidget::mouseMoveEvent(event);
+}
+
+void HeatmapView::leaveEvent(QEvent* event) {
+  setHoveredCell(-1, -1);
+  QWidget::leaveEvent(event);
+}
@@ -0,0 +1,395 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "history_store.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#define HISTORY_DEBUG false
+
+// Logs and points header (version bumped on any layout change, incl. PlotValueType order)
+static constexpr quint32 kHistoryMagic = 0x4A4D5448;  // "JMTH"
+static constexpr quint32 kHistoryVersion = 2;
+static constexpr qint64 kHeaderSize = 2 * sizeof(quint32);
+
+// Wait for other writers of the store (ms)
+static constexpr int kLockTimeout = 10000;
+
+// Stored benchmark values (fixed size, native endianness)
+struct StoredPoint {
+  qint32 nameId;
+  qint32 repetitions;
+  double values[kHistoryValues];
+};
+static constexpr qint64 kPointSize = sizeof(StoredPoint);
+
+/**************************************************************************************************
+ *
+ * Helpers
+ *
+ **************************************************************************************************/
+
+// Open log file and check/write its header
+static bool openLog(QFile& file, bool readOnly, QString& errorMsg) {
+  if (!file.open(readOnly ? QIODevice::ReadOnly : QIODevice::ReadWrite)) {
+    errorMsg = "Cannot open history file: " + file.fileName();
+    return false;
+  }
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_6_0);
+  if (file.size() == 0) {
+    if (!readOnly)
+      stream << kHistoryMagic << kHistoryVersion;
+    return true;
+  }
+  quint32 magic = 0, version = 0;
+  stream >> magic >> version;
+  if (magic != kHistoryMagic || version != kHistoryVersion) {
+    errorMsg = "Unsupported history file: " + file.fileName();
+    return false;
+  }
+  return true;
+}
+
+// Stored Y-value of benchmark (-1 if missing: no aggregate, no bytes/items samples)
+static double getStoredValue(const BenchData& bchData, PlotValueType yType) {
+  if (yType >= BytesType && yType <= BytesCvType && bchData.kbytes_sec.isEmpty())
+    return -1.;
+  if (yType >= ItemsType && yType <= ItemsCvType && bchData.kitems_sec.isEmpty())
+    return -1.;
+  const bool isDefault = yType == CpuTimeType || yType == RealTimeType ||
+                         yType == IterationsType || yType == BytesType || yType == ItemsType;
+  if (!isDefault && !bchData.hasAggregate)
+    return -1.;
+  return getYPlotValue(bchData, yType);
+}
+
+static QDataStream& operator<<(QDataStream& stream, const HistoryRun& run) {
+  const BenchContext& context = run.context;
+  stream << run.date << run.label << run.source << run.pointsOffset << run.pointsCount;
+  stream << context.date << context.host_name << context.executable << context.build_type
+         << context.num_cpus << context.mhz_per_cpu << context.cpu_scaling_enabled;
+  stream << static_cast<qint32>(context.caches.size());
+  for (const auto& cache : context.caches)
+    stream << cache.type << cache.level << static_cast<qint64>(cache.size) << cache.num_sharing;
+  return stream;
+}
+
+static QDataStream& operator>>(QDataStream& stream, HistoryRun& run) {
+  BenchContext& context = run.context;
+  stream >> run.date >> run.label >> run.source >> run.pointsOffset >> run.pointsCount;
+  stream >> context.date >> context.host_name >> context.executable >> context.build_type >>
+      context.num_cpus >> context.mhz_per_cpu >> context.cpu_scaling_enabled;
+  qint32 cacheCount = 0;
+  stream >> cacheCount;
+  for (qint32 i = 0; i < cacheCount && stream.status() == QDataStream::Ok; ++i) {
+    BenchCache cache;
+    qint64 size = 0;
+    stream >> cache.type >> cache.level >> size >> cache.num_sharing;
+    cache.size = size;
+    context.caches.append(cache);
+  }
+  return stream;
+}
+
+// Run date from context (ISO or console formats), results file date otherwise
+static QDateTime getRunDate(const BenchContext& context, const QString& source) {
+  QDateTime date = QDateTime::fromString(context.date, Qt::ISODate);
+  if (!date.isValid())
+    date = QDateTime::fromString(context.date, "yyyy-MM-dd HH:mm:ss");
+  if (!date.isValid())
+    date = QDateTime::fromString(context.date, "MM/dd/yy HH:mm:ss").addYears(100);
+  if (!date.isValid() && QFileInfo::exists(source))
+    date = QFileInfo(source).lastModified();
+  if (!date.isValid())
+    date = QDateTime::currentDateTime();
+  return date;
+}
+
+/**************************************************************************************************
+ *
+ * Store
+ *
+ **************************************************************************************************/
+
+HistoryStore::HistoryStore(const QString& dirPath)
+    : mDirPath(dirPath), mLock(QDir(dirPath).filePath("store.lock")) {}
+
+HistoryStore::~HistoryStore() {
+  close();
+}
+
+QString HistoryStore::defaultPath() {
+  return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation))
+      .filePath("history");
+}
+
+void HistoryStore::close() {
+  if (mPoints != nullptr) {
+    mPointsFile.unmap(const_cast<uchar*>(mPoints));
+    mPoints = nullptr;
+  }
+  mNamesFile.close();
+  mRunsFile.close();
+  mPointsFile.close();
+
+  mRuns.clear();
+  mDateOrder.clear();
+  mNames.clear();
+  mNameIds.clear();
+}
+
+bool HistoryStore::open(QString& errorMsg, bool readOnly) {
+  close();  // reopening reloads runs appended by other processes
+  mReadOnly = readOnly;
+
+  QDir dir(mDirPath);
+  if (!readOnly && !dir.mkpath(".")) {
+    errorMsg = "Cannot create history directory: " + mDirPath;
+    return false;
+  }
+  mNamesFile.setFileName(dir.filePath("names.log"));
+  mRunsFile.setFileName(dir.filePath("runs.log"));
+  mPointsFile.setFileName(dir.filePath("points.bin"));
+  if (readOnly && !mRunsFile.exists())
+    return true;  // nothing recorded yet
+  if (!readOnly && !lock(errorMsg))
+    return false;
+  bool ok = openLog(mNamesFile, readOnly, errorMsg) && openLog(mRunsFile, readOnly, errorMsg) &&
+            openLog(mPointsFile, readOnly, errorMsg) && load(errorMsg);
+  if (!readOnly)
+    mLock.unlock();
+  return ok;
+}
+
+bool HistoryStore::lock(QString& errorMsg) {
+  if (!mLock.tryLock(kLockTimeout)) {
+    errorMsg = "History store is locked by another process: " + mDirPath;
+    return false;
+  }
+  return true;
+}
+
+bool HistoryStore::load(QString& errorMsg) {
+  if (mPoints != nullptr) {
+    mPointsFile.unmap(const_cast<uchar*>(mPoints));
+    mPoints = nullptr;
+  }
+  mRuns.clear();
+  mNames.clear();
+  mNameIds.clear();
+
+  // Names
+  QDataStream namesStream(&mNamesFile);
+  namesStream.setVersion(QDataStream::Qt_6_0);
+  mNamesFile.seek(kHeaderSize);
+  qint64 namesEnd = mNamesFile.pos();
+  while (!namesStream.atEnd()) {
+    QString name;
+    namesStream >> name;
+    if (namesStream.status() != QDataStream::Ok)
+      break;
+    mNameIds.insert(name, mNames.size());
+    mNames.append(name);
+    namesEnd = mNamesFile.pos();
+  }
+
+  // Runs (only complete ones with existing points)
+  QDataStream runsStream(&mRunsFile);
+  runsStream.setVersion(QDataStream::Qt_6_0);
+  mRunsFile.seek(kHeaderSize);
+  qint64 runsEnd = mRunsFile.pos(), pointsEnd = kHeaderSize;
+  while (!runsStream.atEnd()) {
+    HistoryRun run;
+    runsStream >> run;
+    if (runsStream.status() != QDataStream::Ok ||
+        run.pointsOffset + run.pointsCount * kPointSize > mPointsFile.size())
+      break;
+    pointsEnd = std::max(pointsEnd, run.pointsOffset + run.pointsCount * kPointSize);
+    mRuns.append(run);
+    runsEnd = mRunsFile.pos();
+  }
+
+  // Drop interrupted append (writers only, under store lock so never another one in progress)
+  if (!mReadOnly && (mNamesFile.size() != namesEnd || mRunsFile.size() != runsEnd ||
+                     mPointsFile.size() != pointsEnd)) {
+    qWarning() << "History: dropping incomplete data in" << mDirPath;
+    mNamesFile.resize(namesEnd);
+    mRunsFile.resize(runsEnd);
+    mPointsFile.resize(pointsEnd);
+  }
+  if (HISTORY_DEBUG)
+    qDebug() << "History:" << mRuns.size() << "runs," << mNames.size() << "benchmarks";
+
+  updateDateOrder();
+  return mapPoints(errorMsg);
+}
+
+bool HistoryStore::mapPoints(QString& errorMsg) {
+  if (mPoints != nullptr) {
+    mPointsFile.unmap(const_cast<uchar*>(mPoints));
+    mPoints = nullptr;
+  }
+  if (mPointsFile.size() == 0)
+    return true;
+
+  mPoints = mPointsFile.map(0, mPointsFile.size());
+  if (mPoints == nullptr) {
+    errorMsg = "Cannot map history file: " + mPointsFile.fileName();
+    return false;
+  }
+  return true;
+}
+
+void HistoryStore::updateDateOrder() {
+  mDateOrder.resize(mRuns.size());
+  std::iota(mDateOrder.begin(), mDateOrder.end(), 0);
+  std::stable_sort(mDateOrder.begin(), mDateOrder.end(),
+                   [this](int lhs, int rhs) { return mRuns[lhs].date < mRuns[rhs].date; });
+}
+
+bool HistoryStore::addRun(const BenchResults& bchResults, const QString& source,
+                          const QString& label, QString& errorMsg) {
+  if (!mPointsFile.isOpen() || mReadOnly) {
+    errorMsg = "History store not opened for writing";
+    return false;
+  }
+
+  // Reload under lock (names/runs appended by other writers since open)
+  if (!lock(errorMsg))
+    return false;
+  bool ok = load(errorMsg) && appendRun(bchResults, source, label, errorMsg);
+  mLock.unlock();
+  return ok;
+}
+
+bool HistoryStore::appendRun(const BenchResults& bchResults, const QString& source,
+                             const QString& label, QString& errorMsg) {
+  // Points sorted by name id (new names appended to table)
+  QStringList newNames;
+  std::vector<StoredPoint> points;
+  points.reserve(bchResults.benchmarks.size());
+  for (const auto& bchData : bchResults.benchmarks) {
+    int nameId = mNameIds.value(bchData.run_name, -1);
+    if (nameId < 0) {
+      nameId = mNames.size();
+      mNameIds.insert(bchData.run_name, nameId);
+      mNames.append(bchData.run_name);
+      newNames.append(bchData.run_name);
+    }
+    StoredPoint point;
+    point.nameId = nameId;
+    point.repetitions = bchData.repetitions;
+    for (int type = 0; type < kHistoryValues; ++type)
+      point.values[type] = getStoredValue(bchData, static_cast<PlotValueType>(type));
+    points.push_back(point);
+  }
+  std::stable_sort(points.begin(), points.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.nameId < rhs.nameId;
+  });
+  points.erase(std::unique(points.begin(), points.end(),
+                           [](const auto& lhs, const auto& rhs) {
+                             return lhs.nameId == rhs.nameId;
+                           }),
+               points.end());
+
+  // Append names, then points, then run (commit)
+  if (mPoints != nullptr) {
+    mPointsFile.unmap(const_cast<uchar*>(mPoints));
+    mPoints = nullptr;
+  }
+  QDataStream namesStream(&mNamesFile);
+  namesStream.setVersion(QDataStream::Qt_6_0);
+  mNamesFile.seek(mNamesFile.size());
+  for (const auto& name : std::as_const(newNames))
+    namesStream << name;
+
+  HistoryRun run;
+  run.date = getRunDate(bchResults.context, source);
+  run.label = label.isEmpty() ? QFileInfo(source).fileName() : label;
+  run.source = QFileInfo(source).absoluteFilePath();
+  run.context = bchResults.context;
+  run.pointsOffset = mPointsFile.size();
+  run.pointsCount = static_cast<qint32>(points.size());
+
+  const qint64 pointsBytes = run.pointsCount * kPointSize;
+  mPointsFile.seek(run.pointsOffset);
+  bool ok = namesStream.status() == QDataStream::Ok && mNamesFile.flush() &&
+            mPointsFile.write(reinterpret_cast<const char*>(points.data()), pointsBytes) ==
+                pointsBytes &&
+            mPointsFile.flush();
+  if (ok) {
+    QDataStream runsStream(&mRunsFile);
+    runsStream.setVersion(QDataStream::Qt_6_0);
+    mRunsFile.seek(mRunsFile.size());
+    runsStream << run;
+    ok = runsStream.status() == QDataStream::Ok && mRunsFile.flush();
+  }
+  if (!ok) {
+    errorMsg = "Error writing history in: " + mDirPath;
+    mapPoints(errorMsg);
+    return false;
+  }
+
+  mRuns.append(run);
+  updateDateOrder();
+  return mapPoints(errorMsg);
+}
+
+QVector<HistoryPoint> HistoryStore::history(const QString& name, PlotValueType yType) const {
+  QVector<HistoryPoint> history;
+  const int nameId = mNameIds.value(name, -1);
+  if (nameId < 0 || mPoints == nullptr || yType < 0 || yType >= kHistoryValues)
+    return history;
+
+  history.reserve(mRuns.size());
+  for (int runIdx : mDateOrder) {
+    const HistoryRun& run = mRuns[runIdx];
+
+    // Binary search in run block (sorted by name id)
+    const uchar* block = mPoints + run.pointsOffset;
+    qint32 low = 0, high = run.pointsCount;
+    while (low < high) {
+      const qint32 mid = (low + high) / 2;
+      qint32 midId;
+      std::memcpy(&midId, block + mid * kPointSize + offsetof(StoredPoint, nameId),
+                  sizeof(midId));
+      if (midId < nameId)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+    if (low >= run.pointsCount)
+      continue;
+
+    StoredPoint point;
+    std::memcpy(&point, block + low * kPointSize, kPointSize);
+    if (point.nameId != nameId || point.values[yType] < 0.)
+      continue;
+    history.append({runIdx, point.values[yType]});
+  }
+
+  return history;
+}
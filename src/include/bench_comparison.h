@@ -0,0 +1,64 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef BENCH_COMPARISON_H
+#define BENCH_COMPARISON_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "plot_parameters.h"
+
+// Statistical test on repetitions
+enum CompareTest { MannWhitneyTest, WelchTest };
+
+// Benchmark matched between baseline and candidate results
+struct BenchComparison {
+  int baseIdx, candIdx;         // indexes in results
+  double baseValue, candValue;  // Y-values (times in us)
+  double ratio = -1.;           // candidate / baseline (-1 if undefined)
+  double pValue = -1.;          // -1 if not enough repetitions
+};
+
+// Comparison of two results, matched by run name
+struct ResultsComparison {
+  QVector<BenchComparison> matched;  // in candidate order
+  QStringList baseOnly, candOnly;    // unmatched run names
+};
+
+/*
+ * Tests
+ */
+// Two-sided Mann-Whitney U test p-value (exact without ties on small samples, normal otherwise)
+double mannWhitneyTest(const QVector<double>& samplesA, const QVector<double>& samplesB);
+
+// Two-sided Welch t-test p-value
+double welchTest(const QVector<double>& samplesA, const QVector<double>& samplesB);
+
+/*
+ * Comparison
+ */
+// Check lower Y-value is better (times, dispersion)
+bool isYLowerBetter(PlotValueType yType);
+
+// Significant change of candidate at alpha level (1: regression, -1: improvement, 0: none)
+int getSignificance(const BenchComparison& cmp, bool lowerBetter, double alpha);
+
+// Match benchmarks by run name and compare Y-values (multi-threaded)
+ResultsComparison compareResults(const BenchResults& baseline, const BenchResults& candidate,
+                                 PlotValueType yType, CompareTest test);
+
+#endif  // BENCH_COMPARISON_H
@@ -0,0 +1,56 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef BENCH_SEARCH_H
+#define BENCH_SEARCH_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct BenchResults;
+
+//
+// Search index of benchmarks (trigrams of lowercase names, including family, container,
+// templates and arguments)
+// A query is a list of space separated terms, all of them must match:
+//  - text: substring (case-insensitive)
+//  - glob: substring with '*' and '?' wildcards
+//  - /regex/: regular expression (case-insensitive)
+//  - a1>=1024, t2=int: argument/template predicate (=, !=, <, <=, >, >=), numeric when possible
+// Fixed parts of text and glob terms narrow candidates through trigram posting lists before being
+// checked, and a query extending the previous one only checks the previous matches.
+class BenchSearchIndex {
+ public:
+  // Build index of results benchmarks (kept by pointer, index must be rebuilt when they change)
+  void build(const BenchResults* bchResults);
+  void clear();
+
+  // Matching benchmarks indexes (sorted), returns false if query is invalid
+  bool search(const QString& query, QVector<int>& bchIdxs, QString& errorMsg);
+
+ private:
+  const BenchResults* mBchResults = nullptr;
+  QVector<QString> mTexts;                 // per benchmark, lowercase name
+  QHash<quint64, QVector<int>> mPostings;  // trigram -> sorted benchmarks indexes
+
+  // Previous search
+  QStringList mLastWords;
+  bool mLastExtensible = false;  // last term narrowed by typing on (text or glob)
+  QVector<int> mLastMatches;
+};
+
+#endif  // BENCH_SEARCH_H
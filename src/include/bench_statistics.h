@@ -0,0 +1,95 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef BENCH_STATISTICS_H
+#define BENCH_STATISTICS_H
+
+#include <QVector>
+
+#include "plot_parameters.h"
+
+/*
+ * Reductions
+ */
+// Sum of values
+double sumReduce(const double* data, qsizetype count);
+
+// Sum of squared deviations from mean
+double squaredDevReduce(const double* data, qsizetype count, double mean);
+
+/*
+ * Outliers
+ */
+// Default factor of filter method (1.5 IQR, 3.5 MAD score, 5% trimmed)
+double getOutlierDefaultFactor(OutlierMethod method);
+
+// Parse filter as "method[:factor]" (none, iqr, mad, trim), returns false if invalid
+bool parseOutlierFilter(const QString& text, OutlierFilter& filter);
+
+// Get filter as "method[:factor]" (inverse of parse)
+QString getOutlierFilterName(const OutlierFilter& filter);
+
+// Get filtered aggregates associated to Y-value (nullptr if not filtered)
+const BenchFiltered* getYPlotFiltered(const BenchData& bchData, PlotValueType yType);
+
+/*
+ * Bootstrap
+ */
+// Bootstrapped estimator
+enum BootstrapStatistic { BootstrapNone, BootstrapMean, BootstrapMedian };
+
+// Confidence interval (in Y-value unit, times in us)
+struct ConfidenceInterval {
+  double low = 0., high = 0.;
+  bool isValid = false;  // false if not enough samples
+};
+
+// Get per-repetition samples associated to Y-value (nullptr if none) and their factor to us
+const QVector<double>* getYPlotSamples(const BenchData& bchData, PlotValueType yType,
+                                       double& factor);
+
+// Get estimator whose interval matches Y-value (BootstrapNone if not applicable)
+BootstrapStatistic getYPlotStatistic(PlotValueType yType);
+
+// Percentile bootstrap confidence intervals of Y-values for benchmarks indexes (multi-threaded)
+// Resampling is seeded by benchmark name, so intervals are stable between reloads.
+// Outliers are excluded from resampling if results were filtered.
+QVector<ConfidenceInterval> bootstrapIntervals(const BenchResults& bchResults,
+                                               const QVector<int>& bchIdxs,
+                                               PlotValueType yType, double confidence = 0.95,
+                                               int resamples = 10000);
+
+/*
+ * Density
+ */
+// Density estimation method
+enum DensityMethod { DensityKde, DensityHistogram };
+
+// Density on regular grid (in Y-value unit, times in us)
+struct DensityEstimate {
+  double low = 0., step = 0.;  // grid point i at low + i * step (bin centers for histogram)
+  QVector<double> density;     // empty if not enough samples or no spread
+};
+
+// Densities of per-repetition Y-values for benchmarks indexes (multi-threaded, outliers included)
+// Gaussian KDE uses Silverman's bandwidth (times scale), binning samples linearly on the grid then
+// convolving bins with the kernel: O(samples + grid * kernel) instead of O(samples * grid).
+// Histogram uses Freedman-Diaconis bins, at most grid size.
+QVector<DensityEstimate> densityEstimates(const BenchResults& bchResults,
+                                          const QVector<int>& bchIdxs, PlotValueType yType,
+                                          DensityMethod method, double bandwidthScale = 1.,
+                                          int gridSize = 256);
+
+#endif  // BENCH_STATISTICS_H
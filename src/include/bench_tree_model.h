@@ -0,0 +1,114 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef BENCH_TREE_MODEL_H
+#define BENCH_TREE_MODEL_H
+
+#include <QAbstractItemModel>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct BenchResults;
+struct BenchData;
+
+//
+// Checkable tree of benchmarks (family > container > benchmark), read from results on demand
+// Only tree structure and check bits are stored, texts are formatted when displayed.
+// Benchmarks of a subtree own a contiguous range of check bits (leaf slots, in build order).
+class BenchTreeModel : public QAbstractItemModel {
+  Q_OBJECT
+
+ public:
+  explicit BenchTreeModel(QObject* parent = nullptr);
+
+  // Rebuild tree from results (kept by pointer, model must be reset before results change)
+  // If kept, unchecked benchmarks are matched by hashed names in new results (others checked).
+  void setResults(const BenchResults* bchResults, bool keepSelection = false);
+  // Update tree from reloaded results, keeping selection, sorting and expanded rows (matched by
+  // names): only changed rows if same benchmarks, layout change otherwise (reset if new columns)
+  void reloadResults(const BenchResults* bchResults);
+
+  // Checked benchmarks indexes, in displayed order
+  QVector<int> selectedBenchmarks() const;
+  bool anyChecked() const;
+  // All benchmarks, or matching ones if filtered
+  void setAllChecked(bool checked);
+
+  // Show matching benchmarks only (and their groups), all when cleared
+  void setFilter(const QVector<int>& bchIdxs);
+  void clearFilter();
+  bool isFiltered() const { return mFiltered; }
+
+  QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+  QModelIndex parent(const QModelIndex& child) const override;
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+  Qt::ItemFlags flags(const QModelIndex& index) const override;
+  QVariant headerData(int section, Qt::Orientation orientation,
+                      int role = Qt::DisplayRole) const override;
+  void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+ signals:
+  // Once per user or bulk check change
+  void checkedChanged();
+
+ private:
+  struct Node {
+    int parent = -1;  // node index (root has none)
+    int row = 0;      // position in parent visible rows
+    int bchIdx = -1;  // benchmark index, -1 for groups
+    int childBegin = 0, childCount = 0;  // range in children indexes
+    int rowBegin = 0, rowCount = 0;      // range in visible rows
+    int leafBegin = 0, leafCount = 1;    // range in leaf slots
+    QString name;                        // groups only
+  };
+
+  int addNode(int parent, int bchIdx, const QString& name = QString());
+  void setChildren(int parent, const QVector<int>& children);
+  void updateColumns();
+  void buildTree(bool keepSelection);
+  void sortChildren(int column, Qt::SortOrder order);
+  void updateRows();
+  bool isShown(const Node& node) const;
+  void updateShownIndexes(const QModelIndexList& prevIndexes);
+  size_t nodeKey(int nodeIdx) const;
+  size_t valuesHash(const BenchData& bchData) const;
+  void emitSubtreeChanged(int nodeIdx);
+  QModelIndex nodeIndex(int nodeIdx, int column = 0) const;
+  Qt::CheckState nodeCheckState(const Node& node) const;
+  QString columnText(const BenchData& bchData, int column) const;
+  double columnValue(const BenchData& bchData, int column) const;
+
+  const BenchResults* mBchResults = nullptr;
+  QVector<Node> mNodes;         // root first, children created after their parent
+  QVector<int> mChildren;       // node indexes, contiguous per parent in displayed order
+  QVector<int> mRows;           // visible children, same layout
+  QVector<size_t> mLeafHashes;  // leaf slot -> benchmark name hash (identity across reloads)
+  QVector<size_t> mLeafValues;  // leaf slot -> displayed values hash (changes across reloads)
+  QVector<int> mBenchSlots;     // benchmark index -> leaf slot
+  QVector<quint64> mChecked;    // bitset of leaf slots
+  QVector<quint64> mMatched;    // bitset of leaf slots matching filter
+  bool mFiltered = false;
+  QStringList mHeaders;
+  double mTimeFactor = 1.;  // from us
+  int mBytesColumn = -1, mItemsColumn = -1;
+  int mSortColumn = -1;
+  Qt::SortOrder mSortOrder = Qt::AscendingOrder;
+};
+
+#endif  // BENCH_TREE_MODEL_H
@@ -35,9 +35,9 @@ inline bool operator==(const FileReload& lhs, const FileReload& rhs) {
 // Context Cache
 struct BenchCache {
   QString type;
-  int level;
-  int64_t size;
-  int num_sharing;
+  int level = 0;
+  int64_t size = 0;
+  int num_sharing = 0;
 };
 
 // Benchmarks Context
@@ -45,14 +45,49 @@ struct BenchContext {
   QString date;
   QString host_name;
   QString executable;
-  int num_cpus;
-  int mhz_per_cpu;
-  bool cpu_scaling_enabled;
+  int num_cpus = 0;
+  int mhz_per_cpu = 0;
+  bool cpu_scaling_enabled = false;
   //"load_avg": [], // ?
   QString build_type;
   QVector<BenchCache> caches;
 };
 
+// Benchmark Parameter (argument/template) value parsed at load time
+struct BenchParam {
+  enum Kind {
+    TextParam,     // not numeric (uses fallback index as value)
+    NumberParam,   // plain number
+    DataSizeParam  // JOMT custom data size template (e.g. "data8<64>"), value in bytes
+  };
+  Kind kind = TextParam;
+  double value = 0.;
+};
+
+// Benchmark samples distribution (computed once at load time)
+struct BenchStats {
+  double min = 0., max = 0.;
+  double median = 0.;
+  double lowQuart = 0., uppQuart = 0.;  // medians of lower/upper halves
+  double p90 = 0., p99 = 0.;            // nearest-rank percentiles
+};
+
+// Outlier filter of repetition samples (applied at load time, raw samples kept)
+enum OutlierMethod { OutlierNone, OutlierIqr, OutlierMad, OutlierTrim };
+struct OutlierFilter {
+  OutlierMethod method = OutlierNone;
+  double factor = 0.;  // IQR fences factor, MAD score limit or trimmed percent per side
+};
+
+// Aggregates of samples without outliers (-1 if not filtered)
+struct BenchFiltered {
+  double lowFence = -1., highFence = -1.;  // kept samples range
+  double min = -1., max = -1.;             // of kept samples
+  double mean = -1., median = -1., stddev = -1., cv = -1.;
+  double lowQuart = -1., uppQuart = -1.;  // medians of lower/upper halves
+  QVector<double> outliers;               // rejected samples
+};
+
 // Benchmark Data
 struct BenchData {
   // Iterations
@@ -61,7 +96,7 @@ struct BenchData {
   QString run_type;
   int repetitions = 0;
   int repetition_index;
-  int threads;
+  int threads = 1;
   int iterations;
   QString time_unit;
   QVector<double> real_time;  // One per iteration
@@ -70,14 +105,21 @@ struct BenchData {
   QVector<double> kitems_sec;
 
   // Aggregate (all durations in us/cv in %)
+  // Note: -1 if not reported, then computed from repetitions if any
   bool hasAggregate = false;
-  double min_real, min_cpu, min_kbytes, min_kitems;
-  double max_real, max_cpu, max_kbytes, max_kitems;
-  double mean_real, mean_cpu, mean_kbytes, mean_kitems;
-  double median_real, median_cpu, median_kbytes, median_kitems;
-  double stddev_real, stddev_cpu, stddev_kbytes, stddev_kitems;
+  double min_real = -1, min_cpu = -1, min_kbytes = -1, min_kitems = -1;
+  double max_real = -1, max_cpu = -1, max_kbytes = -1, max_kitems = -1;
+  double mean_real = -1, mean_cpu = -1, mean_kbytes = -1, mean_kitems = -1;
+  double median_real = -1, median_cpu = -1, median_kbytes = -1, median_kitems = -1;
+  double stddev_real = -1, stddev_cpu = -1, stddev_kbytes = -1, stddev_kitems = -1;
   double cv_real = -1, cv_cpu = -1, cv_kbytes = -1, cv_kitems = -1;
 
+  // Samples distribution (durations in us)
+  BenchStats real_stats, cpu_stats, kbytes_stats, kitems_stats;
+
+  // Aggregates without outliers (durations in us), next to raw ones above
+  BenchFiltered real_filtered, cpu_filtered, kbytes_filtered, kitems_filtered;
+
   // Meta
   // Note: JOMT format = "JOMT_FamilyName_ContainerName<templates>/params
   QString base_name;      // run_name without template/param/JOMT prefix
@@ -85,12 +127,23 @@ struct BenchData {
   QString container;      // container name (empty if not JOMT)
   QStringList arguments;  // benchmark arguments
   QStringList templates;  // template parameters
+  QVector<BenchParam> argValues;   // parsed 'arguments' (same order)
+  QVector<BenchParam> tpltValues;  // parsed 'templates' (same order)
 
   // Default (use associated 'min' values if has aggregate)
   double real_time_us, cpu_time_us;  // in us
   double kbytes_sec_dflt = 0, kitems_sec_dflt = 0;
 };
 
+// Family complexity (from 'BigO' and 'RMS' aggregates)
+struct BenchComplexity {
+  QString run_name;               // family run name (without arguments)
+  QString big_o;                  // e.g. "N", "NlgN", "f(N)" (empty if no 'BigO' entry)
+  double cpu_coefficient = -1.;   // in us
+  double real_coefficient = -1.;
+  double rms = -1.;               // relative to mean (-1 if no 'RMS' entry)
+};
+
 // Benchmark Subset
 struct BenchSubset {
   BenchSubset() = default;
@@ -108,6 +161,8 @@ struct BenchMeta {
   bool hasAggregate = false, onlyAggregate = true, hasCv = false;
   bool hasBytesSec = false, hasItemsSec = false;
   int maxArguments = 0, maxTemplates = 0;
+  int maxThreads = 1;
+  OutlierFilter outlierFilter;  // applied to repetitions
   QString time_unit;  // if same for all, otherwise "us" as default
 };
 
@@ -120,10 +175,14 @@ struct BenchResults {
   BenchMeta meta;
   BenchContext context;
   QVector<BenchData> benchmarks;
+  QVector<BenchComplexity> complexities;
 
   /*
    * Static functions
    */
+  // Factor converting durations in time unit (ns, us, ms or s) to us
+  static double getTimeFactorUs(QStringView timeUnit);
+
   // Replace argument and/or template with glyph in BenchData name
   static QString extractData(const BenchData& data, int argIdx, int tpltIdx,
                              const QString& glyph = "", int argIdx2 = -1, int tpltIdx2 = -1,
@@ -141,14 +200,24 @@ struct BenchResults {
   // Try to extract special name+value from template name (JOMT specific)
   static QPair<double, QString> convertCustomDataSize(const QString& tplt);
 
-  // Convert parameter name to value (check special names, use incremented fallback if all else
+  // Parse parameter name into value and kind (done once at load time)
+  static BenchParam parseParam(QStringView name);
+
+  // Convert parameter to axis value (check special names, use incremented fallback if all else
   // fail)
+  static double getParamValue(const BenchParam& param, QString& custDataName,
+                              bool& custDataAxis, double& fallbackIdx);
   static double getParamValue(const QString& name, QString& custDataName, bool& custDataAxis,
-                              double& fallbackIdx);
+                              double& fallbackIdx) {
+    return getParamValue(parseParam(name), custDataName, custDataAxis, fallbackIdx);
+  }
 
   /*
    * Member functions
    */
+  // Compute samples distribution, missing and filtered aggregates of all benchmarks (after parsing)
+  void updateStats(const OutlierFilter& filter = OutlierFilter());
+
   // Ordered vector of all BenchData indexes
   QVector<int> segmentAll() const;
 
@@ -170,6 +239,9 @@ struct BenchResults {
   // Each BaseName from index vector in its own subset
   QVector<BenchSubset> segmentBaseNames(const QVector<int>& subset) const;
 
+  // Each 'run name % threads' from index vector in its own subset (ordered by threads)
+  QVector<BenchSubset> segmentThreads(const QVector<int>& subset) const;
+
   // Each 'full name % param1 % param2' from index vector in its own subset
   QVector<BenchSubset> segment2DNames(const QVector<int>& subset, bool isArg1, int idx1,
                                       bool isArg2, int idx2) const;
@@ -197,6 +269,12 @@ struct BenchResults {
   QString getBenchName(int index) const;
   // Get Argument/Template name
   QString getParamName(bool isArgument, int benchIdx, int paramIdx) const;
+  // Get Argument/Template parsed value
+  const BenchParam& getParam(bool isArgument, int benchIdx, int paramIdx) const;
+  // Get complexity index of Benchmark family (-1 if none)
+  int getComplexityIndex(int benchIdx) const;
+  // Indexes of other results Benchmarks found here by full name (missing ones dropped)
+  QVector<int> matchBenchmarks(const BenchResults& other, const QVector<int>& otherIdxs) const;
 
   //
   // Merge results (rename BenchData if already exists)
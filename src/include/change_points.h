@@ -0,0 +1,58 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CHANGE_POINTS_H
+#define CHANGE_POINTS_H
+
+#include <QVector>
+
+//
+// Incremental change-point detection (two-sided self-starting CUSUM)
+// Each value is standardized against the running mean/sigma of its segment's previous values,
+// then deviations are accumulated in sigma units. When a sum exceeds the threshold, a change
+// point is set where the sum started rising and only the values since then are processed again.
+class ChangePointDetector {
+ public:
+  explicit ChangePointDetector(double threshold = 5., double drift = 0.5, int warmup = 8);
+
+  // Append value, returns true if new change points were detected
+  bool append(double value);
+  // Remove all values
+  void clear();
+
+  int size() const { return mValues.size(); }
+  double threshold() const { return mThreshold; }
+  // Index of first value of each new segment
+  const QVector<int>& changePoints() const { return mChangePoints; }
+
+ private:
+  void startSegment(int begin);
+  bool process(int idx);
+
+  double mThreshold, mDrift;  // in sigma units
+  int mWarmup;                // values before segment is monitored
+
+  QVector<double> mValues;
+  QVector<int> mChangePoints;
+
+  // Current segment
+  int mSegBegin = 0;
+  int mCount = 0;
+  double mMean = 0., mM2 = 0.;  // running stats (Welford)
+  double mHighSum = 0., mLowSum = 0.;
+  int mHighStart = 0, mLowStart = 0;  // where sums last left zero
+};
+
+#endif  // CHANGE_POINTS_H
@@ -0,0 +1,56 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CHART_ERROR_BARS_H
+#define CHART_ERROR_BARS_H
+
+#include <QVector>
+
+#include "chart_overlay.h"
+
+class QChart;
+class QAbstractSeries;
+class QAbstractBarSeries;
+class QXYSeries;
+
+//
+// Error bars (whiskers) drawn over chart series, positioned from series values at paint time
+class ChartErrorBars : public ChartOverlay {
+ public:
+  explicit ChartErrorBars(QChart* chart);
+
+  // Interval of XY-series point at X value
+  void addBar(QXYSeries* series, double x, double low, double high);
+  // Interval of bar set value in category
+  void addBar(QAbstractBarSeries* series, int setIdx, int category, double low, double high);
+
+  void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+             QWidget* widget = nullptr) override;
+
+ protected:
+  void clearItems() override;
+
+ private:
+  struct Bar {
+    QAbstractSeries* series;
+    int setIdx;  // -1 for XY-series
+    double pos;  // X value or category index
+    double low, high;
+  };
+
+  QVector<Bar> mBars;
+};
+
+#endif  // CHART_ERROR_BARS_H
@@ -0,0 +1,84 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CHART_HOVER_H
+#define CHART_HOVER_H
+
+#include <QHash>
+#include <QObject>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+#include "bench_statistics.h"
+#include "plot_parameters.h"
+
+class QAbstractSeries;
+class QChartView;
+
+//
+// Hover hit-testing of chart items, through a grid index of their values (built once per items
+// update, at first hover), instead of per-point series signals
+class ChartHover : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit ChartHover(QChartView* view);
+
+  // Item extent in series values (null size for XY points), key reported when hovered
+  void addItem(QAbstractSeries* series, const QRectF& extent, int key);
+  // Remove all items (must be done before removing chart series)
+  void clear();
+
+ signals:
+  // Key of item under cursor (-1 if none), only emitted on change
+  void hovered(int key);
+
+ protected:
+  bool eventFilter(QObject* watched, QEvent* event) override;
+
+ private:
+  struct Item {
+    QAbstractSeries* series;
+    QRectF extent;
+    int key;
+  };
+
+  void build();
+  int itemAt(const QPointF& pos);
+  void setHovered(int key);
+
+  QChartView* mView;
+  QVector<Item> mItems;
+  int mHoveredKey = -1;
+
+  // Grid of item centers, bins of equal counts per axis (robust to log-like distributions)
+  bool mBuilt = false;
+  QVector<double> mXEdges, mYEdges;  // bins lower bounds
+  QVector<int> mCellStarts;          // per cell, in mCellItems
+  QVector<int> mCellItems;           // item indexes sorted by cell
+  double mHalfWidth = 0., mHalfHeight = 0.;  // largest item half extent
+};
+
+// Interval of benchmark Y-value, computed only if not already in cache (by benchmark index)
+const ConfidenceInterval& getBenchInterval(QHash<int, ConfidenceInterval>& intervals,
+                                           const BenchResults& bchResults, int benchIdx,
+                                           PlotValueType yType);
+
+// Tooltip text of benchmark: name, value, confidence interval (if valid) and repetitions
+QString getBenchHoverText(const BenchResults& bchResults, int benchIdx, PlotValueType yType,
+                          double timeFactor, const ConfidenceInterval& interval);
+
+#endif  // CHART_HOVER_H
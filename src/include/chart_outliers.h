@@ -0,0 +1,51 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CHART_OUTLIERS_H
+#define CHART_OUTLIERS_H
+
+#include <QVector>
+
+#include "chart_overlay.h"
+
+class QChart;
+class QBoxPlotSeries;
+
+//
+// Outlier markers drawn over box plot series, positioned from series layout at paint time
+class ChartOutliers : public ChartOverlay {
+ public:
+  explicit ChartOutliers(QChart* chart);
+
+  // Samples outside of box set whiskers
+  void addOutliers(QBoxPlotSeries* series, int setIdx, const QVector<double>& values);
+
+  void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+             QWidget* widget = nullptr) override;
+
+ protected:
+  void clearItems() override;
+
+ private:
+  struct Marker {
+    QBoxPlotSeries* series;
+    int setIdx;  // category
+    double value;
+  };
+
+  QVector<Marker> mMarkers;
+};
+
+#endif  // CHART_OUTLIERS_H
@@ -0,0 +1,46 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CHART_OVERLAY_H
+#define CHART_OVERLAY_H
+
+#include <QGraphicsItem>
+
+class QChart;
+
+//
+// Base of items drawn over chart plot area, positioned from series values at paint time
+// Subclasses hold their own items and paint them (scaled values, clipped to plot area).
+class ChartOverlay : public QGraphicsItem {
+ public:
+  explicit ChartOverlay(QChart* chart);
+
+  // Remove all items (must be done before removing chart series)
+  void clear();
+
+  // Factor applied to items values (e.g. time unit)
+  void setScale(double scale);
+
+  QRectF boundingRect() const override;
+
+ protected:
+  // Drop items of subclass
+  virtual void clearItems() = 0;
+
+  QChart* mChart;
+  double mScale = 1.;
+};
+
+#endif  // CHART_OVERLAY_H
@@ -0,0 +1,57 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CHART_VIOLINS_H
+#define CHART_VIOLINS_H
+
+#include <QPainterPath>
+#include <QVector>
+
+#include "bench_statistics.h"
+#include "chart_overlay.h"
+
+class QChart;
+class QXYSeries;
+
+//
+// Density outlines (violins) drawn over chart series, built once in grid units then placed by one
+// transform per violin at paint time
+class ChartViolins : public ChartOverlay {
+ public:
+  explicit ChartViolins(QChart* chart);
+
+  // Vertical outline of density at X position, widest point at half-width (in X values)
+  // Smooth mirrored curve, or histogram steps
+  void addViolin(QXYSeries* series, double pos, const DensityEstimate& estimate, double halfWidth,
+                 bool steps);
+
+  void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+             QWidget* widget = nullptr) override;
+
+ protected:
+  void clearItems() override;
+
+ private:
+  struct Violin {
+    QXYSeries* series;
+    double pos;
+    double low, step;   // grid origin and step (in Y values)
+    QPainterPath path;  // X in values relative to position, Y in grid steps
+  };
+
+  QVector<Violin> mViolins;
+};
+
+#endif  // CHART_VIOLINS_H
@@ -19,6 +19,7 @@
 #include <QCommandLineParser>
 
 class QApplication;
+class QCoreApplication;
 
 class CommandLineHandler {
  public:
@@ -26,7 +27,17 @@ class CommandLineHandler {
 
   bool process(const QApplication& app);
 
+  // Headless commands ("compare", "record"), checked before creating any application
+  static bool isHeadlessCommand(int argc, char* argv[]);
+  // Run headless command, returns exit code
+  static int processHeadless(const QCoreApplication& app);
+
  private:
+  // Compare baseline and candidate results (0: ok, 1: regression, 2: error)
+  static int processCompare(const QCoreApplication& app);
+  // Record results files in history store (0: ok, 2: error)
+  static int processRecord(const QCoreApplication& app);
+
   QCommandLineParser mParser;
 };
 
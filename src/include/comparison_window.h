@@ -0,0 +1,61 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef COMPARISON_WINDOW_H
+#define COMPARISON_WINDOW_H
+
+#include <QChartView>
+#include <QString>
+#include <QWidget>
+
+#include "bench_comparison.h"
+
+namespace Ui {
+class ComparisonWindow;
+}
+class ComparisonModel;
+
+class ComparisonWindow : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit ComparisonWindow(const BenchResults& baseline, const BenchResults& candidate,
+                            PlotValueType yType, const QString& baseFilename,
+                            const QString& candFilename, QWidget* parent = nullptr);
+  ~ComparisonWindow();
+
+ private:
+  void connectUI();
+  void loadConfig();
+  void saveConfig();
+  void updateComparison();
+  void updateChart();
+
+ public slots:
+  void onComboTestChanged(int index);
+  void onSpinAlphaChanged(double d);
+
+ private:
+  Ui::ComparisonWindow* ui;
+  QChartView* mChartView = nullptr;
+  ComparisonModel* mModel = nullptr;
+
+  const BenchResults mBaseline, mCandidate;
+  const PlotValueType mYType;
+  ResultsComparison mComparison;
+  bool mIgnoreEvents = false;
+};
+
+#endif  // COMPARISON_WINDOW_H
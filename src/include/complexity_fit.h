@@ -0,0 +1,89 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef COMPLEXITY_FIT_H
+#define COMPLEXITY_FIT_H
+
+#include <vector>
+
+#include <QPointF>
+#include <QString>
+#include <QVector>
+
+// Complexity models (same as Google benchmark, logarithms in base 2)
+enum ComplexityModel {
+  ComplexityO1,
+  ComplexityOLogN,
+  ComplexityON,
+  ComplexityONLogN,
+  ComplexityON2,
+  ComplexityON3,
+  ComplexityCustom
+};
+
+//
+// Custom complexity function of n (e.g. "n * sqrt(n)", "n^1.5", "n lg n")
+// Supports + - * / ^, implicit products, parentheses, numbers and functions (lg, log2, log, ln,
+// log10, sqrt, exp, abs). Parsed once to postfix operations, evaluated without allocation.
+class ComplexityExpression {
+ public:
+  // Parse expression (false with error message if invalid)
+  bool parse(const QString& text, QString& errorMsg);
+
+  bool isValid() const { return !mOps.empty(); }
+  const QString& text() const { return mText; }
+
+  // Evaluate for n (NaN if invalid)
+  double evaluate(double n) const;
+
+ private:
+  struct Op {
+    enum Kind { Number, Variable, Add, Sub, Mul, Div, Pow, Neg, Func } kind;
+    double value = 0.;
+    double (*func)(double) = nullptr;
+  };
+  friend class ComplexityParser;
+
+  QString mText;
+  std::vector<Op> mOps;
+  int mMaxDepth = 0;  // evaluation stack size
+};
+
+// Least squares fit of y = coefficient * f(x)
+struct ComplexityFit {
+  ComplexityModel model = ComplexityO1;
+  double coefficient = 0.;
+  double rms = -1.;  // root mean square of residuals, relative to mean
+  bool isValid = false;
+};
+
+// Model value for n (custom expression used for ComplexityCustom)
+double getComplexityValue(ComplexityModel model, double n,
+                          const ComplexityExpression* custom = nullptr);
+
+// Model notation (e.g. "n log n", custom expression text)
+QString getComplexityName(ComplexityModel model, const ComplexityExpression* custom = nullptr);
+
+// Model from Google benchmark 'big_o' notation (false if not plottable, e.g. lambda "f(N)")
+bool parseBigO(const QString& bigO, ComplexityModel& model);
+
+// Fit model to points (x = n), invalid if less than 2 points or model undefined on them
+ComplexityFit fitComplexity(const QVector<QPointF>& points, ComplexityModel model,
+                            const ComplexityExpression* custom = nullptr);
+
+// Fit all standard models and keep the one with lowest RMS
+ComplexityFit fitBestComplexity(const QVector<QPointF>& points);
+
+#endif  // COMPLEXITY_FIT_H
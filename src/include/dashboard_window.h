@@ -0,0 +1,109 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DASHBOARD_WINDOW_H
+#define DASHBOARD_WINDOW_H
+
+#include <QFileSystemWatcher>
+#include <QMetaObject>
+#include <QPoint>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+#include <QWidget>
+
+#include "plot_parameters.h"
+
+namespace Ui {
+class DashboardWindow;
+}
+class QAbstractAxis;
+class QChartView;
+
+//
+// Tiled 2D charts of one results snapshot, reloaded at once (single parse for all charts)
+class DashboardWindow : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit DashboardWindow(const BenchResults& bchResults, const QString& origFilename,
+                           const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
+  ~DashboardWindow();
+
+  // Chart types that can be tiled
+  static bool isChartSupported(PlotChartType type);
+
+  // Add chart of benchmarks from other results (matched by names)
+  void addChart(const BenchResults& srcResults, const QVector<int>& srcIdxs,
+                const PlotParams& plotParams);
+
+  const QString& origFilename() const { return mOrigFilename; }
+  const QVector<FileReload>& addFilenames() const { return mAddFilenames; }
+
+ private:
+  struct Tile {
+    PlotParams params;
+    QVector<int> bchIdxs;  // in mBchResults (matched again on reload)
+    bool allIndexes;
+    QWidget* frame;
+    QWidget* plotter;
+    QChartView* view;  // if X-axis can be linked, nullptr otherwise
+  };
+  struct LinkedAxis {
+    QPointer<QAbstractAxis> axis;
+    QString key;  // X-parameter, linked to axes of same key
+  };
+
+  void connectUI();
+  void loadConfig();
+  void saveConfig();
+  void addTile(const QVector<int>& bchIdxs, const PlotParams& plotParams);
+  void removeTile(QWidget* frame);
+  void clearTiles();
+  void updateGrid();
+  void linkAxes();
+  void syncAxes(QAbstractAxis* srcAxis, qreal min, qreal max);
+
+ protected:
+  bool eventFilter(QObject* watched, QEvent* event) override;
+
+ public slots:
+  void onSpinColumnsChanged(int i);
+  void onCheckLinkX(int state);
+  void onCheckOptions(int state);
+  void onRestoreClicked();
+
+  void onCheckAutoReload(int state);
+  void onAutoReload(const QString& path);
+  void onReloadClicked();
+  void onSnapshotClicked();
+
+ private:
+  Ui::DashboardWindow* ui;
+
+  BenchResults mBchResults;  // shared by all charts
+  const QString mOrigFilename;
+  const QVector<FileReload> mAddFilenames;
+
+  QVector<Tile> mTiles;
+  QFileSystemWatcher mWatcher;
+
+  QVector<LinkedAxis> mLinkedAxes;
+  QVector<QMetaObject::Connection> mLinkConnections;
+  bool mSyncingAxes = false;
+  QPoint mPanPos;  // last middle-drag position
+};
+
+#endif  // DASHBOARD_WINDOW_H
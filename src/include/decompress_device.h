@@ -0,0 +1,69 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DECOMPRESS_DEVICE_H
+#define DECOMPRESS_DEVICE_H
+
+#include <QByteArray>
+#include <QIODevice>
+
+struct z_stream_s;
+struct ZSTD_DCtx_s;
+
+//
+// Read-only sequential device decompressing a source device on the fly (gzip/zstd)
+class DecompressDevice : public QIODevice {
+  Q_OBJECT
+
+ public:
+  enum Compression { NoCompression, GzipCompression, ZstdCompression };
+
+  explicit DecompressDevice(QIODevice* source, Compression compression,
+                            QObject* parent = nullptr);
+  ~DecompressDevice() override;
+
+  // Detect compression from source magic number (does not consume it)
+  static Compression detectCompression(QIODevice& source);
+
+  bool open(OpenMode mode) override;
+  void close() override;
+  bool isSequential() const override { return true; }
+  bool atEnd() const override;
+
+  // Whether compressed data was corrupted (see errorString())
+  bool hasFailed() const { return mFailed; }
+
+ protected:
+  qint64 readData(char* data, qint64 maxSize) override;
+  qint64 writeData(const char* data, qint64 maxSize) override;
+
+ private:
+  bool fillInput();
+  qint64 readGzip(char* data, qint64 maxSize);
+  qint64 readZstd(char* data, qint64 maxSize);
+
+  QIODevice* mSource;
+  const Compression mCompression;
+
+  QByteArray mInput;  // compressed chunk
+  qint64 mInputPos = 0;
+  bool mFinished = false;
+  bool mFailed = false;
+
+  z_stream_s* mGzStream = nullptr;
+  ZSTD_DCtx_s* mZstdStream = nullptr;
+};
+
+#endif  // DECOMPRESS_DEVICE_H
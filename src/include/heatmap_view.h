@@ -0,0 +1,83 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef HEATMAP_VIEW_H
+#define HEATMAP_VIEW_H
+
+#include <QImage>
+#include <QPixmap>
+#include <QRgb>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QWidget>
+
+//
+// Value grid rasterized into an image (one pixel per cell), scaled to the widget with a color scale
+class HeatmapView : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit HeatmapView(QWidget* parent = nullptr);
+
+  // Row-major values (NaN if missing), one label per row/column
+  void setGrid(const QVector<double>& values, const QStringList& rowLabels,
+               const QStringList& colLabels);
+  // Colors from minimum to maximum value
+  void setColorTable(const QVector<QRgb>& colors);
+  void setLogScale(bool log);
+  // Factor applied to displayed values (e.g. time unit), colors unchanged
+  void setValueScale(double scale);
+  void setTitles(const QString& xTitle, const QString& yTitle, const QString& valueTitle);
+  // Shown instead of an empty grid
+  void setMessage(const QString& message);
+
+  int rowCount() const { return mRowLabels.size(); }
+  int columnCount() const { return mColLabels.size(); }
+  // Displayed value of cell (NaN if missing)
+  double value(int row, int col) const;
+
+ signals:
+  // Cell under cursor (-1 if none)
+  void cellHovered(int row, int col);
+
+ protected:
+  void paintEvent(QPaintEvent* event) override;
+  void resizeEvent(QResizeEvent* event) override;
+  void mouseMoveEvent(QMouseEvent* event) override;
+  void leaveEvent(QEvent* event) override;
+
+ private:
+  void rasterize();
+  double normalized(double value) const;  // in [0, 1] from range (NaN if not mappable)
+  QRect gridRect() const;
+  QRect cellRect(int row, int col) const;
+  void setHoveredCell(int row, int col);
+
+  QVector<double> mValues;
+  QStringList mRowLabels, mColLabels;
+  QVector<QRgb> mColors;
+  bool mLog = false;
+  double mScale = 1.;
+  double mMin = 0., mMax = 0.;  // finite values range (positive ones if log)
+  QString mXTitle, mYTitle, mValueTitle, mMessage;
+  int mRowLabelWidth = 0, mColLabelWidth = 0;
+
+  QImage mImage;    // one pixel per cell
+  QPixmap mScaled;  // image at grid size (cached between paints)
+  int mHoverRow = -1, mHoverCol = -1;
+};
+
+#endif  // HEATMAP_VIEW_H
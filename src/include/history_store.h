@@ -0,0 +1,105 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QLockFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "plot_parameters.h"
+
+// Number of stored Y-values per benchmark (one per PlotValueType)
+constexpr int kHistoryValues = ItemsCvType + 1;
+
+// Run recorded in history
+struct HistoryRun {
+  QDateTime date;  // from context, file date otherwise
+  QString label;   // e.g. commit (file name by default)
+  QString source;  // original results file
+  BenchContext context;
+
+  // Points block in store
+  qint64 pointsOffset = 0;
+  qint32 pointsCount = 0;
+};
+
+// Benchmark Y-value in one run
+struct HistoryPoint {
+  int runIdx;
+  double value;
+};
+
+//
+// On-disk history of results, indexed by benchmark name and run date
+// Append-only versioned logs: names table, runs (committed last) and one points block per run
+// sorted by name id, memory-mapped so that a benchmark history is one binary search per run.
+class HistoryStore {
+ public:
+  explicit HistoryStore(const QString& dirPath = defaultPath());
+  ~HistoryStore();
+
+  // Default store location (application data)
+  static QString defaultPath();
+
+  // Open or create store (drops data of any interrupted append), reloads if already opened
+  // Read-only stores never modify files, so they can be opened while another process records.
+  // Writers hold the store lock while dropping data or appending a run.
+  bool open(QString& errorMsg, bool readOnly = false);
+  // Close files and clear loaded runs
+  void close();
+  // Append results as a new run
+  bool addRun(const BenchResults& bchResults, const QString& source, const QString& label,
+              QString& errorMsg);
+
+  // Runs in recording order
+  const QVector<HistoryRun>& runs() const { return mRuns; }
+  // Run indexes by increasing date
+  const QVector<int>& runsByDate() const { return mDateOrder; }
+  // Names of all recorded benchmarks
+  const QStringList& names() const { return mNames; }
+  // Store directory
+  const QString& dirPath() const { return mDirPath; }
+
+  // Y-values of benchmark by increasing run date (runs without benchmark/value skipped)
+  QVector<HistoryPoint> history(const QString& name, PlotValueType yType) const;
+
+ private:
+  bool lock(QString& errorMsg);
+  // (Re)load names and runs from files, drops incomplete data if writer (lock held)
+  bool load(QString& errorMsg);
+  bool appendRun(const BenchResults& bchResults, const QString& source, const QString& label,
+                 QString& errorMsg);
+  bool mapPoints(QString& errorMsg);
+  void updateDateOrder();
+
+  QString mDirPath;
+  bool mReadOnly = false;
+  QLockFile mLock;  // between writer processes
+  QFile mNamesFile, mRunsFile, mPointsFile;
+  const uchar* mPoints = nullptr;  // mapped points file
+
+  QVector<HistoryRun> mRuns;
+  QVector<int> mDateOrder;
+  QStringList mNames;
+  QHash<QString, int> mNameIds;
+};
+
+#endif  // HISTORY_STORE_H
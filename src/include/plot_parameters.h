@@ -30,7 +30,11 @@ enum PlotChartType {
   ChartHBarType,
   ChartBoxType,
   Chart3DBarsType,
-  Chart3DSurfaceType
+  Chart3DSurfaceType,
+  ChartHistoryType,
+  ChartScalingType,
+  ChartHeatmapType,
+  ChartViolinType
 };
 
 // Parameter types
@@ -70,6 +74,7 @@ struct BenchYStats {
   double min, max;
   double median;
   double lowQuart, uppQuart;
+  QVector<double> outliers;  // outside of whiskers (if filtered)
 };
 
 // Plot parameters
@@ -97,11 +102,8 @@ double normalizeTimeUs(const BenchData& bchData, double value);
 // Check Y-value type is time-based
 bool isYTimeBased(PlotValueType yType);
 
-// Find median in vector subpart
-double findMedian(QVector<double> sorted, int begin, int end);
-
-// Get Y-value statistics (for Box chart)
-BenchYStats getYPlotStats(BenchData& bchData, PlotValueType yType);
+// Get Y-value statistics (for Box chart, from precomputed samples distribution)
+BenchYStats getYPlotStats(const BenchData& bchData, PlotValueType yType);
 
 // Compare first common elements of string lists
 bool commonPartEqual(const QStringList& listA, const QStringList& listB);
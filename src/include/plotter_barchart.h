@@ -18,11 +18,14 @@
 
 #include <QChartView>
 #include <QFileSystemWatcher>
+#include <QHash>
 #include <QString>
 #include <QVector>
 #include <QWidget>
 
+#include "bench_statistics.h"
 #include "plot_parameters.h"
+#include "series_baseline.h"
 #include "series_dialog.h"
 
 namespace Ui {
@@ -33,6 +36,8 @@ class PlotterBarChart;
 // }
 struct BenchResults;
 struct FileReload;
+class ChartErrorBars;
+class ChartHover;
 
 class PlotterBarChart : public QWidget {
   Q_OBJECT
@@ -43,6 +48,11 @@ class PlotterBarChart : public QWidget {
                            const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
   ~PlotterBarChart();
 
+  // Reload driven by owner (e.g. dashboard): own watcher and reload controls disabled
+  void setSharedReload();
+  // Update chart from reloaded results
+  void reloadResults(const BenchResults& newBchResults);
+
  private:
   void connectUI();
   void setupChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
@@ -50,6 +60,12 @@ class PlotterBarChart : public QWidget {
   void setupOptions(bool init = true);
   void loadConfig(bool init);
   void saveConfig();
+  void updateErrorBars();
+  void updateHoverItems();
+  void updateBaselineChoices();
+  void updateSeriesValues(bool fitRange = true);
+  void fitYRange();
+  void reconcileSeries(const BenchResults& bchResults);
 
  public slots:
   void onComboThemeChanged(int index);
@@ -59,6 +75,9 @@ class PlotterBarChart : public QWidget {
   void onSpinLegendFontSizeChanged(int i);
   void onSeriesEditClicked();
   void onComboTimeUnitChanged(int index);
+  void onCheckErrorBars(int state);
+  void onComboBaselineChanged(int index);
+  void onBarHovered(int benchIdx);
 
   void onComboAxisChanged(int index);
   void onCheckAxisVisible(int state);
@@ -100,6 +119,9 @@ class PlotterBarChart : public QWidget {
 
   Ui::PlotterBarChart* ui;
   QChartView* mChartView = nullptr;
+  ChartErrorBars* mErrorBars = nullptr;
+  ChartHover* mHover = nullptr;
+  QHash<int, ConfidenceInterval> mIntervals;  // error bars, also shown on hover
 
   QVector<int> mBenchIdxs;
   const PlotParams mPlotParams;
@@ -107,11 +129,18 @@ class PlotterBarChart : public QWidget {
   const QVector<FileReload> mAddFilenames;
   const bool mAllIndexes;
 
+  BenchResults mBchResults;          // plotted results (shared data)
+  QVector<BenchSubset> mBchSubsets;  // plotted subsets, in bar sets order
   QFileSystemWatcher mWatcher;
   SeriesMapping mSeriesMapping;
-  double mCurrentTimeFactor;  // from us
+  SeriesBaseline mBaseline;    // plotted values joined on X-param
+  QHash<int, double> mRatios;  // benchmark -> ratio to baseline (plotted bars only)
+  QString mAbsoluteTitle;      // Y-axis title of plotted values
+  double mCurrentTimeFactor;   // from us
   QVector<AxisParam> mAxesParams{2};
   const bool mIsVert;
+  bool mRelative = false;  // ratios to baseline plotted
+  bool mSharedReload = false;
   bool mIgnoreEvents = false;
 };
 
@@ -18,10 +18,12 @@
 
 #include <QChartView>
 #include <QFileSystemWatcher>
+#include <QHash>
 #include <QString>
 #include <QVector>
 #include <QWidget>
 
+#include "bench_statistics.h"
 #include "plot_parameters.h"
 #include "series_dialog.h"
 
@@ -33,23 +35,31 @@ class PlotterBoxChart;
 // }
 struct BenchResults;
 struct FileReload;
+class ChartHover;
+class ChartOutliers;
 
 class PlotterBoxChart : public QWidget {
   Q_OBJECT
 
  public:
-  explicit PlotterBoxChart(BenchResults& bchResults, const QVector<int>& bchIdxs,
+  explicit PlotterBoxChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
                            const PlotParams& plotParams, const QString& filename,
                            const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
   ~PlotterBoxChart();
 
+  // Reload driven by owner (e.g. dashboard): own watcher and reload controls disabled
+  void setSharedReload();
+  // Update chart from reloaded results
+  void reloadResults(const BenchResults& newBchResults);
+
  private:
   void connectUI();
-  void setupChart(BenchResults& bchResults, const QVector<int>& bchIdxs,
+  void setupChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
                   const PlotParams& plotParams, bool init = true);
   void setupOptions(bool init = true);
   void loadConfig(bool init);
   void saveConfig();
+  void updateHoverItems();
 
  public slots:
   void onComboThemeChanged(int index);
@@ -59,6 +69,7 @@ class PlotterBoxChart : public QWidget {
   void onSpinLegendFontSizeChanged(int i);
   void onSeriesEditClicked();
   void onComboTimeUnitChanged(int index);
+  void onBoxHovered(int benchIdx);
 
   void onComboAxisChanged(int index);
   void onCheckAxisVisible(int state);
@@ -96,6 +107,9 @@ class PlotterBoxChart : public QWidget {
 
   Ui::PlotterBoxChart* ui;
   QChartView* mChartView = nullptr;
+  ChartOutliers* mOutliers = nullptr;
+  ChartHover* mHover = nullptr;
+  QHash<int, ConfidenceInterval> mIntervals;  // of hovered boxes
 
   QVector<int> mBenchIdxs;
   const PlotParams mPlotParams;
@@ -103,10 +117,13 @@ class PlotterBoxChart : public QWidget {
   const QVector<FileReload> mAddFilenames;
   const bool mAllIndexes;
 
+  BenchResults mBchResults;          // plotted results (shared data)
+  QVector<BenchSubset> mBchSubsets;  // plotted subsets, in series order
   QFileSystemWatcher mWatcher;
   SeriesMapping mSeriesMapping;
   double mCurrentTimeFactor;  // from us
   QVector<AxisParam> mAxesParams{2};
+  bool mSharedReload = false;
   bool mIgnoreEvents = false;
 };
 
@@ -0,0 +1,94 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PLOTTER_HEATMAP_H
+#define PLOTTER_HEATMAP_H
+
+#include <QFileSystemWatcher>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QWidget>
+
+#include "benchmark_results.h"
+#include "plot_parameters.h"
+
+namespace Ui {
+class PlotterHeatmap;
+}
+class HeatmapView;
+
+class PlotterHeatmap : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit PlotterHeatmap(const BenchResults& bchResults, const QVector<int>& bchIdxs,
+                          const PlotParams& plotParams, const QString& filename,
+                          const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
+  ~PlotterHeatmap();
+
+  // Reload driven by owner (e.g. dashboard): own watcher and reload controls disabled
+  void setSharedReload();
+  // Update chart from reloaded results
+  void reloadResults(const BenchResults& newBchResults);
+
+ private:
+  // Benchmarks placed by Z-param (or name) row and X-param column
+  struct HeatmapGrid {
+    QString name;
+    QStringList rowLabels, colLabels;
+    QVector<int> cells;  // row-major benchmark indexes (-1 if missing)
+  };
+
+  void connectUI();
+  void setupOptions();
+  void loadConfig();
+  void saveConfig();
+
+  void loadGrids(const BenchResults& bchResults);
+  void updateGrid();
+  void updateTitles();
+
+ public slots:
+  void onComboGridChanged(int index);
+  void onComboGradientChanged(int index);
+  void onCheckLog(int state);
+  void onComboTimeUnitChanged(int index);
+  void onCellHovered(int row, int col);
+
+  void onCheckAutoReload(int state);
+  void onAutoReload(const QString& path);
+  void onReloadClicked();
+  void onSnapshotClicked();
+
+ private:
+  Ui::PlotterHeatmap* ui;
+  HeatmapView* mView = nullptr;
+
+  BenchResults mBchResults;
+  QVector<int> mBenchIdxs;
+  const PlotParams mPlotParams;
+  const QString mOrigFilename;
+  const QVector<FileReload> mAddFilenames;
+  const bool mAllIndexes;
+
+  QVector<HeatmapGrid> mGrids;
+  QFileSystemWatcher mWatcher;
+  double mCurrentTimeFactor;  // from us
+  bool mSharedReload = false;
+  bool mIgnoreEvents = false;
+};
+
+#endif  // PLOTTER_HEATMAP_H
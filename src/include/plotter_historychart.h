@@ -0,0 +1,107 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PLOTTER_HISTORYCHART_H
+#define PLOTTER_HISTORYCHART_H
+
+#include <vector>
+
+#include <QChartView>
+#include <QFileSystemWatcher>
+#include <QLineSeries>
+#include <QScatterSeries>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QWidget>
+
+#include "change_points.h"
+#include "history_store.h"
+#include "plot_parameters.h"
+
+namespace Ui {
+class PlotterHistoryChart;
+}
+struct BenchResults;
+struct FileReload;
+
+class PlotterHistoryChart : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit PlotterHistoryChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
+                               const PlotParams& plotParams, const QString& filename,
+                               const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
+  ~PlotterHistoryChart();
+
+ private:
+  // Benchmark history with its change points
+  struct HistorySeries {
+    QString name;
+    QVector<int> runIdxs;    // plotted runs, by date
+    QVector<double> values;  // same order (times in us)
+    ChangePointDetector detector;
+    QLineSeries* line = nullptr;
+    QScatterSeries* changes = nullptr;
+  };
+
+  void connectUI();
+  void setupChart();
+  void setupOptions();
+  void loadConfig();
+  void saveConfig();
+
+  void updateHistory(bool reset);
+  void updatePoints(HistorySeries& series);
+  void updateChangePoints(HistorySeries& series);
+  void updateAxes();
+  double getRunX(int runIdx) const;
+  QString getRunText(const HistorySeries& series, int pointIdx) const;
+  void showPointTip(const HistorySeries& series, const QPointF& point, bool isChange);
+
+ public slots:
+  void onComboThemeChanged(int index);
+  void onCheckLegendVisible(int state);
+  void onComboTimeUnitChanged(int index);
+  void onComboRunAxisChanged(int index);
+
+  void onCheckChangePoints(int state);
+  void onSpinThresholdChanged(double d);
+
+  void onRecordClicked();
+  void onCheckAutoReload(int state);
+  void onAutoReload(const QString& path);
+  void onReloadClicked();
+  void onSnapshotClicked();
+
+ private:
+  Ui::PlotterHistoryChart* ui;
+  QChartView* mChartView = nullptr;
+
+  const PlotParams mPlotParams;
+  const QString mOrigFilename;
+  const QVector<FileReload> mAddFilenames;
+  const QString mTimeUnit;  // of original results
+
+  HistoryStore mStore;  // read-only, reopened on reload
+  QVector<int> mRunOrder;
+  QVector<int> mRunPositions;  // run index -> position by date
+  std::vector<HistorySeries> mSeries;
+  QFileSystemWatcher mWatcher;
+  double mCurrentTimeFactor;  // from us
+  bool mIgnoreEvents = false;
+};
+
+#endif  // PLOTTER_HISTORYCHART_H
@@ -18,11 +18,15 @@
 
 #include <QChartView>
 #include <QFileSystemWatcher>
+#include <QHash>
 #include <QString>
 #include <QVector>
 #include <QWidget>
 
+#include "bench_statistics.h"
+#include "complexity_fit.h"
 #include "plot_parameters.h"
+#include "series_baseline.h"
 #include "series_dialog.h"
 
 namespace Ui {
@@ -33,6 +37,9 @@ class PlotterLineChart;
 // }
 struct BenchResults;
 struct FileReload;
+class ChartErrorBars;
+class ChartHover;
+class QLineSeries;
 
 class PlotterLineChart : public QWidget {
   Q_OBJECT
@@ -43,6 +50,11 @@ class PlotterLineChart : public QWidget {
                             const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
   ~PlotterLineChart();
 
+  // Reload driven by owner (e.g. dashboard): own watcher and reload controls disabled
+  void setSharedReload();
+  // Update chart from reloaded results
+  void reloadResults(const BenchResults& newBchResults);
+
  private:
   void connectUI();
   void setupChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
@@ -50,6 +62,14 @@ class PlotterLineChart : public QWidget {
   void setupOptions(bool init = true);
   void loadConfig(bool init);
   void saveConfig();
+  void updateErrorBars();
+  void updateComplexityFits();
+  void clearComplexityFits();
+  void updateHoverItems();
+  void updateBaselineChoices();
+  void updateSeriesValues(bool fitRange = true);
+  void fitYRange();
+  void reconcileSeries(const BenchResults& bchResults);
 
  public slots:
   void onComboThemeChanged(int index);
@@ -59,6 +79,11 @@ class PlotterLineChart : public QWidget {
   void onSpinLegendFontSizeChanged(int i);
   void onSeriesEditClicked();
   void onComboTimeUnitChanged(int index);
+  void onCheckErrorBars(int state);
+  void onComboBaselineChanged(int index);
+  void onPointHovered(int benchIdx);
+  void onComboComplexityChanged(int index);
+  void onEditComplexityFinished();
 
   void onComboAxisChanged(int index);
   void onCheckAxisVisible(int state);
@@ -97,6 +122,10 @@ class PlotterLineChart : public QWidget {
 
   Ui::PlotterLineChart* ui;
   QChartView* mChartView = nullptr;
+  ChartErrorBars* mErrorBars = nullptr;
+  ChartHover* mHover = nullptr;
+  QHash<int, ConfidenceInterval> mIntervals;  // error bars, also shown on hover
+  QVector<QLineSeries*> mFitSeries;  // complexity curves, after plotted series
 
   QVector<int> mBenchIdxs;
   const PlotParams mPlotParams;
@@ -104,10 +133,18 @@ class PlotterLineChart : public QWidget {
   const QVector<FileReload> mAddFilenames;
   const bool mAllIndexes;
 
+  BenchResults mBchResults;          // plotted results (shared data)
+  QVector<BenchSubset> mBchSubsets;  // plotted subsets, in series order
   QFileSystemWatcher mWatcher;
   SeriesMapping mSeriesMapping;
-  double mCurrentTimeFactor;  // from us
+  ComplexityExpression mCustomComplexity;
+  SeriesBaseline mBaseline;    // plotted values joined on X-param
+  QHash<int, double> mRatios;  // benchmark -> ratio to baseline (plotted points only)
+  QString mAbsoluteTitle;      // Y-axis title of plotted values
+  double mCurrentTimeFactor;   // from us
   QVector<ValAxisParam> mAxesParams{2};
+  bool mRelative = false;  // ratios to baseline plotted
+  bool mSharedReload = false;
   bool mIgnoreEvents = false;
 };
 
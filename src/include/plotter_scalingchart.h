@@ -0,0 +1,101 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PLOTTER_SCALINGCHART_H
+#define PLOTTER_SCALINGCHART_H
+
+#include <vector>
+
+#include <QChartView>
+#include <QFileSystemWatcher>
+#include <QLineSeries>
+#include <QString>
+#include <QVector>
+#include <QWidget>
+
+#include "plot_parameters.h"
+
+namespace Ui {
+class PlotterScalingChart;
+}
+struct BenchResults;
+struct FileReload;
+
+class PlotterScalingChart : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit PlotterScalingChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
+                               const PlotParams& plotParams, const QString& filename,
+                               const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
+  ~PlotterScalingChart();
+
+  // Reload driven by owner (e.g. dashboard): own watcher and reload controls disabled
+  void setSharedReload();
+  // Update chart from reloaded results
+  void reloadResults(const BenchResults& newBchResults);
+
+ private:
+  // Benchmark throughput per thread count
+  struct ScalingSeries {
+    QString name;
+    QVector<int> threads;         // ascending
+    QVector<double> throughputs;  // same order
+    QLineSeries* line = nullptr;
+    QLineSeries* ideal = nullptr;  // ideal scaling from lowest thread count
+  };
+
+  void connectUI();
+  void setupChart();
+  void setupOptions();
+  void loadConfig();
+  void saveConfig();
+
+  bool loadSeries(const BenchResults& bchResults, QString& errorMsg);
+  void updatePoints();
+  void updateAxes();
+  double getMetricValue(const ScalingSeries& series, int pointIdx) const;
+  double getIdealValue(const ScalingSeries& series, int threads) const;
+  void showPointTip(const ScalingSeries& series, const QPointF& point);
+
+ public slots:
+  void onComboThemeChanged(int index);
+  void onCheckLegendVisible(int state);
+  void onComboMetricChanged(int index);
+  void onCheckIdealLines(int state);
+  void onCheckLogThreads(int state);
+
+  void onCheckAutoReload(int state);
+  void onAutoReload(const QString& path);
+  void onReloadClicked();
+  void onSnapshotClicked();
+
+ private:
+  Ui::PlotterScalingChart* ui;
+  QChartView* mChartView = nullptr;
+
+  QVector<int> mBenchIdxs;
+  const PlotParams mPlotParams;
+  const QString mOrigFilename;
+  const QVector<FileReload> mAddFilenames;
+  const bool mAllIndexes;
+
+  std::vector<ScalingSeries> mSeries;
+  QFileSystemWatcher mWatcher;
+  bool mSharedReload = false;
+  bool mIgnoreEvents = false;
+};
+
+#endif  // PLOTTER_SCALINGCHART_H
@@ -0,0 +1,96 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PLOTTER_VIOLINCHART_H
+#define PLOTTER_VIOLINCHART_H
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QWidget>
+
+#include "bench_statistics.h"
+#include "benchmark_results.h"
+#include "plot_parameters.h"
+
+namespace Ui {
+class PlotterViolinChart;
+}
+class QChartView;
+class ChartHover;
+class ChartViolins;
+
+class PlotterViolinChart : public QWidget {
+  Q_OBJECT
+
+ public:
+  explicit PlotterViolinChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
+                              const PlotParams& plotParams, const QString& filename,
+                              const QVector<FileReload>& addFilenames, QWidget* parent = nullptr);
+  ~PlotterViolinChart();
+
+  // Reload driven by owner (e.g. dashboard): own watcher and reload controls disabled
+  void setSharedReload();
+  // Update chart from reloaded results
+  void reloadResults(const BenchResults& newBchResults);
+
+ private:
+  void connectUI();
+  void setupOptions();
+  void loadConfig();
+  void saveConfig();
+
+  void loadSubsets();
+  void loadDensities();
+  void updateChart();
+
+ public slots:
+  void onComboThemeChanged(int index);
+  void onCheckLegendVisible(int state);
+  void onComboMethodChanged(int index);
+  void onSpinBandwidthChanged(double d);
+  void onComboTimeUnitChanged(int index);
+  void onViolinHovered(int key);
+
+  void onCheckAutoReload(int state);
+  void onAutoReload(const QString& path);
+  void onReloadClicked();
+  void onSnapshotClicked();
+
+ private:
+  Ui::PlotterViolinChart* ui;
+  QChartView* mChartView = nullptr;
+  ChartViolins* mViolins = nullptr;
+  ChartHover* mHover = nullptr;
+  QHash<int, ConfidenceInterval> mIntervals;  // of hovered violins
+
+  BenchResults mBchResults;
+  QVector<int> mBenchIdxs;
+  const PlotParams mPlotParams;
+  const QString mOrigFilename;
+  const QVector<FileReload> mAddFilenames;
+  const bool mAllIndexes;
+
+  QVector<BenchSubset> mBchSubsets;     // one series per benchmark % X-param
+  QVector<int> mPlotIdxs;               // benchmarks of subsets, in order
+  QVector<DensityEstimate> mEstimates;  // per plotted benchmark (unit independent)
+  QFileSystemWatcher mWatcher;
+  double mCurrentTimeFactor;  // from us
+  bool mSharedReload = false;
+  bool mIgnoreEvents = false;
+};
+
+#endif  // PLOTTER_VIOLINCHART_H
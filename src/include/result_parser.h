@@ -18,9 +18,31 @@
 
 #include "benchmark_results.h"
 
+class QIODevice;
+
 class ResultParser {
  public:
+  // Google benchmark output formats
+  enum ResultFormat { UnknownFormat, JsonFormat, CsvFormat, ConsoleFormat };
+
+  // Parse results file in any supported format (auto-detected)
+  static BenchResults parseResultsFile(const QString& filename, QString& errorMsg);
+
   static BenchResults parseJsonFile(const QString& filename, QString& errorMsg);
+  static BenchResults parseCsvFile(const QString& filename, QString& errorMsg);
+  static BenchResults parseConsoleFile(const QString& filename, QString& errorMsg);
+
+  // Detect format from the beginning of device content (does not consume it)
+  static ResultFormat detectFormat(QIODevice& device);
+
+  // Outlier filter of repetitions applied to parsed results (none by default)
+  static void setOutlierFilter(const OutlierFilter& filter);
+  static const OutlierFilter& outlierFilter();
+
+ private:
+  static BenchResults parseJson(QIODevice& device, QString& errorMsg);
+  static BenchResults parseCsv(QIODevice& device, QString& errorMsg);
+  static BenchResults parseConsole(QIODevice& device, QString& errorMsg);
 };
 
 #endif  // RESULTPARSER_H
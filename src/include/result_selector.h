@@ -17,17 +17,20 @@
 #define RESULT_SELECTOR_H
 
 #include <QFileSystemWatcher>
-#include <QSet>
+#include <QPointer>
 #include <QString>
 #include <QVector>
 #include <QWidget>
 
+#include "bench_search.h"
 #include "benchmark_results.h"
+#include "plot_parameters.h"
 
 namespace Ui {
 class ResultSelector;
 }
-class QTreeWidgetItem;
+class BenchTreeModel;
+class DashboardWindow;
 
 class ResultSelector : public QWidget {
   Q_OBJECT
@@ -44,10 +47,13 @@ class ResultSelector : public QWidget {
   void loadConfig();
   void saveConfig();
   void updateComboBoxY();
-  void updateResults(bool clear, const QSet<QString> unselected = {});
+  void updateResults(bool clear, bool keepState = false);
+  void applyFilter(bool expand = true);
+  PlotParams getPlotParams() const;
 
  public slots:
-  void onItemChanged(QTreeWidgetItem* item, int column);
+  void onItemsChanged();
+  void onFilterChanged();
 
   void onComboTypeChanged(int index);
   void onComboXChanged(int index);
@@ -58,17 +64,24 @@ class ResultSelector : public QWidget {
   void onCheckAutoReload(int state);
   void onReloadClicked();
 
+  void onComboOutliersChanged(int index);
+  void onSpinOutliersChanged(double factor);
+
   void onNewClicked();
   void onAppendClicked();
   void onOverwriteClicked();
+  void onCompareClicked();
 
   void onSelectAllClicked();
   void onSelectNoneClicked();
 
   void onPlotClicked();
+  void onDashboardClicked();
 
  private:
   Ui::ResultSelector* ui;
+  BenchTreeModel* mTreeModel;
+  BenchSearchIndex mSearchIndex;
 
   BenchResults mBchResults;
   QString mOrigFilename;
@@ -76,6 +89,7 @@ class ResultSelector : public QWidget {
 
   QString mWorkingDir;
   QFileSystemWatcher mWatcher;
+  QPointer<DashboardWindow> mDashboard;  // of current results files
 };
 
 #endif  // RESULT_SELECTOR_H
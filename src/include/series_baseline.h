@@ -0,0 +1,59 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SERIES_BASELINE_H
+#define SERIES_BASELINE_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "benchmark_results.h"
+#include "plot_parameters.h"
+
+// Reference of normalized series
+enum BaselineKind { BaselineNone, BaselineSeries, BaselineContainer };
+
+//
+// Y-values of plotted series joined on X-parameter names (hash join, once per series update), so
+// that ratios to any reference are divisions of aligned values
+class SeriesBaseline {
+ public:
+  // Values of subsets benchmarks, one series per subset
+  void build(const BenchResults& bchResults, const QVector<BenchSubset>& subsets,
+             const PlotParams& plotParams);
+
+  // Containers of JOMT series (empty if none)
+  const QStringList& containers() const { return mContainers; }
+
+  // Reference series of each series (-1 if none): series at index for all, or series with same
+  // family and parameters in container at index
+  QVector<int> getReferences(BaselineKind kind, int refIdx) const;
+
+  // Ratios of series points to reference points at same X (NaN if missing or not positive)
+  QVector<double> getRatios(int seriesIdx, int refSeriesIdx) const;
+
+ private:
+  qsizetype mKeyCount = 0;
+  QVector<QVector<int>> mPointKeys;  // per series, X-key of each point
+  QVector<double> mValues;           // series-major, per X-key (NaN if missing)
+
+  QStringList mContainers;
+  QVector<QString> mFamilyKeys;       // per series, name without container (null if not JOMT)
+  QHash<QString, int> mFamilySeries;  // family key and container index -> series
+};
+
+#endif  // SERIES_BASELINE_H
@@ -18,7 +18,9 @@
 #include <QDir>
 #include <QIcon>
 #include <QScopedPointer>
+#include <QSettings>
 
+#include "bench_statistics.h"
 #include "benchmark_results.h"
 #include "commandline_handler.h"
 #include "plot_parameters.h"
@@ -35,12 +37,27 @@
 
 int main(int argc, char* argv[]) {
   // Init
-  QApplication app(argc, argv);
   QCoreApplication::setOrganizationName(APP_NAME);
   QCoreApplication::setApplicationName(APP_NAME);
   QCoreApplication::setApplicationVersion(APP_VER);
+
+  // Headless commands (no GUI application, for CI runners)
+  if (CommandLineHandler::isHeadlessCommand(argc, argv)) {
+    QCoreApplication app(argc, argv);
+    return CommandLineHandler::processHeadless(app);
+  }
+
+  QApplication app(argc, argv);
   QApplication::setWindowIcon(QIcon(APP_ICON));
 
+  // Outlier filter preference, applied to all parsed results
+  {
+    QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+    OutlierFilter filter;
+    if (parseOutlierFilter(settings.value("selector/outliers").toString(), filter))
+      ResultParser::setOutlierFilter(filter);
+  }
+
   //
   // Command line options
   CommandLineHandler cmdHandler;
@@ -54,7 +71,7 @@ int main(int argc, char* argv[]) {
       QDir jmtDir(DEFAULT_DIR);
 
       QString errorMsg;
-      BenchResults bchResults = ResultParser::parseJsonFile(jmtDir.filePath(fileName), errorMsg);
+      BenchResults bchResults = ResultParser::parseResultsFile(jmtDir.filePath(fileName), errorMsg);
 
       if (bchResults.benchmarks.isEmpty()) {
         qCritical() << "Error parsing file: " << fileName << " -> " << errorMsg;
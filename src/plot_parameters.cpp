@@ -17,6 +17,13 @@
 
 #include <algorithm>
 
+#include "bench_statistics.h"
+
+// Aggregate without outliers if results were filtered, raw one otherwise
+static double filteredOr(const BenchFiltered& filtered, double filteredValue, double rawValue) {
+  return (filtered.mean >= 0.) ? filteredValue : rawValue;
+}
+
 double getYPlotValue(const BenchData& bchData, PlotValueType yType) {
   switch (yType) {
     // CPU time
@@ -24,19 +31,19 @@ double getYPlotValue(const BenchData& bchData, PlotValueType yType) {
       return bchData.cpu_time_us;
     }
     case CpuTimeMinType: {
-      return bchData.min_cpu;
+      return filteredOr(bchData.cpu_filtered, bchData.cpu_filtered.min, bchData.min_cpu);
     }
     case CpuTimeMeanType: {
-      return bchData.mean_cpu;
+      return filteredOr(bchData.cpu_filtered, bchData.cpu_filtered.mean, bchData.mean_cpu);
     }
     case CpuTimeMedianType: {
-      return bchData.median_cpu;
+      return filteredOr(bchData.cpu_filtered, bchData.cpu_filtered.median, bchData.median_cpu);
     }
     case CpuTimeStddevType: {
-      return bchData.stddev_cpu;
+      return filteredOr(bchData.cpu_filtered, bchData.cpu_filtered.stddev, bchData.stddev_cpu);
     }
     case CpuTimeCvType: {
-      return bchData.cv_cpu;
+      return filteredOr(bchData.cpu_filtered, bchData.cpu_filtered.cv, bchData.cv_cpu);
     }
 
     // Real time
@@ -44,19 +51,19 @@ double getYPlotValue(const BenchData& bchData, PlotValueType yType) {
       return bchData.real_time_us;
     }
     case RealTimeMinType: {
-      return bchData.min_real;
+      return filteredOr(bchData.real_filtered, bchData.real_filtered.min, bchData.min_real);
     }
     case RealTimeMeanType: {
-      return bchData.mean_real;
+      return filteredOr(bchData.real_filtered, bchData.real_filtered.mean, bchData.mean_real);
     }
     case RealTimeMedianType: {
-      return bchData.median_real;
+      return filteredOr(bchData.real_filtered, bchData.real_filtered.median, bchData.median_real);
     }
     case RealTimeStddevType: {
-      return bchData.stddev_real;
+      return filteredOr(bchData.real_filtered, bchData.real_filtered.stddev, bchData.stddev_real);
     }
     case RealTimeCvType: {
-      return bchData.cv_real;
+      return filteredOr(bchData.real_filtered, bchData.real_filtered.cv, bchData.cv_real);
     }
 
     // Iterations
@@ -69,19 +76,21 @@ double getYPlotValue(const BenchData& bchData, PlotValueType yType) {
       return bchData.kbytes_sec_dflt;
     }
     case BytesMinType: {
-      return bchData.min_kbytes;
+      return filteredOr(bchData.kbytes_filtered, bchData.kbytes_filtered.min, bchData.min_kbytes);
     }
     case BytesMeanType: {
-      return bchData.mean_kbytes;
+      return filteredOr(bchData.kbytes_filtered, bchData.kbytes_filtered.mean, bchData.mean_kbytes);
     }
     case BytesMedianType: {
-      return bchData.median_kbytes;
+      return filteredOr(bchData.kbytes_filtered, bchData.kbytes_filtered.median,
+                        bchData.median_kbytes);
     }
     case BytesStddevType: {
-      return bchData.stddev_kbytes;
+      return filteredOr(bchData.kbytes_filtered, bchData.kbytes_filtered.stddev,
+                        bchData.stddev_kbytes);
     }
     case BytesCvType: {
-      return bchData.cv_kbytes;
+      return filteredOr(bchData.kbytes_filtered, bchData.kbytes_filtered.cv, bchData.cv_kbytes);
     }
 
     // Items/s
@@ -89,19 +98,21 @@ double getYPlotValue(const BenchData& bchData, PlotValueType yType) {
       return bchData.kitems_sec_dflt;
     }
     case ItemsMinType: {
-      return bchData.min_kitems;
+      return filteredOr(bchData.kitems_filtered, bchData.kitems_filtered.min, bchData.min_kitems);
     }
     case ItemsMeanType: {
-      return bchData.mean_kitems;
+      return filteredOr(bchData.kitems_filtered, bchData.kitems_filtered.mean, bchData.mean_kitems);
     }
     case ItemsMedianType: {
-      return bchData.median_kitems;
+      return filteredOr(bchData.kitems_filtered, bchData.kitems_filtered.median,
+                        bchData.median_kitems);
     }
     case ItemsStddevType: {
-      return bchData.stddev_kitems;
+      return filteredOr(bchData.kitems_filtered, bchData.kitems_filtered.stddev,
+                        bchData.stddev_kitems);
     }
     case ItemsCvType: {
-      return bchData.cv_kitems;
+      return filteredOr(bchData.kitems_filtered, bchData.kitems_filtered.cv, bchData.cv_kitems);
     }
   }
 
@@ -203,12 +214,7 @@ QString getYPlotName(PlotValueType yType, QString timeUnit) {
 }
 
 double normalizeTimeUs(const BenchData& bchData, double value) {
-  double timeFactor = 1.;
-  if (bchData.time_unit == "ns")
-    timeFactor = 0.001;
-  else if (bchData.time_unit == "ms")
-    timeFactor = 1000.;
-  return value * timeFactor;
+  return value * BenchResults::getTimeFactorUs(bchData.time_unit);
 }
 
 bool isYTimeBased(PlotValueType yType) {
@@ -222,21 +228,7 @@ bool isYTimeBased(PlotValueType yType) {
   return true;
 }
 
-double findMedian(QVector<double> sorted, int begin, int end) {
-  int count = end - begin;
-  if (count <= 0)
-    return 0.;
-
-  if (count % 2) {
-    return sorted.at(count / 2 + begin);
-  } else {
-    qreal right = sorted.at(count / 2 + begin);
-    qreal left = sorted.at(count / 2 - 1 + begin);
-    return (right + left) / 2.0;
-  }
-}
-
-BenchYStats getYPlotStats(BenchData& bchData, PlotValueType yType) {
+BenchYStats getYPlotStats(const BenchData& bchData, PlotValueType yType) {
   BenchYStats statRes;
 
   // No statistics
@@ -260,12 +252,8 @@ BenchYStats getYPlotStats(BenchData& bchData, PlotValueType yType) {
       statRes.min = bchData.min_cpu;
       statRes.max = bchData.max_cpu;
       statRes.median = bchData.median_cpu;
-
-      std::sort(bchData.cpu_time.begin(), bchData.cpu_time.end());
-      int count = bchData.cpu_time.count();
-      statRes.lowQuart = normalizeTimeUs(bchData, findMedian(bchData.cpu_time, 0, count / 2));
-      statRes.uppQuart =
-          normalizeTimeUs(bchData, findMedian(bchData.cpu_time, count / 2 + (count % 2), count));
+      statRes.lowQuart = bchData.cpu_stats.lowQuart;
+      statRes.uppQuart = bchData.cpu_stats.uppQuart;
 
       break;
     }
@@ -278,12 +266,8 @@ BenchYStats getYPlotStats(BenchData& bchData, PlotValueType yType) {
       statRes.min = bchData.min_real;
       statRes.max = bchData.max_real;
       statRes.median = bchData.median_real;
-
-      std::sort(bchData.real_time.begin(), bchData.real_time.end());
-      int count = bchData.real_time.count();
-      statRes.lowQuart = normalizeTimeUs(bchData, findMedian(bchData.real_time, 0, count / 2));
-      statRes.uppQuart =
-          normalizeTimeUs(bchData, findMedian(bchData.real_time, count / 2 + (count % 2), count));
+      statRes.lowQuart = bchData.real_stats.lowQuart;
+      statRes.uppQuart = bchData.real_stats.uppQuart;
 
       break;
     }
@@ -296,11 +280,8 @@ BenchYStats getYPlotStats(BenchData& bchData, PlotValueType yType) {
       statRes.min = bchData.min_kbytes;
       statRes.max = bchData.max_kbytes;
       statRes.median = bchData.median_kbytes;
-
-      std::sort(bchData.kbytes_sec.begin(), bchData.kbytes_sec.end());
-      int count = bchData.kbytes_sec.count();
-      statRes.lowQuart = findMedian(bchData.kbytes_sec, 0, count / 2);
-      statRes.uppQuart = findMedian(bchData.kbytes_sec, count / 2 + (count % 2), count);
+      statRes.lowQuart = bchData.kbytes_stats.lowQuart;
+      statRes.uppQuart = bchData.kbytes_stats.uppQuart;
 
       break;
     }
@@ -313,11 +294,8 @@ BenchYStats getYPlotStats(BenchData& bchData, PlotValueType yType) {
       statRes.min = bchData.min_kitems;
       statRes.max = bchData.max_kitems;
       statRes.median = bchData.median_kitems;
-
-      std::sort(bchData.kitems_sec.begin(), bchData.kitems_sec.end());
-      int count = bchData.kitems_sec.count();
-      statRes.lowQuart = findMedian(bchData.kitems_sec, 0, count / 2);
-      statRes.uppQuart = findMedian(bchData.kitems_sec, count / 2 + (count % 2), count);
+      statRes.lowQuart = bchData.kitems_stats.lowQuart;
+      statRes.uppQuart = bchData.kitems_stats.uppQuart;
 
       break;
     }
@@ -333,6 +311,17 @@ BenchYStats getYPlotStats(BenchData& bchData, PlotValueType yType) {
     }
   }
 
+  // Box and whiskers of kept samples only, outliers apart
+  const BenchFiltered* filtered = getYPlotFiltered(bchData, yType);
+  if (filtered != nullptr) {
+    statRes.min = filtered->min;
+    statRes.max = filtered->max;
+    statRes.median = filtered->median;
+    statRes.lowQuart = filtered->lowQuart;
+    statRes.uppQuart = filtered->uppQuart;
+    statRes.outliers = filtered->outliers;
+  }
+
   return statRes;
 }
 
@@ -1132,7 +1132,7 @@ void Plotter3DBars::onAutoReload(const QString& path) {
 void Plotter3DBars::onReloadClicked() {
   // Load new results
   QString errorMsg;
-  BenchResults newBchResults = ResultParser::parseJsonFile(mOrigFilename, errorMsg);
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
 
   if (newBchResults.benchmarks.isEmpty()) {
     QMessageBox::critical(this, "Chart reload",
@@ -1142,7 +1142,7 @@ void Plotter3DBars::onReloadClicked() {
 
   for (const auto& addFile : std::as_const(mAddFilenames)) {
     errorMsg.clear();
-    BenchResults newAddResults = ResultParser::parseJsonFile(addFile.filename, errorMsg);
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
     if (newAddResults.benchmarks.isEmpty()) {
       QMessageBox::critical(
           this, "Chart reload",
@@ -1159,12 +1159,10 @@ void Plotter3DBars::onReloadClicked() {
   // Check compatibility with previous
   errorMsg.clear();
   if (mBenchIdxs.size() != newBchResults.benchmarks.size()) {
-    errorMsg = "Number of series/points is different";
-    if (mAllIndexes) {
-      mBenchIdxs.clear();
-      for (int i = 0; i < newBchResults.benchmarks.size(); ++i)
-        mBenchIdxs.append(i);
-    }
+    if (mAllIndexes)
+      mBenchIdxs = newBchResults.segmentAll();  // membership checked below
+    else
+      errorMsg = "Number of series/points is different";
   }
 
   while (errorMsg.isEmpty())  // once
@@ -1179,48 +1177,41 @@ void Plotter3DBars::onReloadClicked() {
         break;
       }
       const auto oldSeries = oldBarsSeries[0];
-      const auto oldDataProxy = oldSeries->dataProxy();
 
+      // Whole array and labels reset at once (rows added or removed as well)
       QVector<BenchSubset> newBchSubsets = newBchResults.groupParam(
           mPlotParams.xType == PlotArgumentType, mBenchIdxs, mPlotParams.xIdx, "X");
-      if (newBchSubsets.size() != oldDataProxy->rowCount()) {
-        errorMsg = "Number of single series rows is different";
-        break;
-      }
-
-      int newRowsIdx = 0;
+      QScopedPointer<QBarDataArray> dataArray(new QBarDataArray);
+      dataArray->reserve(newBchSubsets.size());
+      QStringList rowLabels, prevColLabels;
+      bool firstCol = true;
       for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-        const auto& oldRowLabel = oldDataProxy->rowLabels().at(newRowsIdx);
-        const QString& subsetName = bchSubset.name;
-        if (subsetName != oldRowLabel) {
-          errorMsg = "Series row has different name";
-          break;
-        }
-        const auto& oldRow = oldDataProxy->rowAt(newRowsIdx);
-        if (bchSubset.idxs.size() != oldRow->size()) {
-          errorMsg = "Number of series columns is different";
-          break;
-        }
-        ++newRowsIdx;
-      }
+        QScopedPointer<QBarDataRow> data(new QBarDataRow);
+        data->reserve(bchSubset.idxs.size());
 
-      // Direct update if compatible
-      if (errorMsg.isEmpty()) {
-        newRowsIdx = 0;
-        for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-          int newColsIdx = 0;
-          for (int idx : bchSubset.idxs) {
-            // Update item
-            oldDataProxy->setItem(
-                newRowsIdx, newColsIdx,
-                QBarDataItem(static_cast<float>(
-                    getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
-                    mCurrentTimeFactor)));
-            ++newColsIdx;
-          }
-          ++newRowsIdx;
+        QStringList colLabels;
+        for (int idx : bchSubset.idxs) {
+          colLabels.append(newBchResults.getParamName(mPlotParams.xType == PlotArgumentType, idx,
+                                                      mPlotParams.xIdx));
+          data->append(static_cast<float>(
+              getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
+              mCurrentTimeFactor));
         }
+        dataArray->append(data.take());
+        rowLabels.append(bchSubset.name);
+
+        // Set column labels (only if no collision, empty otherwise)
+        if (firstCol)  // init
+          prevColLabels = colLabels;
+        else if (commonPartEqual(prevColLabels, colLabels)) {
+          if (prevColLabels.size() < colLabels.size())  // replace by longest
+            prevColLabels = colLabels;
+        } else {  // collision
+          prevColLabels = QStringList("");
+        }
+        firstCol = false;
       }
+      oldSeries->dataProxy()->resetArray(dataArray.take(), rowLabels, prevColLabels);
     } else {
       // Check compatibility with previous
       const auto& oldBarsSeries = mBars->seriesList();
@@ -1289,7 +1280,10 @@ void Plotter3DBars::onReloadClicked() {
           const auto& oldDataProxy = oldSeries->dataProxy();
           QVector<BenchSubset> newBchZSubs = newBchResults.segmentParam(
               mPlotParams.zType == PlotArgumentType, bchName.idxs, mPlotParams.zIdx);
-          int newRowsIdx = 0;
+
+          // Whole series array reset at once (labels kept)
+          QScopedPointer<QBarDataArray> dataArray(new QBarDataArray);
+          dataArray->reserve(newBchZSubs.size());
           for (const auto& bchZSub : std::as_const(newBchZSubs)) {
             QVector<BenchSubset> newBchSubsets = newBchResults.groupParam(
                 mPlotParams.xType == PlotArgumentType, bchZSub.idxs, mPlotParams.xIdx, "X");
@@ -1297,18 +1291,16 @@ void Plotter3DBars::onReloadClicked() {
               break;
             const auto& bchSubset = newBchSubsets[0];
 
-            int newColsIdx = 0;
+            QScopedPointer<QBarDataRow> data(new QBarDataRow);
+            data->reserve(bchSubset.idxs.size());
             for (int idx : bchSubset.idxs) {
-              // Update item
-              oldDataProxy->setItem(
-                  newRowsIdx, newColsIdx,
-                  QBarDataItem(static_cast<float>(
-                      getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
-                      mCurrentTimeFactor)));
-              ++newColsIdx;
+              data->append(static_cast<float>(
+                  getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
+                  mCurrentTimeFactor));
             }
-            ++newRowsIdx;
+            dataArray->append(data.take());
           }
+          oldDataProxy->resetArray(dataArray.take());
           ++newSeriesIdx;
         }
       }
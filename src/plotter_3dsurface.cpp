@@ -232,9 +232,9 @@ void Plotter3DSurface::setupChart(const BenchResults& bchResults, const QVector<
         int index = 0;
         double xFallback = 0.;
         for (int idx : bchSubset.idxs) {
-          QString xName =
-              bchResults.getParamName(plotParams.xType == PlotArgumentType, idx, plotParams.xIdx);
-          double xVal = BenchResults::getParamValue(xName, custXName, custXAxis, xFallback);
+          const BenchParam& xParam =
+              bchResults.getParam(plotParams.xType == PlotArgumentType, idx, plotParams.xIdx);
+          double xVal = BenchResults::getParamValue(xParam, custXName, custXAxis, xFallback);
 
           // Y val
           double yVal =
@@ -311,10 +311,10 @@ void Plotter3DSurface::setupChart(const BenchResults& bchResults, const QVector<
       QScopedPointer<QSurfaceDataArray> dataArray(new QSurfaceDataArray);
       double zFallback = 0.;
       for (const auto& bchZSub : std::as_const(bchZSubs)) {
-        QString zName = bchZSub.name;
         //                qDebug() << "bchZSub" << bchZSub.name << "|" << bchZSub.idxs;
-
-        double zVal = BenchResults::getParamValue(zName, custZName, custZAxis, zFallback);
+        const BenchParam& zParam = bchResults.getParam(plotParams.zType == PlotArgumentType,
+                                                       bchZSub.idxs.front(), plotParams.zIdx);
+        double zVal = BenchResults::getParamValue(zParam, custZName, custZAxis, zFallback);
 
         // One row per Z-param from 2D-names
         QScopedPointer<QSurfaceDataRow> newRow(new QSurfaceDataRow(bchZSub.idxs.size()));
@@ -327,9 +327,9 @@ void Plotter3DSurface::setupChart(const BenchResults& bchResults, const QVector<
           int index = 0;
           double xFallback = 0.;
           for (int idx : bchSubset.idxs) {
-            QString xName =
-                bchResults.getParamName(plotParams.xType == PlotArgumentType, idx, plotParams.xIdx);
-            double xVal = BenchResults::getParamValue(xName, custXName, custXAxis, xFallback);
+            const BenchParam& xParam =
+                bchResults.getParam(plotParams.xType == PlotArgumentType, idx, plotParams.xIdx);
+            double xVal = BenchResults::getParamValue(xParam, custXName, custXAxis, xFallback);
 
             // Y val
             double yVal =
@@ -1150,7 +1150,7 @@ void Plotter3DSurface::onAutoReload(const QString& path) {
 void Plotter3DSurface::onReloadClicked() {
   // Load new results
   QString errorMsg;
-  BenchResults newBchResults = ResultParser::parseJsonFile(mOrigFilename, errorMsg);
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
 
   if (newBchResults.benchmarks.isEmpty()) {
     QMessageBox::critical(this, "Chart reload",
@@ -1160,7 +1160,7 @@ void Plotter3DSurface::onReloadClicked() {
 
   for (const auto& addFile : std::as_const(mAddFilenames)) {
     errorMsg.clear();
-    BenchResults newAddResults = ResultParser::parseJsonFile(addFile.filename, errorMsg);
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
     if (newAddResults.benchmarks.isEmpty()) {
       QMessageBox::critical(
           this, "Chart reload",
@@ -1177,12 +1177,10 @@ void Plotter3DSurface::onReloadClicked() {
   // Check compatibility with previous
   errorMsg.clear();
   if (mBenchIdxs.size() != newBchResults.benchmarks.size()) {
-    errorMsg = "Number of series/points is different";
-    if (mAllIndexes) {
-      mBenchIdxs.clear();
-      for (int i = 0; i < newBchResults.benchmarks.size(); ++i)
-        mBenchIdxs.append(i);
-    }
+    if (mAllIndexes)
+      mBenchIdxs = newBchResults.segmentAll();
+    if (!mAllIndexes || mPlotParams.zType != PlotEmptyType)  // single series reset otherwise
+      errorMsg = "Number of series/points is different";
   }
 
   while (errorMsg.isEmpty())  // once
@@ -1197,8 +1195,6 @@ void Plotter3DSurface::onReloadClicked() {
         break;
       }
       const auto& oldSeries = oldSurfaceSeries[0];
-      const auto& oldDataProxy = oldSeries->dataProxy();
-      const auto& oldDataArray = oldDataProxy->array();
 
       QVector<BenchSubset> newBchSubsets = newBchResults.groupParam(
           mPlotParams.xType == PlotArgumentType, mBenchIdxs, mPlotParams.xIdx, "X");
@@ -1221,56 +1217,30 @@ void Plotter3DSurface::onReloadClicked() {
         errorMsg = "Not enough X-values to trace surface for: " + culpritName;
         break;
       }
-      // Check rows
-      if (newBchSubsets.size() != oldDataProxy->rowCount()) {
-        errorMsg = "Number of single series rows is different";
-        break;
-      }
+      // Whole array reset at once (rows added or removed as well)
+      bool custXAxis = true;
+      QString custXName;
+      double zFallback = 0.;
 
-      int prevRowSize = 0;
-      int newRowsIdx = 0;
+      QScopedPointer<QSurfaceDataArray> dataArray(new QSurfaceDataArray);
+      dataArray->reserve(newBchSubsets.size());
       for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-        // Check inter benchmark consistency
-        if (prevRowSize > 0 && prevRowSize != bchSubset.idxs.size()) {
-          errorMsg = "Inconsistent number of X-values between benchmarks to trace surface";
-          break;
-        }
-        prevRowSize = bchSubset.idxs.size();
-
-        const auto& oldRow = oldDataArray->at(newRowsIdx);
-        if (bchSubset.idxs.size() != oldRow->size()) {
-          errorMsg = "Number of series columns is different";
-          break;
-        }
-        ++newRowsIdx;
-      }
-
-      // Direct update if compatible
-      if (errorMsg.isEmpty()) {
-        bool custXAxis = true;
-        QString custXName;
-        double zFallback = 0.;
+        QScopedPointer<QSurfaceDataRow> newRow(new QSurfaceDataRow(bchSubset.idxs.size()));
+        int index = 0;
+        double xFallback = 0.;
+        for (int idx : bchSubset.idxs) {
+          const BenchParam& xParam = newBchResults.getParam(mPlotParams.xType == PlotArgumentType,
+                                                            idx, mPlotParams.xIdx);
+          double xVal = BenchResults::getParamValue(xParam, custXName, custXAxis, xFallback);
+          double yVal = getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
+                        mCurrentTimeFactor;
 
-        newRowsIdx = 0;
-        for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-          double xFallback = 0.;
-          int newColsIdx = 0;
-          for (int idx : bchSubset.idxs) {
-            // Update item
-            QString xName = newBchResults.getParamName(mPlotParams.xType == PlotArgumentType, idx,
-                                                       mPlotParams.xIdx);
-            double xVal = BenchResults::getParamValue(xName, custXName, custXAxis, xFallback);
-            double yVal = getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
-                          mCurrentTimeFactor;
-
-            oldDataProxy->setItem(newRowsIdx, newColsIdx,
-                                  QSurfaceDataItem(QVector3D(xVal, yVal, zFallback)));
-            ++newColsIdx;
-          }
-          ++zFallback;
-          ++newRowsIdx;
+          (*newRow)[index++].setPosition(QVector3D(xVal, yVal, zFallback));
         }
+        dataArray->append(newRow.take());
+        ++zFallback;
       }
+      oldSeries->dataProxy()->resetArray(dataArray.take());
     } else {
       // Check compatibility with previous
       const auto& oldSurfaceSeries = mSurface->seriesList();
@@ -1370,35 +1340,36 @@ void Plotter3DSurface::onReloadClicked() {
             continue;
 
           const auto& oldSeries = oldSurfaceSeries.at(newSeriesIdx);
-          const auto& oldDataProxy = oldSeries->dataProxy();
 
+          // Whole series array reset at once
+          QScopedPointer<QSurfaceDataArray> dataArray(new QSurfaceDataArray);
+          dataArray->reserve(newBchZSubs.size());
           double zFallback = 0.;
-          int newRowsIdx = 0;
           for (const auto& bchZSub : std::as_const(newBchZSubs)) {
-            const QString zName = bchZSub.name;
-            double zVal = BenchResults::getParamValue(zName, custZName, custZAxis, zFallback);
+            const BenchParam& zParam = newBchResults.getParam(
+                mPlotParams.zType == PlotArgumentType, bchZSub.idxs.front(), mPlotParams.zIdx);
+            double zVal = BenchResults::getParamValue(zParam, custZName, custZAxis, zFallback);
 
             QVector<BenchSubset> newBchSubsets = newBchResults.groupParam(
                 mPlotParams.xType == PlotArgumentType, bchZSub.idxs, mPlotParams.xIdx, "X");
             Q_ASSERT(newBchSubsets.size() == 1);
             const auto& bchSubset = newBchSubsets[0];
 
+            QScopedPointer<QSurfaceDataRow> newRow(new QSurfaceDataRow(bchSubset.idxs.size()));
+            int index = 0;
             double xFallback = 0.;
-            int newColsIdx = 0;
             for (int idx : bchSubset.idxs) {
-              // Update item
-              QString xName = newBchResults.getParamName(mPlotParams.xType == PlotArgumentType, idx,
-                                                         mPlotParams.xIdx);
-              double xVal = BenchResults::getParamValue(xName, custXName, custXAxis, xFallback);
+              const BenchParam& xParam = newBchResults.getParam(
+                  mPlotParams.xType == PlotArgumentType, idx, mPlotParams.xIdx);
+              double xVal = BenchResults::getParamValue(xParam, custXName, custXAxis, xFallback);
               double yVal = getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
                             mCurrentTimeFactor;
 
-              oldDataProxy->setItem(newRowsIdx, newColsIdx,
-                                    QSurfaceDataItem(QVector3D(xVal, yVal, zVal)));
-              ++newColsIdx;
+              (*newRow)[index++].setPosition(QVector3D(xVal, yVal, zVal));
             }
-            ++newRowsIdx;
+            dataArray->append(newRow.take());
           }
+          oldSeries->dataProxy()->resetArray(dataArray.take());
           ++newSeriesIdx;
         }
       }
@@ -15,13 +15,21 @@
 
 #include "plotter_barchart.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <QDateTime>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QToolTip>
 #include <QtCharts>
 
+#include "bench_statistics.h"
 #include "benchmark_results.h"
+#include "chart_error_bars.h"
+#include "chart_hover.h"
 #include "result_parser.h"
 #include "ui_plotter_barchart.h"
 
@@ -104,6 +112,14 @@ void PlotterBarChart::connectUI() {
             &PlotterBarChart::onComboTimeUnitChanged);
   }
 
+  if (getYPlotStatistic(mPlotParams.yType) == BootstrapNone)
+    ui->checkBoxErrorBars->setEnabled(false);
+  else
+    connect(ui->checkBoxErrorBars, &QCheckBox::stateChanged, this,
+            &PlotterBarChart::onCheckErrorBars);
+  connect(ui->comboBoxBaseline, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterBarChart::onComboBaselineChanged);
+
   // Axes
   ui->comboBoxAxis->addItem("X-Axis");
   ui->comboBoxAxis->addItem("Y-Axis");
@@ -167,6 +183,8 @@ void PlotterBarChart::setupChart(const BenchResults& bchResults, const QVector<i
   } else {  // Re-init
     chart = mChartView->chart();
     chart->setTitle("");
+    mErrorBars->clear();
+    mHover->clear();
     chart->removeAllSeries();
     const auto xAxes = chart->axes(Qt::Horizontal);
     if (!xAxes.empty())
@@ -175,8 +193,10 @@ void PlotterBarChart::setupChart(const BenchResults& bchResults, const QVector<i
     if (!yAxes.empty())
       chart->removeAxis(yAxes.constFirst());
     mSeriesMapping.clear();
+    mBchSubsets.clear();
   }
   Q_ASSERT(chart);
+  mBchResults = bchResults;
 
   // Time unit
   mCurrentTimeFactor = 1.;
@@ -222,6 +242,7 @@ void PlotterBarChart::setupChart(const BenchResults& bchResults, const QVector<i
     // X-row
     QScopedPointer<QBarSet> barSet(new QBarSet(subsetName.toHtmlEscaped()));
     mSeriesMapping.push_back({subsetName, subsetName});  // color set later
+    mBchSubsets.push_back(bchSubset);
 
     QStringList colLabels;
     for (int idx : bchSubset.idxs) {
@@ -276,10 +297,19 @@ void PlotterBarChart::setupChart(const BenchResults& bchResults, const QVector<i
     chart->setTitle("No compatible series to display");
 
   if (init) {
+    // Error bars drawn over series
+    mErrorBars = new ChartErrorBars(chart);
+
     // View
     mChartView = new QChartView(scopedChart.take(), this);
     mChartView->setRenderHint(QPainter::Antialiasing);
+
+    // Bars tooltips
+    mHover = new ChartHover(mChartView);
+    connect(mHover, &ChartHover::hovered, this, &PlotterBarChart::onBarHovered);
   }
+  updateHoverItems();
+  updateBaselineChoices();
 }
 
 void PlotterBarChart::setupOptions(bool init) {
@@ -371,6 +401,7 @@ void PlotterBarChart::setupOptions(bool init) {
   // Apply actions
   if (ui->checkBoxAutoReload->isChecked())
     onCheckAutoReload(Qt::Checked);
+  updateErrorBars();
 
   // Update series color config
   if (!chart->series().empty()) {
@@ -394,6 +425,10 @@ void PlotterBarChart::setupOptions(bool init) {
   if (!init)
     ui->comboBoxAxis->setCurrentIndex(prevAxisIdx);
 
+  // Ratios to loaded (or kept) baseline
+  if (mRelative || ui->comboBoxBaseline->currentIndex() > 0)
+    updateSeriesValues();
+
   // Update timestamp
   QDateTime today = QDateTime::currentDateTime();
   QTime now = today.time();
@@ -413,6 +448,16 @@ void PlotterBarChart::loadConfig(bool init) {
   if (auto value = settings.value("theme"); value.isValid())
     ui->comboBoxTheme->setCurrentText(value.toString());
 
+  if (auto value = settings.value("errorBars"); value.isValid()) {
+    const QSignalBlocker blocker(ui->checkBoxErrorBars);  // applied once options are set
+    ui->checkBoxErrorBars->setChecked(value.toBool());
+  }
+  if (auto value = settings.value("baseline"); value.isValid()) {
+    const QSignalBlocker blocker(ui->comboBoxBaseline);  // applied once options are set
+    if (int idx = ui->comboBoxBaseline->findText(value.toString()); idx >= 0)
+      ui->comboBoxBaseline->setCurrentIndex(idx);
+  }
+
   if (auto value = settings.value("legend/visible"); value.isValid())
     ui->checkBoxLegendVisible->setChecked(value.toBool());
   if (auto value = settings.value("legend/align"); value.isValid())
@@ -509,6 +554,8 @@ void PlotterBarChart::saveConfig() {
   settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
   settings.setValue("timeUnit", ui->comboBoxTimeUnit->currentText());
   settings.setValue("theme", ui->comboBoxTheme->currentText());
+  settings.setValue("errorBars", ui->checkBoxErrorBars->isChecked());
+  settings.setValue("baseline", ui->comboBoxBaseline->currentText());
 
   settings.setValue("legend/visible", ui->checkBoxLegendVisible->isChecked());
   settings.setValue("legend/align", ui->comboBoxLegendAlign->currentText());
@@ -530,7 +577,8 @@ void PlotterBarChart::saveConfig() {
 
     settings.setValue(prefix + "/visible", axis.visible);
     settings.setValue(prefix + "/title", axis.title);
-    settings.setValue(prefix + "/titleText", axis.titleText);
+    if (idx == 0 || !mRelative)  // ratios title and range not kept for plotted values
+      settings.setValue(prefix + "/titleText", axis.titleText);
     settings.setValue(prefix + "/titleSize", axis.titleSize);
     settings.setValue(prefix + "/labelSize", axis.labelSize);
 
@@ -545,8 +593,10 @@ void PlotterBarChart::saveConfig() {
       settings.setValue(prefix + "/log", ui->checkBoxLog->isChecked());
       settings.setValue(prefix + "/logBase", ui->spinBoxLogBase->value());
       settings.setValue(prefix + "/labelFormat", ui->lineEditFormat->text());
-      settings.setValue(prefix + "/min", ui->doubleSpinBoxMin->value());
-      settings.setValue(prefix + "/max", ui->doubleSpinBoxMax->value());
+      if (!mRelative) {
+        settings.setValue(prefix + "/min", ui->doubleSpinBoxMin->value());
+        settings.setValue(prefix + "/max", ui->doubleSpinBoxMax->value());
+      }
       settings.setValue(prefix + "/ticks", ui->spinBoxTicks->value());
       settings.setValue(prefix + "/mticks", ui->spinBoxMTicks->value());
     }
@@ -625,6 +675,7 @@ void PlotterBarChart::onSeriesEditClicked() {
       }
     }
     mSeriesMapping = newMapping;
+    mErrorBars->update();  // colors
   }
 }
 
@@ -676,6 +727,216 @@ void PlotterBarChart::onComboTimeUnitChanged(int /*index*/) {
   }
 
   mCurrentTimeFactor = unitFactor;
+  mErrorBars->setScale(mCurrentTimeFactor);
+  updateHoverItems();
+}
+
+void PlotterBarChart::onCheckErrorBars(int /*state*/) { updateErrorBars(); }
+
+void PlotterBarChart::onComboBaselineChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+  updateSeriesValues();
+}
+
+void PlotterBarChart::onBarHovered(int benchIdx) {
+  if (benchIdx < 0) {
+    QToolTip::hideText();
+    return;
+  }
+
+  QString text =
+      getBenchHoverText(mBchResults, benchIdx, mPlotParams.yType, mCurrentTimeFactor,
+                        getBenchInterval(mIntervals, mBchResults, benchIdx, mPlotParams.yType));
+  if (mRelative)
+    text += "\nRatio to " + ui->comboBoxBaseline->currentText() + ": " +
+            QString::number(mRatios.value(benchIdx), 'g', 4);
+  QToolTip::showText(QCursor::pos(), text, mChartView);
+}
+
+void PlotterBarChart::updateHoverItems() {
+  mHover->clear();
+  const auto chartSeries = mChartView->chart()->series();
+  if (chartSeries.empty())
+    return;
+
+  // Bar extents inside their category group (same layout as Qt bar series)
+  auto barSeries = (QAbstractBarSeries*)chartSeries[0];
+  const auto barSets = barSeries->barSets();
+  const double groupWidth = barSeries->barWidth();
+  const double width = groupWidth / barSets.size();
+  for (int setIdx = 0; setIdx < mBchSubsets.size() && setIdx < barSets.size(); ++setIdx) {
+    const auto& idxs = mBchSubsets[setIdx].idxs;
+    for (int colIdx = 0; colIdx < idxs.size(); ++colIdx) {
+      if (mRelative && !mRatios.contains(idxs[colIdx]))
+        continue;  // missing ratio (empty bar)
+      const double pos = colIdx - groupWidth / 2. + setIdx * width;
+      const double val = barSets[setIdx]->at(colIdx);
+      const QRectF extent = mIsVert ? QRectF(pos, std::min(0., val), width, std::abs(val))
+                                    : QRectF(std::min(0., val), pos, std::abs(val), width);
+      mHover->addItem(barSeries, extent, idxs[colIdx]);
+    }
+  }
+}
+
+void PlotterBarChart::updateErrorBars() {
+  mErrorBars->clear();
+  mIntervals.clear();
+  mErrorBars->setScale(mCurrentTimeFactor);
+  if (!ui->checkBoxErrorBars->isEnabled() || !ui->checkBoxErrorBars->isChecked())
+    return;
+  const auto chartSeries = mChartView->chart()->series();
+  if (chartSeries.empty())
+    return;
+
+  // Intervals of all bars at once
+  QVector<int> bchIdxs;
+  for (const auto& bchSubset : std::as_const(mBchSubsets))
+    bchIdxs.append(bchSubset.idxs);
+  const auto intervals = bootstrapIntervals(mBchResults, bchIdxs, mPlotParams.yType);
+
+  auto barSeries = (QAbstractBarSeries*)chartSeries[0];
+  int intervalIdx = 0;
+  for (int setIdx = 0; setIdx < mBchSubsets.size(); ++setIdx) {
+    for (int colIdx = 0; colIdx < mBchSubsets[setIdx].idxs.size(); ++colIdx) {
+      const auto& interval = intervals[intervalIdx];
+      mIntervals.insert(bchIdxs[intervalIdx++], interval);
+      if (interval.isValid)
+        mErrorBars->addBar(barSeries, setIdx, colIdx, interval.low, interval.high);
+    }
+  }
+}
+
+// Reference choices of plotted bar sets: sets, then JOMT containers (selection kept by name)
+void PlotterBarChart::updateBaselineChoices() {
+  mBaseline.build(mBchResults, mBchSubsets, mPlotParams);
+
+  const QString prevText = ui->comboBoxBaseline->currentText();
+  const QSignalBlocker blocker(ui->comboBoxBaseline);
+  ui->comboBoxBaseline->clear();
+  ui->comboBoxBaseline->addItem("None", QList<QVariant>{BaselineNone, -1});
+  for (int idx = 0; idx < mBchSubsets.size(); ++idx)
+    ui->comboBoxBaseline->addItem(mBchSubsets[idx].name, QList<QVariant>{BaselineSeries, idx});
+  const auto& containers = mBaseline.containers();
+  for (int idx = 0; idx < containers.size(); ++idx)
+    ui->comboBoxBaseline->addItem(containers[idx] + " (container)",
+                                  QList<QVariant>{BaselineContainer, idx});
+  if (int idx = ui->comboBoxBaseline->findText(prevText); idx > 0)
+    ui->comboBoxBaseline->setCurrentIndex(idx);
+}
+
+// Bar values as plotted values, or as ratios to baseline at same X (missing ratios as empty bars)
+void PlotterBarChart::updateSeriesValues(bool fitRange) {
+  const QList<QVariant> choice = ui->comboBoxBaseline->currentData().toList();
+  const auto kind = choice.isEmpty() ? BaselineNone : (BaselineKind)choice[0].toInt();
+  const bool wasRelative = mRelative;
+  mRelative = kind != BaselineNone;
+
+  mErrorBars->clear();
+  mHover->clear();
+  mRatios.clear();
+
+  // Ratios from values joined once (no lookup when baseline changes)
+  const auto chartSeries = mChartView->chart()->series();
+  if (!chartSeries.empty()) {
+    const int refIdx = (choice.size() > 1) ? choice[1].toInt() : -1;
+    const QVector<int> refs = mBaseline.getReferences(kind, refIdx);
+    const auto barSets = ((QAbstractBarSeries*)chartSeries[0])->barSets();
+    for (int setIdx = 0; setIdx < mBchSubsets.size() && setIdx < barSets.size(); ++setIdx) {
+      const auto& idxs = mBchSubsets[setIdx].idxs;
+      const QVector<double> ratios =
+          mRelative ? mBaseline.getRatios(setIdx, refs[setIdx]) : QVector<double>();
+      auto* barSet = barSets.at(setIdx);
+      for (int colIdx = 0; colIdx < idxs.size() && colIdx < barSet->count(); ++colIdx) {
+        const int idx = idxs[colIdx];
+        double val = 0.;
+        if (!mRelative)
+          val = getYPlotValue(mBchResults.benchmarks[idx], mPlotParams.yType) * mCurrentTimeFactor;
+        else if (!std::isnan(ratios[colIdx])) {
+          val = ratios[colIdx];
+          mRatios.insert(idx, val);
+        }
+        if (barSet->at(colIdx) != val)
+          barSet->replace(colIdx, val);
+      }
+    }
+  }
+
+  // Unitless ratios: time unit and intervals only apply to plotted values
+  ui->comboBoxTimeUnit->setEnabled(!mRelative && isYTimeBased(mPlotParams.yType));
+  ui->checkBoxErrorBars->setEnabled(!mRelative &&
+                                    getYPlotStatistic(mPlotParams.yType) != BootstrapNone);
+
+  // Y-axis title (plotted values one restored)
+  if (mRelative) {
+    if (!wasRelative)
+      mAbsoluteTitle = mAxesParams[1].titleText;
+    onEditTitleChanged2("Ratio to " + ui->comboBoxBaseline->currentText(), 1);
+  } else if (wasRelative)
+    onEditTitleChanged2(mAbsoluteTitle, 1);
+  if (ui->comboBoxAxis->currentIndex() == 1) {
+    const QSignalBlocker blocker(ui->lineEditTitle);
+    ui->lineEditTitle->setText(mAxesParams[1].titleText);
+    ui->lineEditTitle->setCursorPosition(0);
+  }
+
+  if (fitRange || mRelative != wasRelative)
+    fitYRange();
+  updateErrorBars();
+  updateHoverItems();
+}
+
+// Y-range fitted to bar values (e.g. after values changed to ratios)
+void PlotterBarChart::fitYRange() {
+  auto chart = mChartView->chart();
+  const auto yAxes = chart->axes(mIsVert ? Qt::Vertical : Qt::Horizontal);
+  const auto chartSeries = chart->series();
+  if (yAxes.isEmpty() || chartSeries.empty())
+    return;
+
+  double yMin = 0.;  // bars from zero
+  double yMax = std::numeric_limits<double>::lowest();
+  double posMin = std::numeric_limits<double>::max();
+  const auto barSets = ((QAbstractBarSeries*)chartSeries[0])->barSets();
+  for (const auto* barSet : barSets) {
+    for (int colIdx = 0; colIdx < barSet->count(); ++colIdx) {
+      const double val = barSet->at(colIdx);
+      yMin = std::min(yMin, val);
+      yMax = std::max(yMax, val);
+      if (val > 0.)
+        posMin = std::min(posMin, val);
+    }
+  }
+  if (yMax == std::numeric_limits<double>::lowest())
+    return;  // no bars
+
+  if (yAxes.constFirst()->type() == QAbstractAxis::AxisTypeLogValue) {
+    if (posMin > yMax)
+      return;  // no positive bar
+    yMin = posMin;
+    if (yMin == yMax) {  // flat (e.g. baseline itself)
+      yMin /= 2.;
+      yMax *= 2.;
+    }
+  } else {
+    if (yMax <= yMin)
+      yMax = yMin + 1.;
+    auto yAxis = (QValueAxis*)yAxes.constFirst();
+    yAxis->setRange(yMin, yMax);
+    yAxis->applyNiceNumbers();
+    yMin = yAxis->min();
+    yMax = yAxis->max();
+  }
+
+  // Spin boxes always hold Y-range (category axis has its own combos)
+  {
+    const QSignalBlocker blockerMin(ui->doubleSpinBoxMin);
+    const QSignalBlocker blockerMax(ui->doubleSpinBoxMax);
+    ui->doubleSpinBoxMin->setValue(yMin);
+    ui->doubleSpinBoxMax->setValue(yMax);
+  }
+  onSpinMinChanged2(yMin, 1);
+  onSpinMaxChanged2(yMax, 1);
 }
 
 //
@@ -1030,8 +1291,16 @@ void PlotterBarChart::onSpinMTicksChanged(int i) {
 
 //
 // Actions
+void PlotterBarChart::setSharedReload() {
+  mSharedReload = true;
+  onCheckAutoReload(Qt::Unchecked);
+  ui->checkBoxAutoReload->hide();
+  ui->pushButtonReload->hide();
+  ui->labelLastReload->hide();
+}
+
 void PlotterBarChart::onCheckAutoReload(int state) {
-  if (state == Qt::Checked) {
+  if (state == Qt::Checked && !mSharedReload) {
     if (mWatcher.files().empty()) {
       mWatcher.addPath(mOrigFilename);
       for (const auto& addFilename : mAddFilenames)
@@ -1054,7 +1323,7 @@ void PlotterBarChart::onAutoReload(const QString& path) {
 void PlotterBarChart::onReloadClicked() {
   // Load new results
   QString errorMsg;
-  BenchResults newBchResults = ResultParser::parseJsonFile(mOrigFilename, errorMsg);
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
 
   if (newBchResults.benchmarks.isEmpty()) {
     QMessageBox::critical(this, "Chart reload",
@@ -1064,7 +1333,7 @@ void PlotterBarChart::onReloadClicked() {
 
   for (const auto& addFile : std::as_const(mAddFilenames)) {
     errorMsg.clear();
-    BenchResults newAddResults = ResultParser::parseJsonFile(addFile.filename, errorMsg);
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
     if (newAddResults.benchmarks.isEmpty()) {
       QMessageBox::critical(
           this, "Chart reload",
@@ -1078,85 +1347,27 @@ void PlotterBarChart::onReloadClicked() {
       newBchResults.overwriteResults(newAddResults);
   }
 
-  // Check compatibility with previous
-  errorMsg.clear();
-  if (mBenchIdxs.size() != newBchResults.benchmarks.size()) {
-    errorMsg = "Number of series/points is different";
-    if (mAllIndexes) {
-      mBenchIdxs.clear();
-      for (int i = 0; i < newBchResults.benchmarks.size(); ++i)
-        mBenchIdxs.append(i);
-    }
-  }
-
-  QVector<BenchSubset> newBchSubsets = newBchResults.groupParam(
-      mPlotParams.xType == PlotArgumentType, mBenchIdxs, mPlotParams.xIdx, "X");
-  int newBarSetIdx = 0;
-  const auto& oldChartSeries = mChartView->chart()->series();
-  if (newBchSubsets.isEmpty()) {
-    errorMsg = "No compatible series to display";  // Ignore empty series
-  }
-  if (oldChartSeries.size() != 1) {
-    errorMsg = "No compatible series to display originally";
-  }
+  reloadResults(newBchResults);
+}
 
-  if (errorMsg.isEmpty()) {
-    const QAbstractBarSeries* oldBarSeries = (QAbstractBarSeries*)oldChartSeries[0];
-    for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-      // Ignore empty set
-      if (bchSubset.idxs.isEmpty())
-        continue;
-      if (newBarSetIdx >= oldBarSeries->count())
-        break;
-
-      const QString& subsetName = bchSubset.name;
-      if (subsetName != mSeriesMapping[newBarSetIdx].oldName) {
-        errorMsg = "Series has different name";
-        break;
-      }
-      const auto barSet = oldBarSeries->barSets().at(newBarSetIdx);
-      if (bchSubset.idxs.size() != barSet->count()) {
-        errorMsg = "Number of series bars is different";
-        break;
-      }
-      ++newBarSetIdx;
-    }
-    if (newBarSetIdx != oldBarSeries->count()) {
-      errorMsg = "Number of series is different";
-    }
+void PlotterBarChart::reloadResults(const BenchResults& newBchResults) {
+  // Plotted benchmarks (all of them, or previous ones matched by names)
+  QVector<int> newBenchIdxs = mAllIndexes
+                                  ? newBchResults.segmentAll()
+                                  : newBchResults.matchBenchmarks(mBchResults, mBenchIdxs);
+  if (newBenchIdxs.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload", "No plotted benchmarks in reloaded results");
+    return;
   }
+  mBenchIdxs = newBenchIdxs;
 
-  // Direct update if compatible
-  if (errorMsg.isEmpty()) {
-    newBarSetIdx = 0;
-    const QAbstractBarSeries* oldBarSeries = (QAbstractBarSeries*)oldChartSeries[0];
-    for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-      // Ignore empty set
-      if (bchSubset.idxs.isEmpty()) {
-        qWarning() << "No X-value to trace bar for:" << bchSubset.name;
-        continue;
-      }
-
-      // Update points
-      const auto& barSet = oldBarSeries->barSets().at(newBarSetIdx);
-      barSet->remove(0, barSet->count());
-
-      for (int idx : bchSubset.idxs) {
-        // Add column
-        barSet->append(getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
-                       mCurrentTimeFactor);
-      }
-      ++newBarSetIdx;
-    }
-  }
-  // Reset update if all benchmarks
-  else if (mAllIndexes) {
+  // Bar sets matched by names if any, reset otherwise (no axes)
+  if (!mSeriesMapping.isEmpty())
+    reconcileSeries(newBchResults);
+  else {
     saveConfig();
     setupChart(newBchResults, mBenchIdxs, mPlotParams, false);
     setupOptions(false);
-  } else {
-    QMessageBox::critical(this, "Chart reload", errorMsg);
-    return;
   }
 
   // Update timestamp
@@ -1165,6 +1376,118 @@ void PlotterBarChart::onReloadClicked() {
   ui->labelLastReload->setText("(Last: " + now.toString() + ")");
 }
 
+// New subsets matched to plotted bar sets by name: values swapped in place, sets of new subsets
+// appended and those of removed subsets deleted (axes and options kept)
+void PlotterBarChart::reconcileSeries(const BenchResults& bchResults) {
+  auto chart = mChartView->chart();
+  auto series = (QAbstractBarSeries*)chart->series().constFirst();
+  mErrorBars->clear();
+  mHover->clear();
+
+  QHash<QString, int> prevIdxs;  // subset name -> bar set index
+  for (int idx = 0; idx < mSeriesMapping.size(); ++idx)
+    prevIdxs.insert(mSeriesMapping[idx].oldName, idx);
+  const auto prevSets = series->barSets();
+
+  const QVector<BenchSubset> bchSubsets = bchResults.groupParam(
+      mPlotParams.xType == PlotArgumentType, mBenchIdxs, mPlotParams.xIdx, "X");
+  SeriesMapping configs;
+  QVector<BenchSubset> subsets;
+  QHash<QBarSet*, int> setIdxs;  // -> configs/subsets index
+  bool firstCol = true, newSets = false;
+  QStringList prevColLabels;
+  QList<qreal> values;
+  for (const auto& bchSubset : bchSubsets) {
+    // Ignore empty set
+    if (bchSubset.idxs.isEmpty()) {
+      qWarning() << "No X-value to trace bar for:" << bchSubset.name;
+      continue;
+    }
+
+    values.clear();
+    QStringList colLabels;
+    for (int idx : bchSubset.idxs) {
+      QString xName =
+          bchResults.getParamName(mPlotParams.xType == PlotArgumentType, idx, mPlotParams.xIdx);
+      colLabels.append(xName.toHtmlEscaped());
+      values.append(getYPlotValue(bchResults.benchmarks[idx], mPlotParams.yType) *
+                    mCurrentTimeFactor);
+    }
+
+    QBarSet* barSet = nullptr;
+    if (auto it = prevIdxs.find(bchSubset.name); it != prevIdxs.end()) {
+      barSet = prevSets.at(it.value());
+      configs.append(mSeriesMapping[it.value()]);
+      prevIdxs.erase(it);
+
+      // Changed values only, extra columns appended or removed
+      const int common = std::min<int>(barSet->count(), values.size());
+      for (int col = 0; col < common; ++col) {
+        if (barSet->at(col) != values[col])
+          barSet->replace(col, values[col]);
+      }
+      if (barSet->count() > common)
+        barSet->remove(common, barSet->count() - common);
+      else if (values.size() > common)
+        barSet->append(values.mid(common));
+    } else {
+      barSet = new QBarSet(bchSubset.name.toHtmlEscaped());
+      barSet->append(values);
+      series->append(barSet);
+      configs.append({bchSubset.name, bchSubset.name});  // color synced with theme below
+      newSets = true;
+    }
+    setIdxs.insert(barSet, subsets.size());
+    subsets.append(bchSubset);
+
+    // Set column labels (only if no collision, empty otherwise)
+    if (firstCol)  // init
+      prevColLabels = colLabels;
+    else if (commonPartEqual(prevColLabels, colLabels)) {
+      if (prevColLabels.size() < colLabels.size())  // replace by longest
+        prevColLabels = colLabels;
+    } else {  // collision
+      prevColLabels = QStringList("");
+    }
+    firstCol = false;
+  }
+
+  // Bar sets of removed subsets
+  for (int idx : std::as_const(prevIdxs))
+    series->remove(prevSets.at(idx));
+
+  // Mapping in series order (kept sets first)
+  mSeriesMapping.clear();
+  mBchSubsets.clear();
+  const auto barSets = series->barSets();
+  for (auto barSet : barSets) {
+    const int idx = setIdxs.value(barSet);
+    mSeriesMapping.append(configs[idx]);
+    mBchSubsets.append(subsets[idx]);
+  }
+  chart->setTitle(barSets.isEmpty() ? "No compatible series to display" : "");
+
+  // Column labels
+  const auto catAxes = chart->axes(mIsVert ? Qt::Horizontal : Qt::Vertical);
+  if (!catAxes.isEmpty()) {
+    auto catAxis = (QBarCategoryAxis*)catAxes.constFirst();
+    if (catAxis->categories() != prevColLabels)
+      catAxis->setCategories(prevColLabels);
+  }
+  // Theme colors of new sets (configs of kept ones re-applied)
+  if (newSets)
+    onComboThemeChanged(ui->comboBoxTheme->currentIndex());
+
+  mBchResults = bchResults;
+  updateBaselineChoices();
+  if (mRelative || ui->comboBoxBaseline->currentIndex() > 0)
+    updateSeriesValues(false);  // ratios of new values (range kept)
+  else {
+    updateErrorBars();
+    updateHoverItems();
+  }
+}
+
 void PlotterBarChart::onSnapshotClicked() {
   QString fileName =
       QFileDialog::getSaveFileName(this, tr("Save snapshot"), "", tr("Images (*.png)"));
@@ -15,13 +15,18 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>. */
 
 #include "plotter_boxchart.h"
 
+#include <algorithm>
+
 #include <QDateTime>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QToolTip>
 #include <QtCharts>
 
 #include "benchmark_results.h"
+#include "chart_hover.h"
+#include "chart_outliers.h"
 #include "result_parser.h"
 #include "ui_plotter_boxchart.h"
 
@@ -29,7 +34,7 @@ namespace {
 const bool kForceConfig = false;
 }
 
-PlotterBoxChart::PlotterBoxChart(BenchResults& bchResults, const QVector<int>& bchIdxs,
+PlotterBoxChart::PlotterBoxChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
                                  const PlotParams& plotParams, const QString& origFilename,
                                  const QVector<FileReload>& addFilenames, QWidget* parent)
     : QWidget(parent)
@@ -141,7 +146,7 @@ void PlotterBoxChart::connectUI() {
   connect(ui->pushButtonSnapshot, &QPushButton::clicked, this, &PlotterBoxChart::onSnapshotClicked);
 }
 
-void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& bchIdxs,
+void PlotterBoxChart::setupChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
                                  const PlotParams& plotParams, bool init) {
   //    QScopedPointer<QChart> scopedChart(new QChart());
   //    QChart* chart = scopedChart.get();
@@ -150,9 +155,14 @@ void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& b
   if (init) {
     scopedChart.reset(new QChart());
     chart = scopedChart.get();
+
+    // Outlier markers drawn over series
+    mOutliers = new ChartOutliers(chart);
   } else {  // Re-init
     chart = mChartView->chart();
     chart->setTitle("");
+    mOutliers->clear();
+    mHover->clear();
     chart->removeAllSeries();
     const auto xAxes = chart->axes(Qt::Horizontal);
     if (!xAxes.empty())
@@ -161,8 +171,11 @@ void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& b
     if (!yAxes.empty())
       chart->removeAxis(yAxes.constFirst());
     mSeriesMapping.clear();
+    mBchSubsets.clear();
   }
   Q_ASSERT(chart);
+  mBchResults = bchResults;
+  mIntervals.clear();
 
   // Time unit
   mCurrentTimeFactor = 1.;
@@ -172,6 +185,7 @@ void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& b
     else if (bchResults.meta.time_unit == "ms")
       mCurrentTimeFactor = 0.001;
   }
+  mOutliers->setScale(mCurrentTimeFactor);
 
   // 2D Boxes and whiskers
   // X: argumentA or templateB
@@ -179,6 +193,8 @@ void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& b
   // Box: one per benchmark % X-param
   QVector<BenchSubset> bchSubsets =
       bchResults.groupParam(plotParams.xType == PlotArgumentType, bchIdxs, plotParams.xIdx, "X");
+  bool hasOutliers = false;
+  double outlierMin = 0., outlierMax = 0.;
   for (const auto& bchSubset : std::as_const(bchSubsets)) {
     // Series = benchmark % X-param
     QScopedPointer<QBoxPlotSeries> series(new QBoxPlotSeries());
@@ -200,11 +216,21 @@ void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& b
       box->setValue(QBoxSet::LowerQuartile, yStats.lowQuart * mCurrentTimeFactor);
       box->setValue(QBoxSet::UpperQuartile, yStats.uppQuart * mCurrentTimeFactor);
 
+      // Filtered outliers apart from whiskers
+      if (!yStats.outliers.isEmpty()) {
+        mOutliers->addOutliers(series.get(), series->count(), yStats.outliers);
+        const auto minMax = std::minmax_element(yStats.outliers.begin(), yStats.outliers.end());
+        outlierMin = hasOutliers ? std::min(outlierMin, *minMax.first) : *minMax.first;
+        outlierMax = hasOutliers ? std::max(outlierMax, *minMax.second) : *minMax.second;
+        hasOutliers = true;
+      }
+
       series->append(box.take());
     }
     // Add series
     series->setName(subsetName.toHtmlEscaped());
     mSeriesMapping.push_back({subsetName, subsetName});  // color set later
+    mBchSubsets.push_back(bchSubset);
     chart->addSeries(series.take());
   }
 
@@ -225,6 +251,9 @@ void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& b
     // Y-axis
     QValueAxis* yAxis = (QValueAxis*)(chart->axes(Qt::Vertical).constFirst());
     yAxis->setTitleText(getYPlotName(plotParams.yType, bchResults.meta.time_unit));
+    if (hasOutliers)
+      yAxis->setRange(std::min(yAxis->min(), outlierMin * mCurrentTimeFactor),
+                      std::max(yAxis->max(), outlierMax * mCurrentTimeFactor));
     yAxis->applyNiceNumbers();
   } else
     chart->setTitle("No compatible series to display");
@@ -233,7 +262,12 @@ void PlotterBoxChart::setupChart(BenchResults& bchResults, const QVector<int>& b
     // View
     mChartView = new QChartView(scopedChart.take(), this);
     mChartView->setRenderHint(QPainter::Antialiasing);
+
+    // Boxes tooltips
+    mHover = new ChartHover(mChartView);
+    connect(mHover, &ChartHover::hovered, this, &PlotterBoxChart::onBoxHovered);
   }
+  updateHoverItems();
 }
 
 void PlotterBoxChart::setupOptions(bool init) {
@@ -519,6 +553,7 @@ void PlotterBoxChart::onComboThemeChanged(int index) {
     } else
       config.newColor = config.oldColor;  // sync with theme
   }
+  mOutliers->update();  // colors
 
   // Re-apply font sizes
   onSpinLegendFontSizeChanged(ui->spinBoxLegendFontSize->value());
@@ -565,6 +600,7 @@ void PlotterBoxChart::onSeriesEditClicked() {
       }
     }
     mSeriesMapping = newMapping;
+    mOutliers->update();  // colors
   }
 }
 
@@ -618,6 +654,39 @@ void PlotterBoxChart::onComboTimeUnitChanged(int /*index*/) {
   }
 
   mCurrentTimeFactor = unitFactor;
+  mOutliers->setScale(mCurrentTimeFactor);
+  updateHoverItems();
+}
+
+void PlotterBoxChart::onBoxHovered(int benchIdx) {
+  if (benchIdx < 0)
+    QToolTip::hideText();
+  else
+    QToolTip::showText(
+        QCursor::pos(),
+        getBenchHoverText(mBchResults, benchIdx, mPlotParams.yType, mCurrentTimeFactor,
+                          getBenchInterval(mIntervals, mBchResults, benchIdx, mPlotParams.yType)),
+        mChartView);
+}
+
+void PlotterBoxChart::updateHoverItems() {
+  mHover->clear();
+
+  // Box extents (whiskers included) inside their category (same layout as Qt box series)
+  const auto chartSeries = mChartView->chart()->series();
+  const int seriesCount = std::min<int>(chartSeries.size(), mBchSubsets.size());
+  for (int seriesIdx = 0; seriesIdx < seriesCount; ++seriesIdx) {
+    auto boxSeries = (QBoxPlotSeries*)chartSeries.at(seriesIdx);
+    const auto boxes = boxSeries->boxSets();
+    const auto& idxs = mBchSubsets[seriesIdx].idxs;
+    const double width = boxSeries->boxWidth() / chartSeries.size();
+    for (int boxIdx = 0; boxIdx < idxs.size() && boxIdx < boxes.size(); ++boxIdx) {
+      const double pos = boxIdx - 0.5 + (seriesIdx + 0.5) / chartSeries.size();
+      const double low = boxes[boxIdx]->at(QBoxSet::LowerExtreme);
+      const double high = boxes[boxIdx]->at(QBoxSet::UpperExtreme);
+      mHover->addItem(boxSeries, QRectF(pos - width / 2., low, width, high - low), idxs[boxIdx]);
+    }
+  }
 }
 
 //
@@ -927,8 +996,16 @@ void PlotterBoxChart::onSpinMTicksChanged(int i) {
 
 //
 // Actions
+void PlotterBoxChart::setSharedReload() {
+  mSharedReload = true;
+  onCheckAutoReload(Qt::Unchecked);
+  ui->checkBoxAutoReload->hide();
+  ui->pushButtonReload->hide();
+  ui->labelLastReload->hide();
+}
+
 void PlotterBoxChart::onCheckAutoReload(int state) {
-  if (state == Qt::Checked) {
+  if (state == Qt::Checked && !mSharedReload) {
     if (mWatcher.files().empty()) {
       mWatcher.addPath(mOrigFilename);
       for (const auto& addFilename : mAddFilenames)
@@ -951,7 +1028,7 @@ void PlotterBoxChart::onAutoReload(const QString& path) {
 void PlotterBoxChart::onReloadClicked() {
   // Load new results
   QString errorMsg;
-  BenchResults newBchResults = ResultParser::parseJsonFile(mOrigFilename, errorMsg);
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
 
   if (newBchResults.benchmarks.isEmpty()) {
     QMessageBox::critical(this, "Chart reload",
@@ -961,7 +1038,7 @@ void PlotterBoxChart::onReloadClicked() {
 
   for (const auto& addFile : std::as_const(mAddFilenames)) {
     errorMsg.clear();
-    BenchResults newAddResults = ResultParser::parseJsonFile(addFile.filename, errorMsg);
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
     if (newAddResults.benchmarks.isEmpty()) {
       QMessageBox::critical(
           this, "Chart reload",
@@ -975,76 +1052,71 @@ void PlotterBoxChart::onReloadClicked() {
       newBchResults.overwriteResults(newAddResults);
   }
 
-  // Check compatibility with previous
-  errorMsg.clear();
-  if (mBenchIdxs.size() != newBchResults.benchmarks.size()) {
-    errorMsg = "Number of series/points is different";
-    if (mAllIndexes) {
-      mBenchIdxs.clear();
-      for (int i = 0; i < newBchResults.benchmarks.size(); ++i)
-        mBenchIdxs.append(i);
-    }
+  reloadResults(newBchResults);
+}
+
+void PlotterBoxChart::reloadResults(const BenchResults& newBchResults) {
+  // Plotted benchmarks (all of them, or previous ones matched by names)
+  QVector<int> newBenchIdxs = mAllIndexes
+                                  ? newBchResults.segmentAll()
+                                  : newBchResults.matchBenchmarks(mBchResults, mBenchIdxs);
+  if (newBenchIdxs.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload", "No plotted benchmarks in reloaded results");
+    return;
   }
+  mBenchIdxs = newBenchIdxs;
 
+  // Check compatibility with previous (same series names and box counts)
   QVector<BenchSubset> newBchSubsets = newBchResults.groupParam(
       mPlotParams.xType == PlotArgumentType, mBenchIdxs, mPlotParams.xIdx, "X");
   const auto& oldChartSeries = mChartView->chart()->series();
-  int newSeriesIdx = 0;
-  if (errorMsg.isEmpty()) {
-    for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-      if (newSeriesIdx >= oldChartSeries.size())
-        break;
-
-      const QString& subsetName = bchSubset.name;
-      if (subsetName != mSeriesMapping[newSeriesIdx].oldName) {
-        errorMsg = "Series has different name";
-        break;
-      }
-      const auto boxSeries = (QBoxPlotSeries*)oldChartSeries[newSeriesIdx];
-      if (bchSubset.idxs.size() != boxSeries->count()) {
-        errorMsg = "Series has different number of points";
-        break;
-      }
-      ++newSeriesIdx;
-    }
-    if (newSeriesIdx != oldChartSeries.size()) {
-      errorMsg = "Number of series is different";
-    }
+  bool compatible = newBchSubsets.size() == oldChartSeries.size();
+  for (int seriesIdx = 0; compatible && seriesIdx < newBchSubsets.size(); ++seriesIdx) {
+    const auto boxSeries = (QBoxPlotSeries*)oldChartSeries[seriesIdx];
+    compatible = newBchSubsets[seriesIdx].name == mSeriesMapping[seriesIdx].oldName &&
+                 newBchSubsets[seriesIdx].idxs.size() == boxSeries->count();
   }
 
   // Direct update if compatible
-  if (errorMsg.isEmpty()) {
-    newSeriesIdx = 0;
+  if (compatible) {
+    int newSeriesIdx = 0;
+    mOutliers->clear();
+    mHover->clear();
     for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-      // Update points
+      // Update boxes in place (same count)
       QBoxPlotSeries* oldSeries = (QBoxPlotSeries*)oldChartSeries[newSeriesIdx];
-      oldSeries->clear();
+      const auto boxes = oldSeries->boxSets();
 
-      for (int idx : bchSubset.idxs) {
+      for (int boxIdx = 0; boxIdx < bchSubset.idxs.size(); ++boxIdx) {
+        const int idx = bchSubset.idxs[boxIdx];
         QString xName = newBchResults.getParamName(mPlotParams.xType == PlotArgumentType, idx,
                                                    mPlotParams.xIdx);
         BenchYStats yStats = getYPlotStats(newBchResults.benchmarks[idx], mPlotParams.yType);
 
-        QScopedPointer<QBoxSet> box(new QBoxSet(xName.toHtmlEscaped()));
+        QBoxSet* box = boxes[boxIdx];
+        if (box->label() != xName.toHtmlEscaped())
+          box->setLabel(xName.toHtmlEscaped());
         box->setValue(QBoxSet::LowerExtreme, yStats.min * mCurrentTimeFactor);
         box->setValue(QBoxSet::UpperExtreme, yStats.max * mCurrentTimeFactor);
         box->setValue(QBoxSet::Median, yStats.median * mCurrentTimeFactor);
         box->setValue(QBoxSet::LowerQuartile, yStats.lowQuart * mCurrentTimeFactor);
         box->setValue(QBoxSet::UpperQuartile, yStats.uppQuart * mCurrentTimeFactor);
 
-        oldSeries->append(box.take());
+        if (!yStats.outliers.isEmpty())
+          mOutliers->addOutliers(oldSeries, boxIdx, yStats.outliers);
       }
       ++newSeriesIdx;
     }
+    mBchResults = newBchResults;
+    mBchSubsets = newBchSubsets;
+    mIntervals.clear();
+    updateHoverItems();
   }
-  // Reset update if all benchmarks
-  else if (mAllIndexes) {
+  // Reset update otherwise (matched benchmarks)
+  else {
     saveConfig();
     setupChart(newBchResults, mBenchIdxs, mPlotParams, false);
     setupOptions(false);
-  } else {
-    QMessageBox::critical(this, "Chart reload", errorMsg);
-    return;
   }
 
   // Update timestamp
@@ -0,0 +1,493 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "plotter_heatmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include <QBrush>
+#include <QCursor>
+#include <QDateTime>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHash>
+#include <QMessageBox>
+#include <QSettings>
+#include <QToolTip>
+
+#include "heatmap_view.h"
+#include "result_parser.h"
+#include "ui_plotter_heatmap.h"
+
+// Color scales, from minimum to maximum value
+static const QVector<QPair<QString, QGradientStops>>& colorScales() {
+  static const QVector<QPair<QString, QGradientStops>> scales = {
+      {"Viridis",
+       {{0., QColor(68, 1, 84)},
+        {0.25, QColor(59, 82, 139)},
+        {0.5, QColor(33, 145, 140)},
+        {0.75, QColor(94, 201, 98)},
+        {1., QColor(253, 231, 37)}}},
+      {"Deep volcano", {{0., Qt::black}, {0.33, Qt::blue}, {0.67, Qt::red}, {1., Qt::yellow}}},
+      {"Spectral redux", {{0., Qt::blue}, {0.33, Qt::green}, {0.5, Qt::yellow}, {1., Qt::red}}},
+      {"Cool to warm",
+       {{0., QColor(59, 76, 192)}, {0.5, QColor(221, 221, 221)}, {1., QColor(180, 4, 38)}}},
+      {"Grayscale", {{0., Qt::black}, {1., Qt::white}}}};
+  return scales;
+}
+
+// Colors interpolated between gradient stops
+static QVector<QRgb> getColorTable(const QGradientStops& stops, int size = 256) {
+  QVector<QRgb> colors(size);
+  int stopIdx = 0;
+  for (int idx = 0; idx < size; ++idx) {
+    const double t = (double)idx / (size - 1);
+    while (stopIdx + 2 < stops.size() && stops[stopIdx + 1].first < t)
+      ++stopIdx;
+    const auto& [t0, color0] = stops[stopIdx];
+    const auto& [t1, color1] = stops[stopIdx + 1];
+    const double f = (t1 > t0) ? std::clamp((t - t0) / (t1 - t0), 0., 1.) : 0.;
+    colors[idx] = qRgb((int)std::lround(color0.red() + f * (color1.red() - color0.red())),
+                       (int)std::lround(color0.green() + f * (color1.green() - color0.green())),
+                       (int)std::lround(color0.blue() + f * (color1.blue() - color0.blue())));
+  }
+  return colors;
+}
+
+// Order of labels by parameter value if all numeric, as first seen otherwise
+static QVector<int> getParamOrder(const QVector<BenchParam>& params) {
+  QVector<int> order(params.size());
+  std::iota(order.begin(), order.end(), 0);
+  const bool numeric = std::none_of(params.cbegin(), params.cend(), [](const BenchParam& param) {
+    return param.kind == BenchParam::TextParam;
+  });
+  if (numeric)
+    std::stable_sort(order.begin(), order.end(),
+                     [&params](int lhs, int rhs) { return params[lhs].value < params[rhs].value; });
+  return order;
+}
+
+// Parameter axis title
+static QString getParamTitle(PlotParamType type, int idx) {
+  if (type == PlotArgumentType)
+    return "Argument " + QString::number(idx + 1);
+  if (type == PlotTemplateType)
+    return "Template " + QString::number(idx + 1);
+  return QString();
+}
+
+PlotterHeatmap::PlotterHeatmap(const BenchResults& bchResults, const QVector<int>& bchIdxs,
+                               const PlotParams& plotParams, const QString& origFilename,
+                               const QVector<FileReload>& addFilenames, QWidget* parent)
+    : QWidget(parent)
+    , ui(new Ui::PlotterHeatmap)
+    , mBchResults(bchResults)
+    , mBenchIdxs(bchIdxs)
+    , mPlotParams(plotParams)
+    , mOrigFilename(origFilename)
+    , mAddFilenames(addFilenames)
+    , mAllIndexes(bchIdxs.size() == bchResults.benchmarks.size())
+    , mWatcher(parent) {
+  // UI
+  ui->setupUi(this);
+  this->setAttribute(Qt::WA_DeleteOnClose);
+
+  QFileInfo fileInfo(origFilename);
+  this->setWindowTitle("Heatmap - " + fileInfo.fileName());
+
+  mView = new HeatmapView(this);
+  connectUI();
+
+  // Time unit
+  mCurrentTimeFactor = 1.;
+  if (isYTimeBased(mPlotParams.yType)) {
+    if (bchResults.meta.time_unit == "ns")
+      mCurrentTimeFactor = 1000.;
+    else if (bchResults.meta.time_unit == "ms")
+      mCurrentTimeFactor = 0.001;
+  }
+
+  // Init
+  loadGrids(bchResults);
+  setupOptions();
+
+  // Show
+  ui->horizontalLayout->insertWidget(0, mView, 1);
+}
+
+PlotterHeatmap::~PlotterHeatmap() {
+  // Save options to file
+  saveConfig();
+
+  delete ui;
+}
+
+void PlotterHeatmap::connectUI() {
+  // Grid
+  connect(ui->comboBoxGrid, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterHeatmap::onComboGridChanged);
+  connect(mView, &HeatmapView::cellHovered, this, &PlotterHeatmap::onCellHovered);
+
+  // Colors
+  for (const auto& scale : colorScales())
+    ui->comboBoxGradient->addItem(scale.first);
+  connect(ui->comboBoxGradient, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterHeatmap::onComboGradientChanged);
+  connect(ui->checkBoxLog, &QCheckBox::stateChanged, this, &PlotterHeatmap::onCheckLog);
+
+  if (!isYTimeBased(mPlotParams.yType))
+    ui->comboBoxTimeUnit->setEnabled(false);
+  else {
+    ui->comboBoxTimeUnit->addItem("ns", 1000.);
+    ui->comboBoxTimeUnit->addItem("us", 1.);
+    ui->comboBoxTimeUnit->addItem("ms", 0.001);
+    connect(ui->comboBoxTimeUnit, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            &PlotterHeatmap::onComboTimeUnitChanged);
+  }
+
+  // Actions
+  connect(&mWatcher, &QFileSystemWatcher::fileChanged, this, &PlotterHeatmap::onAutoReload);
+  connect(ui->checkBoxAutoReload, &QCheckBox::stateChanged, this,
+          &PlotterHeatmap::onCheckAutoReload);
+  connect(ui->pushButtonReload, &QPushButton::clicked, this, &PlotterHeatmap::onReloadClicked);
+  connect(ui->pushButtonSnapshot, &QPushButton::clicked, this,
+          &PlotterHeatmap::onSnapshotClicked);
+}
+
+void PlotterHeatmap::setupOptions() {
+  mIgnoreEvents = true;
+
+  // Time unit
+  if (mCurrentTimeFactor > 1.)
+    ui->comboBoxTimeUnit->setCurrentIndex(0);  // ns
+  else if (mCurrentTimeFactor < 1.)
+    ui->comboBoxTimeUnit->setCurrentIndex(2);  // ms
+  else
+    ui->comboBoxTimeUnit->setCurrentIndex(1);  // us
+
+  // Load options from file
+  loadConfig();
+  mIgnoreEvents = false;
+
+  // Apply actions
+  onComboGradientChanged(ui->comboBoxGradient->currentIndex());
+  onCheckLog(ui->checkBoxLog->checkState());
+  mView->setValueScale(mCurrentTimeFactor);
+  updateTitles();
+  updateGrid();
+  if (ui->checkBoxAutoReload->isChecked())
+    onCheckAutoReload(Qt::Checked);
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterHeatmap::loadConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("heatmap");
+
+  if (auto value = settings.value("autoReload"); value.isValid())
+    ui->checkBoxAutoReload->setChecked(value.toBool());
+
+  if (auto value = settings.value("gradient"); value.isValid())
+    ui->comboBoxGradient->setCurrentText(value.toString());
+  if (auto value = settings.value("log"); value.isValid())
+    ui->checkBoxLog->setChecked(value.toBool());
+
+  settings.endGroup();
+}
+
+void PlotterHeatmap::saveConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("heatmap");
+
+  settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
+  settings.setValue("gradient", ui->comboBoxGradient->currentText());
+  settings.setValue("log", ui->checkBoxLog->isChecked());
+
+  settings.endGroup();
+}
+
+/**************************************************************************************************
+ *
+ * Heatmap
+ *
+ **************************************************************************************************/
+
+void PlotterHeatmap::loadGrids(const BenchResults& bchResults) {
+  // 2D Heatmap
+  // X: argumentA or templateB (columns)
+  // Z: argumentC or templateD (rows), benchmark % X-param otherwise
+  // Grid: one per benchmark % X-param % Z-param (single one without Z-param)
+  const bool xIsArg = mPlotParams.xType == PlotArgumentType;
+  const bool zIsArg = mPlotParams.zType == PlotArgumentType;
+  const bool hasZParam = mPlotParams.zType != PlotEmptyType;
+  QVector<QPair<QString, QVector<BenchSubset>>> gridRows;
+  if (hasZParam) {
+    const auto bchNames = bchResults.segment2DNames(mBenchIdxs, xIsArg, mPlotParams.xIdx, zIsArg,
+                                                    mPlotParams.zIdx);
+    for (const auto& bchName : bchNames)
+      gridRows.append(
+          {bchName.name, bchResults.segmentParam(zIsArg, bchName.idxs, mPlotParams.zIdx)});
+  } else {
+    gridRows.append(
+        {"All benchmarks", bchResults.groupParam(xIsArg, mBenchIdxs, mPlotParams.xIdx, "X")});
+  }
+
+  mGrids.clear();
+  for (const auto& [name, bchRows] : std::as_const(gridRows)) {
+    HeatmapGrid grid;
+    grid.name = name;
+
+    // Columns of all rows
+    QHash<QString, int> colIdxs;
+    QStringList colLabels;
+    QVector<BenchParam> colParams, rowParams;
+    for (const auto& bchRow : bchRows) {
+      for (int idx : bchRow.idxs) {
+        const QString colName = bchResults.getParamName(xIsArg, idx, mPlotParams.xIdx);
+        if (!colIdxs.contains(colName)) {
+          colIdxs.insert(colName, colLabels.size());
+          colLabels.append(colName);
+          colParams.append(bchResults.getParam(xIsArg, idx, mPlotParams.xIdx));
+        }
+      }
+      if (!bchRow.idxs.isEmpty())
+        rowParams.append(hasZParam ? bchResults.getParam(zIsArg, bchRow.idxs.front(),
+                                                         mPlotParams.zIdx)
+                                   : BenchParam());  // benchmarks kept in order
+    }
+    if (colLabels.isEmpty())
+      continue;
+
+    // Ordered by parameter values
+    const QVector<int> colOrder = getParamOrder(colParams);
+    QVector<int> colPos(colOrder.size());
+    for (int pos = 0; pos < colOrder.size(); ++pos) {
+      colPos[colOrder[pos]] = pos;
+      grid.colLabels.append(colLabels[colOrder[pos]]);
+    }
+    QVector<const BenchSubset*> rows;
+    for (const auto& bchRow : bchRows)
+      if (!bchRow.idxs.isEmpty())
+        rows.append(&bchRow);
+    const QVector<int> rowOrder = getParamOrder(rowParams);
+
+    // Benchmark per cell (last one if duplicated)
+    const qsizetype colCount = grid.colLabels.size();
+    grid.cells.fill(-1, rows.size() * colCount);
+    for (int rowIdx = 0; rowIdx < rowOrder.size(); ++rowIdx) {
+      const BenchSubset& bchRow = *rows[rowOrder[rowIdx]];
+      grid.rowLabels.append(bchRow.name);
+      for (int idx : bchRow.idxs) {
+        const int col = colPos[colIdxs.value(bchResults.getParamName(xIsArg, idx,
+                                                                     mPlotParams.xIdx))];
+        grid.cells[rowIdx * colCount + col] = idx;
+      }
+    }
+    mGrids.append(std::move(grid));
+  }
+
+  // Grid choice (kept by name)
+  const QString prevName = ui->comboBoxGrid->currentText();
+  mIgnoreEvents = true;
+  ui->comboBoxGrid->clear();
+  for (const auto& grid : std::as_const(mGrids))
+    ui->comboBoxGrid->addItem(grid.name);
+  if (!prevName.isEmpty() && ui->comboBoxGrid->findText(prevName) >= 0)
+    ui->comboBoxGrid->setCurrentText(prevName);
+  ui->comboBoxGrid->setEnabled(mGrids.size() > 1);
+  mIgnoreEvents = false;
+}
+
+void PlotterHeatmap::updateGrid() {
+  const int gridIdx = ui->comboBoxGrid->currentIndex();
+  if (gridIdx < 0 || gridIdx >= mGrids.size()) {
+    mView->setGrid({}, {}, {});
+    mView->setMessage("No compatible series to display");
+    return;
+  }
+
+  // Values in original unit (scaled by view)
+  const HeatmapGrid& grid = mGrids[gridIdx];
+  QVector<double> values(grid.cells.size(), std::numeric_limits<double>::quiet_NaN());
+  for (qsizetype cell = 0; cell < grid.cells.size(); ++cell) {
+    if (grid.cells[cell] >= 0)
+      values[cell] = getYPlotValue(mBchResults.benchmarks[grid.cells[cell]], mPlotParams.yType);
+  }
+  mView->setGrid(values, grid.rowLabels, grid.colLabels);
+}
+
+void PlotterHeatmap::updateTitles() {
+  QString timeUnit = "us";
+  if (mCurrentTimeFactor > 1.)
+    timeUnit = "ns";
+  else if (mCurrentTimeFactor < 1.)
+    timeUnit = "ms";
+
+  mView->setTitles(getParamTitle(mPlotParams.xType, mPlotParams.xIdx),
+                   getParamTitle(mPlotParams.zType, mPlotParams.zIdx),
+                   getYPlotName(mPlotParams.yType, timeUnit));
+}
+
+/**************************************************************************************************
+ *
+ * Options
+ *
+ **************************************************************************************************/
+
+void PlotterHeatmap::onComboGridChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+  updateGrid();
+}
+
+void PlotterHeatmap::onComboGradientChanged(int index) {
+  const auto& scales = colorScales();
+  if (index >= 0 && index < scales.size())
+    mView->setColorTable(getColorTable(scales[index].second));
+}
+
+void PlotterHeatmap::onCheckLog(int state) { mView->setLogScale(state == Qt::Checked); }
+
+void PlotterHeatmap::onComboTimeUnitChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+
+  // Only displayed values scaled (same colors)
+  mCurrentTimeFactor = ui->comboBoxTimeUnit->currentData().toDouble();
+  mView->setValueScale(mCurrentTimeFactor);
+  updateTitles();
+}
+
+void PlotterHeatmap::onCellHovered(int row, int col) {
+  const int gridIdx = ui->comboBoxGrid->currentIndex();
+  if (row < 0 || col < 0 || gridIdx < 0 || gridIdx >= mGrids.size()) {
+    QToolTip::hideText();
+    return;
+  }
+
+  const HeatmapGrid& grid = mGrids[gridIdx];
+  const int idx = grid.cells[row * grid.colLabels.size() + col];
+  QString text;
+  if (idx >= 0)
+    text = mBchResults.getBenchName(idx) + "\n" + QString::number(mView->value(row, col), 'g', 6);
+  else
+    text = grid.rowLabels[row] + " [X=" + grid.colLabels[col] + "]\n(missing)";
+  QToolTip::showText(QCursor::pos(), text, mView);
+}
+
+/**************************************************************************************************
+ *
+ * Actions
+ *
+ **************************************************************************************************/
+
+void PlotterHeatmap::setSharedReload() {
+  mSharedReload = true;
+  onCheckAutoReload(Qt::Unchecked);
+  ui->checkBoxAutoReload->hide();
+  ui->pushButtonReload->hide();
+  ui->labelLastReload->hide();
+}
+
+void PlotterHeatmap::onCheckAutoReload(int state) {
+  if (state == Qt::Checked && !mSharedReload) {
+    if (mWatcher.files().empty()) {
+      mWatcher.addPath(mOrigFilename);
+      for (const auto& addFilename : std::as_const(mAddFilenames))
+        mWatcher.addPath(addFilename.filename);
+    }
+  } else {
+    if (!mWatcher.files().empty())
+      mWatcher.removePaths(mWatcher.files());
+  }
+}
+
+void PlotterHeatmap::onAutoReload(const QString& path) {
+  QFileInfo fi(path);
+  if (fi.exists() && fi.isReadable() && fi.size() > 0)
+    onReloadClicked();
+  else
+    qWarning() << "Unable to auto-reload file: " << path;
+}
+
+void PlotterHeatmap::onReloadClicked() {
+  // Load new results
+  QString errorMsg;
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
+
+  if (newBchResults.benchmarks.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload",
+                          "Error parsing original file: " + mOrigFilename + " -> " + errorMsg);
+    return;
+  }
+  for (const auto& addFile : std::as_const(mAddFilenames)) {
+    errorMsg.clear();
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
+    if (newAddResults.benchmarks.isEmpty()) {
+      QMessageBox::critical(
+          this, "Chart reload",
+          "Error parsing additional file: " + addFile.filename + " -> " + errorMsg);
+      return;
+    }
+    if (addFile.isAppend)
+      newBchResults.appendResults(newAddResults);
+    else
+      newBchResults.overwriteResults(newAddResults);
+  }
+
+  reloadResults(newBchResults);
+}
+
+void PlotterHeatmap::reloadResults(const BenchResults& newBchResults) {
+  // Plotted benchmarks (all of them, or previous ones matched by names)
+  QVector<int> newBenchIdxs = mAllIndexes
+                                  ? newBchResults.segmentAll()
+                                  : newBchResults.matchBenchmarks(mBchResults, mBenchIdxs);
+  if (newBenchIdxs.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload", "No plotted benchmarks in reloaded results");
+    return;
+  }
+  mBenchIdxs = newBenchIdxs;
+  mBchResults = newBchResults;
+
+  loadGrids(mBchResults);
+  updateGrid();
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterHeatmap::onSnapshotClicked() {
+  QString fileName =
+      QFileDialog::getSaveFileName(this, tr("Save snapshot"), "", tr("Images (*.png)"));
+
+  if (!fileName.isEmpty()) {
+    QPixmap pixmap = mView->grab();
+
+    bool ok = pixmap.save(fileName, "PNG");
+    if (!ok)
+      QMessageBox::warning(this, "Chart snapshot", "Error saving snapshot file.");
+  }
+}
@@ -0,0 +1,646 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "plotter_historychart.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QCursor>
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QSet>
+#include <QToolTip>
+#include <QtCharts>
+
+#include "benchmark_results.h"
+#include "result_parser.h"
+#include "ui_plotter_historychart.h"
+
+// Maximum number of run labels on X-axis
+static constexpr int kMaxRunLabels = 20;
+
+// Parse original results file with its additional files
+static BenchResults parseResults(const QString& origFilename,
+                                 const QVector<FileReload>& addFilenames, QString& errorMsg) {
+  BenchResults bchResults = ResultParser::parseResultsFile(origFilename, errorMsg);
+  if (bchResults.benchmarks.isEmpty()) {
+    errorMsg = "Error parsing original file: " + origFilename + " -> " + errorMsg;
+    return bchResults;
+  }
+  for (const auto& addFile : addFilenames) {
+    errorMsg.clear();
+    BenchResults addResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
+    if (addResults.benchmarks.isEmpty()) {
+      errorMsg = "Error parsing additional file: " + addFile.filename + " -> " + errorMsg;
+      return BenchResults();
+    }
+    if (addFile.isAppend)
+      bchResults.appendResults(addResults);
+    else
+      bchResults.overwriteResults(addResults);
+  }
+  return bchResults;
+}
+
+PlotterHistoryChart::PlotterHistoryChart(const BenchResults& bchResults,
+                                         const QVector<int>& bchIdxs,
+                                         const PlotParams& plotParams,
+                                         const QString& origFilename,
+                                         const QVector<FileReload>& addFilenames, QWidget* parent)
+    : QWidget(parent)
+    , ui(new Ui::PlotterHistoryChart)
+    , mPlotParams(plotParams)
+    , mOrigFilename(origFilename)
+    , mAddFilenames(addFilenames)
+    , mTimeUnit(bchResults.meta.time_unit)
+    , mWatcher(parent) {
+  // UI
+  ui->setupUi(this);
+  this->setAttribute(Qt::WA_DeleteOnClose);
+
+  QFileInfo fileInfo(origFilename);
+  this->setWindowTitle("History - " + fileInfo.fileName());
+
+  // One series per selected benchmark
+  QStringList names;
+  for (int idx : bchIdxs)
+    names.append(bchResults.benchmarks[idx].run_name);
+  names.removeDuplicates();
+  mSeries.resize(names.size());
+  for (int idx = 0; idx < names.size(); ++idx)
+    mSeries[idx].name = names[idx];
+
+  connectUI();
+
+  // Init
+  setupChart();
+  setupOptions();
+
+  // Show
+  ui->horizontalLayout->insertWidget(0, mChartView);
+}
+
+PlotterHistoryChart::~PlotterHistoryChart() {
+  // Save options to file
+  saveConfig();
+
+  delete ui;
+}
+
+void PlotterHistoryChart::connectUI() {
+  // Theme
+  ui->comboBoxTheme->addItem("Light", QChart::ChartThemeLight);
+  ui->comboBoxTheme->addItem("Blue Cerulean", QChart::ChartThemeBlueCerulean);
+  ui->comboBoxTheme->addItem("Dark", QChart::ChartThemeDark);
+  ui->comboBoxTheme->addItem("Brown Sand", QChart::ChartThemeBrownSand);
+  ui->comboBoxTheme->addItem("Blue Ncs", QChart::ChartThemeBlueNcs);
+  ui->comboBoxTheme->addItem("High Contrast", QChart::ChartThemeHighContrast);
+  ui->comboBoxTheme->addItem("Blue Icy", QChart::ChartThemeBlueIcy);
+  ui->comboBoxTheme->addItem("Qt", QChart::ChartThemeQt);
+  connect(ui->comboBoxTheme, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterHistoryChart::onComboThemeChanged);
+
+  // Legend
+  connect(ui->checkBoxLegendVisible, &QCheckBox::stateChanged, this,
+          &PlotterHistoryChart::onCheckLegendVisible);
+
+  if (!isYTimeBased(mPlotParams.yType))
+    ui->comboBoxTimeUnit->setEnabled(false);
+  else {
+    ui->comboBoxTimeUnit->addItem("ns", 1000.);
+    ui->comboBoxTimeUnit->addItem("us", 1.);
+    ui->comboBoxTimeUnit->addItem("ms", 0.001);
+    connect(ui->comboBoxTimeUnit, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            &PlotterHistoryChart::onComboTimeUnitChanged);
+  }
+
+  ui->comboBoxRunAxis->addItem("Date", true);
+  ui->comboBoxRunAxis->addItem("Label", false);
+  connect(ui->comboBoxRunAxis, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterHistoryChart::onComboRunAxisChanged);
+
+  // Change points
+  connect(ui->checkBoxChangePoints, &QCheckBox::stateChanged, this,
+          &PlotterHistoryChart::onCheckChangePoints);
+  connect(ui->doubleSpinBoxThreshold, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this,
+          &PlotterHistoryChart::onSpinThresholdChanged);
+
+  // Actions
+  connect(ui->pushButtonRecord, &QPushButton::clicked, this,
+          &PlotterHistoryChart::onRecordClicked);
+  connect(&mWatcher, &QFileSystemWatcher::fileChanged, this, &PlotterHistoryChart::onAutoReload);
+  connect(ui->checkBoxAutoReload, &QCheckBox::stateChanged, this,
+          &PlotterHistoryChart::onCheckAutoReload);
+  connect(ui->pushButtonReload, &QPushButton::clicked, this,
+          &PlotterHistoryChart::onReloadClicked);
+  connect(ui->pushButtonSnapshot, &QPushButton::clicked, this,
+          &PlotterHistoryChart::onSnapshotClicked);
+}
+
+void PlotterHistoryChart::setupChart() {
+  QChart* chart = new QChart();
+
+  // Time unit
+  mCurrentTimeFactor = 1.;
+  if (isYTimeBased(mPlotParams.yType)) {
+    if (mTimeUnit == "ns")
+      mCurrentTimeFactor = 1000.;
+    else if (mTimeUnit == "ms")
+      mCurrentTimeFactor = 0.001;
+  }
+
+  // Store (created empty if needed, so that it can be watched)
+  QString errorMsg;
+  if (!QFileInfo::exists(QDir(mStore.dirPath()).filePath("runs.log"))) {
+    HistoryStore newStore(mStore.dirPath());
+    newStore.open(errorMsg);
+  }
+  if (!mStore.open(errorMsg, true)) {
+    qWarning() << errorMsg;
+    chart->setTitle(errorMsg);
+  }
+
+  // History
+  // X: run date or label
+  // Y: time/iter/bytes/items
+  // Line: one per benchmark, with change points markers
+  for (size_t idx = 0; idx < mSeries.size(); ++idx) {
+    auto& series = mSeries[idx];
+
+    series.line = new QLineSeries();
+    series.line->setName(series.name.toHtmlEscaped());
+    series.line->setPointsVisible(true);
+    chart->addSeries(series.line);
+
+    series.changes = new QScatterSeries();
+    series.changes->setName(series.name.toHtmlEscaped());
+    series.changes->setMarkerShape(QScatterSeries::MarkerShapeRectangle);
+    series.changes->setMarkerSize(11.);
+    chart->addSeries(series.changes);
+
+    // Tooltips
+    connect(series.line, &QXYSeries::hovered, this, [this, idx](const QPointF& point, bool state) {
+      if (state)
+        showPointTip(mSeries[idx], point, false);
+      else
+        QToolTip::hideText();
+    });
+    connect(series.changes, &QXYSeries::hovered, this,
+            [this, idx](const QPointF& point, bool state) {
+              if (state)
+                showPointTip(mSeries[idx], point, true);
+              else
+                QToolTip::hideText();
+            });
+  }
+
+  // Y-axis (X-axis created with data)
+  QValueAxis* yAxis = new QValueAxis();
+  chart->addAxis(yAxis, Qt::AlignLeft);
+  for (auto* series : chart->series())
+    series->attachAxis(yAxis);
+
+  // View
+  mChartView = new QChartView(chart, this);
+  mChartView->setRenderHint(QPainter::Antialiasing);
+}
+
+void PlotterHistoryChart::setupOptions() {
+  auto chart = mChartView->chart();
+
+  // General
+  chart->setTheme(QChart::ChartThemeLight);
+  chart->legend()->setAlignment(Qt::AlignTop);
+  chart->legend()->setShowToolTips(true);
+
+  mIgnoreEvents = true;
+
+  // Time unit
+  if (mCurrentTimeFactor > 1.)
+    ui->comboBoxTimeUnit->setCurrentIndex(0);  // ns
+  else if (mCurrentTimeFactor < 1.)
+    ui->comboBoxTimeUnit->setCurrentIndex(2);  // ms
+  else
+    ui->comboBoxTimeUnit->setCurrentIndex(1);  // us
+
+  // Load options from file
+  loadConfig();
+  mIgnoreEvents = false;
+
+  // Apply actions
+  onComboThemeChanged(ui->comboBoxTheme->currentIndex());
+  onCheckChangePoints(ui->checkBoxChangePoints->checkState());
+  if (ui->checkBoxAutoReload->isChecked())
+    onCheckAutoReload(Qt::Checked);
+
+  // History
+  updateHistory(true);
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterHistoryChart::loadConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("history");
+
+  if (auto value = settings.value("autoReload"); value.isValid())
+    ui->checkBoxAutoReload->setChecked(value.toBool());
+
+  if (auto value = settings.value("theme"); value.isValid())
+    ui->comboBoxTheme->setCurrentText(value.toString());
+
+  if (auto value = settings.value("legend/visible"); value.isValid())
+    ui->checkBoxLegendVisible->setChecked(value.toBool());
+
+  if (auto value = settings.value("runAxis"); value.isValid())
+    ui->comboBoxRunAxis->setCurrentText(value.toString());
+
+  if (auto value = settings.value("changePoints/visible"); value.isValid())
+    ui->checkBoxChangePoints->setChecked(value.toBool());
+  if (auto value = settings.value("changePoints/threshold"); value.isValid())
+    ui->doubleSpinBoxThreshold->setValue(value.toDouble());
+
+  settings.endGroup();
+}
+
+void PlotterHistoryChart::saveConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("history");
+
+  settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
+  settings.setValue("theme", ui->comboBoxTheme->currentText());
+  settings.setValue("legend/visible", ui->checkBoxLegendVisible->isChecked());
+  settings.setValue("runAxis", ui->comboBoxRunAxis->currentText());
+  settings.setValue("changePoints/visible", ui->checkBoxChangePoints->isChecked());
+  settings.setValue("changePoints/threshold", ui->doubleSpinBoxThreshold->value());
+
+  settings.endGroup();
+}
+
+/**************************************************************************************************
+ *
+ * History
+ *
+ **************************************************************************************************/
+
+void PlotterHistoryChart::updateHistory(bool reset) {
+  // Positions are kept if new runs are the most recent ones
+  const QVector<int>& runOrder = mStore.runsByDate();
+  if (runOrder.size() < mRunOrder.size() ||
+      !std::equal(mRunOrder.cbegin(), mRunOrder.cend(), runOrder.cbegin()))
+    reset = true;
+  mRunOrder = runOrder;
+  mRunPositions.resize(mRunOrder.size());
+  for (int pos = 0; pos < mRunOrder.size(); ++pos)
+    mRunPositions[mRunOrder[pos]] = pos;
+
+  for (auto& series : mSeries) {
+    const QVector<HistoryPoint> history = mStore.history(series.name, mPlotParams.yType);
+
+    // Only feed new runs if plotted ones are unchanged
+    const bool isAppend =
+        !reset && history.size() >= series.runIdxs.size() &&
+        std::equal(series.runIdxs.cbegin(), series.runIdxs.cend(), history.cbegin(),
+                   [](int runIdx, const HistoryPoint& point) { return runIdx == point.runIdx; });
+    if (!isAppend) {
+      series.runIdxs.clear();
+      series.values.clear();
+      series.detector = ChangePointDetector(ui->doubleSpinBoxThreshold->value());
+      series.line->clear();
+    }
+
+    bool hasNewChanges = !isAppend;
+    QList<QPointF> newPoints;
+    for (qsizetype idx = series.runIdxs.size(); idx < history.size(); ++idx) {
+      const HistoryPoint& point = history[idx];
+      series.runIdxs.append(point.runIdx);
+      series.values.append(point.value);
+      newPoints.append(QPointF(getRunX(point.runIdx), point.value * mCurrentTimeFactor));
+      hasNewChanges |= series.detector.append(point.value);
+    }
+    if (!newPoints.isEmpty())
+      series.line->append(newPoints);
+    if (hasNewChanges)
+      updateChangePoints(series);
+  }
+
+  updateAxes();
+}
+
+void PlotterHistoryChart::updatePoints(HistorySeries& series) {
+  QList<QPointF> points;
+  points.reserve(series.values.size());
+  for (qsizetype idx = 0; idx < series.values.size(); ++idx)
+    points.append(
+        QPointF(getRunX(series.runIdxs[idx]), series.values[idx] * mCurrentTimeFactor));
+  series.line->replace(points);
+
+  updateChangePoints(series);
+}
+
+void PlotterHistoryChart::updateChangePoints(HistorySeries& series) {
+  QList<QPointF> points;
+  for (int idx : series.detector.changePoints())
+    points.append(
+        QPointF(getRunX(series.runIdxs[idx]), series.values[idx] * mCurrentTimeFactor));
+  series.changes->replace(points);
+}
+
+void PlotterHistoryChart::updateAxes() {
+  auto chart = mChartView->chart();
+  const auto& runs = mStore.runs();
+
+  // X-axis (re-created, labels depend on runs)
+  const auto xAxes = chart->axes(Qt::Horizontal);
+  if (!xAxes.empty()) {
+    chart->removeAxis(xAxes.constFirst());
+    delete xAxes.constFirst();
+  }
+
+  QAbstractAxis* xAxis = nullptr;
+  if (ui->comboBoxRunAxis->currentData().toBool()) {
+    QDateTimeAxis* dateAxis = new QDateTimeAxis();
+    dateAxis->setTitleText("Run date");
+    dateAxis->setFormat("yyyy-MM-dd");
+    dateAxis->setTickCount(7);
+    if (!mRunOrder.isEmpty()) {
+      QDateTime minDate = runs[mRunOrder.constFirst()].date;
+      QDateTime maxDate = runs[mRunOrder.constLast()].date;
+      if (minDate == maxDate) {
+        minDate = minDate.addDays(-1);
+        maxDate = maxDate.addDays(1);
+      }
+      dateAxis->setRange(minDate, maxDate);
+    }
+    xAxis = dateAxis;
+  } else {
+    QCategoryAxis* runAxis = new QCategoryAxis();
+    runAxis->setTitleText("Run");
+    runAxis->setLabelsPosition(QCategoryAxis::AxisLabelsPositionOnValue);
+    runAxis->setStartValue(-1.);
+
+    // Unique labels, evenly spread
+    QSet<QString> usedLabels;
+    const int step = std::max<int>(1, std::ceil(mRunOrder.size() / double(kMaxRunLabels)));
+    for (int pos = 0; pos < mRunOrder.size(); pos += step) {
+      QString label = runs[mRunOrder[pos]].label;
+      if (usedLabels.contains(label))
+        label += " #" + QString::number(pos + 1);
+      usedLabels.insert(label);
+      runAxis->append(label, pos);
+    }
+    runAxis->setRange(-0.5, std::max<qsizetype>(mRunOrder.size(), 1) - 0.5);
+    xAxis = runAxis;
+  }
+  chart->addAxis(xAxis, Qt::AlignBottom);
+  for (auto* series : chart->series())
+    series->attachAxis(xAxis);
+
+  // Y-axis
+  const auto yAxes = chart->axes(Qt::Vertical);
+  if (yAxes.empty())
+    return;
+  QValueAxis* yAxis = (QValueAxis*)(yAxes.constFirst());
+  yAxis->setTitleText(getYPlotName(mPlotParams.yType, ui->comboBoxTimeUnit->currentText()));
+
+  double yMin = 0., yMax = 0.;
+  bool hasPoints = false;
+  for (const auto& series : mSeries) {
+    if (series.values.isEmpty())
+      continue;
+    const auto [minIt, maxIt] = std::minmax_element(series.values.cbegin(), series.values.cend());
+    yMin = hasPoints ? std::min(yMin, *minIt) : *minIt;
+    yMax = hasPoints ? std::max(yMax, *maxIt) : *maxIt;
+    hasPoints = true;
+  }
+  if (hasPoints) {
+    const double margin = (yMax > yMin) ? (yMax - yMin) * 0.05 : std::max(std::abs(yMax), 1.);
+    yAxis->setRange(std::max(0., yMin - margin) * mCurrentTimeFactor,
+                    (yMax + margin) * mCurrentTimeFactor);
+    yAxis->applyNiceNumbers();
+    if (chart->title() == "No recorded runs for selected benchmarks")
+      chart->setTitle("");
+  } else if (chart->title().isEmpty())
+    chart->setTitle("No recorded runs for selected benchmarks");
+}
+
+double PlotterHistoryChart::getRunX(int runIdx) const {
+  if (ui->comboBoxRunAxis->currentData().toBool())
+    return mStore.runs()[runIdx].date.toMSecsSinceEpoch();
+  return mRunPositions[runIdx];
+}
+
+QString PlotterHistoryChart::getRunText(const HistorySeries& series, int pointIdx) const {
+  const HistoryRun& run = mStore.runs()[series.runIdxs[pointIdx]];
+  QString text = series.name + "\n" + run.label + " (" + run.date.toString("yyyy-MM-dd HH:mm") +
+                 ")\n" + QString::number(series.values[pointIdx] * mCurrentTimeFactor, 'g', 4);
+  if (isYTimeBased(mPlotParams.yType))
+    text += " " + ui->comboBoxTimeUnit->currentText();
+  return text;
+}
+
+void PlotterHistoryChart::showPointTip(const HistorySeries& series, const QPointF& point,
+                                       bool isChange) {
+  if (series.runIdxs.isEmpty())
+    return;
+
+  // Nearest plotted run
+  auto it = std::lower_bound(series.runIdxs.cbegin(), series.runIdxs.cend(), point.x(),
+                             [this](int runIdx, double x) { return getRunX(runIdx) < x; });
+  int pointIdx = it - series.runIdxs.cbegin();
+  if (pointIdx == series.runIdxs.size() ||
+      (pointIdx > 0 && point.x() - getRunX(series.runIdxs[pointIdx - 1]) <
+                           getRunX(series.runIdxs[pointIdx]) - point.x()))
+    --pointIdx;
+  QString text = getRunText(series, pointIdx);
+
+  // Shift between segments means
+  const auto& changePoints = series.detector.changePoints();
+  const int changeIdx = changePoints.indexOf(pointIdx);
+  if (isChange && changeIdx >= 0) {
+    const int prevBegin = (changeIdx > 0) ? changePoints[changeIdx - 1] : 0;
+    const int nextBegin = (changeIdx + 1 < changePoints.size()) ? changePoints[changeIdx + 1]
+                                                                : series.values.size();
+    auto segmentMean = [&series](int begin, int end) {
+      double sum = 0.;
+      for (int idx = begin; idx < end; ++idx)
+        sum += series.values[idx];
+      return sum / (end - begin);
+    };
+    const double before = segmentMean(prevBegin, pointIdx);
+    const double after = segmentMean(pointIdx, nextBegin);
+    const double shift = (before != 0.) ? (after - before) / std::abs(before) * 100. : 0.;
+    text += "\nChange point: " + QString((shift >= 0.) ? "+" : "") +
+            QString::number(shift, 'f', 1) + "% (mean " +
+            QString::number(before * mCurrentTimeFactor, 'g', 4) + " -> " +
+            QString::number(after * mCurrentTimeFactor, 'g', 4) + ")";
+  }
+
+  QToolTip::showText(QCursor::pos(), text, mChartView);
+}
+
+/**************************************************************************************************
+ *
+ * Options
+ *
+ **************************************************************************************************/
+
+//
+// Theme
+void PlotterHistoryChart::onComboThemeChanged(int index) {
+  QChart::ChartTheme theme =
+      static_cast<QChart::ChartTheme>(ui->comboBoxTheme->itemData(index).toInt());
+  auto chart = mChartView->chart();
+  chart->setTheme(theme);
+
+  // Change points colored as their line, without legend entry
+  for (auto& series : mSeries) {
+    series.changes->setColor(series.line->color());
+    const auto markers = chart->legend()->markers(series.changes);
+    for (auto* marker : markers)
+      marker->setVisible(false);
+  }
+}
+
+//
+// Legend
+void PlotterHistoryChart::onCheckLegendVisible(int state) {
+  mChartView->chart()->legend()->setVisible(state == Qt::Checked);
+}
+
+void PlotterHistoryChart::onComboTimeUnitChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+
+  mCurrentTimeFactor = ui->comboBoxTimeUnit->currentData().toDouble();
+  for (auto& series : mSeries)
+    updatePoints(series);
+  updateAxes();
+}
+
+void PlotterHistoryChart::onComboRunAxisChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+
+  for (auto& series : mSeries)
+    updatePoints(series);
+  updateAxes();
+}
+
+//
+// Change points
+void PlotterHistoryChart::onCheckChangePoints(int state) {
+  for (auto& series : mSeries)
+    series.changes->setVisible(state == Qt::Checked);
+}
+
+void PlotterHistoryChart::onSpinThresholdChanged(double d) {
+  if (mIgnoreEvents)
+    return;
+
+  // Detection parameters changed, all history processed again
+  for (auto& series : mSeries) {
+    series.detector = ChangePointDetector(d);
+    for (double value : std::as_const(series.values))
+      series.detector.append(value);
+    updateChangePoints(series);
+  }
+}
+
+/**************************************************************************************************
+ *
+ * Actions
+ *
+ **************************************************************************************************/
+
+void PlotterHistoryChart::onRecordClicked() {
+  // Current results
+  QString errorMsg;
+  BenchResults bchResults = parseResults(mOrigFilename, mAddFilenames, errorMsg);
+  if (bchResults.benchmarks.isEmpty()) {
+    QMessageBox::critical(this, "Record run", errorMsg);
+    return;
+  }
+
+  bool ok = false;
+  const QString label =
+      QInputDialog::getText(this, "Record run", "Run label (e.g. commit):", QLineEdit::Normal,
+                            QFileInfo(mOrigFilename).fileName(), &ok);
+  if (!ok)
+    return;
+
+  // Append through a writable store (this one stays read-only)
+  HistoryStore store(mStore.dirPath());
+  if (!store.open(errorMsg) || !store.addRun(bchResults, mOrigFilename, label, errorMsg)) {
+    QMessageBox::critical(this, "Record run", errorMsg);
+    return;
+  }
+  if (!ui->checkBoxAutoReload->isChecked())
+    onReloadClicked();
+}
+
+void PlotterHistoryChart::onCheckAutoReload(int state) {
+  if (state == Qt::Checked) {
+    if (mWatcher.files().empty())
+      mWatcher.addPath(QDir(mStore.dirPath()).filePath("runs.log"));
+  } else {
+    if (!mWatcher.files().empty())
+      mWatcher.removePaths(mWatcher.files());
+  }
+}
+
+void PlotterHistoryChart::onAutoReload(const QString& path) {
+  QFileInfo fi(path);
+  if (fi.exists() && fi.isReadable())
+    onReloadClicked();
+  else
+    qWarning() << "Unable to auto-reload file: " << path;
+}
+
+void PlotterHistoryChart::onReloadClicked() {
+  // Runs recorded since last load
+  QString errorMsg;
+  if (!mStore.open(errorMsg, true)) {
+    QMessageBox::critical(this, "Chart reload", errorMsg);
+    return;
+  }
+  updateHistory(false);
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterHistoryChart::onSnapshotClicked() {
+  QString fileName =
+      QFileDialog::getSaveFileName(this, tr("Save snapshot"), "", tr("Images (*.png)"));
+
+  if (!fileName.isEmpty()) {
+    QPixmap pixmap = mChartView->grab();
+
+    bool ok = pixmap.save(fileName, "PNG");
+    if (!ok)
+      QMessageBox::warning(this, "Chart snapshot", "Error saving snapshot file.");
+  }
+}
@@ -15,16 +15,31 @@
 
 #include "plotter_linechart.h"
 
+#include <cmath>
+#include <limits>
+
 #include <QDateTime>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QToolTip>
 #include <QtCharts>
 
+#include "bench_statistics.h"
 #include "benchmark_results.h"
+#include "chart_error_bars.h"
+#include "chart_hover.h"
+#include "complexity_fit.h"
 #include "result_parser.h"
 #include "ui_plotter_linechart.h"
 
+// Complexity combo special items (models otherwise)
+static constexpr int kFitNone = -1;
+static constexpr int kFitAuto = -2;
+static constexpr int kFitReported = -3;
+
+static const int kFitSamples = 64;  // points per fitted curve
+
 PlotterLineChart::PlotterLineChart(const BenchResults& bchResults, const QVector<int>& bchIdxs,
                                    const PlotParams& plotParams, const QString& origFilename,
                                    const QVector<FileReload>& addFilenames, QWidget* parent)
@@ -46,9 +61,6 @@ PlotterLineChart::PlotterLineChart(const BenchResults& bchResults, const QVector
 
   connectUI();
 
-  // TODO: select points
-  // See: https://doc.qt.io/qt-5/qtcharts-callout-example.html
-
   // Init
   setupChart(bchResults, bchIdxs, plotParams);
   setupOptions();
@@ -103,6 +115,29 @@ void PlotterLineChart::connectUI() {
             &PlotterLineChart::onComboTimeUnitChanged);
   }
 
+  if (getYPlotStatistic(mPlotParams.yType) == BootstrapNone)
+    ui->checkBoxErrorBars->setEnabled(false);
+  else
+    connect(ui->checkBoxErrorBars, &QCheckBox::stateChanged, this,
+            &PlotterLineChart::onCheckErrorBars);
+  connect(ui->comboBoxBaseline, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterLineChart::onComboBaselineChanged);
+
+  ui->comboBoxComplexity->addItem("None", kFitNone);
+  ui->comboBoxComplexity->addItem("Best fit", kFitAuto);
+  ui->comboBoxComplexity->addItem("Reported (BigO)", kFitReported);
+  ui->comboBoxComplexity->addItem("O(1)", ComplexityO1);
+  ui->comboBoxComplexity->addItem("O(log n)", ComplexityOLogN);
+  ui->comboBoxComplexity->addItem("O(n)", ComplexityON);
+  ui->comboBoxComplexity->addItem("O(n log n)", ComplexityONLogN);
+  ui->comboBoxComplexity->addItem("O(n²)", ComplexityON2);
+  ui->comboBoxComplexity->addItem("O(n³)", ComplexityON3);
+  ui->comboBoxComplexity->addItem("Custom", ComplexityCustom);
+  connect(ui->comboBoxComplexity, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterLineChart::onComboComplexityChanged);
+  connect(ui->lineEditComplexity, &QLineEdit::editingFinished, this,
+          &PlotterLineChart::onEditComplexityFinished);
+
   // Axes
   ui->comboBoxAxis->addItem("X-Axis");
   ui->comboBoxAxis->addItem("Y-Axis");
@@ -151,6 +186,9 @@ void PlotterLineChart::setupChart(const BenchResults& bchResults, const QVector<
   } else {  // Re-init
     chart = mChartView->chart();
     chart->setTitle("");
+    mErrorBars->clear();
+    mHover->clear();
+    clearComplexityFits();
     chart->removeAllSeries();
     const auto xAxes = chart->axes(Qt::Horizontal);
     if (!xAxes.empty())
@@ -159,8 +197,10 @@ void PlotterLineChart::setupChart(const BenchResults& bchResults, const QVector<
     if (!yAxes.empty())
       chart->removeAxis(yAxes.constFirst());
     mSeriesMapping.clear();
+    mBchSubsets.clear();
   }
   Q_ASSERT(chart);
+  mBchResults = bchResults;
 
   // Time unit
   mCurrentTimeFactor = 1.;
@@ -199,9 +239,9 @@ void PlotterLineChart::setupChart(const BenchResults& bchResults, const QVector<
 
     double xFallback = 0.;
     for (int idx : bchSubset.idxs) {
-      QString xName =
-          bchResults.getParamName(plotParams.xType == PlotArgumentType, idx, plotParams.xIdx);
-      double xVal = BenchResults::getParamValue(xName, custDataName, custDataAxis, xFallback);
+      const BenchParam& xParam =
+          bchResults.getParam(plotParams.xType == PlotArgumentType, idx, plotParams.xIdx);
+      double xVal = BenchResults::getParamValue(xParam, custDataName, custDataAxis, xFallback);
 
       // Add point
       series->append(
@@ -210,6 +250,7 @@ void PlotterLineChart::setupChart(const BenchResults& bchResults, const QVector<
     // Add series
     series->setName(subsetName.toHtmlEscaped());
     mSeriesMapping.push_back({subsetName, subsetName});  // color set later
+    mBchSubsets.push_back(bchSubset);
     chart->addSeries(series.take());
   }
 
@@ -238,10 +279,19 @@ void PlotterLineChart::setupChart(const BenchResults& bchResults, const QVector<
     chart->setTitle("No series with at least 2 points to display");
 
   if (init) {
+    // Error bars drawn over series
+    mErrorBars = new ChartErrorBars(chart);
+
     // View
     mChartView = new QChartView(scopedChart.take(), this);
     mChartView->setRenderHint(QPainter::Antialiasing);
+
+    // Points tooltips
+    mHover = new ChartHover(mChartView);
+    connect(mHover, &ChartHover::hovered, this, &PlotterLineChart::onPointHovered);
   }
+  updateHoverItems();
+  updateBaselineChoices();
 }
 
 void PlotterLineChart::setupOptions(bool init) {
@@ -326,6 +376,7 @@ void PlotterLineChart::setupOptions(bool init) {
   // Apply actions
   if (ui->checkBoxAutoReload->isChecked())
     onCheckAutoReload(Qt::Checked);
+  updateErrorBars();
 
   // Update series color config
   const auto& chartSeries = chart->series();
@@ -342,11 +393,16 @@ void PlotterLineChart::setupOptions(bool init) {
     if (config.newName != config.oldName)
       series->setName(config.newName.toHtmlEscaped());
   }
+  updateComplexityFits();
 
   // Restore selected axis
   if (!init)
     ui->comboBoxAxis->setCurrentIndex(prevAxisIdx);
 
+  // Ratios to loaded (or kept) baseline
+  if (mRelative || ui->comboBoxBaseline->currentIndex() > 0)
+    updateSeriesValues();
+
   // Update timestamp
   QDateTime today = QDateTime::currentDateTime();
   QTime now = today.time();
@@ -366,6 +422,28 @@ void PlotterLineChart::loadConfig(bool init) {
   if (auto value = settings.value("theme"); value.isValid())
     ui->comboBoxTheme->setCurrentText(value.toString());
 
+  if (auto value = settings.value("errorBars"); value.isValid()) {
+    const QSignalBlocker blocker(ui->checkBoxErrorBars);  // applied once options are set
+    ui->checkBoxErrorBars->setChecked(value.toBool());
+  }
+  if (auto value = settings.value("complexity/custom"); value.isValid()) {
+    QString errorMsg;
+    ui->lineEditComplexity->setText(value.toString());
+    if (!mCustomComplexity.parse(value.toString(), errorMsg))
+      mCustomComplexity = ComplexityExpression();
+  }
+  if (auto value = settings.value("complexity/model"); value.isValid()) {
+    const QSignalBlocker blocker(ui->comboBoxComplexity);  // applied once options are set
+    ui->comboBoxComplexity->setCurrentText(value.toString());
+    ui->lineEditComplexity->setEnabled(ui->comboBoxComplexity->currentData().toInt() ==
+                                       ComplexityCustom);
+  }
+  if (auto value = settings.value("baseline"); value.isValid()) {
+    const QSignalBlocker blocker(ui->comboBoxBaseline);  // applied once options are set
+    if (int idx = ui->comboBoxBaseline->findText(value.toString()); idx >= 0)
+      ui->comboBoxBaseline->setCurrentIndex(idx);
+  }
+
   if (auto value = settings.value("legend/visible"); value.isValid())
     ui->checkBoxLegendVisible->setChecked(value.toBool());
   if (auto value = settings.value("legend/align"); value.isValid())
@@ -463,6 +541,10 @@ void PlotterLineChart::saveConfig() {
   settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
   settings.setValue("timeUnit", ui->comboBoxTimeUnit->currentText());
   settings.setValue("theme", ui->comboBoxTheme->currentText());
+  settings.setValue("errorBars", ui->checkBoxErrorBars->isChecked());
+  settings.setValue("complexity/model", ui->comboBoxComplexity->currentText());
+  settings.setValue("complexity/custom", ui->lineEditComplexity->text());
+  settings.setValue("baseline", ui->comboBoxBaseline->currentText());
 
   settings.setValue("legend/visible", ui->checkBoxLegendVisible->isChecked());
   settings.setValue("legend/align", ui->comboBoxLegendAlign->currentText());
@@ -485,12 +567,14 @@ void PlotterLineChart::saveConfig() {
     settings.setValue(prefix + "/title", axis.title);
     settings.setValue(prefix + "/log", axis.log);
     settings.setValue(prefix + "/logBase", axis.logBase);
-    settings.setValue(prefix + "/titleText", axis.titleText);
     settings.setValue(prefix + "/titleSize", axis.titleSize);
     settings.setValue(prefix + "/labelFormat", axis.labelFormat);
     settings.setValue(prefix + "/labelSize", axis.labelSize);
-    settings.setValue(prefix + "/min", axis.min);
-    settings.setValue(prefix + "/max", axis.max);
+    if (i == 0 || !mRelative) {  // ratios title and range not kept for plotted values
+      settings.setValue(prefix + "/titleText", axis.titleText);
+      settings.setValue(prefix + "/min", axis.min);
+      settings.setValue(prefix + "/max", axis.max);
+    }
     settings.setValue(prefix + "/ticks", axis.ticks);
     settings.setValue(prefix + "/mticks", axis.mticks);
   }
@@ -518,6 +602,7 @@ void PlotterLineChart::onComboThemeChanged(int index) {
     else
       config.newColor = config.oldColor;  // sync with theme
   }
+  updateComplexityFits();
 
   // Re-apply font sizes
   onSpinLegendFontSizeChanged(ui->spinBoxLegendFontSize->value());
@@ -562,6 +647,8 @@ void PlotterLineChart::onSeriesEditClicked() {
       }
     }
     mSeriesMapping = newMapping;
+    mErrorBars->update();  // colors
+    updateComplexityFits();
   }
 }
 
@@ -608,6 +695,309 @@ void PlotterLineChart::onComboTimeUnitChanged(int /*index*/) {
   }
 
   mCurrentTimeFactor = unitFactor;
+  mErrorBars->setScale(mCurrentTimeFactor);
+  updateComplexityFits();  // coefficients
+  updateHoverItems();
+}
+
+void PlotterLineChart::onCheckErrorBars(int /*state*/) { updateErrorBars(); }
+
+void PlotterLineChart::onComboBaselineChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+  updateSeriesValues();
+}
+
+void PlotterLineChart::onPointHovered(int benchIdx) {
+  if (benchIdx < 0) {
+    QToolTip::hideText();
+    return;
+  }
+
+  QString text =
+      getBenchHoverText(mBchResults, benchIdx, mPlotParams.yType, mCurrentTimeFactor,
+                        getBenchInterval(mIntervals, mBchResults, benchIdx, mPlotParams.yType));
+  if (mRelative)
+    text += "\nRatio to " + ui->comboBoxBaseline->currentText() + ": " +
+            QString::number(mRatios.value(benchIdx), 'g', 4);
+  QToolTip::showText(QCursor::pos(), text, mChartView);
+}
+
+void PlotterLineChart::updateHoverItems() {
+  mHover->clear();
+  const auto chartSeries = mChartView->chart()->series();
+  for (int seriesIdx = 0; seriesIdx < mBchSubsets.size(); ++seriesIdx) {
+    auto series = (QXYSeries*)chartSeries.at(seriesIdx);
+    const auto& idxs = mBchSubsets[seriesIdx].idxs;
+    for (int pointIdx = 0, plotIdx = 0; pointIdx < idxs.size(); ++pointIdx) {
+      if (mRelative && !mRatios.contains(idxs[pointIdx]))
+        continue;  // missing ratio (not plotted)
+      mHover->addItem(series, QRectF(series->at(plotIdx++), QSizeF()), idxs[pointIdx]);
+    }
+  }
+}
+
+// Reference choices of plotted series: series, then JOMT containers (selection kept by name)
+void PlotterLineChart::updateBaselineChoices() {
+  mBaseline.build(mBchResults, mBchSubsets, mPlotParams);
+
+  const QString prevText = ui->comboBoxBaseline->currentText();
+  const QSignalBlocker blocker(ui->comboBoxBaseline);
+  ui->comboBoxBaseline->clear();
+  ui->comboBoxBaseline->addItem("None", QList<QVariant>{BaselineNone, -1});
+  for (int idx = 0; idx < mBchSubsets.size(); ++idx)
+    ui->comboBoxBaseline->addItem(mBchSubsets[idx].name, QList<QVariant>{BaselineSeries, idx});
+  const auto& containers = mBaseline.containers();
+  for (int idx = 0; idx < containers.size(); ++idx)
+    ui->comboBoxBaseline->addItem(containers[idx] + " (container)",
+                                  QList<QVariant>{BaselineContainer, idx});
+  if (int idx = ui->comboBoxBaseline->findText(prevText); idx > 0)
+    ui->comboBoxBaseline->setCurrentIndex(idx);
+}
+
+// Series points as plotted values, or as ratios to baseline at same X (missing ratios skipped)
+void PlotterLineChart::updateSeriesValues(bool fitRange) {
+  const QList<QVariant> choice = ui->comboBoxBaseline->currentData().toList();
+  const auto kind = choice.isEmpty() ? BaselineNone : (BaselineKind)choice[0].toInt();
+  const bool wasRelative = mRelative;
+  mRelative = kind != BaselineNone;
+
+  mErrorBars->clear();
+  mHover->clear();
+  clearComplexityFits();
+  mRatios.clear();
+
+  // Ratios from values joined once (no lookup when baseline changes)
+  const int refIdx = (choice.size() > 1) ? choice[1].toInt() : -1;
+  const QVector<int> refs = mBaseline.getReferences(kind, refIdx);
+  const auto chartSeries = mChartView->chart()->series();
+  bool custDataAxis = true;
+  QString custDataName;
+  QList<QPointF> points;
+  for (int seriesIdx = 0; seriesIdx < mBchSubsets.size(); ++seriesIdx) {
+    const auto& idxs = mBchSubsets[seriesIdx].idxs;
+    const QVector<double> ratios =
+        mRelative ? mBaseline.getRatios(seriesIdx, refs[seriesIdx]) : QVector<double>();
+    points.clear();
+    double xFallback = 0.;
+    for (int pointIdx = 0; pointIdx < idxs.size(); ++pointIdx) {
+      const int idx = idxs[pointIdx];
+      const BenchParam& xParam =
+          mBchResults.getParam(mPlotParams.xType == PlotArgumentType, idx, mPlotParams.xIdx);
+      double xVal = BenchResults::getParamValue(xParam, custDataName, custDataAxis, xFallback);
+      if (!mRelative)
+        points.append({xVal, getYPlotValue(mBchResults.benchmarks[idx], mPlotParams.yType) *
+                                 mCurrentTimeFactor});
+      else if (!std::isnan(ratios[pointIdx])) {
+        points.append({xVal, ratios[pointIdx]});
+        mRatios.insert(idx, ratios[pointIdx]);
+      }
+    }
+    ((QXYSeries*)chartSeries.at(seriesIdx))->replace(points);
+  }
+
+  // Unitless ratios: time unit, intervals and complexity only apply to plotted values
+  ui->comboBoxTimeUnit->setEnabled(!mRelative && isYTimeBased(mPlotParams.yType));
+  ui->checkBoxErrorBars->setEnabled(!mRelative &&
+                                    getYPlotStatistic(mPlotParams.yType) != BootstrapNone);
+  ui->comboBoxComplexity->setEnabled(!mRelative);
+  ui->lineEditComplexity->setEnabled(
+      !mRelative && ui->comboBoxComplexity->currentData().toInt() == ComplexityCustom);
+
+  // Y-axis title (plotted values one restored)
+  if (mRelative) {
+    if (!wasRelative)
+      mAbsoluteTitle = mAxesParams[1].titleText;
+    onEditTitleChanged2("Ratio to " + ui->comboBoxBaseline->currentText(), 1);
+  } else if (wasRelative)
+    onEditTitleChanged2(mAbsoluteTitle, 1);
+  if (ui->comboBoxAxis->currentIndex() == 1) {
+    const QSignalBlocker blocker(ui->lineEditTitle);
+    ui->lineEditTitle->setText(mAxesParams[1].titleText);
+    ui->lineEditTitle->setCursorPosition(0);
+  }
+
+  if (fitRange || mRelative != wasRelative)
+    fitYRange();
+  updateErrorBars();
+  updateComplexityFits();
+  updateHoverItems();
+}
+
+// Y-range fitted to series points (e.g. after values changed to ratios)
+void PlotterLineChart::fitYRange() {
+  auto chart = mChartView->chart();
+  const auto yAxes = chart->axes(Qt::Vertical);
+  if (yAxes.isEmpty())
+    return;
+
+  double yMin = std::numeric_limits<double>::max();
+  double yMax = std::numeric_limits<double>::lowest();
+  const auto chartSeries = chart->series();
+  for (int seriesIdx = 0; seriesIdx < mBchSubsets.size(); ++seriesIdx) {
+    const auto points = ((QXYSeries*)chartSeries.at(seriesIdx))->points();
+    for (const auto& point : points) {
+      yMin = std::min(yMin, point.y());
+      yMax = std::max(yMax, point.y());
+    }
+  }
+  if (yMin > yMax)
+    return;  // no points
+  if (yMin == yMax) {  // flat (e.g. baseline itself), kept positive for log axis
+    const double margin = (yMin != 0.) ? std::abs(yMin) / 2. : 1.;
+    yMin -= margin;
+    yMax += margin;
+  }
+  if (yAxes.constFirst()->type() == QAbstractAxis::AxisTypeValue) {
+    auto yAxis = (QValueAxis*)yAxes.constFirst();
+    yAxis->setRange(yMin, yMax);
+    yAxis->applyNiceNumbers();
+    yMin = yAxis->min();
+    yMax = yAxis->max();
+  }
+
+  onSpinMinChanged2(yMin, 1);
+  onSpinMaxChanged2(yMax, 1);
+  if (ui->comboBoxAxis->currentIndex() == 1) {
+    const QSignalBlocker blockerMin(ui->doubleSpinBoxMin);
+    const QSignalBlocker blockerMax(ui->doubleSpinBoxMax);
+    ui->doubleSpinBoxMin->setValue(yMin);
+    ui->doubleSpinBoxMax->setValue(yMax);
+  }
+}
+
+void PlotterLineChart::updateErrorBars() {
+  mErrorBars->clear();
+  mIntervals.clear();
+  mErrorBars->setScale(mCurrentTimeFactor);
+  if (!ui->checkBoxErrorBars->isEnabled() || !ui->checkBoxErrorBars->isChecked())
+    return;
+
+  // Intervals of all points at once
+  QVector<int> bchIdxs;
+  for (const auto& bchSubset : std::as_const(mBchSubsets))
+    bchIdxs.append(bchSubset.idxs);
+  const auto intervals = bootstrapIntervals(mBchResults, bchIdxs, mPlotParams.yType);
+
+  const auto chartSeries = mChartView->chart()->series();
+  int intervalIdx = 0;
+  for (int seriesIdx = 0; seriesIdx < mBchSubsets.size(); ++seriesIdx) {
+    auto series = (QXYSeries*)chartSeries.at(seriesIdx);
+    for (int pointIdx = 0; pointIdx < mBchSubsets[seriesIdx].idxs.size(); ++pointIdx) {
+      const auto& interval = intervals[intervalIdx];
+      mIntervals.insert(bchIdxs[intervalIdx++], interval);
+      if (interval.isValid)
+        mErrorBars->addBar(series, series->at(pointIdx).x(), interval.low, interval.high);
+    }
+  }
+}
+
+void PlotterLineChart::onComboComplexityChanged(int /*index*/) {
+  ui->lineEditComplexity->setEnabled(ui->comboBoxComplexity->currentData().toInt() ==
+                                     ComplexityCustom);
+  updateComplexityFits();
+}
+
+void PlotterLineChart::onEditComplexityFinished() {
+  const QString text = ui->lineEditComplexity->text().trimmed();
+  if (text == mCustomComplexity.text())
+    return;
+
+  QString errorMsg;
+  if (!mCustomComplexity.parse(text, errorMsg)) {
+    mCustomComplexity = ComplexityExpression();
+    if (!text.isEmpty())
+      QMessageBox::warning(this, "Custom complexity", errorMsg);
+  }
+  updateComplexityFits();
+}
+
+void PlotterLineChart::clearComplexityFits() {
+  auto chart = mChartView->chart();
+  for (auto fitSeries : std::as_const(mFitSeries)) {
+    chart->removeSeries(fitSeries);
+    delete fitSeries;
+  }
+  mFitSeries.clear();
+}
+
+void PlotterLineChart::updateComplexityFits() {
+  clearComplexityFits();
+  const int fitType = ui->comboBoxComplexity->currentData().toInt();
+  if (fitType == kFitNone || mBchSubsets.isEmpty() || mRelative)
+    return;
+  if (fitType == ComplexityCustom && !mCustomComplexity.isValid())
+    return;
+
+  // Reported coefficients only apply to the time they were computed from
+  const PlotValueType yType = mPlotParams.yType;
+  const bool cpuTime = yType >= CpuTimeType && yType <= CpuTimeMedianType;
+  const bool realTime = yType >= RealTimeType && yType <= RealTimeMedianType;
+
+  auto chart = mChartView->chart();
+  const auto chartSeries = chart->series();
+  const auto xAxes = chart->axes(Qt::Horizontal);
+  const auto yAxes = chart->axes(Qt::Vertical);
+  for (int seriesIdx = 0; seriesIdx < mBchSubsets.size(); ++seriesIdx) {
+    const auto series = (QXYSeries*)chartSeries.at(seriesIdx);
+    const QVector<QPointF> points = series->points();
+
+    ComplexityFit fit;
+    if (fitType == kFitAuto)
+      fit = fitBestComplexity(points);
+    else if (fitType == kFitReported) {
+      int cplxIdx = mBchResults.getComplexityIndex(mBchSubsets[seriesIdx].idxs.constFirst());
+      if (cplxIdx < 0 || (!cpuTime && !realTime))
+        continue;
+      const auto& complexity = mBchResults.complexities[cplxIdx];
+      const double coefficient =
+          cpuTime ? complexity.cpu_coefficient : complexity.real_coefficient;
+      if (coefficient < 0. || !parseBigO(complexity.big_o, fit.model))
+        continue;
+      fit.coefficient = coefficient * mCurrentTimeFactor;
+      fit.rms = complexity.rms;
+      fit.isValid = true;
+    } else
+      fit = fitComplexity(points, static_cast<ComplexityModel>(fitType), &mCustomComplexity);
+    if (!fit.isValid)
+      continue;
+
+    // Sample curve over series range (geometric steps for power-of-2 ranges)
+    double xMin = points.constFirst().x(), xMax = xMin;
+    for (const auto& point : points) {
+      xMin = std::min(xMin, point.x());
+      xMax = std::max(xMax, point.x());
+    }
+    const bool geometric = xMin > 0.;
+    auto fitSeries = new QLineSeries();
+    for (int i = 0; i < kFitSamples; ++i) {
+      const double t = (double)i / (kFitSamples - 1);
+      const double x = geometric ? xMin * std::pow(xMax / xMin, t) : xMin + t * (xMax - xMin);
+      const double y = fit.coefficient * getComplexityValue(fit.model, x, &mCustomComplexity);
+      if (std::isfinite(y))
+        fitSeries->append(x, y);
+    }
+
+    QString fitName = mSeriesMapping[seriesIdx].newName + " ~ " +
+                      QString::number(fit.coefficient, 'g', 3) + " " +
+                      getComplexityName(fit.model, &mCustomComplexity);
+    if (fit.rms >= 0.)
+      fitName += " (RMS " + QString::number(fit.rms * 100., 'f', 1) + "%)";
+    fitSeries->setName(fitName.toHtmlEscaped());
+
+    QPen pen = fitSeries->pen();
+    pen.setColor(series->color());
+    pen.setStyle(Qt::DashLine);
+    pen.setWidthF(1.);
+    fitSeries->setPen(pen);
+
+    chart->addSeries(fitSeries);
+    if (!xAxes.isEmpty())
+      fitSeries->attachAxis(xAxes.constFirst());
+    if (!yAxes.isEmpty())
+      fitSeries->attachAxis(yAxes.constFirst());
+    mFitSeries.append(fitSeries);
+  }
 }
 
 //
@@ -904,8 +1294,16 @@ void PlotterLineChart::onSpinMTicksChanged(int i) {
 
 //
 // Actions
+void PlotterLineChart::setSharedReload() {
+  mSharedReload = true;
+  onCheckAutoReload(Qt::Unchecked);
+  ui->checkBoxAutoReload->hide();
+  ui->pushButtonReload->hide();
+  ui->labelLastReload->hide();
+}
+
 void PlotterLineChart::onCheckAutoReload(int state) {
-  if (state == Qt::Checked) {
+  if (state == Qt::Checked && !mSharedReload) {
     if (mWatcher.files().empty()) {
       mWatcher.addPath(mOrigFilename);
       for (const auto& addFilename : std::as_const(mAddFilenames))
@@ -928,7 +1326,7 @@ void PlotterLineChart::onAutoReload(const QString& path) {
 void PlotterLineChart::onReloadClicked() {
   // Load new results
   QString errorMsg;
-  BenchResults newBchResults = ResultParser::parseJsonFile(mOrigFilename, errorMsg);
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
 
   if (newBchResults.benchmarks.isEmpty()) {
     QMessageBox::critical(this, "Chart reload",
@@ -937,7 +1335,7 @@ void PlotterLineChart::onReloadClicked() {
   }
   for (const auto& addFile : std::as_const(mAddFilenames)) {
     errorMsg.clear();
-    BenchResults newAddResults = ResultParser::parseJsonFile(addFile.filename, errorMsg);
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
     if (newAddResults.benchmarks.isEmpty()) {
       QMessageBox::critical(
           this, "Chart reload",
@@ -950,83 +1348,27 @@ void PlotterLineChart::onReloadClicked() {
       newBchResults.overwriteResults(newAddResults);
   }
 
-  // Check compatibility with previous
-  errorMsg.clear();
-  if (mBenchIdxs.size() != newBchResults.benchmarks.size()) {
-    errorMsg = "Number of series/points is different";
-    if (mAllIndexes) {
-      mBenchIdxs.clear();
-      for (int i = 0; i < newBchResults.benchmarks.size(); ++i)
-        mBenchIdxs.append(i);
-    }
-  }
-
-  QVector<BenchSubset> newBchSubsets = newBchResults.groupParam(
-      mPlotParams.xType == PlotArgumentType, mBenchIdxs, mPlotParams.xIdx, "X");
-  const auto& oldChartSeries = mChartView->chart()->series();
-  int newSeriesIdx = 0;
-  if (errorMsg.isEmpty()) {
-    for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-      // Ignore single point lines
-      if (bchSubset.idxs.size() < 2)
-        continue;
-      if (newSeriesIdx >= oldChartSeries.size())
-        break;
+  reloadResults(newBchResults);
+}
 
-      const QString& subsetName = bchSubset.name;
-      if (subsetName != mSeriesMapping[newSeriesIdx].oldName) {
-        errorMsg = "Series has different name";
-        break;
-      }
-      const auto lineSeries = (QLineSeries*)(oldChartSeries[newSeriesIdx]);
-      if (bchSubset.idxs.size() != lineSeries->count()) {
-        errorMsg = "Series has different number of points";
-        break;
-      }
-      ++newSeriesIdx;
-    }
-    if (newSeriesIdx != oldChartSeries.size()) {
-      errorMsg = "Number of series is different";
-    }
+void PlotterLineChart::reloadResults(const BenchResults& newBchResults) {
+  // Plotted benchmarks (all of them, or previous ones matched by names)
+  QVector<int> newBenchIdxs = mAllIndexes
+                                  ? newBchResults.segmentAll()
+                                  : newBchResults.matchBenchmarks(mBchResults, mBenchIdxs);
+  if (newBenchIdxs.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload", "No plotted benchmarks in reloaded results");
+    return;
   }
+  mBenchIdxs = newBenchIdxs;
 
-  // Direct update if compatible
-  if (errorMsg.isEmpty()) {
-    bool custDataAxis = true;
-    QString custDataName;
-    newSeriesIdx = 0;
-    for (const auto& bchSubset : std::as_const(newBchSubsets)) {
-      // Ignore single point lines
-      if (bchSubset.idxs.size() < 2) {
-        qWarning() << "Not enough points to trace line for: " << bchSubset.name;
-        continue;
-      }
-
-      // Update points
-      QXYSeries* oldSeries = (QXYSeries*)oldChartSeries[newSeriesIdx];
-      oldSeries->clear();
-
-      double xFallback = 0.;
-      for (int idx : bchSubset.idxs) {
-        QString xName = newBchResults.getParamName(mPlotParams.xType == PlotArgumentType, idx,
-                                                   mPlotParams.xIdx);
-        double xVal = BenchResults::getParamValue(xName, custDataName, custDataAxis, xFallback);
-
-        // Add point
-        oldSeries->append(xVal, getYPlotValue(newBchResults.benchmarks[idx], mPlotParams.yType) *
-                                    mCurrentTimeFactor);
-      }
-      ++newSeriesIdx;
-    }
-  }
-  // Reset update if all benchmarks
-  else if (mAllIndexes) {
+  // Series matched by names if any, reset otherwise (no axes)
+  if (!mSeriesMapping.isEmpty())
+    reconcileSeries(newBchResults);
+  else {
     saveConfig();
     setupChart(newBchResults, mBenchIdxs, mPlotParams, false);
     setupOptions(false);
-  } else {
-    QMessageBox::critical(this, "Chart reload", errorMsg);
-    return;
   }
 
   // Update timestamp
@@ -1035,6 +1377,96 @@ void PlotterLineChart::onReloadClicked() {
   ui->labelLastReload->setText("(Last: " + now.toString() + ")");
 }
 
+// New subsets matched to plotted series by name: points replaced at once, series of new subsets
+// appended and those of removed subsets deleted (axes and options kept)
+void PlotterLineChart::reconcileSeries(const BenchResults& bchResults) {
+  auto chart = mChartView->chart();
+  mErrorBars->clear();
+  mHover->clear();
+  clearComplexityFits();  // plotted series only
+
+  QHash<QString, int> prevIdxs;  // subset name -> series index
+  for (int idx = 0; idx < mSeriesMapping.size(); ++idx)
+    prevIdxs.insert(mSeriesMapping[idx].oldName, idx);
+  const auto prevSeries = chart->series();
+
+  const QVector<BenchSubset> bchSubsets = bchResults.groupParam(
+      mPlotParams.xType == PlotArgumentType, mBenchIdxs, mPlotParams.xIdx, "X");
+  SeriesMapping configs;
+  QVector<BenchSubset> subsets;
+  QHash<QAbstractSeries*, int> seriesIdxs;  // -> configs/subsets index
+  bool custDataAxis = true;
+  QString custDataName;
+  QList<QPointF> points;
+  for (const auto& bchSubset : bchSubsets) {
+    // Ignore single point lines
+    if (bchSubset.idxs.size() < 2) {
+      qWarning() << "Not enough points to trace line for: " << bchSubset.name;
+      continue;
+    }
+
+    points.clear();
+    double xFallback = 0.;
+    for (int idx : bchSubset.idxs) {
+      const BenchParam& xParam =
+          bchResults.getParam(mPlotParams.xType == PlotArgumentType, idx, mPlotParams.xIdx);
+      double xVal = BenchResults::getParamValue(xParam, custDataName, custDataAxis, xFallback);
+      points.append({xVal, getYPlotValue(bchResults.benchmarks[idx], mPlotParams.yType) *
+                               mCurrentTimeFactor});
+    }
+
+    QXYSeries* series = nullptr;
+    if (auto it = prevIdxs.find(bchSubset.name); it != prevIdxs.end()) {
+      series = (QXYSeries*)prevSeries.at(it.value());
+      configs.append(mSeriesMapping[it.value()]);
+      prevIdxs.erase(it);
+      series->replace(points);
+    } else {
+      if (mPlotParams.type == ChartLineType)
+        series = new QLineSeries();
+      else
+        series = new QSplineSeries();
+      series->setName(bchSubset.name.toHtmlEscaped());
+      series->append(points);
+      chart->addSeries(series);  // theme color
+      const auto axes = chart->axes();
+      for (auto axis : axes)
+        series->attachAxis(axis);
+      configs.append({bchSubset.name, bchSubset.name});
+      configs.last().oldColor = configs.last().newColor = series->color();
+    }
+    seriesIdxs.insert(series, subsets.size());
+    subsets.append(bchSubset);
+  }
+
+  // Series of removed subsets
+  for (int idx : std::as_const(prevIdxs)) {
+    chart->removeSeries(prevSeries.at(idx));
+    delete prevSeries.at(idx);
+  }
+
+  // Mapping in chart order (kept series first)
+  mSeriesMapping.clear();
+  mBchSubsets.clear();
+  const auto chartSeries = chart->series();
+  for (auto series : chartSeries) {
+    const int idx = seriesIdxs.value(series);
+    mSeriesMapping.append(configs[idx]);
+    mBchSubsets.append(subsets[idx]);
+  }
+  chart->setTitle(chartSeries.isEmpty() ? "No series with at least 2 points to display" : "");
+
+  mBchResults = bchResults;
+  updateBaselineChoices();
+  if (mRelative || ui->comboBoxBaseline->currentIndex() > 0)
+    updateSeriesValues(false);  // ratios of new values (range kept)
+  else {
+    updateErrorBars();
+    updateComplexityFits();
+    updateHoverItems();
+  }
+}
+
 void PlotterLineChart::onSnapshotClicked() {
   QString fileName =
       QFileDialog::getSaveFileName(this, tr("Save snapshot"), "", tr("Images (*.png)"));
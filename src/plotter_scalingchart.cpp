@@ -0,0 +1,578 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "plotter_scalingchart.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QCursor>
+#include <QDateTime>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QMessageBox>
+#include <QToolTip>
+#include <QtCharts>
+
+#include "benchmark_results.h"
+#include "result_parser.h"
+#include "ui_plotter_scalingchart.h"
+
+// Plotted metric
+enum ScalingMetric { ScalingThroughput, ScalingSpeedup, ScalingEfficiency };
+
+// Check Y-value type can be converted to a throughput (not a dispersion or iterations)
+static bool isYThroughputBased(PlotValueType yType) {
+  switch (yType) {
+    case CpuTimeStddevType:
+    case CpuTimeCvType:
+    case RealTimeStddevType:
+    case RealTimeCvType:
+    case IterationsType:
+    case BytesStddevType:
+    case BytesCvType:
+    case ItemsStddevType:
+    case ItemsCvType:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Throughput of benchmark: Y-value if already a rate, iterations per second otherwise
+static double getThroughput(const BenchData& bchData, PlotValueType yType) {
+  const double value = getYPlotValue(bchData, yType);
+  if (!isYTimeBased(yType))
+    return value;
+  return (value > 0.) ? 1000000. / value : 0.;  // from us
+}
+
+PlotterScalingChart::PlotterScalingChart(const BenchResults& bchResults,
+                                         const QVector<int>& bchIdxs,
+                                         const PlotParams& plotParams,
+                                         const QString& origFilename,
+                                         const QVector<FileReload>& addFilenames, QWidget* parent)
+    : QWidget(parent)
+    , ui(new Ui::PlotterScalingChart)
+    , mBenchIdxs(bchIdxs)
+    , mPlotParams(plotParams)
+    , mOrigFilename(origFilename)
+    , mAddFilenames(addFilenames)
+    , mAllIndexes(bchIdxs.size() == bchResults.benchmarks.size())
+    , mWatcher(parent) {
+  // UI
+  ui->setupUi(this);
+  this->setAttribute(Qt::WA_DeleteOnClose);
+
+  QFileInfo fileInfo(origFilename);
+  this->setWindowTitle("Scaling - " + fileInfo.fileName());
+
+  connectUI();
+
+  // Init
+  setupChart();
+  QString errorMsg;
+  if (!loadSeries(bchResults, errorMsg)) {
+    qWarning() << errorMsg;
+    mChartView->chart()->setTitle(errorMsg);
+  }
+  setupOptions();
+
+  // Show
+  ui->horizontalLayout->insertWidget(0, mChartView);
+}
+
+PlotterScalingChart::~PlotterScalingChart() {
+  // Save options to file
+  saveConfig();
+
+  delete ui;
+}
+
+void PlotterScalingChart::connectUI() {
+  // Theme
+  ui->comboBoxTheme->addItem("Light", QChart::ChartThemeLight);
+  ui->comboBoxTheme->addItem("Blue Cerulean", QChart::ChartThemeBlueCerulean);
+  ui->comboBoxTheme->addItem("Dark", QChart::ChartThemeDark);
+  ui->comboBoxTheme->addItem("Brown Sand", QChart::ChartThemeBrownSand);
+  ui->comboBoxTheme->addItem("Blue Ncs", QChart::ChartThemeBlueNcs);
+  ui->comboBoxTheme->addItem("High Contrast", QChart::ChartThemeHighContrast);
+  ui->comboBoxTheme->addItem("Blue Icy", QChart::ChartThemeBlueIcy);
+  ui->comboBoxTheme->addItem("Qt", QChart::ChartThemeQt);
+  connect(ui->comboBoxTheme, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterScalingChart::onComboThemeChanged);
+
+  // Legend
+  connect(ui->checkBoxLegendVisible, &QCheckBox::stateChanged, this,
+          &PlotterScalingChart::onCheckLegendVisible);
+
+  // Scaling
+  ui->comboBoxMetric->addItem("Throughput", ScalingThroughput);
+  ui->comboBoxMetric->addItem("Speedup", ScalingSpeedup);
+  ui->comboBoxMetric->addItem("Efficiency", ScalingEfficiency);
+  connect(ui->comboBoxMetric, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterScalingChart::onComboMetricChanged);
+  connect(ui->checkBoxIdeal, &QCheckBox::stateChanged, this,
+          &PlotterScalingChart::onCheckIdealLines);
+  connect(ui->checkBoxLogThreads, &QCheckBox::stateChanged, this,
+          &PlotterScalingChart::onCheckLogThreads);
+
+  // Actions
+  connect(&mWatcher, &QFileSystemWatcher::fileChanged, this, &PlotterScalingChart::onAutoReload);
+  connect(ui->checkBoxAutoReload, &QCheckBox::stateChanged, this,
+          &PlotterScalingChart::onCheckAutoReload);
+  connect(ui->pushButtonReload, &QPushButton::clicked, this,
+          &PlotterScalingChart::onReloadClicked);
+  connect(ui->pushButtonSnapshot, &QPushButton::clicked, this,
+          &PlotterScalingChart::onSnapshotClicked);
+}
+
+void PlotterScalingChart::setupChart() {
+  QChart* chart = new QChart();
+
+  // Y-axis (X-axis depends on options)
+  QValueAxis* yAxis = new QValueAxis();
+  chart->addAxis(yAxis, Qt::AlignLeft);
+
+  // View
+  mChartView = new QChartView(chart, this);
+  mChartView->setRenderHint(QPainter::Antialiasing);
+}
+
+void PlotterScalingChart::setupOptions() {
+  auto chart = mChartView->chart();
+
+  // General
+  chart->setTheme(QChart::ChartThemeLight);
+  chart->legend()->setAlignment(Qt::AlignTop);
+  chart->legend()->setShowToolTips(true);
+
+  // Load options from file
+  mIgnoreEvents = true;
+  loadConfig();
+  mIgnoreEvents = false;
+
+  // Apply actions
+  onComboThemeChanged(ui->comboBoxTheme->currentIndex());
+  onCheckIdealLines(ui->checkBoxIdeal->checkState());
+  if (ui->checkBoxAutoReload->isChecked())
+    onCheckAutoReload(Qt::Checked);
+  updatePoints();
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterScalingChart::loadConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("scaling");
+
+  if (auto value = settings.value("autoReload"); value.isValid())
+    ui->checkBoxAutoReload->setChecked(value.toBool());
+
+  if (auto value = settings.value("theme"); value.isValid())
+    ui->comboBoxTheme->setCurrentText(value.toString());
+
+  if (auto value = settings.value("legend/visible"); value.isValid())
+    ui->checkBoxLegendVisible->setChecked(value.toBool());
+
+  if (auto value = settings.value("metric"); value.isValid())
+    ui->comboBoxMetric->setCurrentText(value.toString());
+  if (auto value = settings.value("ideal"); value.isValid())
+    ui->checkBoxIdeal->setChecked(value.toBool());
+  if (auto value = settings.value("logThreads"); value.isValid())
+    ui->checkBoxLogThreads->setChecked(value.toBool());
+
+  settings.endGroup();
+}
+
+void PlotterScalingChart::saveConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("scaling");
+
+  settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
+  settings.setValue("theme", ui->comboBoxTheme->currentText());
+  settings.setValue("legend/visible", ui->checkBoxLegendVisible->isChecked());
+  settings.setValue("metric", ui->comboBoxMetric->currentText());
+  settings.setValue("ideal", ui->checkBoxIdeal->isChecked());
+  settings.setValue("logThreads", ui->checkBoxLogThreads->isChecked());
+
+  settings.endGroup();
+}
+
+/**************************************************************************************************
+ *
+ * Scaling
+ *
+ **************************************************************************************************/
+
+bool PlotterScalingChart::loadSeries(const BenchResults& bchResults, QString& errorMsg) {
+  if (!isYThroughputBased(mPlotParams.yType)) {
+    errorMsg = "Scaling needs a time or throughput value";
+    return false;
+  }
+
+  // Scaling
+  // X: threads
+  // Y: throughput (or speedup/efficiency from it)
+  // Line: one per benchmark % threads
+  std::vector<ScalingSeries> newSeries;
+  const QVector<BenchSubset> bchSubsets = bchResults.segmentThreads(mBenchIdxs);
+  for (const auto& bchSubset : bchSubsets) {
+    ScalingSeries series;
+    series.name = bchSubset.name;
+    for (int idx : bchSubset.idxs) {
+      const BenchData& bchData = bchResults.benchmarks[idx];
+      if (!series.threads.isEmpty() && series.threads.constLast() == bchData.threads)
+        continue;  // duplicated run
+      series.threads.append(bchData.threads);
+      series.throughputs.append(getThroughput(bchData, mPlotParams.yType));
+    }
+    // Ignore single thread count lines
+    if (series.threads.size() < 2) {
+      qWarning() << "Not enough thread counts to trace scaling for: " << series.name;
+      continue;
+    }
+    newSeries.push_back(std::move(series));
+  }
+
+  // Same series kept, only points updated
+  auto chart = mChartView->chart();
+  const bool sameSeries =
+      newSeries.size() == mSeries.size() &&
+      std::equal(newSeries.cbegin(), newSeries.cend(), mSeries.cbegin(),
+                 [](const ScalingSeries& lhs, const ScalingSeries& rhs) {
+                   return lhs.name == rhs.name;
+                 });
+  if (sameSeries) {
+    for (size_t idx = 0; idx < mSeries.size(); ++idx) {
+      mSeries[idx].threads = newSeries[idx].threads;
+      mSeries[idx].throughputs = newSeries[idx].throughputs;
+    }
+  } else {
+    chart->removeAllSeries();
+    mSeries = std::move(newSeries);
+    for (size_t idx = 0; idx < mSeries.size(); ++idx) {
+      auto& series = mSeries[idx];
+
+      series.line = new QLineSeries();
+      series.line->setName(series.name.toHtmlEscaped());
+      series.line->setPointsVisible(true);
+      chart->addSeries(series.line);
+
+      series.ideal = new QLineSeries();
+      series.ideal->setName(series.name.toHtmlEscaped());
+      chart->addSeries(series.ideal);
+
+      // Tooltips
+      connect(series.line, &QXYSeries::hovered, this,
+              [this, idx](const QPointF& point, bool state) {
+                if (state)
+                  showPointTip(mSeries[idx], point);
+                else
+                  QToolTip::hideText();
+              });
+    }
+    for (auto* axis : chart->axes())
+      for (auto* series : chart->series())
+        series->attachAxis(axis);
+  }
+
+  if (mSeries.empty()) {
+    errorMsg = "No benchmarks with at least 2 thread counts to display";
+    return false;
+  }
+  chart->setTitle("");
+  return true;
+}
+
+void PlotterScalingChart::updatePoints() {
+  for (auto& series : mSeries) {
+    QList<QPointF> points, idealPoints;
+    points.reserve(series.threads.size());
+    for (qsizetype idx = 0; idx < series.threads.size(); ++idx) {
+      points.append(QPointF(series.threads[idx], getMetricValue(series, idx)));
+      idealPoints.append(
+          QPointF(series.threads[idx], getIdealValue(series, series.threads[idx])));
+    }
+    series.line->replace(points);
+    series.ideal->replace(idealPoints);
+  }
+
+  updateAxes();
+}
+
+void PlotterScalingChart::updateAxes() {
+  auto chart = mChartView->chart();
+  const auto metric = static_cast<ScalingMetric>(ui->comboBoxMetric->currentData().toInt());
+
+  // X-axis (re-created, linear or log2)
+  const auto xAxes = chart->axes(Qt::Horizontal);
+  if (!xAxes.empty()) {
+    chart->removeAxis(xAxes.constFirst());
+    delete xAxes.constFirst();
+  }
+
+  int minThreads = 0, maxThreads = 0;
+  bool singleRef = true;  // all speedups relative to 1 thread
+  for (const auto& series : mSeries) {
+    minThreads = (minThreads > 0) ? std::min(minThreads, series.threads.constFirst())
+                                  : series.threads.constFirst();
+    maxThreads = std::max(maxThreads, series.threads.constLast());
+    singleRef &= series.threads.constFirst() == 1;
+  }
+
+  QAbstractAxis* xAxis = nullptr;
+  if (ui->checkBoxLogThreads->isChecked()) {
+    QLogValueAxis* logAxis = new QLogValueAxis();
+    logAxis->setBase(2.);
+    logAxis->setLabelFormat("%g");
+    if (maxThreads > 0)
+      logAxis->setRange(minThreads / 1.25, maxThreads * 1.25);
+    xAxis = logAxis;
+  } else {
+    QValueAxis* valueAxis = new QValueAxis();
+    valueAxis->setLabelFormat("%g");
+    if (maxThreads > 0) {
+      valueAxis->setRange(0., maxThreads);
+      valueAxis->applyNiceNumbers();
+    }
+    xAxis = valueAxis;
+  }
+  xAxis->setTitleText("Threads");
+  chart->addAxis(xAxis, Qt::AlignBottom);
+  for (auto* series : chart->series())
+    series->attachAxis(xAxis);
+
+  // Y-axis
+  const auto yAxes = chart->axes(Qt::Vertical);
+  if (yAxes.empty())
+    return;
+  QValueAxis* yAxis = (QValueAxis*)(yAxes.constFirst());
+  const QString refName = singleRef ? "1 thread" : "lowest threads";
+  if (metric == ScalingSpeedup)
+    yAxis->setTitleText("Speedup (vs. " + refName + ")");
+  else if (metric == ScalingEfficiency)
+    yAxis->setTitleText("Parallel efficiency (%, vs. " + refName + ")");
+  else if (isYTimeBased(mPlotParams.yType))
+    yAxis->setTitleText("Throughput (iterations/s)");
+  else
+    yAxis->setTitleText(getYPlotName(mPlotParams.yType));
+
+  double yMax = 0.;
+  for (const auto& series : mSeries) {
+    for (qsizetype idx = 0; idx < series.threads.size(); ++idx) {
+      yMax = std::max(yMax, getMetricValue(series, idx));
+      if (ui->checkBoxIdeal->isChecked())
+        yMax = std::max(yMax, getIdealValue(series, series.threads[idx]));
+    }
+  }
+  yAxis->setLabelFormat("%g");
+  yAxis->setRange(0., (yMax > 0.) ? yMax * 1.05 : 1.);
+  yAxis->applyNiceNumbers();
+}
+
+double PlotterScalingChart::getMetricValue(const ScalingSeries& series, int pointIdx) const {
+  const auto metric = static_cast<ScalingMetric>(ui->comboBoxMetric->currentData().toInt());
+  const double throughput = series.throughputs[pointIdx];
+  if (metric == ScalingThroughput)
+    return throughput;
+
+  // Relative to lowest thread count (assumed ideal up to it)
+  const double refThroughput = series.throughputs.constFirst();
+  const double speedup = (refThroughput > 0.) ? throughput / refThroughput : 0.;
+  if (metric == ScalingSpeedup)
+    return speedup;
+  return speedup * series.threads.constFirst() / series.threads[pointIdx] * 100.;
+}
+
+double PlotterScalingChart::getIdealValue(const ScalingSeries& series, int threads) const {
+  const auto metric = static_cast<ScalingMetric>(ui->comboBoxMetric->currentData().toInt());
+  const double ratio = (double)threads / series.threads.constFirst();
+  if (metric == ScalingThroughput)
+    return series.throughputs.constFirst() * ratio;
+  if (metric == ScalingSpeedup)
+    return ratio;
+  return 100.;
+}
+
+void PlotterScalingChart::showPointTip(const ScalingSeries& series, const QPointF& point) {
+  // Nearest thread count
+  int pointIdx = 0;
+  for (qsizetype idx = 1; idx < series.threads.size(); ++idx)
+    if (std::abs(series.threads[idx] - point.x()) < std::abs(series.threads[pointIdx] - point.x()))
+      pointIdx = idx;
+
+  const double refThroughput = series.throughputs.constFirst();
+  const double speedup = (refThroughput > 0.) ? series.throughputs[pointIdx] / refThroughput : 0.;
+  const double efficiency = speedup * series.threads.constFirst() / series.threads[pointIdx];
+  QString text = series.name + "\n" + QString::number(series.threads[pointIdx]) + " threads\n" +
+                 "Throughput: " + QString::number(series.throughputs[pointIdx], 'g', 4) +
+                 (isYTimeBased(mPlotParams.yType) ? " iterations/s" : "") + "\n" +
+                 "Speedup: " + QString::number(speedup, 'f', 2) + "x\n" +
+                 "Efficiency: " + QString::number(efficiency * 100., 'f', 1) + "%";
+
+  QToolTip::showText(QCursor::pos(), text, mChartView);
+}
+
+/**************************************************************************************************
+ *
+ * Options
+ *
+ **************************************************************************************************/
+
+//
+// Theme
+void PlotterScalingChart::onComboThemeChanged(int index) {
+  QChart::ChartTheme theme =
+      static_cast<QChart::ChartTheme>(ui->comboBoxTheme->itemData(index).toInt());
+  auto chart = mChartView->chart();
+  chart->setTheme(theme);
+
+  // Ideal lines dashed as their line, without legend entry
+  for (auto& series : mSeries) {
+    QPen pen = series.ideal->pen();
+    pen.setColor(series.line->color());
+    pen.setStyle(Qt::DashLine);
+    pen.setWidthF(1.);
+    series.ideal->setPen(pen);
+    const auto markers = chart->legend()->markers(series.ideal);
+    for (auto* marker : markers)
+      marker->setVisible(false);
+  }
+}
+
+//
+// Legend
+void PlotterScalingChart::onCheckLegendVisible(int state) {
+  mChartView->chart()->legend()->setVisible(state == Qt::Checked);
+}
+
+//
+// Scaling
+void PlotterScalingChart::onComboMetricChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+  updatePoints();
+}
+
+void PlotterScalingChart::onCheckIdealLines(int state) {
+  for (auto& series : mSeries)
+    series.ideal->setVisible(state == Qt::Checked);
+  if (!mIgnoreEvents)
+    updateAxes();
+}
+
+void PlotterScalingChart::onCheckLogThreads(int /*state*/) {
+  if (mIgnoreEvents)
+    return;
+  updateAxes();
+}
+
+/**************************************************************************************************
+ *
+ * Actions
+ *
+ **************************************************************************************************/
+
+void PlotterScalingChart::setSharedReload() {
+  mSharedReload = true;
+  onCheckAutoReload(Qt::Unchecked);
+  ui->checkBoxAutoReload->hide();
+  ui->pushButtonReload->hide();
+  ui->labelLastReload->hide();
+}
+
+void PlotterScalingChart::onCheckAutoReload(int state) {
+  if (state == Qt::Checked && !mSharedReload) {
+    if (mWatcher.files().empty()) {
+      mWatcher.addPath(mOrigFilename);
+      for (const auto& addFilename : std::as_const(mAddFilenames))
+        mWatcher.addPath(addFilename.filename);
+    }
+  } else {
+    if (!mWatcher.files().empty())
+      mWatcher.removePaths(mWatcher.files());
+  }
+}
+
+void PlotterScalingChart::onAutoReload(const QString& path) {
+  QFileInfo fi(path);
+  if (fi.exists() && fi.isReadable() && fi.size() > 0)
+    onReloadClicked();
+  else
+    qWarning() << "Unable to auto-reload file: " << path;
+}
+
+void PlotterScalingChart::onReloadClicked() {
+  // Load new results
+  QString errorMsg;
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
+
+  if (newBchResults.benchmarks.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload",
+                          "Error parsing original file: " + mOrigFilename + " -> " + errorMsg);
+    return;
+  }
+  for (const auto& addFile : std::as_const(mAddFilenames)) {
+    errorMsg.clear();
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
+    if (newAddResults.benchmarks.isEmpty()) {
+      QMessageBox::critical(
+          this, "Chart reload",
+          "Error parsing additional file: " + addFile.filename + " -> " + errorMsg);
+      return;
+    }
+    if (addFile.isAppend)
+      newBchResults.appendResults(newAddResults);
+    else
+      newBchResults.overwriteResults(newAddResults);
+  }
+
+  reloadResults(newBchResults);
+}
+
+void PlotterScalingChart::reloadResults(const BenchResults& newBchResults) {
+  // Selection follows new results if all benchmarks
+  if (mAllIndexes)
+    mBenchIdxs = newBchResults.segmentAll();
+
+  QString errorMsg;
+  if (!loadSeries(newBchResults, errorMsg))
+    mChartView->chart()->setTitle(errorMsg);
+  onComboThemeChanged(ui->comboBoxTheme->currentIndex());  // new series
+  onCheckIdealLines(ui->checkBoxIdeal->checkState());
+  updatePoints();
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterScalingChart::onSnapshotClicked() {
+  QString fileName =
+      QFileDialog::getSaveFileName(this, tr("Save snapshot"), "", tr("Images (*.png)"));
+
+  if (!fileName.isEmpty()) {
+    QPixmap pixmap = mChartView->grab();
+
+    bool ok = pixmap.save(fileName, "PNG");
+    if (!ok)
+      QMessageBox::warning(this, "Chart snapshot", "Error saving snapshot file.");
+  }
+}
@@ -0,0 +1,478 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "plotter_violinchart.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <QCursor>
+#include <QDateTime>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHash>
+#include <QMessageBox>
+#include <QSettings>
+#include <QToolTip>
+#include <QtCharts>
+
+#include "chart_hover.h"
+#include "chart_violins.h"
+#include "result_parser.h"
+#include "ui_plotter_violinchart.h"
+
+// Violin half-width at density maximum (in categories)
+static constexpr double kHalfWidth = 0.4;
+
+PlotterViolinChart::PlotterViolinChart(const BenchResults& bchResults,
+                                       const QVector<int>& bchIdxs, const PlotParams& plotParams,
+                                       const QString& origFilename,
+                                       const QVector<FileReload>& addFilenames, QWidget* parent)
+    : QWidget(parent)
+    , ui(new Ui::PlotterViolinChart)
+    , mBchResults(bchResults)
+    , mBenchIdxs(bchIdxs)
+    , mPlotParams(plotParams)
+    , mOrigFilename(origFilename)
+    , mAddFilenames(addFilenames)
+    , mAllIndexes(bchIdxs.size() == bchResults.benchmarks.size())
+    , mWatcher(parent) {
+  // UI
+  ui->setupUi(this);
+  this->setAttribute(Qt::WA_DeleteOnClose);
+
+  QFileInfo fileInfo(origFilename);
+  this->setWindowTitle("Violins - " + fileInfo.fileName());
+
+  // View
+  QChart* chart = new QChart();
+  chart->legend()->setAlignment(Qt::AlignTop);
+  chart->legend()->setShowToolTips(true);
+  mChartView = new QChartView(chart, this);
+  mChartView->setRenderHint(QPainter::Antialiasing);
+  mViolins = new ChartViolins(chart);
+  mHover = new ChartHover(mChartView);
+  connectUI();
+
+  // Time unit
+  mCurrentTimeFactor = 1.;
+  if (isYTimeBased(mPlotParams.yType)) {
+    if (bchResults.meta.time_unit == "ns")
+      mCurrentTimeFactor = 1000.;
+    else if (bchResults.meta.time_unit == "ms")
+      mCurrentTimeFactor = 0.001;
+  }
+
+  // Init
+  loadSubsets();
+  setupOptions();
+
+  // Show
+  ui->horizontalLayout->insertWidget(0, mChartView, 1);
+}
+
+PlotterViolinChart::~PlotterViolinChart() {
+  // Save options to file
+  saveConfig();
+
+  delete ui;
+}
+
+void PlotterViolinChart::connectUI() {
+  // Theme
+  ui->comboBoxTheme->addItem("Light", QChart::ChartThemeLight);
+  ui->comboBoxTheme->addItem("Blue Cerulean", QChart::ChartThemeBlueCerulean);
+  ui->comboBoxTheme->addItem("Dark", QChart::ChartThemeDark);
+  ui->comboBoxTheme->addItem("Brown Sand", QChart::ChartThemeBrownSand);
+  ui->comboBoxTheme->addItem("Blue Ncs", QChart::ChartThemeBlueNcs);
+  ui->comboBoxTheme->addItem("High Contrast", QChart::ChartThemeHighContrast);
+  ui->comboBoxTheme->addItem("Blue Icy", QChart::ChartThemeBlueIcy);
+  ui->comboBoxTheme->addItem("Qt", QChart::ChartThemeQt);
+  connect(ui->comboBoxTheme, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterViolinChart::onComboThemeChanged);
+
+  // Legend
+  connect(ui->checkBoxLegendVisible, &QCheckBox::stateChanged, this,
+          &PlotterViolinChart::onCheckLegendVisible);
+
+  // Density
+  ui->comboBoxMethod->addItem("KDE", DensityKde);
+  ui->comboBoxMethod->addItem("Histogram", DensityHistogram);
+  connect(ui->comboBoxMethod, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &PlotterViolinChart::onComboMethodChanged);
+  connect(ui->doubleSpinBoxBandwidth, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this,
+          &PlotterViolinChart::onSpinBandwidthChanged);
+
+  if (!isYTimeBased(mPlotParams.yType))
+    ui->comboBoxTimeUnit->setEnabled(false);
+  else {
+    ui->comboBoxTimeUnit->addItem("ns", 1000.);
+    ui->comboBoxTimeUnit->addItem("us", 1.);
+    ui->comboBoxTimeUnit->addItem("ms", 0.001);
+    connect(ui->comboBoxTimeUnit, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            &PlotterViolinChart::onComboTimeUnitChanged);
+  }
+
+  // Violins tooltips
+  connect(mHover, &ChartHover::hovered, this, &PlotterViolinChart::onViolinHovered);
+
+  // Actions
+  connect(&mWatcher, &QFileSystemWatcher::fileChanged, this, &PlotterViolinChart::onAutoReload);
+  connect(ui->checkBoxAutoReload, &QCheckBox::stateChanged, this,
+          &PlotterViolinChart::onCheckAutoReload);
+  connect(ui->pushButtonReload, &QPushButton::clicked, this,
+          &PlotterViolinChart::onReloadClicked);
+  connect(ui->pushButtonSnapshot, &QPushButton::clicked, this,
+          &PlotterViolinChart::onSnapshotClicked);
+}
+
+void PlotterViolinChart::setupOptions() {
+  mIgnoreEvents = true;
+
+  // Time unit
+  if (mCurrentTimeFactor > 1.)
+    ui->comboBoxTimeUnit->setCurrentIndex(0);  // ns
+  else if (mCurrentTimeFactor < 1.)
+    ui->comboBoxTimeUnit->setCurrentIndex(2);  // ms
+  else
+    ui->comboBoxTimeUnit->setCurrentIndex(1);  // us
+
+  // Load options from file
+  loadConfig();
+  mIgnoreEvents = false;
+
+  // Apply actions
+  onComboThemeChanged(ui->comboBoxTheme->currentIndex());
+  onCheckLegendVisible(ui->checkBoxLegendVisible->checkState());
+  onComboMethodChanged(ui->comboBoxMethod->currentIndex());  // densities and chart
+  if (ui->checkBoxAutoReload->isChecked())
+    onCheckAutoReload(Qt::Checked);
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterViolinChart::loadConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("violins");
+
+  if (auto value = settings.value("autoReload"); value.isValid())
+    ui->checkBoxAutoReload->setChecked(value.toBool());
+
+  if (auto value = settings.value("theme"); value.isValid())
+    ui->comboBoxTheme->setCurrentText(value.toString());
+  if (auto value = settings.value("legend/visible"); value.isValid())
+    ui->checkBoxLegendVisible->setChecked(value.toBool());
+
+  if (auto value = settings.value("method"); value.isValid())
+    ui->comboBoxMethod->setCurrentText(value.toString());
+  if (auto value = settings.value("bandwidth"); value.isValid())
+    ui->doubleSpinBoxBandwidth->setValue(value.toDouble());
+
+  settings.endGroup();
+}
+
+void PlotterViolinChart::saveConfig() {
+  QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  settings.beginGroup("violins");
+
+  settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
+  settings.setValue("theme", ui->comboBoxTheme->currentText());
+  settings.setValue("legend/visible", ui->checkBoxLegendVisible->isChecked());
+  settings.setValue("method", ui->comboBoxMethod->currentText());
+  settings.setValue("bandwidth", ui->doubleSpinBoxBandwidth->value());
+
+  settings.endGroup();
+}
+
+/**************************************************************************************************
+ *
+ * Violins
+ *
+ **************************************************************************************************/
+
+void PlotterViolinChart::loadSubsets() {
+  // 2D Violins
+  // X: argumentA or templateB (benchmark name without X-param)
+  // Y: time/bytes/items repetitions distribution
+  // Series: one per benchmark % X-param, violins overlaid in X-param categories
+  mBchSubsets = mBchResults.groupParam(mPlotParams.xType == PlotArgumentType, mBenchIdxs,
+                                       mPlotParams.xIdx, "X");
+  mPlotIdxs.clear();
+  for (const auto& bchSubset : std::as_const(mBchSubsets))
+    mPlotIdxs.append(bchSubset.idxs);
+}
+
+void PlotterViolinChart::loadDensities() {
+  const auto method = static_cast<DensityMethod>(ui->comboBoxMethod->currentData().toInt());
+  mEstimates = densityEstimates(mBchResults, mPlotIdxs, mPlotParams.yType, method,
+                                ui->doubleSpinBoxBandwidth->value());
+}
+
+void PlotterViolinChart::updateChart() {
+  auto chart = mChartView->chart();
+
+  // Clear (overlays first, they reference series)
+  mHover->clear();
+  mViolins->clear();
+  chart->removeAllSeries();
+  const auto prevAxes = chart->axes();
+  for (auto axis : prevAxes) {
+    chart->removeAxis(axis);
+    delete axis;
+  }
+  mViolins->setScale(mCurrentTimeFactor);
+
+  if (mPlotIdxs.isEmpty() || mEstimates.size() != mPlotIdxs.size()) {
+    chart->setTitle("No compatible series to display");
+    return;
+  }
+  chart->setTitle("");
+
+  auto xAxis = new QCategoryAxis();
+  auto yAxis = new QValueAxis();
+  chart->addAxis(xAxis, Qt::AlignBottom);
+  chart->addAxis(yAxis, Qt::AlignLeft);
+
+  const bool xIsArg = mPlotParams.xType == PlotArgumentType;
+  const bool steps = ui->comboBoxMethod->currentData().toInt() == DensityHistogram;
+  QHash<QString, int> categories;
+  double yMin = std::numeric_limits<double>::max();
+  double yMax = std::numeric_limits<double>::lowest();
+  int plotIdx = 0;
+  for (const auto& bchSubset : std::as_const(mBchSubsets)) {
+    // Medians as series points (legend, colors and axes of violins)
+    auto series = new QScatterSeries();
+    series->setName(bchSubset.name.toHtmlEscaped());
+    series->setMarkerSize(8.);
+    chart->addSeries(series);
+    series->attachAxis(xAxis);
+    series->attachAxis(yAxis);
+
+    for (int idx : bchSubset.idxs) {
+      // Category of X-param (benchmark itself without X-param)
+      const QString xName = (mPlotParams.xType == PlotEmptyType)
+                                ? bchSubset.name
+                                : mBchResults.getParamName(xIsArg, idx, mPlotParams.xIdx);
+      auto catIt = categories.constFind(xName);
+      if (catIt == categories.cend()) {
+        catIt = categories.insert(xName, categories.size());
+        xAxis->append(xName, catIt.value());
+      }
+      const double pos = catIt.value();
+
+      const double median =
+          getYPlotStats(mBchResults.benchmarks[idx], mPlotParams.yType).median * mCurrentTimeFactor;
+      series->append(pos, median);
+
+      // Violin extent (grid points or bin edges)
+      double low = median, high = median;
+      const DensityEstimate& estimate = mEstimates[plotIdx++];
+      if (!estimate.density.isEmpty()) {
+        mViolins->addViolin(series, pos, estimate, kHalfWidth, steps);
+        const double edge = steps ? estimate.step / 2. : 0.;
+        low = std::min(low, (estimate.low - edge) * mCurrentTimeFactor);
+        high = std::max(
+            high, (estimate.low + (estimate.density.size() - 1) * estimate.step + edge) *
+                      mCurrentTimeFactor);
+      }
+      mHover->addItem(series, QRectF(pos - kHalfWidth, low, 2. * kHalfWidth, high - low), idx);
+      yMin = std::min(yMin, low);
+      yMax = std::max(yMax, high);
+    }
+  }
+
+  // X-axis
+  xAxis->setLabelsPosition(QCategoryAxis::AxisLabelsPositionOnValue);
+  xAxis->setRange(-0.5, categories.size() - 0.5);
+  if (mPlotParams.xType == PlotArgumentType)
+    xAxis->setTitleText("Argument " + QString::number(mPlotParams.xIdx + 1));
+  else if (mPlotParams.xType == PlotTemplateType)
+    xAxis->setTitleText("Template " + QString::number(mPlotParams.xIdx + 1));
+
+  // Y-axis
+  QString timeUnit = "us";
+  if (mCurrentTimeFactor > 1.)
+    timeUnit = "ns";
+  else if (mCurrentTimeFactor < 1.)
+    timeUnit = "ms";
+  yAxis->setTitleText(getYPlotName(mPlotParams.yType, timeUnit));
+  yAxis->setLabelFormat("%g");
+  if (yMax > yMin)
+    yAxis->setRange(yMin, yMax);
+  else
+    yAxis->setRange(yMin - 1., yMax + 1.);
+  yAxis->applyNiceNumbers();
+}
+
+/**************************************************************************************************
+ *
+ * Options
+ *
+ **************************************************************************************************/
+
+void PlotterViolinChart::onComboThemeChanged(int index) {
+  if (mIgnoreEvents)
+    return;
+
+  // Violins follow series colors
+  QChart::ChartTheme theme =
+      static_cast<QChart::ChartTheme>(ui->comboBoxTheme->itemData(index).toInt());
+  mChartView->chart()->setTheme(theme);
+}
+
+void PlotterViolinChart::onCheckLegendVisible(int state) {
+  mChartView->chart()->legend()->setVisible(state == Qt::Checked);
+}
+
+void PlotterViolinChart::onComboMethodChanged(int /*index*/) {
+  ui->doubleSpinBoxBandwidth->setEnabled(ui->comboBoxMethod->currentData().toInt() ==
+                                         DensityKde);
+  if (mIgnoreEvents)
+    return;
+
+  loadDensities();
+  updateChart();
+}
+
+void PlotterViolinChart::onSpinBandwidthChanged(double /*d*/) {
+  if (mIgnoreEvents)
+    return;
+
+  loadDensities();
+  updateChart();
+}
+
+void PlotterViolinChart::onComboTimeUnitChanged(int /*index*/) {
+  if (mIgnoreEvents)
+    return;
+
+  // Densities kept (in us), only chart values scaled
+  mCurrentTimeFactor = ui->comboBoxTimeUnit->currentData().toDouble();
+  updateChart();
+}
+
+void PlotterViolinChart::onViolinHovered(int key) {
+  if (key < 0)
+    QToolTip::hideText();
+  else
+    QToolTip::showText(
+        QCursor::pos(),
+        getBenchHoverText(mBchResults, key, mPlotParams.yType, mCurrentTimeFactor,
+                          getBenchInterval(mIntervals, mBchResults, key, mPlotParams.yType)),
+        mChartView);
+}
+
+/**************************************************************************************************
+ *
+ * Actions
+ *
+ **************************************************************************************************/
+
+void PlotterViolinChart::setSharedReload() {
+  mSharedReload = true;
+  onCheckAutoReload(Qt::Unchecked);
+  ui->checkBoxAutoReload->hide();
+  ui->pushButtonReload->hide();
+  ui->labelLastReload->hide();
+}
+
+void PlotterViolinChart::onCheckAutoReload(int state) {
+  if (state == Qt::Checked && !mSharedReload) {
+    if (mWatcher.files().empty()) {
+      mWatcher.addPath(mOrigFilename);
+      for (const auto& addFilename : std::as_const(mAddFilenames))
+        mWatcher.addPath(addFilename.filename);
+    }
+  } else {
+    if (!mWatcher.files().empty())
+      mWatcher.removePaths(mWatcher.files());
+  }
+}
+
+void PlotterViolinChart::onAutoReload(const QString& path) {
+  QFileInfo fi(path);
+  if (fi.exists() && fi.isReadable() && fi.size() > 0)
+    onReloadClicked();
+  else
+    qWarning() << "Unable to auto-reload file: " << path;
+}
+
+void PlotterViolinChart::onReloadClicked() {
+  // Load new results
+  QString errorMsg;
+  BenchResults newBchResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
+
+  if (newBchResults.benchmarks.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload",
+                          "Error parsing original file: " + mOrigFilename + " -> " + errorMsg);
+    return;
+  }
+  for (const auto& addFile : std::as_const(mAddFilenames)) {
+    errorMsg.clear();
+    BenchResults newAddResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
+    if (newAddResults.benchmarks.isEmpty()) {
+      QMessageBox::critical(
+          this, "Chart reload",
+          "Error parsing additional file: " + addFile.filename + " -> " + errorMsg);
+      return;
+    }
+    if (addFile.isAppend)
+      newBchResults.appendResults(newAddResults);
+    else
+      newBchResults.overwriteResults(newAddResults);
+  }
+
+  reloadResults(newBchResults);
+}
+
+void PlotterViolinChart::reloadResults(const BenchResults& newBchResults) {
+  // Plotted benchmarks (all of them, or previous ones matched by names)
+  QVector<int> newBenchIdxs = mAllIndexes
+                                  ? newBchResults.segmentAll()
+                                  : newBchResults.matchBenchmarks(mBchResults, mBenchIdxs);
+  if (newBenchIdxs.isEmpty()) {
+    QMessageBox::critical(this, "Chart reload", "No plotted benchmarks in reloaded results");
+    return;
+  }
+  mBenchIdxs = newBenchIdxs;
+  mBchResults = newBchResults;
+  mIntervals.clear();
+
+  loadSubsets();
+  loadDensities();
+  updateChart();
+
+  // Update timestamp
+  QDateTime today = QDateTime::currentDateTime();
+  QTime now = today.time();
+  ui->labelLastReload->setText("(Last: " + now.toString() + ")");
+}
+
+void PlotterViolinChart::onSnapshotClicked() {
+  QString fileName =
+      QFileDialog::getSaveFileName(this, tr("Save snapshot"), "", tr("Images (*.png)"));
+
+  if (!fileName.isEmpty()) {
+    QPixmap pixmap = mChartView->grab();
+
+    bool ok = pixmap.save(fileName, "PNG");
+    if (!ok)
+      QMessageBox::warning(this, "Chart snapshot", "Error saving snapshot file.");
+  }
+}
@@ -15,26 +15,36 @@
 
 #include "result_parser.h"
 
+#include "decompress_device.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 #include <QFile>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QRegularExpression>
+#include <QScopedPointer>
 #include <QStringView>
+#include <QThread>
+#include <QVarLengthArray>
 
 #define PARSE_DEBUG false
 #if PARSE_DEBUG
 #include <QDebug>
 #endif
 
-// Find benchmark index by name
-static int findExistingBenchmark(const BenchResults& bchResults, const QString& run_name) {
-  int idx = -1;
-  for (int i = 0; idx < 0 && i < bchResults.benchmarks.size(); ++i)
-    if (bchResults.benchmarks[i].run_name == run_name)
-      idx = i;
-
-  return idx;
-}
+/**************************************************************************************************
+ *
+ * Common helpers
+ *
+ **************************************************************************************************/
 
 // Remove aggregate suffix if any
 static void cleanupName(BenchData& bchData) {
@@ -55,591 +65,1336 @@ static void cleanupName(BenchData& bchData) {
   }
 }
 
-// Parse benchmark results from json file
-BenchResults ResultParser::parseJsonFile(const QString& filename, QString& errorMsg) {
-  BenchResults bchResults;
+// Convert timings to us (and update results time unit, displayed in ns, us or ms)
+static void normalizeTimes(BenchResults& bchResults, BenchData& bchData) {
+  const QString timeUnit =
+      (bchData.time_unit == "ns" || bchData.time_unit == "ms") ? bchData.time_unit : "us";
+  if (bchResults.meta.time_unit.isEmpty())
+    bchResults.meta.time_unit = timeUnit;
+  else if (bchResults.meta.time_unit != timeUnit)
+    bchResults.meta.time_unit = "us";
 
-  // Read file
-  QFile benchFile(filename);
-  if (!benchFile.open(QIODevice::ReadOnly)) {
-    errorMsg = "Couldn't open benchmark results file.";
-    return bchResults;
-  }
-  QByteArray benchData = benchFile.readAll();
-  benchFile.close();
+  const double timeFactor = BenchResults::getTimeFactorUs(bchData.time_unit);
+  bchData.real_time_us = bchData.real_time.back() * timeFactor;
+  bchData.cpu_time_us = bchData.cpu_time.back() * timeFactor;
+}
 
-  // Get Json main object
-  QJsonDocument benchDoc(QJsonDocument::fromJson(benchData));
-  if (!benchDoc.isObject()) {
-    errorMsg = "Not a json benchmark results file.";
-    return bchResults;
+// Add 'BigO' or 'RMS' aggregate to its family complexity
+static void insertComplexity(BenchResults& bchResults, const BenchComplexity& complexity) {
+  auto it = std::find_if(
+      bchResults.complexities.begin(), bchResults.complexities.end(),
+      [&complexity](const auto& cplx) { return cplx.run_name == complexity.run_name; });
+  if (it == bchResults.complexities.end()) {
+    bchResults.complexities.append(complexity);
+    return;
   }
-  QJsonObject benchObj = benchDoc.object();
-  if (benchObj.isEmpty()) {
-    errorMsg = "Empty json benchmark results file.";
-    return bchResults;
+  if (!complexity.big_o.isEmpty()) {
+    it->big_o = complexity.big_o;
+    it->cpu_coefficient = complexity.cpu_coefficient;
+    it->real_coefficient = complexity.real_coefficient;
+  }
+  if (complexity.rms >= 0.)
+    it->rms = complexity.rms;
+}
+
+// Remove aggregate suffix from family run name if any
+static void cleanupFamilyName(QString& runName) {
+  int lastIdx = runName.lastIndexOf("/repeats:");
+  if (lastIdx > 0)
+    runName.truncate(lastIdx);
+}
+
+// Set aggregate values from aggregate entry (false if unknown aggregate)
+static bool applyAggregate(BenchResults& bchResults, BenchData& dstData, const BenchData& aggData,
+                           const QString& aggregate_name) {
+  if (aggregate_name == "mean") {
+    dstData.mean_cpu = aggData.cpu_time_us;
+    dstData.mean_real = aggData.real_time_us;
+    if (!aggData.kbytes_sec.isEmpty())
+      dstData.mean_kbytes = aggData.kbytes_sec_dflt;
+    if (!aggData.kitems_sec.isEmpty())
+      dstData.mean_kitems = aggData.kitems_sec_dflt;
+  } else if (aggregate_name == "median") {
+    dstData.median_cpu = aggData.cpu_time_us;
+    dstData.median_real = aggData.real_time_us;
+    if (!aggData.kbytes_sec.isEmpty())
+      dstData.median_kbytes = aggData.kbytes_sec_dflt;
+    if (!aggData.kitems_sec.isEmpty())
+      dstData.median_kitems = aggData.kitems_sec_dflt;
+  } else if (aggregate_name == "stddev") {
+    dstData.stddev_cpu = aggData.cpu_time_us;
+    dstData.stddev_real = aggData.real_time_us;
+    if (!aggData.kbytes_sec.isEmpty())
+      dstData.stddev_kbytes = aggData.kbytes_sec_dflt;
+    if (!aggData.kitems_sec.isEmpty())
+      dstData.stddev_kitems = aggData.kitems_sec_dflt;
+  } else if (aggregate_name == "cv") {
+    dstData.cv_cpu = aggData.cpu_time.back() * 100;  // percent
+    dstData.cv_real = aggData.real_time.back() * 100;
+    if (!aggData.kbytes_sec.isEmpty())
+      dstData.cv_kbytes = aggData.kbytes_sec_dflt * 100;
+    if (!aggData.kitems_sec.isEmpty())
+      dstData.cv_kitems = aggData.kitems_sec_dflt * 100;
+    bchResults.meta.hasCv = true;
+  } else {
+    qCritical() << "Results parsing: unknown benchmark value for 'aggregate_name' ->"
+                << aggregate_name;
+    return false;
   }
 
-  /*
-   * Context
-   */
-  if (benchObj.contains("context") && benchObj["context"].isObject()) {
-    QJsonObject ctxObj = benchObj["context"].toObject();
+  return true;
+}
 
-    // Meta
-    if (ctxObj.contains("date") && ctxObj["date"].isString()) {
-      bchResults.context.date = ctxObj["date"].toString();
-      if (PARSE_DEBUG)
-        qDebug() << "date: " << bchResults.context.date;
+// Extract templates/arguments/base name/family/container from run name (false if invalid)
+// Run name is tokenized in a single scan, only stored parts are copied.
+static bool splitRunName(BenchData& bchData) {
+  const QStringView runName(bchData.run_name);
+  const qsizetype size = runName.size();
+
+  // Name part (until first '/' outside brackets): templates start and separators
+  // Example: "Name<tplt1, Foo<a, b>>/arg1/arg2"
+  qsizetype tpltIdx = -1, nameEnd = size;
+  QVarLengthArray<qsizetype, 16> tpltSeps;  // '<' then top-level commas
+  int depth = 0;
+  for (qsizetype idx = 0; idx < size; ++idx) {
+    const QChar chr = runName[idx];
+    if (chr == u'<') {
+      if (depth++ == 0 && tpltIdx < 0 && idx > 0) {
+        tpltIdx = idx;
+        tpltSeps.append(idx);
+      }
+    } else if (chr == u'>') {
+      if (depth > 0)
+        --depth;
+    } else if (chr == u',') {
+      if (tpltIdx >= 0 && depth <= 1)
+        tpltSeps.append(idx);
+    } else if (chr == u'/' && depth == 0) {
+      nameEnd = idx;
+      break;
     }
-    if (ctxObj.contains("host_name") && ctxObj["host_name"].isString()) {
-      bchResults.context.host_name = ctxObj["host_name"].toString();
-      if (PARSE_DEBUG)
-        qDebug() << "host_name: " << bchResults.context.host_name;
+  }
+
+  // Templates
+  if (tpltIdx > 0) {
+    if (runName[nameEnd - 1] != u'>') {
+      qCritical() << "Bad benchmark template formatting:" << runName.left(nameEnd);
+      return false;
     }
-    if (ctxObj.contains("executable") && ctxObj["executable"].isString()) {
-      bchResults.context.executable = ctxObj["executable"].toString();
-      if (PARSE_DEBUG)
-        qDebug() << "executable: " << bchResults.context.executable;
+    tpltSeps.append(nameEnd - 1);  // closing '>'
+    bchData.templates.reserve(tpltSeps.size() - 1);
+    bchData.tpltValues.reserve(tpltSeps.size() - 1);
+    for (qsizetype sepIdx = 0; sepIdx + 1 < tpltSeps.size(); ++sepIdx) {
+      const qsizetype begin = tpltSeps[sepIdx] + 1;
+      const QStringView tplt = runName.sliced(begin, tpltSeps[sepIdx + 1] - begin).trimmed();
+      bchData.templates.append(tplt.toString());
+      bchData.tpltValues.append(BenchResults::parseParam(tplt));
     }
+  }
+  // Debug: templates
+  for (int idx = 0; idx < bchData.templates.size(); ++idx)
+    if (PARSE_DEBUG)
+      qDebug() << "-> template[" << idx << "]:" << bchData.templates[idx];
 
-    // Build
-    if (ctxObj.contains("library_build_type") && ctxObj["library_build_type"].isString()) {
-      bchResults.context.build_type = ctxObj["library_build_type"].toString();
-      if (PARSE_DEBUG)
-        qDebug() << "library_build_type: " << bchResults.context.build_type;
-    } else if (ctxObj.contains("build_type") && ctxObj["build_type"].isString()) {
-      bchResults.context.build_type = ctxObj["build_type"].toString();
-      if (PARSE_DEBUG)
-        qDebug() << "build_type: " << bchResults.context.build_type;
+  // Arguments
+  if (nameEnd < size) {
+    const qsizetype argCount = runName.sliced(nameEnd).count(u'/');
+    bchData.arguments.reserve(argCount);
+    bchData.argValues.reserve(argCount);
+    qsizetype begin = nameEnd + 1;
+    while (begin <= size) {
+      qsizetype end = runName.indexOf(u'/', begin);
+      if (end < 0)
+        end = size;
+      const QStringView arg = runName.sliced(begin, end - begin);
+      bchData.arguments.append(arg.toString());
+      bchData.argValues.append(BenchResults::parseParam(arg));
+      begin = end + 1;
     }
+  }
+  // Debug: params
+  for (int prmIdx = 0; prmIdx < bchData.arguments.size(); ++prmIdx)
+    if (PARSE_DEBUG)
+      qDebug() << "-> param[" << prmIdx << "]:" << bchData.arguments[prmIdx];
 
-    // CPU
-    if (ctxObj.contains("num_cpus") && ctxObj["num_cpus"].isDouble()) {
-      bchResults.context.num_cpus = ctxObj["num_cpus"].toInt();
-      if (PARSE_DEBUG)
-        qDebug() << "num_cpus: " << bchResults.context.num_cpus;
+  // Base name (i.e. name without templates/arguments)
+  QStringView baseName = runName.left(tpltIdx > 0 ? tpltIdx : nameEnd);
+
+  // JOMT
+  // Family / Container
+  if (baseName.startsWith(u"JOMT_")) {
+    // Examples: "JOMT_Fill_vector<int>/64" Vs "JOMT_Fill_deque<int>/64"
+    baseName = baseName.sliced(5);  // remove prefix
+    bchData.base_name = baseName.toString();
+    qsizetype idx = baseName.indexOf(u'_');
+    if (idx > 0) {
+      bchData.family = baseName.left(idx).toString();
+      bchData.container = baseName.sliced(idx + 1).toString();
     }
-    if (ctxObj.contains("mhz_per_cpu") && ctxObj["mhz_per_cpu"].isDouble()) {
-      bchResults.context.mhz_per_cpu = ctxObj["mhz_per_cpu"].toInt();
+  }
+  // Classic (base name as family name)
+  else {
+    bchData.base_name = baseName.toString();
+    bchData.family = bchData.base_name;
+  }
+
+  if (PARSE_DEBUG)
+    qDebug() << "-> base_name:" << bchData.base_name;
+  if (PARSE_DEBUG)
+    qDebug() << "-> family:" << bchData.family;
+  if (PARSE_DEBUG)
+    qDebug() << "-> container:" << bchData.container;
+
+  return true;
+}
+
+// Add parsed entry to results (new benchmark, repetition or aggregate of existing one)
+static void insertBenchmark(BenchResults& bchResults, QHash<QString, int>& bchIndexes,
+                            BenchData& bchData, const QString& aggregate_name) {
+  // Time normalization (us)
+  normalizeTimes(bchResults, bchData);
+
+  // Throughput
+  if (!bchData.kbytes_sec.isEmpty()) {
+    bchData.kbytes_sec_dflt = bchData.kbytes_sec.back();
+    bchResults.meta.hasBytesSec = true;
+  }
+  if (!bchData.kitems_sec.isEmpty()) {
+    bchData.kitems_sec_dflt = bchData.kitems_sec.back();
+    bchResults.meta.hasItemsSec = true;
+  }
+
+  /*
+   * Existing benchmark
+   */
+  const auto idxIt = bchIndexes.constFind(bchData.run_name);
+  if (idxIt != bchIndexes.constEnd()) {
+    BenchData& exBchData = bchResults.benchmarks[*idxIt];
+
+    /*
+     * Aggregate type
+     */
+    if (bchData.run_type == "aggregate") {
       if (PARSE_DEBUG)
-        qDebug() << "mhz_per_cpu: " << bchResults.context.mhz_per_cpu;
-    }
-    if (ctxObj.contains("cpu_scaling_enabled") && ctxObj["cpu_scaling_enabled"].isBool()) {
-      bchResults.context.cpu_scaling_enabled = ctxObj["cpu_scaling_enabled"].toBool();
+        qDebug() << "-> append aggregate:" << exBchData.name;
+
+      applyAggregate(bchResults, exBchData, bchData, aggregate_name);
+
+      // New aggregate line
       if (PARSE_DEBUG)
-        qDebug() << "cpu_scaling_enabled: " << bchResults.context.cpu_scaling_enabled;
+        qDebug() << "||";
     }
 
-    // Caches
-    if (ctxObj.contains("caches") && ctxObj["caches"].isArray()) {
-      QJsonArray cchArray = ctxObj["caches"].toArray();
-      bchResults.context.caches.reserve(cchArray.size());
+    /*
+     * Iteration type (from aggregate)
+     */
+    else {
+      if (PARSE_DEBUG)
+        qDebug() << "-> append iteration:" << exBchData.name;
+
+      // Append data
+      exBchData.cpu_time.append(bchData.cpu_time.back());
+      exBchData.cpu_time_us = std::min(exBchData.cpu_time_us, bchData.cpu_time_us);
 
-      for (int cchIdx = 0; cchIdx < cchArray.size(); ++cchIdx) {
-        // Cache
-        QJsonObject cchObj = cchArray[cchIdx].toObject();
-        BenchCache bchCache;
-        if (PARSE_DEBUG)
-          qDebug() << "Context cache";
+      exBchData.real_time.append(bchData.real_time.back());
+      exBchData.real_time_us = std::min(exBchData.real_time_us, bchData.real_time_us);
+
+      if (!bchData.kbytes_sec.isEmpty()) {
+        exBchData.kbytes_sec.append(bchData.kbytes_sec_dflt);
+        exBchData.kbytes_sec_dflt = std::min(exBchData.kbytes_sec_dflt, bchData.kbytes_sec_dflt);
+      }
+      if (!bchData.kitems_sec.isEmpty()) {
+        exBchData.kitems_sec.append(bchData.kitems_sec_dflt);
+        exBchData.kitems_sec_dflt = std::min(exBchData.kitems_sec_dflt, bchData.kitems_sec_dflt);
+      }
+
+      // Min/Max
+      if (!exBchData.hasAggregate)  // First -> init
+      {
+        exBchData.min_cpu = exBchData.cpu_time_us;
+        exBchData.max_cpu = std::max(exBchData.cpu_time_us, bchData.cpu_time_us);
 
-        // Meta
-        if (cchObj.contains("type") && cchObj["type"].isString()) {
-          bchCache.type = cchObj["type"].toString();
-          if (PARSE_DEBUG)
-            qDebug() << "-> type:" << bchCache.type;
+        exBchData.min_real = exBchData.real_time_us;
+        exBchData.max_real = std::max(exBchData.real_time_us, bchData.real_time_us);
+
+        if (!bchData.kbytes_sec.isEmpty()) {
+          exBchData.min_kbytes = exBchData.kbytes_sec_dflt;
+          exBchData.max_kbytes = std::max(exBchData.kbytes_sec_dflt, bchData.kbytes_sec_dflt);
         }
-        if (cchObj.contains("level") && cchObj["level"].isDouble()) {
-          bchCache.level = cchObj["level"].toInt();
-          if (PARSE_DEBUG)
-            qDebug() << "-> level:" << bchCache.level;
+        if (!bchData.kitems_sec.isEmpty()) {
+          exBchData.min_kitems = exBchData.kitems_sec_dflt;
+          exBchData.max_kitems = std::max(exBchData.kitems_sec_dflt, bchData.kitems_sec_dflt);
         }
-        if (cchObj.contains("size") && cchObj["size"].isDouble()) {
-          bchCache.size = static_cast<int64_t>(cchObj["size"].toDouble());
-          if (PARSE_DEBUG)
-            qDebug() << "-> size:" << bchCache.size;
+      } else {
+        if (exBchData.min_cpu > bchData.cpu_time_us)
+          exBchData.min_cpu = bchData.cpu_time_us;
+        if (exBchData.max_cpu < bchData.cpu_time_us)
+          exBchData.max_cpu = bchData.cpu_time_us;
+
+        if (exBchData.min_real > bchData.real_time_us)
+          exBchData.min_real = bchData.real_time_us;
+        if (exBchData.max_real < bchData.real_time_us)
+          exBchData.max_real = bchData.real_time_us;
+
+        if (!bchData.kbytes_sec.isEmpty()) {
+          if (exBchData.min_kbytes > bchData.kbytes_sec_dflt)
+            exBchData.min_kbytes = bchData.kbytes_sec_dflt;
+          if (exBchData.max_kbytes < bchData.kbytes_sec_dflt)
+            exBchData.max_kbytes = bchData.kbytes_sec_dflt;
         }
-        if (cchObj.contains("num_sharing") && cchObj["num_sharing"].isDouble()) {
-          bchCache.num_sharing = cchObj["num_sharing"].toInt();
-          if (PARSE_DEBUG)
-            qDebug() << "-> num_sharing:" << bchCache.num_sharing;
+        if (!bchData.kitems_sec.isEmpty()) {
+          if (exBchData.min_kitems > bchData.kitems_sec_dflt)
+            exBchData.min_kitems = bchData.kitems_sec_dflt;
+          if (exBchData.max_kitems < bchData.kitems_sec_dflt)
+            exBchData.max_kitems = bchData.kitems_sec_dflt;
         }
+      }
 
-        //
-        // Push bench cache
-        bchResults.context.caches.append(bchCache);
+      // State
+      exBchData.hasAggregate = true;
+      bchResults.meta.hasAggregate = true;
+      bchResults.meta.onlyAggregate = false;
 
-        // New line between caches
-        if (PARSE_DEBUG)
-          qDebug() << "";
+      // Debug
+      if (PARSE_DEBUG) {
+        qDebug() << "** exBchData.min_cpu:" << exBchData.min_cpu;
+        qDebug() << "** exBchData.max_cpu:" << exBchData.max_cpu;
+        qDebug() << "** exBchData.min_real:" << exBchData.min_real;
+        qDebug() << "** exBchData.max_real:" << exBchData.max_real;
+        if (!exBchData.kbytes_sec.isEmpty()) {
+          qDebug() << "** exBchData.min_kbytes:" << exBchData.min_kbytes;
+          qDebug() << "** exBchData.max_kbytes:" << exBchData.max_kbytes;
+        }
+        if (!exBchData.kitems_sec.isEmpty()) {
+          qDebug() << "** exBchData.min_kitems:" << exBchData.min_kitems;
+          qDebug() << "** exBchData.max_kitems:" << exBchData.max_kitems;
+        }
       }
+
+      // New  append line
+      if (PARSE_DEBUG)
+        qDebug() << "|";
     }
-  } else
-    qCritical() << "Results parsing: missing field 'context'";
+    return;
+  }
 
-  // New line between context and benchmarks
-  if (PARSE_DEBUG)
-    qDebug() << "";
+  /*
+   * New benchmark
+   */
+  /*
+   * Aggregate-only type
+   */
+  if (bchData.run_type == "aggregate") {
+    if (PARSE_DEBUG)
+      qDebug() << "-> new aggregate-only";
+
+    if (!applyAggregate(bchResults, bchData, bchData, aggregate_name))
+      return;
+
+    // Init
+    bchData.hasAggregate = true;
+    bchResults.meta.hasAggregate = true;
+
+    bchData.cpu_time_us = -1;
+    bchData.real_time_us = -1;
+    bchData.min_cpu = bchData.max_cpu = -1;
+    bchData.min_real = bchData.max_real = -1;
+  }
 
   /*
-   * Benchmarks
+   * Add new benchmark
    */
-  if (benchObj.contains("benchmarks") && benchObj["benchmarks"].isArray()) {
-    QJsonArray bchArray = benchObj["benchmarks"].toArray();
-    bchResults.benchmarks.reserve(bchArray.size());
+  if (!splitRunName(bchData))
+    return;
 
-    for (int bchIdx = 0; bchIdx < bchArray.size(); ++bchIdx) {
-      // Benchmark
-      QJsonObject bchObj = bchArray[bchIdx].toObject();
-      BenchData bchData;
+  //
+  // Global Meta
+  if (bchData.arguments.size() > bchResults.meta.maxArguments)
+    bchResults.meta.maxArguments = bchData.arguments.size();
+  if (bchData.templates.size() > bchResults.meta.maxTemplates)
+    bchResults.meta.maxTemplates = bchData.templates.size();
+  bchResults.meta.onlyAggregate &= bchData.run_type == "aggregate";
+  if (bchData.threads > bchResults.meta.maxThreads)
+    bchResults.meta.maxThreads = bchData.threads;
 
-      //
-      // Name
-      if (bchObj.contains("name") && bchObj["name"].isString()) {
-        bchData.name = bchObj["name"].toString();
-        if (PARSE_DEBUG)
-          qDebug() << "bench name:" << bchData.name;
-      } else {
-        qCritical() << "Results parsing: missing benchmark field 'name'";
+  //
+  // Push new BenchData
+  bchIndexes.insert(bchData.run_name, bchResults.benchmarks.size());
+  bchResults.benchmarks.append(bchData);
+
+  // New line between benchmarks
+  if (PARSE_DEBUG)
+    qDebug() << "";
+}
+
+/**************************************************************************************************
+ *
+ * Text formats helpers (CSV/console)
+ *
+ **************************************************************************************************/
+
+// Line without end-of-line characters
+static std::string_view trimmedLine(const QByteArray& line) {
+  std::string_view view(line.constData(), line.size());
+  while (!view.empty() && (view.back() == '\n' || view.back() == '\r' || view.back() == ' '))
+    view.remove_suffix(1);
+
+  return view;
+}
+
+// Convert whole text to double
+static bool toDouble(std::string_view text, double& value) {
+  if (!text.empty() && text.front() == '+')
+    text.remove_prefix(1);
+  const char* end = text.data() + text.size();
+  const auto res = std::from_chars(text.data(), end, value);
+
+  return res.ec == std::errc() && res.ptr == end && !text.empty();
+}
+
+// Convert human readable number (e.g. "1.5Gi/s", "12.3M", "5%") to double
+static bool toHumanDouble(std::string_view text, double& value) {
+  const char* end = text.data() + text.size();
+  const auto res = std::from_chars(text.data(), end, value);
+  if (res.ec != std::errc())
+    return false;
+
+  // Suffix
+  std::string_view suffix(res.ptr, end - res.ptr);
+  bool binary = false;
+  if (suffix.ends_with("/s"))
+    suffix.remove_suffix(2);
+  if (suffix.ends_with("B")) {  // old "GB/s" format (1024 based)
+    suffix.remove_suffix(1);
+    binary = true;
+  }
+  if (suffix.ends_with("i")) {
+    suffix.remove_suffix(1);
+    binary = true;
+  }
+  if (suffix.empty())
+    return true;
+  if (suffix == "%") {
+    value /= 100.;
+    return true;
+  }
+
+  const std::string_view units = "kMGTPE";
+  const auto exp = units.find(suffix.front() == 'K' ? 'k' : suffix.front());
+  if (suffix.size() != 1 || exp == std::string_view::npos)
+    return false;
+  for (size_t i = 0; i <= exp; ++i)
+    value *= binary ? 1024. : 1000.;
+
+  return true;
+}
+
+// Separate aggregate suffix from name (e.g. "BM_Foo/8_mean" -> "mean")
+static QString extractAggregateName(QString& name) {
+  static const QStringList aggregates = {"mean", "median", "stddev", "cv", "BigO", "RMS"};
+
+  int lastIdx = name.lastIndexOf('_');
+  if (lastIdx <= 0)
+    return "";
+
+  const QString suffix = name.mid(lastIdx + 1);
+  if (!aggregates.contains(suffix))
+    return "";
+  name.truncate(lastIdx);
+
+  return suffix;
+}
+
+// Thread count from benchmark name (e.g. "BM_Foo/8/threads:4")
+static int extractThreads(const QString& name) {
+  const QString thrdPrefix = "/threads:";
+  int thrdIdx = name.lastIndexOf(thrdPrefix);
+  if (thrdIdx < 0)
+    return 1;
+
+  int threads = 0;
+  for (int i = thrdIdx + thrdPrefix.size(); i < name.size() && name[i].isDigit(); ++i)
+    threads = threads * 10 + name[i].digitValue();
+
+  return threads > 0 ? threads : 1;
+}
+
+// Parse context line printed by console reporter (also on stderr for CSV reporter)
+static void parseContextLine(std::string_view line, BenchContext& context) {
+  static const QRegularExpression dateRegex(
+      R"(^(\d{4}-\d{2}-\d{2}[T ]\S+|\d{2}/\d{2}/\d{2} \d{2}:\d{2}:\d{2})$)");
+  static const QRegularExpression cpuRegex(R"(^Run on \((\d+) X ([\d.]+) MHz CPU)");
+  static const QRegularExpression cacheRegex(
+      R"(^\s+L(\d+) (\w+) (\d+)\s*([KMG]?)i?B?\s*\(x(\d+)\))");
+
+  const QString sLine = QString::fromUtf8(line.data(), line.size());
+
+  if (sLine.startsWith("Running ")) {
+    context.executable = sLine.mid(8).trimmed();
+  } else if (sLine.contains("CPU scaling is enabled")) {
+    context.cpu_scaling_enabled = true;
+  } else if (sLine.contains("Library was built as DEBUG")) {
+    context.build_type = "debug";
+  } else if (auto match = dateRegex.match(sLine); match.hasMatch()) {
+    context.date = match.captured(1);
+  } else if (auto match = cpuRegex.match(sLine); match.hasMatch()) {
+    context.num_cpus = match.captured(1).toInt();
+    context.mhz_per_cpu = static_cast<int>(match.captured(2).toDouble());
+  } else if (auto match = cacheRegex.match(sLine); match.hasMatch()) {
+    BenchCache bchCache;
+    bchCache.level = match.captured(1).toInt();
+    bchCache.type = match.captured(2);
+    bchCache.size = match.captured(3).toLongLong();
+    const QString unit = match.captured(4);
+    if (unit == "K")
+      bchCache.size *= 1024;
+    else if (unit == "M")
+      bchCache.size *= 1024 * 1024;
+    else if (unit == "G")
+      bchCache.size *= 1024 * 1024 * 1024;
+    int count = match.captured(5).toInt();
+    bchCache.num_sharing = (count > 0 && context.num_cpus > 0) ? context.num_cpus / count : 0;
+
+    context.caches.append(bchCache);
+  }
+}
+
+// Split CSV line into fields (quotes kept)
+static void splitCsvLine(std::string_view line, QVarLengthArray<std::string_view, 16>& fields) {
+  fields.clear();
+
+  bool inQuotes = false;
+  size_t start = 0;
+  for (size_t i = 0; i < line.size(); ++i) {
+    if (line[i] == '"')
+      inQuotes = !inQuotes;
+    else if (line[i] == ',' && !inQuotes) {
+      fields.append(line.substr(start, i - start));
+      start = i + 1;
+    }
+  }
+  fields.append(line.substr(start));
+}
+
+// Remove CSV quotes from field
+static QString unquoteCsv(std::string_view field) {
+  if (field.size() < 2 || field.front() != '"' || field.back() != '"')
+    return QString::fromUtf8(field.data(), field.size());
+
+  field = field.substr(1, field.size() - 2);
+  QString res = QString::fromUtf8(field.data(), field.size());
+  if (field.find("\"\"") != std::string_view::npos)
+    res.replace("\"\"", "\"");
+
+  return res;
+}
+
+// Check time unit from console reporter
+static bool isConsoleUnit(std::string_view unit) {
+  return unit == "ns" || unit == "us" || unit == "ms" || unit == "s" || unit == "%";
+}
+
+// Parse console reporter complexity line (false if not a 'BigO'/'RMS' one)
+// e.g. "BM_Foo_BigO    1.68 NlgN    1.67 NlgN" or "BM_Foo_RMS    2 %    2 %"
+static bool parseConsoleComplexity(std::string_view line, BenchComplexity& complexity,
+                                   const QString& lastTimeUnit) {
+  // Last tokens: "<real> <notation> <cpu> <notation>"
+  QVarLengthArray<std::string_view, 8> tokens;
+  size_t end = line.size();
+  while (end > 0 && tokens.size() < 4) {
+    size_t begin = line.find_last_of(' ', end - 1);
+    begin = (begin == std::string_view::npos) ? 0 : begin + 1;
+    if (begin < end)
+      tokens.append(line.substr(begin, end - begin));
+    end = (begin > 0) ? begin - 1 : 0;
+  }
+  double realValue = 0., cpuValue = 0.;
+  if (tokens.size() < 4 || tokens[0] != tokens[2] || !toDouble(tokens[1], cpuValue) ||
+      !toDouble(tokens[3], realValue))
+    return false;
+
+  std::string_view name = line.substr(0, tokens[3].data() - line.data());
+  while (!name.empty() && name.back() == ' ')
+    name.remove_suffix(1);
+  complexity.run_name = QString::fromUtf8(name.data(), name.size());
+  const QString aggregate_name = extractAggregateName(complexity.run_name);
+  cleanupFamilyName(complexity.run_name);
+
+  if (aggregate_name == "BigO") {
+    const double timeFactor = BenchResults::getTimeFactorUs(lastTimeUnit);
+    complexity.big_o = QString::fromUtf8(tokens[0].data(), tokens[0].size());
+    complexity.cpu_coefficient = cpuValue * timeFactor;
+    complexity.real_coefficient = realValue * timeFactor;
+  } else if (aggregate_name == "RMS" && tokens[0] == "%")
+    complexity.rms = cpuValue / 100.;
+  else
+    return false;
+
+  return !complexity.run_name.isEmpty();
+}
+
+// Parse console reporter benchmark line (false if not a valid benchmark result)
+static bool parseConsoleLine(std::string_view line, BenchData& bchData, QString& aggregate_name,
+                             QString& lastTimeUnit) {
+  // Tokens
+  QVarLengthArray<std::string_view, 32> tokens;
+  size_t pos = 0;
+  while (pos < line.size()) {
+    while (pos < line.size() && line[pos] == ' ')
+      ++pos;
+    size_t end = pos;
+    while (end < line.size() && line[end] != ' ')
+      ++end;
+    if (end > pos)
+      tokens.append(line.substr(pos, end - pos));
+    pos = end;
+  }
+
+  // Timings: "<real> <unit> <cpu> <unit> <iterations>" (name may contain spaces)
+  int timeIdx = -1;
+  double realTime = 0., cpuTime = 0., iterations = 0.;
+  for (int i = 1; timeIdx < 0 && i + 4 < tokens.size(); ++i) {
+    if (isConsoleUnit(tokens[i + 1]) && tokens[i + 3] == tokens[i + 1] &&
+        toDouble(tokens[i], realTime) && toDouble(tokens[i + 2], cpuTime) &&
+        toDouble(tokens[i + 4], iterations))
+      timeIdx = i;
+  }
+  if (timeIdx < 0)
+    return false;  // Error, complexity or unknown line
+
+  // Name
+  std::string_view name = line.substr(0, tokens[timeIdx].data() - line.data());
+  while (!name.empty() && name.back() == ' ')
+    name.remove_suffix(1);
+  bchData.name = QString::fromUtf8(name.data(), name.size());
+  aggregate_name = extractAggregateName(bchData.name);
+  if (aggregate_name == "BigO" || aggregate_name == "RMS")
+    return false;  // Complexity (see parseConsoleComplexity)
+
+  bchData.run_name = bchData.name;
+  cleanupName(bchData);
+  bchData.run_type = aggregate_name.isEmpty() ? "iteration" : "aggregate";
+  bchData.threads = extractThreads(bchData.run_name);
+  bchData.iterations = static_cast<int>(iterations);
+
+  // Timings
+  const std::string_view unit = tokens[timeIdx + 1];
+  if (unit == "%") {  // cv (ratio)
+    realTime /= 100.;
+    cpuTime /= 100.;
+    bchData.time_unit = lastTimeUnit;
+  } else {
+    bchData.time_unit = QString::fromLatin1(unit.data(), unit.size());
+    lastTimeUnit = bchData.time_unit;
+  }
+  bchData.real_time.append(realTime);
+  bchData.cpu_time.append(cpuTime);
+
+  // Throughput ("bytes_per_second=1.5Gi/s" or old "1.5GB/s" and "12M items/s" formats)
+  for (int i = timeIdx + 5; i < tokens.size(); ++i) {
+    const std::string_view& token = tokens[i];
+    double value = 0.;
+    if (token.starts_with("bytes_per_second=")) {
+      if (toHumanDouble(token.substr(17), value))
+        bchData.kbytes_sec.append(value * 0.001);
+    } else if (token.starts_with("items_per_second=")) {
+      if (toHumanDouble(token.substr(17), value))
+        bchData.kitems_sec.append(value * 0.001);
+    } else if (token.ends_with("B/s") && token.find('=') == std::string_view::npos) {
+      if (toHumanDouble(token, value))
+        bchData.kbytes_sec.append(value * 0.001);
+    } else if (token == "items/s" && i > timeIdx + 5) {
+      if (toHumanDouble(tokens[i - 1], value))
+        bchData.kitems_sec.append(value * 0.001);
+    }
+  }
+
+  return true;
+}
+
+/**************************************************************************************************
+ *
+ * Json helpers
+ *
+ **************************************************************************************************/
+
+static qsizetype skipJsonSpaces(const char* data, qsizetype size, qsizetype pos) {
+  while (pos < size && (data[pos] == ' ' || data[pos] == '\n' || data[pos] == '\r' ||
+                        data[pos] == '\t'))
+    ++pos;
+  return pos;
+}
+
+// Position after the string starting at pos (-1 if unterminated)
+static qsizetype skipJsonString(const char* data, qsizetype size, qsizetype pos) {
+  for (++pos; pos < size; ++pos) {
+    const char* quote = static_cast<const char*>(memchr(data + pos, '"', size - pos));
+    if (quote == nullptr)
+      return -1;
+    pos = quote - data;
+    // Count preceding backslashes to know if quote is escaped
+    qsizetype slashes = 0;
+    while (data[pos - 1 - slashes] == '\\')
+      ++slashes;
+    if (slashes % 2 == 0)
+      return pos + 1;
+  }
+  return -1;
+}
+
+// Position after the value starting at pos, without decoding it (-1 if malformed)
+static qsizetype skipJsonValue(const char* data, qsizetype size, qsizetype pos) {
+  if (pos >= size)
+    return -1;
+  if (data[pos] == '"')
+    return skipJsonString(data, size, pos);
+
+  // Scalar
+  if (data[pos] != '{' && data[pos] != '[') {
+    while (pos < size && data[pos] != ',' && data[pos] != '}' && data[pos] != ']' &&
+           data[pos] != ' ' && data[pos] != '\n' && data[pos] != '\r' && data[pos] != '\t')
+      ++pos;
+    return pos;
+  }
+
+  // Object/array
+  int depth = 0;
+  while (pos < size) {
+    switch (data[pos]) {
+      case '"':
+        pos = skipJsonString(data, size, pos);
+        if (pos < 0)
+          return -1;
         continue;
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      case '}':
+      case ']':
+        if (--depth == 0)
+          return pos + 1;
+        break;
+      default:
+        break;
+    }
+    ++pos;
+  }
+  return -1;
+}
+
+//
+// Incremental scan of a json results file through a bounded window refilled from device: 'context'
+// object and 'benchmarks' array elements are copied out once complete, other values skipped
+// (whole decompressed text never resident)
+class JsonStreamScanner {
+ public:
+  explicit JsonStreamScanner(QIODevice& device) : mDevice(device) {}
+
+  // Scan main object, benchmark objects passed in file order (false if malformed)
+  template <typename Func>
+  bool scan(Func onBenchmark);
+
+  QByteArray context;  // empty if none
+  bool hasBenchmarks = false;
+  bool isEmpty = true;
+
+ private:
+  static constexpr qint64 kChunkSize = 1 << 20;
+
+  // Drop consumed bytes and append next chunk (false at end of device)
+  bool fill() {
+    mBuffer.remove(0, mPos);
+    mPos = 0;
+    const QByteArray chunk = mDevice.read(kChunkSize);
+    if (chunk.isEmpty())
+      return false;
+    mBuffer.append(chunk);
+    return true;
+  }
+  // Move to next non-space character (false if none)
+  bool skipSpaces() {
+    while (true) {
+      mPos = skipJsonSpaces(mBuffer.constData(), mBuffer.size(), mPos);
+      if (mPos < mBuffer.size())
+        return true;
+      if (!fill())
+        return false;
+    }
+  }
+  // Position after value starting at current one, refilled until a delimiter follows it
+  // (-1 if malformed)
+  qsizetype valueEnd() {
+    while (true) {
+      const qsizetype end = skipJsonValue(mBuffer.constData(), mBuffer.size(), mPos);
+      if (end >= 0 && end < mBuffer.size())
+        return end;
+      if (!fill())
+        return end;
+    }
+  }
+  char current() const { return mBuffer[mPos]; }
+
+  QIODevice& mDevice;
+  QByteArray mBuffer;
+  qsizetype mPos = 0;
+};
+
+template <typename Func>
+bool JsonStreamScanner::scan(Func onBenchmark) {
+  while (mBuffer.size() < 3 && fill()) {
+  }
+  if (mBuffer.startsWith("\xEF\xBB\xBF"))  // BOM
+    mPos = 3;
+  if (!skipSpaces() || current() != '{')
+    return false;
+  ++mPos;
+
+  while (skipSpaces()) {
+    if (current() == '}')
+      return true;
+
+    // Key
+    if (current() != '"')
+      return false;
+    const qsizetype keyEnd = valueEnd();
+    if (keyEnd < 0)
+      return false;
+    const QByteArray key = mBuffer.sliced(mPos + 1, keyEnd - mPos - 2);
+    mPos = keyEnd;
+    if (!skipSpaces() || current() != ':')
+      return false;
+    ++mPos;
+    if (!skipSpaces())
+      return false;
+    isEmpty = false;
+
+    // Value
+    if (key == "benchmarks" && current() == '[') {
+      hasBenchmarks = true;
+      ++mPos;
+      if (!skipSpaces())
+        return false;
+      while (current() != ']') {
+        const qsizetype end = valueEnd();
+        if (end < 0)
+          return false;
+        onBenchmark(mBuffer.sliced(mPos, end - mPos));
+        mPos = end;
+        if (!skipSpaces())
+          return false;
+        if (current() == ',') {
+          ++mPos;
+          if (!skipSpaces())
+            return false;
+        } else if (current() != ']')
+          return false;
       }
-      // Run name
-      if (bchObj.contains("run_name") && bchObj["run_name"].isString()) {
-        bchData.run_name = bchObj["run_name"].toString();
+      ++mPos;
+    } else {
+      const qsizetype end = valueEnd();
+      if (end < 0)
+        return false;
+      if (key == "context")
+        context = mBuffer.sliced(mPos, end - mPos);
+      mPos = end;
+    }
+
+    if (!skipSpaces())
+      return false;
+    if (current() == ',')
+      ++mPos;
+    else if (current() != '}')
+      return false;
+  }
+  return false;
+}
+
+// Decode json object (empty if invalid)
+static QJsonObject decodeJsonObject(const QByteArray& bytes) {
+  return QJsonDocument::fromJson(bytes).object();
+}
+// Parse context object
+static void parseJsonContext(const QJsonObject& ctxObj, BenchContext& context) {
+  // Meta
+  if (ctxObj.contains("date") && ctxObj["date"].isString()) {
+    context.date = ctxObj["date"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "date: " << context.date;
+  }
+  if (ctxObj.contains("host_name") && ctxObj["host_name"].isString()) {
+    context.host_name = ctxObj["host_name"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "host_name: " << context.host_name;
+  }
+  if (ctxObj.contains("executable") && ctxObj["executable"].isString()) {
+    context.executable = ctxObj["executable"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "executable: " << context.executable;
+  }
+
+  // Build
+  if (ctxObj.contains("library_build_type") && ctxObj["library_build_type"].isString()) {
+    context.build_type = ctxObj["library_build_type"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "library_build_type: " << context.build_type;
+  } else if (ctxObj.contains("build_type") && ctxObj["build_type"].isString()) {
+    context.build_type = ctxObj["build_type"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "build_type: " << context.build_type;
+  }
+
+  // CPU
+  if (ctxObj.contains("num_cpus") && ctxObj["num_cpus"].isDouble()) {
+    context.num_cpus = ctxObj["num_cpus"].toInt();
+    if (PARSE_DEBUG)
+      qDebug() << "num_cpus: " << context.num_cpus;
+  }
+  if (ctxObj.contains("mhz_per_cpu") && ctxObj["mhz_per_cpu"].isDouble()) {
+    context.mhz_per_cpu = ctxObj["mhz_per_cpu"].toInt();
+    if (PARSE_DEBUG)
+      qDebug() << "mhz_per_cpu: " << context.mhz_per_cpu;
+  }
+  if (ctxObj.contains("cpu_scaling_enabled") && ctxObj["cpu_scaling_enabled"].isBool()) {
+    context.cpu_scaling_enabled = ctxObj["cpu_scaling_enabled"].toBool();
+    if (PARSE_DEBUG)
+      qDebug() << "cpu_scaling_enabled: " << context.cpu_scaling_enabled;
+  }
+
+  // Caches
+  if (ctxObj.contains("caches") && ctxObj["caches"].isArray()) {
+    QJsonArray cchArray = ctxObj["caches"].toArray();
+    context.caches.reserve(cchArray.size());
+
+    for (int cchIdx = 0; cchIdx < cchArray.size(); ++cchIdx) {
+      // Cache
+      QJsonObject cchObj = cchArray[cchIdx].toObject();
+      BenchCache bchCache;
+      if (PARSE_DEBUG)
+        qDebug() << "Context cache";
+
+      // Meta
+      if (cchObj.contains("type") && cchObj["type"].isString()) {
+        bchCache.type = cchObj["type"].toString();
         if (PARSE_DEBUG)
-          qDebug() << "-> run_name:" << bchData.run_name;
-      } else {
-        bchData.run_name = bchData.name;
+          qDebug() << "-> type:" << bchCache.type;
+      }
+      if (cchObj.contains("level") && cchObj["level"].isDouble()) {
+        bchCache.level = cchObj["level"].toInt();
         if (PARSE_DEBUG)
-          qDebug() << "-> name as run_name:" << bchData.run_name;
+          qDebug() << "-> level:" << bchCache.level;
       }
-      cleanupName(bchData);
-      // Run type
-      if (bchObj.contains("run_type") && bchObj["run_type"].isString()) {
-        bchData.run_type = bchObj["run_type"].toString();
+      if (cchObj.contains("size") && cchObj["size"].isDouble()) {
+        bchCache.size = static_cast<int64_t>(cchObj["size"].toDouble());
         if (PARSE_DEBUG)
-          qDebug() << "-> run_type:" << bchData.run_type;
-      } else {
-        bchData.run_type = "iteration";
+          qDebug() << "-> size:" << bchCache.size;
+      }
+      if (cchObj.contains("num_sharing") && cchObj["num_sharing"].isDouble()) {
+        bchCache.num_sharing = cchObj["num_sharing"].toInt();
         if (PARSE_DEBUG)
-          qDebug() << "-> default run_type:" << bchData.run_type;
+          qDebug() << "-> num_sharing:" << bchCache.num_sharing;
       }
 
       //
-      // Timing
-      if (bchObj.contains("iterations") && bchObj["iterations"].isDouble()) {
-        bchData.iterations = bchObj["iterations"].toInt();
-        if (PARSE_DEBUG)
-          qDebug() << "-> iterations:" << bchData.iterations;
-      } else {
-        qCritical() << "Results parsing: missing benchmark field 'iterations'";
-        continue;
-      }
+      // Push bench cache
+      context.caches.append(bchCache);
 
-      if (bchObj.contains("real_time") && bchObj["real_time"].isDouble()) {
-        bchData.real_time.append(bchObj["real_time"].toDouble());
-        if (PARSE_DEBUG)
-          qDebug() << "-> real_time:" << bchData.real_time.back();
-      } else {
-        qCritical() << "Results parsing: missing benchmark field 'real_time'";
-        continue;
-      }
+      // New line between caches
+      if (PARSE_DEBUG)
+        qDebug() << "";
+    }
+  }
+}
 
-      if (bchObj.contains("cpu_time") && bchObj["cpu_time"].isDouble()) {
-        bchData.cpu_time.append(bchObj["cpu_time"].toDouble());
-        if (PARSE_DEBUG)
-          qDebug() << "-> cpu_time:" << bchData.cpu_time.back();
-      } else {
-        qCritical() << "Results parsing: missing benchmark field 'cpu_time'";
-        continue;
-      }
+// Parse complexity object (false if not a 'BigO'/'RMS' aggregate)
+static bool parseJsonComplexity(const QJsonObject& bchObj, BenchComplexity& complexity) {
+  if (bchObj["run_type"].toString() != "aggregate")
+    return false;
+  const QString aggregate_name = bchObj["aggregate_name"].toString();
+  if (aggregate_name != "BigO" && aggregate_name != "RMS")
+    return false;
 
-      if (bchObj.contains("time_unit") && bchObj["time_unit"].isString()) {
-        bchData.time_unit = bchObj["time_unit"].toString();
-        if (PARSE_DEBUG)
-          qDebug() << "-> time_unit:" << bchData.time_unit;
-      } else {
-        bchData.time_unit = "ns";
-        if (PARSE_DEBUG)
-          qDebug() << "-> default time_unit:" << bchData.time_unit;
-      }
-      // Time normalization (us)
-      double timeFactor = 1.;
-      if (bchData.time_unit == "ns") {
-        timeFactor = 0.001;
-        if (bchResults.meta.time_unit.isEmpty())
-          bchResults.meta.time_unit = "ns";
-        else if (bchResults.meta.time_unit != "ns")
-          bchResults.meta.time_unit = "us";
-      } else if (bchData.time_unit == "ms") {
-        timeFactor = 1000.;
-        if (bchResults.meta.time_unit.isEmpty())
-          bchResults.meta.time_unit = "ms";
-        else if (bchResults.meta.time_unit != "ms")
-          bchResults.meta.time_unit = "us";
+  // Family name
+  if (bchObj.contains("run_name") && bchObj["run_name"].isString())
+    complexity.run_name = bchObj["run_name"].toString();
+  else {
+    complexity.run_name = bchObj["name"].toString();
+    extractAggregateName(complexity.run_name);
+  }
+  cleanupFamilyName(complexity.run_name);
+  if (PARSE_DEBUG)
+    qDebug() << "complexity:" << complexity.run_name << "->" << aggregate_name;
 
-      } else {
-        bchResults.meta.time_unit = "us";
-      }
-      bchData.real_time_us = bchData.real_time.back() * timeFactor;
-      bchData.cpu_time_us = bchData.cpu_time.back() * timeFactor;
+  // Values
+  if (aggregate_name == "BigO") {
+    const double timeFactor = BenchResults::getTimeFactorUs(bchObj["time_unit"].toString("ns"));
+    complexity.big_o = bchObj["big_o"].toString();
+    if (bchObj["cpu_coefficient"].isDouble())
+      complexity.cpu_coefficient = bchObj["cpu_coefficient"].toDouble() * timeFactor;
+    if (bchObj["real_coefficient"].isDouble())
+      complexity.real_coefficient = bchObj["real_coefficient"].toDouble() * timeFactor;
+    if (PARSE_DEBUG)
+      qDebug() << "-> big_o:" << complexity.big_o << complexity.cpu_coefficient;
+  } else if (bchObj["rms"].isDouble()) {
+    complexity.rms = bchObj["rms"].toDouble();
+    if (PARSE_DEBUG)
+      qDebug() << "-> rms:" << complexity.rms;
+  }
 
-      //
-      // Throughput
-      if (bchObj.contains("bytes_per_second") && bchObj["bytes_per_second"].isDouble()) {
-        bchData.kbytes_sec.append(bchObj["bytes_per_second"].toDouble() * 0.001);
-        bchData.kbytes_sec_dflt = bchData.kbytes_sec.back();
-        bchResults.meta.hasBytesSec = true;
-        if (PARSE_DEBUG)
-          qDebug() << "-> kbytes_sec:" << bchData.kbytes_sec_dflt;
-      }
-      if (bchObj.contains("items_per_second") && bchObj["items_per_second"].isDouble()) {
-        bchData.kitems_sec.append(bchObj["items_per_second"].toDouble() * 0.001);
-        bchData.kitems_sec_dflt = bchData.kitems_sec.back();
-        bchResults.meta.hasItemsSec = true;
-        if (PARSE_DEBUG)
-          qDebug() << "-> kitems_sec:" << bchData.kitems_sec_dflt;
-      }
+  return true;
+}
 
-      /*
-       * Existing benchmark
-       */
-      int idx = findExistingBenchmark(bchResults, bchData.run_name);
-      if (idx >= 0) {
-        BenchData& exBchData = bchResults.benchmarks[idx];
-
-        /*
-         * Aggregate type
-         */
-        if (bchData.run_type == "aggregate") {
-          if (PARSE_DEBUG)
-            qDebug() << "-> append aggregate:" << exBchData.name;
-
-          // Name
-          QString aggregate_name;
-          if (bchObj.contains("aggregate_name") && bchObj["aggregate_name"].isString()) {
-            aggregate_name = bchObj["aggregate_name"].toString();
-            if (PARSE_DEBUG)
-              qDebug() << "-> aggregate_name:" << aggregate_name;
-          } else {
-            qCritical() << "Results parsing: missing benchmark field 'aggregate_name'";
-            continue;
-          }
-          // Type
-          if (aggregate_name == "mean") {
-            exBchData.mean_cpu = bchData.cpu_time_us;
-            exBchData.mean_real = bchData.real_time_us;
-            if (!bchData.kbytes_sec.isEmpty())
-              exBchData.mean_kbytes = bchData.kbytes_sec_dflt;
-            if (!bchData.kitems_sec.isEmpty())
-              exBchData.mean_kitems = bchData.kitems_sec_dflt;
-          } else if (aggregate_name == "median") {
-            exBchData.median_cpu = bchData.cpu_time_us;
-            exBchData.median_real = bchData.real_time_us;
-            if (!bchData.kbytes_sec.isEmpty())
-              exBchData.median_kbytes = bchData.kbytes_sec_dflt;
-            if (!bchData.kitems_sec.isEmpty())
-              exBchData.median_kitems = bchData.kitems_sec_dflt;
-          } else if (aggregate_name == "stddev") {
-            exBchData.stddev_cpu = bchData.cpu_time_us;
-            exBchData.stddev_real = bchData.real_time_us;
-            if (!bchData.kbytes_sec.isEmpty())
-              exBchData.stddev_kbytes = bchData.kbytes_sec_dflt;
-            if (!bchData.kitems_sec.isEmpty())
-              exBchData.stddev_kitems = bchData.kitems_sec_dflt;
-          } else if (aggregate_name == "cv") {
-            exBchData.cv_cpu = bchData.cpu_time.back() * 100;  // percent
-            exBchData.cv_real = bchData.real_time.back() * 100;
-            if (!bchData.kbytes_sec.isEmpty())
-              exBchData.cv_kbytes = bchData.kbytes_sec_dflt * 100;
-            if (!bchData.kitems_sec.isEmpty())
-              exBchData.cv_kitems = bchData.kitems_sec_dflt * 100;
-            bchResults.meta.hasCv = true;
-          } else {
-            qCritical() << "Results parsing: unknown benchmark value for 'aggregate_name' ->"
-                        << aggregate_name;
-            continue;
-          }
-
-          // New aggregate line
-          if (PARSE_DEBUG)
-            qDebug() << "||";
-        }
+// Parse benchmark object (false if invalid)
+static bool parseJsonBenchmark(const QJsonObject& bchObj, BenchData& bchData,
+                               QString& aggregate_name) {
+  //
+  // Name
+  if (bchObj.contains("name") && bchObj["name"].isString()) {
+    bchData.name = bchObj["name"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "bench name:" << bchData.name;
+  } else {
+    qCritical() << "Results parsing: missing benchmark field 'name'";
+    return false;
+  }
+  // Run name
+  if (bchObj.contains("run_name") && bchObj["run_name"].isString()) {
+    bchData.run_name = bchObj["run_name"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "-> run_name:" << bchData.run_name;
+  } else {
+    bchData.run_name = bchData.name;
+    if (PARSE_DEBUG)
+      qDebug() << "-> name as run_name:" << bchData.run_name;
+  }
+  cleanupName(bchData);
+  // Run type
+  if (bchObj.contains("run_type") && bchObj["run_type"].isString()) {
+    bchData.run_type = bchObj["run_type"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "-> run_type:" << bchData.run_type;
+  } else {
+    bchData.run_type = "iteration";
+    if (PARSE_DEBUG)
+      qDebug() << "-> default run_type:" << bchData.run_type;
+  }
 
-        /*
-         * Iteration type (from aggregate)
-         */
-        else {
-          if (PARSE_DEBUG)
-            qDebug() << "-> append iteration:" << exBchData.name;
-
-          // Append data
-          exBchData.cpu_time.append(bchData.cpu_time.back());
-          exBchData.cpu_time_us = std::min(exBchData.cpu_time_us, bchData.cpu_time_us);
-
-          exBchData.real_time.append(bchData.real_time.back());
-          exBchData.real_time_us = std::min(exBchData.real_time_us, bchData.real_time_us);
-
-          if (!bchData.kbytes_sec.isEmpty()) {
-            exBchData.kbytes_sec.append(bchData.kbytes_sec_dflt);
-            exBchData.kbytes_sec_dflt =
-                std::min(exBchData.kbytes_sec_dflt, bchData.kbytes_sec_dflt);
-          }
-          if (!bchData.kitems_sec.isEmpty()) {
-            exBchData.kitems_sec.append(bchData.kitems_sec_dflt);
-            exBchData.kitems_sec_dflt =
-                std::min(exBchData.kitems_sec_dflt, bchData.kitems_sec_dflt);
-          }
-
-          // Min/Max
-          if (!exBchData.hasAggregate)  // First -> init
-          {
-            exBchData.min_cpu = exBchData.cpu_time_us;
-            exBchData.max_cpu = std::max(exBchData.cpu_time_us, bchData.cpu_time_us);
-
-            exBchData.min_real = exBchData.real_time_us;
-            exBchData.max_real = std::max(exBchData.real_time_us, bchData.real_time_us);
-
-            if (!bchData.kbytes_sec.isEmpty()) {
-              exBchData.min_kbytes = exBchData.kbytes_sec_dflt;
-              exBchData.max_kbytes = std::max(exBchData.kbytes_sec_dflt, bchData.kbytes_sec_dflt);
-            }
-            if (!bchData.kitems_sec.isEmpty()) {
-              exBchData.min_kitems = exBchData.kitems_sec_dflt;
-              exBchData.max_kitems = std::max(exBchData.kitems_sec_dflt, bchData.kitems_sec_dflt);
-            }
-          } else {
-            if (exBchData.min_cpu > bchData.cpu_time_us)
-              exBchData.min_cpu = bchData.cpu_time_us;
-            if (exBchData.max_cpu < bchData.cpu_time_us)
-              exBchData.max_cpu = bchData.cpu_time_us;
-
-            if (exBchData.min_real > bchData.real_time_us)
-              exBchData.min_real = bchData.real_time_us;
-            if (exBchData.max_real < bchData.real_time_us)
-              exBchData.max_real = bchData.real_time_us;
-
-            if (!bchData.kbytes_sec.isEmpty()) {
-              if (exBchData.min_kbytes > bchData.kbytes_sec_dflt)
-                exBchData.min_kbytes = bchData.kbytes_sec_dflt;
-              if (exBchData.max_kbytes < bchData.kbytes_sec_dflt)
-                exBchData.max_kbytes = bchData.kbytes_sec_dflt;
-            }
-            if (!bchData.kitems_sec.isEmpty()) {
-              if (exBchData.min_kitems > bchData.kitems_sec_dflt)
-                exBchData.min_kitems = bchData.kitems_sec_dflt;
-              if (exBchData.max_kitems < bchData.kitems_sec_dflt)
-                exBchData.max_kitems = bchData.kitems_sec_dflt;
-            }
-          }
-
-          // State
-          exBchData.hasAggregate = true;
-          bchResults.meta.hasAggregate = true;
-          bchResults.meta.onlyAggregate = false;
-
-          // Debug
-          if (PARSE_DEBUG) {
-            qDebug() << "** exBchData.min_cpu:" << exBchData.min_cpu;
-            qDebug() << "** exBchData.max_cpu:" << exBchData.max_cpu;
-            qDebug() << "** exBchData.min_real:" << exBchData.min_real;
-            qDebug() << "** exBchData.max_real:" << exBchData.max_real;
-            if (!exBchData.kbytes_sec.isEmpty()) {
-              qDebug() << "** exBchData.min_kbytes:" << exBchData.min_kbytes;
-              qDebug() << "** exBchData.max_kbytes:" << exBchData.max_kbytes;
-            }
-            if (!exBchData.kitems_sec.isEmpty()) {
-              qDebug() << "** exBchData.min_kitems:" << exBchData.min_kitems;
-              qDebug() << "** exBchData.max_kitems:" << exBchData.max_kitems;
-            }
-          }
-
-          // New  append line
-          if (PARSE_DEBUG)
-            qDebug() << "|";
-        }
+  //
+  // Timing
+  if (bchObj.contains("iterations") && bchObj["iterations"].isDouble()) {
+    bchData.iterations = bchObj["iterations"].toInt();
+    if (PARSE_DEBUG)
+      qDebug() << "-> iterations:" << bchData.iterations;
+  } else {
+    qCritical() << "Results parsing: missing benchmark field 'iterations'";
+    return false;
+  }
+
+  if (bchObj.contains("real_time") && bchObj["real_time"].isDouble()) {
+    bchData.real_time.append(bchObj["real_time"].toDouble());
+    if (PARSE_DEBUG)
+      qDebug() << "-> real_time:" << bchData.real_time.back();
+  } else {
+    qCritical() << "Results parsing: missing benchmark field 'real_time'";
+    return false;
+  }
+
+  if (bchObj.contains("cpu_time") && bchObj["cpu_time"].isDouble()) {
+    bchData.cpu_time.append(bchObj["cpu_time"].toDouble());
+    if (PARSE_DEBUG)
+      qDebug() << "-> cpu_time:" << bchData.cpu_time.back();
+  } else {
+    qCritical() << "Results parsing: missing benchmark field 'cpu_time'";
+    return false;
+  }
+
+  if (bchObj.contains("time_unit") && bchObj["time_unit"].isString()) {
+    bchData.time_unit = bchObj["time_unit"].toString();
+    if (PARSE_DEBUG)
+      qDebug() << "-> time_unit:" << bchData.time_unit;
+  } else {
+    bchData.time_unit = "ns";
+    if (PARSE_DEBUG)
+      qDebug() << "-> default time_unit:" << bchData.time_unit;
+  }
+
+  //
+  // Throughput
+  if (bchObj.contains("bytes_per_second") && bchObj["bytes_per_second"].isDouble()) {
+    bchData.kbytes_sec.append(bchObj["bytes_per_second"].toDouble() * 0.001);
+    if (PARSE_DEBUG)
+      qDebug() << "-> kbytes_sec:" << bchData.kbytes_sec.back();
+  }
+  if (bchObj.contains("items_per_second") && bchObj["items_per_second"].isDouble()) {
+    bchData.kitems_sec.append(bchObj["items_per_second"].toDouble() * 0.001);
+    if (PARSE_DEBUG)
+      qDebug() << "-> kitems_sec:" << bchData.kitems_sec.back();
+  }
+
+  //
+  // Meta
+  if (bchObj.contains("repetitions") && bchObj["repetitions"].isDouble()) {
+    bchData.repetitions = bchObj["repetitions"].toInt();
+    if (PARSE_DEBUG)
+      qDebug() << "-> repetitions:" << bchData.repetitions;
+  }
+  if (bchObj.contains("repetition_index") && bchObj["repetition_index"].isDouble()) {
+    bchData.repetition_index = bchObj["repetition_index"].toInt();
+    if (PARSE_DEBUG)
+      qDebug() << "-> repetition_index:" << bchData.repetition_index;
+  }
+  if (bchObj.contains("threads") && bchObj["threads"].isDouble()) {
+    bchData.threads = bchObj["threads"].toInt();
+    if (PARSE_DEBUG)
+      qDebug() << "-> threads:" << bchData.threads;
+  }
+
+  //
+  // Aggregate name
+  if (bchData.run_type == "aggregate") {
+    if (bchObj.contains("aggregate_name") && bchObj["aggregate_name"].isString()) {
+      aggregate_name = bchObj["aggregate_name"].toString();
+      if (PARSE_DEBUG)
+        qDebug() << "-> aggregate_name:" << aggregate_name;
+    } else {
+      qCritical() << "Results parsing: missing benchmark field 'aggregate_name'";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**************************************************************************************************
+ *
+ * ResultParser
+ *
+ **************************************************************************************************/
+
+ResultParser::ResultFormat ResultParser::detectFormat(QIODevice& device) {
+  const QByteArray head = device.peek(8192);
+
+  // Json
+  int pos = head.startsWith("\xEF\xBB\xBF") ? 3 : 0;  // BOM
+  while (pos < head.size() && QChar::isSpace(head[pos]))
+    ++pos;
+  if (pos < head.size() && head[pos] == '{')
+    return JsonFormat;
+
+  // Line-based (context may be printed first)
+  const QList<QByteArray> lines = head.split('\n');
+  for (const auto& line : lines) {
+    if (line.startsWith("name,iterations,"))
+      return CsvFormat;
+    if (line.startsWith("Benchmark ") && line.contains(" Time "))
+      return ConsoleFormat;
+  }
+
+  return UnknownFormat;
+}
+
+// Shared by all parsing entry points (set once from preferences or command line)
+static OutlierFilter& outlierFilterStorage() {
+  static OutlierFilter filter;
+  return filter;
+}
+
+void ResultParser::setOutlierFilter(const OutlierFilter& filter) {
+  outlierFilterStorage() = filter;
+}
+
+const OutlierFilter& ResultParser::outlierFilter() {
+  return outlierFilterStorage();
+}
+
+/**************************************************************************************************/
+
+//
+// Results file opened for reading, transparently decompressed if gzip/zstd
+class ResultsFile {
+ public:
+  explicit ResultsFile(const QString& filename) : mFile(filename) {}
+
+  bool open(QString& errorMsg) {
+    if (!mFile.open(QIODevice::ReadOnly)) {
+      errorMsg = "Couldn't open benchmark results file.";
+      return false;
+    }
+    auto compression = DecompressDevice::detectCompression(mFile);
+    if (compression != DecompressDevice::NoCompression) {
+      mDecompress.reset(new DecompressDevice(&mFile, compression));
+      if (!mDecompress->open(QIODevice::ReadOnly)) {
+        errorMsg = "Couldn't decompress benchmark results file: " + mDecompress->errorString();
+        return false;
       }
+    }
+    return true;
+  }
 
-      /*
-       * New benchmark
-       */
-      else {
-        /*
-         * Aggregate-only type
-         */
-        if (bchData.run_type == "aggregate") {
-          if (PARSE_DEBUG)
-            qDebug() << "-> new aggregate-only";
-
-          // Name
-          QString aggregate_name;
-          if (bchObj.contains("aggregate_name") && bchObj["aggregate_name"].isString()) {
-            aggregate_name = bchObj["aggregate_name"].toString();
-            if (PARSE_DEBUG)
-              qDebug() << "-> aggregate_name:" << aggregate_name;
-          } else {
-            qCritical() << "Results parsing: missing benchmark field 'aggregate_name'";
-            continue;
-          }
-          // Type
-          if (aggregate_name == "mean") {
-            bchData.mean_cpu = bchData.cpu_time_us;
-            bchData.mean_real = bchData.real_time_us;
-            if (!bchData.kbytes_sec.isEmpty())
-              bchData.mean_kbytes = bchData.kbytes_sec_dflt;
-            if (!bchData.kitems_sec.isEmpty())
-              bchData.mean_kitems = bchData.kitems_sec_dflt;
-          } else if (aggregate_name == "median") {
-            bchData.median_cpu = bchData.cpu_time_us;
-            bchData.median_real = bchData.real_time_us;
-            if (!bchData.kbytes_sec.isEmpty())
-              bchData.median_kbytes = bchData.kbytes_sec_dflt;
-            if (!bchData.kitems_sec.isEmpty())
-              bchData.median_kitems = bchData.kitems_sec_dflt;
-          } else if (aggregate_name == "stddev") {
-            bchData.stddev_cpu = bchData.cpu_time_us;
-            bchData.stddev_real = bchData.real_time_us;
-            if (!bchData.kbytes_sec.isEmpty())
-              bchData.stddev_kbytes = bchData.kbytes_sec_dflt;
-            if (!bchData.kitems_sec.isEmpty())
-              bchData.stddev_kitems = bchData.kitems_sec_dflt;
-          } else if (aggregate_name == "cv") {
-            bchData.cv_cpu = bchData.cpu_time.back() * 100;  // percent
-            bchData.cv_real = bchData.real_time.back() * 100;
-            if (!bchData.kbytes_sec.isEmpty())
-              bchData.cv_kbytes = bchData.kbytes_sec_dflt * 100;
-            if (!bchData.kitems_sec.isEmpty())
-              bchData.cv_kitems = bchData.kitems_sec_dflt * 100;
-            bchResults.meta.hasCv = true;
-          } else {
-            qCritical() << "Results parsing: unknown benchmark value for 'aggregate_name' ->"
-                        << aggregate_name;
-            continue;
-          }
-
-          // Init
-          bchData.hasAggregate = true;
-          bchResults.meta.hasAggregate = true;
-
-          bchData.cpu_time_us = -1;
-          bchData.real_time_us = -1;
-          bchData.min_cpu = bchData.max_cpu = -1;
-          bchData.min_real = bchData.max_real = -1;
-        }
+  QIODevice& device() {
+    return mDecompress ? static_cast<QIODevice&>(*mDecompress) : static_cast<QIODevice&>(mFile);
+  }
 
-        /*
-         * Add new benchmark
-         */
-        // Arguments (extract from 'run_name')
-        bchData.arguments = bchData.run_name.split('/');
-        QString bchName = bchData.arguments.front();
-        bchData.arguments.pop_front();
-
-        // Debug: params
-        for (int prmIdx = 0; prmIdx < bchData.arguments.size(); ++prmIdx)
-          if (PARSE_DEBUG)
-            qDebug() << "-> param[" << prmIdx << "]:" << bchData.arguments[prmIdx];
-
-        // Templates (extract from 'run_name' too)
-        int tpltIdx = bchName.indexOf("<");
-        if (tpltIdx > 0) {
-          int tpltLast = bchName.lastIndexOf(">");
-          if (tpltLast != bchName.size() - 1) {
-            qCritical() << "Bad benchmark template formatting:" << bchName;
-            continue;
-          }
-          QString tpltName = bchName.mid(tpltIdx + 1, tpltLast - tpltIdx - 1);
-
-          // Split
-          int startIdx = 0;
-          int commaIdx = tpltName.indexOf(",");
-          while (commaIdx > 0) {
-            QString leftString = tpltName.left(commaIdx);
-            int open = leftString.count('<');
-            int close = leftString.count('>');
-
-            if (open <= close) {
-              bchData.templates.append(tpltName.left(commaIdx).trimmed());
-              tpltName.remove(0, commaIdx + 1);
-              startIdx = 0;
-            } else {
-              startIdx = commaIdx + 1;
-            }
-            commaIdx = tpltName.indexOf(",", startIdx);
-          }
-          // Last
-          bchData.templates.append(tpltName.trimmed());
-
-          // For base name
-          bchName.truncate(tpltIdx);
-        }
-        // Debug: templates
-        for (int idx = 0; idx < bchData.templates.size(); ++idx)
-          if (PARSE_DEBUG)
-            qDebug() << "-> template[" << idx << "]:" << bchData.templates[idx];
+  // Check decompression after parsing (errorMsg kept if already set)
+  void checkErrors(QString& errorMsg) const {
+    if (mDecompress && mDecompress->hasFailed() && errorMsg.isEmpty())
+      errorMsg = "Corrupted compressed benchmark results file: " + mDecompress->errorString();
+  }
 
-        // Base name (i.e. name without templates/arguments)
-        bchData.base_name = bchName;
-        if (PARSE_DEBUG)
-          qDebug() << "-> base_name:" << bchData.base_name;
-
-        // JOMT
-        // Family / Container
-        if (bchData.base_name.startsWith("JOMT_")) {
-          // Examples: "JOMT_Fill_vector<int>/64" Vs "JOMT_Fill_deque<int>/64"
-          bchData.base_name = bchData.base_name.remove(0, 5);  // remove prefix
-          int idx = bchData.base_name.indexOf('_');
-          if (idx > 0) {
-            bchData.family = bchData.base_name.left(idx);
-            bchData.container = bchData.base_name;
-            bchData.container = bchData.container.remove(0, idx + 1);
-          }
-        }
-        // Classic (base name as family name)
-        else
-          bchData.family = bchData.base_name;
+ private:
+  QFile mFile;
+  QScopedPointer<DecompressDevice> mDecompress;
+};
 
-        if (PARSE_DEBUG)
-          qDebug() << "-> family:" << bchData.family;
-        if (PARSE_DEBUG)
-          qDebug() << "-> container:" << bchData.container;
-
-        //
-        // Meta
-        if (bchObj.contains("repetitions") && bchObj["repetitions"].isDouble()) {
-          bchData.repetitions = bchObj["repetitions"].toInt();
-          if (PARSE_DEBUG)
-            qDebug() << "-> repetitions:" << bchData.repetitions;
-        }
-        if (bchObj.contains("repetition_index") && bchObj["repetition_index"].isDouble()) {
-          bchData.repetition_index = bchObj["repetition_index"].toInt();
-          if (PARSE_DEBUG)
-            qDebug() << "-> repetition_index:" << bchData.repetition_index;
-        }
-        if (bchObj.contains("threads") && bchObj["threads"].isDouble()) {
-          bchData.threads = bchObj["threads"].toInt();
-          if (PARSE_DEBUG)
-            qDebug() << "-> threads:" << bchData.threads;
-        }
+/**************************************************************************************************/
 
-        //
-        // Global Meta
-        if (bchData.arguments.size() > bchResults.meta.maxArguments)
-          bchResults.meta.maxArguments = bchData.arguments.size();
-        if (bchData.templates.size() > bchResults.meta.maxTemplates)
-          bchResults.meta.maxTemplates = bchData.templates.size();
-        bchResults.meta.onlyAggregate &= bchData.min_real < 0.;
+BenchResults ResultParser::parseResultsFile(const QString& filename, QString& errorMsg) {
+  ResultsFile benchFile(filename);
+  if (!benchFile.open(errorMsg))
+    return BenchResults();
 
-        //
-        // Push new BenchData
-        bchResults.benchmarks.append(bchData);
+  BenchResults bchResults;
+  switch (detectFormat(benchFile.device())) {
+    case JsonFormat:
+      bchResults = parseJson(benchFile.device(), errorMsg);
+      break;
+    case CsvFormat:
+      bchResults = parseCsv(benchFile.device(), errorMsg);
+      break;
+    case ConsoleFormat:
+      bchResults = parseConsole(benchFile.device(), errorMsg);
+      break;
+    case UnknownFormat:
+      errorMsg = "Unknown benchmark results file format.";
+      break;
+  }
+  benchFile.checkErrors(errorMsg);
 
-        // New line between benchmarks
-        if (PARSE_DEBUG)
-          qDebug() << "";
+  return bchResults;
+}
+
+/**************************************************************************************************/
+
+BenchResults ResultParser::parseJsonFile(const QString& filename, QString& errorMsg) {
+  ResultsFile benchFile(filename);
+  if (!benchFile.open(errorMsg))
+    return BenchResults();
+
+  BenchResults bchResults = parseJson(benchFile.device(), errorMsg);
+  benchFile.checkErrors(errorMsg);
+
+  return bchResults;
+}
+
+BenchResults ResultParser::parseCsvFile(const QString& filename, QString& errorMsg) {
+  ResultsFile benchFile(filename);
+  if (!benchFile.open(errorMsg))
+    return BenchResults();
+
+  BenchResults bchResults = parseCsv(benchFile.device(), errorMsg);
+  benchFile.checkErrors(errorMsg);
+
+  return bchResults;
+}
+
+BenchResults ResultParser::parseConsoleFile(const QString& filename, QString& errorMsg) {
+  ResultsFile benchFile(filename);
+  if (!benchFile.open(errorMsg))
+    return BenchResults();
+
+  BenchResults bchResults = parseConsole(benchFile.device(), errorMsg);
+  benchFile.checkErrors(errorMsg);
+
+  return bchResults;
+}
+
+/**************************************************************************************************/
+
+// Parse benchmark results from json file
+// Objects of the 'benchmarks' array are streamed out of the device by a structural scan, then
+// decoded in parallel batches and folded in file order.
+BenchResults ResultParser::parseJson(QIODevice& device, QString& errorMsg) {
+  BenchResults bchResults;
+  QHash<QString, int> bchIndexes;
+
+  struct ParsedBench {
+    BenchData bchData;
+    BenchComplexity complexity;
+    QString aggregate_name;
+    bool isValid = false, isComplexity = false;
+  };
+  static constexpr qsizetype kBatchSize = 8192;
+  QList<QByteArray> batch;
+  std::vector<ParsedBench> parsed;
+
+  // Decode pending benchmark objects and merge them by run_name
+  auto flushBatch = [&]() {
+    const qsizetype bchCount = batch.size();
+    parsed.assign(bchCount, ParsedBench());
+
+    auto decodeRange = [&](qsizetype begin, qsizetype end) {
+      for (qsizetype bchIdx = begin; bchIdx < end; ++bchIdx) {
+        QJsonObject bchObj = decodeJsonObject(batch[bchIdx]);
+        ParsedBench& bench = parsed[bchIdx];
+        bench.isComplexity = parseJsonComplexity(bchObj, bench.complexity);
+        if (!bench.isComplexity)
+          bench.isValid = parseJsonBenchmark(bchObj, bench.bchData, bench.aggregate_name);
       }
+    };
+
+    // Decode chunks on all cores (debug output kept ordered on a single one)
+    static constexpr qsizetype kMinBenchPerThread = 512;
+    qsizetype numThreads = PARSE_DEBUG ? 1 : QThread::idealThreadCount();
+    numThreads = std::clamp<qsizetype>(bchCount / kMinBenchPerThread, 1, numThreads);
+    if (numThreads > 1) {
+      std::vector<std::thread> threads;
+      threads.reserve(numThreads);
+      const qsizetype chunkSize = (bchCount + numThreads - 1) / numThreads;
+      for (qsizetype begin = 0; begin < bchCount; begin += chunkSize)
+        threads.emplace_back(decodeRange, begin, std::min(begin + chunkSize, bchCount));
+      for (auto& thread : threads)
+        thread.join();
+    } else
+      decodeRange(0, bchCount);
+
+    for (auto& bench : parsed) {
+      if (bench.isComplexity)
+        insertComplexity(bchResults, bench.complexity);
+      else if (bench.isValid)
+        insertBenchmark(bchResults, bchIndexes, bench.bchData, bench.aggregate_name);
     }
-  } else
+    batch.clear();
+  };
+
+  // Scan file through a bounded window
+  JsonStreamScanner scanner(device);
+  const bool isValid = scanner.scan([&](QByteArray&& bchBytes) {
+    batch.append(std::move(bchBytes));
+    if (batch.size() >= kBatchSize)
+      flushBatch();
+  });
+  if (!isValid) {
+    errorMsg = "Not a json benchmark results file.";
+    return BenchResults();
+  }
+  if (scanner.isEmpty) {
+    errorMsg = "Empty json benchmark results file.";
+    return BenchResults();
+  }
+  flushBatch();
+
+  /*
+   * Context
+   */
+  QJsonObject ctxObj;
+  if (!scanner.context.isEmpty())
+    ctxObj = decodeJsonObject(scanner.context);
+  if (!ctxObj.isEmpty())
+    parseJsonContext(ctxObj, bchResults.context);
+  else
+    qCritical() << "Results parsing: missing field 'context'";
+
+  if (!scanner.hasBenchmarks)
     qCritical() << "Results parsing: missing field 'benchmarks'";
 
   // Debug
@@ -649,5 +1404,196 @@ BenchResults ResultParser::parseJsonFile(const QString& filename, QString& error
     qDebug() << "meta.hasAggregate:" << bchResults.meta.hasAggregate;
   }
 
+  bchResults.updateStats(outlierFilter());
+
+  return bchResults;
+}
+
+/**************************************************************************************************/
+
+// Parse benchmark results from csv file (--benchmark_format=csv)
+BenchResults ResultParser::parseCsv(QIODevice& device, QString& errorMsg) {
+  BenchResults bchResults;
+  QHash<QString, int> bchIndexes;
+
+  // Columns
+  int nameCol = -1, iterCol = -1, realCol = -1, cpuCol = -1, unitCol = -1;
+  int bytesCol = -1, itemsCol = -1, errorCol = -1;
+  int minCols = 0;
+  bool hasHeader = false;
+
+  QString lastTimeUnit = "ns";
+  QVarLengthArray<std::string_view, 16> fields;
+  while (!device.atEnd()) {
+    const QByteArray lineData = device.readLine();
+    const std::string_view line = trimmedLine(lineData);
+    if (line.empty())
+      continue;
+
+    //
+    // Header (context may be printed first if stderr is redirected too)
+    if (!hasHeader) {
+      if (!line.starts_with("name,")) {
+        parseContextLine(line, bchResults.context);
+        continue;
+      }
+      splitCsvLine(line, fields);
+      for (int col = 0; col < fields.size(); ++col) {
+        const std::string_view& field = fields[col];
+        if (field == "name")
+          nameCol = col;
+        else if (field == "iterations")
+          iterCol = col;
+        else if (field == "real_time")
+          realCol = col;
+        else if (field == "cpu_time")
+          cpuCol = col;
+        else if (field == "time_unit")
+          unitCol = col;
+        else if (field == "bytes_per_second")
+          bytesCol = col;
+        else if (field == "items_per_second")
+          itemsCol = col;
+        else if (field == "error_occurred")
+          errorCol = col;
+      }
+      if (iterCol < 0 || realCol < 0 || cpuCol < 0 || unitCol < 0) {
+        errorMsg = "Missing columns in csv benchmark results file.";
+        return bchResults;
+      }
+      minCols = std::max({nameCol, iterCol, realCol, cpuCol, unitCol}) + 1;
+      hasHeader = true;
+      continue;
+    }
+
+    //
+    // Benchmark
+    splitCsvLine(line, fields);
+    if (fields.size() < minCols) {
+      qCritical() << "Results parsing: incomplete csv line ->"
+                  << QString::fromUtf8(line.data(), line.size());
+      continue;
+    }
+    if (errorCol >= 0 && errorCol < fields.size() && fields[errorCol] == "true")
+      continue;  // Skipped with error
+
+    BenchData bchData;
+
+    // Name
+    bchData.name = unquoteCsv(fields[nameCol]);
+    QString aggregate_name = extractAggregateName(bchData.name);
+    if (aggregate_name == "BigO" || aggregate_name == "RMS") {
+      // Complexity: coefficients with notation as unit, or RMS
+      BenchComplexity complexity;
+      complexity.run_name = bchData.name;
+      cleanupFamilyName(complexity.run_name);
+      double realValue = 0., cpuValue = 0.;
+      if (!toDouble(fields[realCol], realValue) || !toDouble(fields[cpuCol], cpuValue))
+        continue;
+      if (aggregate_name == "BigO") {
+        const double timeFactor = BenchResults::getTimeFactorUs(lastTimeUnit);
+        complexity.big_o = unquoteCsv(fields[unitCol]);
+        complexity.cpu_coefficient = cpuValue * timeFactor;
+        complexity.real_coefficient = realValue * timeFactor;
+      } else
+        complexity.rms = cpuValue;
+      insertComplexity(bchResults, complexity);
+      continue;
+    }
+    bchData.run_name = bchData.name;
+    cleanupName(bchData);
+    bchData.run_type = aggregate_name.isEmpty() ? "iteration" : "aggregate";
+    bchData.threads = extractThreads(bchData.run_name);
+
+    // Timing
+    double value = 0.;
+    if (!toDouble(fields[iterCol], value)) {
+      qCritical() << "Results parsing: missing benchmark field 'iterations'";
+      continue;
+    }
+    bchData.iterations = static_cast<int>(value);
+    if (!toDouble(fields[realCol], value)) {
+      qCritical() << "Results parsing: missing benchmark field 'real_time'";
+      continue;
+    }
+    bchData.real_time.append(value);
+    if (!toDouble(fields[cpuCol], value)) {
+      qCritical() << "Results parsing: missing benchmark field 'cpu_time'";
+      continue;
+    }
+    bchData.cpu_time.append(value);
+
+    const std::string_view unit = fields[unitCol];
+    if (!unit.empty())  // Empty for percentage aggregates (cv)
+      lastTimeUnit = QString::fromLatin1(unit.data(), unit.size());
+    bchData.time_unit = lastTimeUnit;
+
+    // Throughput
+    if (bytesCol >= 0 && bytesCol < fields.size() && toDouble(fields[bytesCol], value))
+      bchData.kbytes_sec.append(value * 0.001);
+    if (itemsCol >= 0 && itemsCol < fields.size() && toDouble(fields[itemsCol], value))
+      bchData.kitems_sec.append(value * 0.001);
+
+    insertBenchmark(bchResults, bchIndexes, bchData, aggregate_name);
+  }
+
+  if (!hasHeader)
+    errorMsg = "Not a csv benchmark results file.";
+
+  bchResults.updateStats(outlierFilter());
+
+  return bchResults;
+}
+
+/**************************************************************************************************/
+
+// Parse benchmark results from console output (--benchmark_format=console)
+BenchResults ResultParser::parseConsole(QIODevice& device, QString& errorMsg) {
+  BenchResults bchResults;
+  QHash<QString, int> bchIndexes;
+  static const QRegularExpression colorRegex("\x1b\\[[0-9;]*m");
+
+  bool hasHeader = false;
+  QString lastTimeUnit = "ns";
+  while (!device.atEnd()) {
+    QByteArray lineData = device.readLine();
+    if (lineData.contains('\x1b'))  // Colored output
+      lineData = QString::fromUtf8(lineData).remove(colorRegex).toUtf8();
+    const std::string_view line = trimmedLine(lineData);
+    if (line.empty())
+      continue;
+
+    // Context then header
+    if (!hasHeader) {
+      if (line.starts_with("Benchmark "))
+        hasHeader = true;
+      else
+        parseContextLine(line, bchResults.context);
+      continue;
+    }
+    if (line.starts_with("---") || line.starts_with("Benchmark "))
+      continue;
+
+    // Complexity
+    BenchComplexity complexity;
+    if (parseConsoleComplexity(line, complexity, lastTimeUnit)) {
+      insertComplexity(bchResults, complexity);
+      continue;
+    }
+
+    // Benchmark
+    BenchData bchData;
+    QString aggregate_name;
+    if (parseConsoleLine(line, bchData, aggregate_name, lastTimeUnit))
+      insertBenchmark(bchResults, bchIndexes, bchData, aggregate_name);
+    else if (PARSE_DEBUG)
+      qDebug() << "Ignored console line:" << QString::fromUtf8(line.data(), line.size());
+  }
+
+  if (!hasHeader)
+    errorMsg = "Not a console benchmark results file.";
+
+  bchResults.updateStats(outlierFilter());
+
   return bchResults;
 }
@@ -15,7 +15,6 @@
 
 #include "result_selector.h"
 
-#include <QCollator>
 #include <QDateTime>
 #include <QDebug>
 #include <QFileDialog>
@@ -24,30 +23,46 @@
 #include <QMessageBox>
 #include <QScreen>
 #include <QSettings>
+#include <QToolTip>
 
+#include "bench_statistics.h"
+#include "bench_tree_model.h"
+#include "comparison_window.h"
+#include "dashboard_window.h"
 #include "plot_parameters.h"
 #include "plotter_3dbars.h"
 #include "plotter_3dsurface.h"
 #include "plotter_barchart.h"
 #include "plotter_boxchart.h"
+#include "plotter_heatmap.h"
+#include "plotter_historychart.h"
 #include "plotter_linechart.h"
+#include "plotter_scalingchart.h"
+#include "plotter_violinchart.h"
 #include "result_parser.h"
 #include "ui_result_selector.h"
 
+// Families collapsed above this count of shown benchmarks
+static constexpr int kMaxExpandedBenchmarks = 10000;
+
 ResultSelector::ResultSelector(QWidget* parent)
     : QWidget(parent)
     , ui(new Ui::ResultSelector)
+    , mTreeModel(new BenchTreeModel(this))
     , mWatcher(parent) {
   ui->setupUi(this);
+  ui->treeView->setModel(mTreeModel);
 
   this->setWindowTitle("JOMT");
 
   ui->pushButtonAppend->setEnabled(false);
   ui->pushButtonOverwrite->setEnabled(false);
+  ui->pushButtonCompare->setEnabled(false);
   ui->pushButtonReload->setEnabled(false);
   ui->pushButtonSelectAll->setEnabled(false);
   ui->pushButtonSelectNone->setEnabled(false);
   ui->pushButtonPlot->setEnabled(false);
+  ui->pushButtonDashboard->setEnabled(false);
 
   connectUI();
   loadConfig();
@@ -57,9 +72,11 @@ ResultSelector::ResultSelector(const BenchResults& bchResults, const QString& fi
                                QWidget* parent)
     : QWidget(parent)
     , ui(new Ui::ResultSelector)
+    , mTreeModel(new BenchTreeModel(this))
     , mBchResults(bchResults)
     , mWatcher(parent) {
   ui->setupUi(this);
+  ui->treeView->setModel(mTreeModel);
 
   if (!fileName.isEmpty()) {
     QFileInfo fileInfo(fileName);
@@ -82,7 +99,8 @@ ResultSelector::~ResultSelector() {
 
 // Private
 void ResultSelector::connectUI() {
-  connect(ui->treeWidget, &QTreeWidget::itemChanged, this, &ResultSelector::onItemChanged);
+  connect(mTreeModel, &BenchTreeModel::checkedChanged, this, &ResultSelector::onItemsChanged);
+  connect(ui->lineEditFilter, &QLineEdit::textChanged, this, &ResultSelector::onFilterChanged);
 
   connect(ui->comboBoxType, QOverload<int>::of(&QComboBox::activated), this,
           &ResultSelector::onComboTypeChanged);
@@ -96,10 +114,20 @@ void ResultSelector::connectUI() {
           &ResultSelector::onCheckAutoReload);
   connect(ui->pushButtonReload, &QPushButton::clicked, this, &ResultSelector::onReloadClicked);
 
+  ui->comboBoxOutliers->addItem("None", OutlierNone);
+  ui->comboBoxOutliers->addItem("IQR", OutlierIqr);
+  ui->comboBoxOutliers->addItem("MAD", OutlierMad);
+  ui->comboBoxOutliers->addItem("Trimmed %", OutlierTrim);
+  connect(ui->comboBoxOutliers, QOverload<int>::of(&QComboBox::activated), this,
+          &ResultSelector::onComboOutliersChanged);
+  connect(ui->doubleSpinBoxOutliers, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this,
+          &ResultSelector::onSpinOutliersChanged);
+
   connect(ui->pushButtonNew, &QPushButton::clicked, this, &ResultSelector::onNewClicked);
   connect(ui->pushButtonAppend, &QPushButton::clicked, this, &ResultSelector::onAppendClicked);
   connect(ui->pushButtonOverwrite, &QPushButton::clicked, this,
           &ResultSelector::onOverwriteClicked);
+  connect(ui->pushButtonCompare, &QPushButton::clicked, this, &ResultSelector::onCompareClicked);
 
   connect(ui->pushButtonSelectAll, &QPushButton::clicked, this,
           &ResultSelector::onSelectAllClicked);
@@ -107,6 +135,8 @@ void ResultSelector::connectUI() {
           &ResultSelector::onSelectNoneClicked);
 
   connect(ui->pushButtonPlot, &QPushButton::clicked, this, &ResultSelector::onPlotClicked);
+  connect(ui->pushButtonDashboard, &QPushButton::clicked, this,
+          &ResultSelector::onDashboardClicked);
 }
 
 void ResultSelector::loadConfig() {
@@ -119,6 +149,13 @@ void ResultSelector::loadConfig() {
     mWorkingDir = value.toString();
   settings.endGroup();
 
+  // Outlier filter (preference or command line, read at startup)
+  const OutlierFilter& filter = ResultParser::outlierFilter();
+  const QSignalBlocker blocker(ui->doubleSpinBoxOutliers);
+  ui->comboBoxOutliers->setCurrentIndex(ui->comboBoxOutliers->findData(filter.method));
+  ui->doubleSpinBoxOutliers->setEnabled(filter.method != OutlierNone);
+  ui->doubleSpinBoxOutliers->setValue(filter.factor);
+
   // Default size
   QSize size = this->size();
   QSize newSize = QGuiApplication::primaryScreen()->size();
@@ -133,6 +170,7 @@ void ResultSelector::saveConfig() {
   settings.beginGroup("selector");
   settings.setValue("autoReload", ui->checkBoxAutoReload->isChecked());
   settings.setValue("workingDir", mWorkingDir);
+  settings.setValue("outliers", getOutlierFilterName(ResultParser::outlierFilter()));
   settings.endGroup();
 }
 
@@ -142,13 +180,15 @@ void ResultSelector::updateComboBoxY() {
   if (ui->comboBoxY->count() > 0)
     prevYType = (PlotValueType)ui->comboBoxY->currentData().toInt();
 
-  // Classic or Boxes
-  if (!mBchResults.meta.hasAggregate || chartType == ChartBoxType) {
+  // Classic or Boxes/Violins (repetitions)
+  if (!mBchResults.meta.hasAggregate || chartType == ChartBoxType ||
+      chartType == ChartViolinType) {
     ui->comboBoxY->clear();
 
     ui->comboBoxY->addItem("Real time", QVariant(RealTimeType));
     ui->comboBoxY->addItem("CPU time", QVariant(CpuTimeType));
-    ui->comboBoxY->addItem("Iterations", QVariant(IterationsType));
+    if (chartType != ChartViolinType)  // same count on each repetition
+      ui->comboBoxY->addItem("Iterations", QVariant(IterationsType));
     if (mBchResults.meta.hasBytesSec)
       ui->comboBoxY->addItem("Bytes/s", QVariant(BytesType));
     if (mBchResults.meta.hasItemsSec)
@@ -199,202 +239,33 @@ void ResultSelector::updateComboBoxY() {
     ui->comboBoxY->setCurrentIndex(yIdx);
 }
 
-// Tree
-class NumericTreeWidgetItem : public QTreeWidgetItem {
- public:
-  NumericTreeWidgetItem(const QStringList& strings) : QTreeWidgetItem(strings) {}
-
- private:
-  bool operator<(const QTreeWidgetItem& other) const {
-    QCollator collator;
-    collator.setNumericMode(true);
-    int column = treeWidget()->sortColumn();
-    return collator.compare(text(column), other.text(column)) < 0;
-  }
-};
-
-static QTreeWidgetItem* buildTreeItem(const BenchData& bchData, double timeFactor,
-                                      bool onlyAggregate, QTreeWidgetItem* item = nullptr) {
-  QStringList labels = {
-      bchData.base_name, bchData.templates.join(", "), bchData.arguments.join("/"),
-      QString::number((!onlyAggregate ? bchData.real_time_us : bchData.mean_real) * timeFactor),
-      QString::number((!onlyAggregate ? bchData.cpu_time_us : bchData.mean_cpu) * timeFactor)};
-  if (!bchData.kbytes_sec.isEmpty())
-    labels.append(QString::number(bchData.kbytes_sec_dflt));
-  if (!bchData.kitems_sec.isEmpty())
-    labels.append(QString::number(bchData.kitems_sec_dflt));
-
-  if (item == nullptr) {
-    item = new NumericTreeWidgetItem(labels);
-  } else {
-    for (int iC = 0; iC < labels.size(); ++iC)
-      item->setText(iC, labels[iC]);
-  }
-
-  return item;
-}
-
-static QSet<QString> getUnselectedBenchmarks(const QTreeWidget* tree,
-                                             const BenchResults& bchResults) {
-  QSet<QString> resNames;
-
-  for (int i = 0; i < tree->topLevelItemCount(); ++i) {
-    QTreeWidgetItem* topItem = tree->topLevelItem(i);
-    if (topItem->childCount() <= 0) {
-      if (topItem->checkState(0) == Qt::Unchecked) {
-        int idx = topItem->data(0, Qt::UserRole).toInt();
-        resNames.insert(bchResults.getBenchName(idx));
-      }
-    } else {
-      for (int j = 0; j < topItem->childCount(); ++j) {
-        QTreeWidgetItem* midItem = topItem->child(j);
-        if (midItem->childCount() <= 0) {
-          if (midItem->checkState(0) == Qt::Unchecked) {
-            int idx = midItem->data(0, Qt::UserRole).toInt();
-            resNames.insert(bchResults.getBenchName(idx));
-          }
-        } else {
-          for (int k = 0; k < midItem->childCount(); ++k) {
-            QTreeWidgetItem* lowItem = midItem->child(k);
-            if (lowItem->checkState(0) == Qt::Unchecked) {
-              int idx = lowItem->data(0, Qt::UserRole).toInt();
-              resNames.insert(bchResults.getBenchName(idx));
-            }
-          }
-        }
-      }
-    }
-  }
-
-  return resNames;
-}
-
-void ResultSelector::updateResults(bool clear, const QSet<QString> unselected) {
+void ResultSelector::updateResults(bool clear, bool keepState) {
   //
-  // Tree widget
-  //    QSet<QString> unselected;
-  if (clear) {
-    //        if (keepSelection)
-    //            unselected = getUnselectedBenchmarks(ui->treeWidget, mBchResults);
-    ui->treeWidget->clear();
-  } else
-    ui->treeWidget->sortByColumn(-1, Qt::SortOrder::AscendingOrder);  // init: unsorted
-  ui->treeWidget->setSortingEnabled(true);
-
-  // Columns
-  int iCol = 5;
-  if (mBchResults.meta.hasBytesSec)
-    ++iCol;
-  if (mBchResults.meta.hasItemsSec)
-    ++iCol;
-  ui->treeWidget->setColumnCount(iCol);
+  // Tree view
+  if (!clear)
+    ui->treeView->sortByColumn(-1, Qt::SortOrder::AscendingOrder);  // init: unsorted
 
   // Time unit
-  double timeFactor = 1.;
-  if (mBchResults.meta.time_unit == "ns")
-    timeFactor = 1000.;
-  else if (mBchResults.meta.time_unit == "ms")
-    timeFactor = 0.001;
-  else
+  if (mBchResults.meta.time_unit != "ns" && mBchResults.meta.time_unit != "ms")
     mBchResults.meta.time_unit = "us";
 
-  // Populate tree
-  bool anySelected = false;
-  QList<QTreeWidgetItem*> items;
-
-  QVector<BenchSubset> bchFamilies = mBchResults.segmentFamilies();
-  for (const auto& bchFamily : std::as_const(bchFamilies)) {
-    bool oneTopSelected = false;
-    bool allTopSelected = true;
-    QTreeWidgetItem* topItem = new QTreeWidgetItem(QStringList(bchFamily.name));
-
-    // JOMT: family + container
-    if (!mBchResults.benchmarks[bchFamily.idxs[0]].container.isEmpty()) {
-      QVector<BenchSubset> bchContainers = mBchResults.segmentContainers(bchFamily.idxs);
-      for (const auto& bchContainer : std::as_const(bchContainers)) {
-        bool oneMidSelected = false;
-        bool allMidSelected = true;
-        QTreeWidgetItem* midItem = new QTreeWidgetItem(QStringList(bchContainer.name));
-
-        for (int idx : bchContainer.idxs) {
-          QTreeWidgetItem* child = buildTreeItem(mBchResults.benchmarks[idx], timeFactor,
-                                                 mBchResults.meta.onlyAggregate);
-          bool selected = !unselected.contains(mBchResults.getBenchName(idx));
-          oneMidSelected |= selected;
-          allMidSelected &= selected;
-          child->setCheckState(0, selected ? Qt::Checked : Qt::Unchecked);
-          child->setData(0, Qt::UserRole, idx);
-          midItem->addChild(child);
-        }
-        oneTopSelected |= oneMidSelected;
-        allTopSelected &= allMidSelected;
-        midItem->setCheckState(0, oneMidSelected
-                                      ? (allMidSelected ? Qt::Checked : Qt::PartiallyChecked)
-                                      : Qt::Unchecked);
-        topItem->addChild(midItem);
-      }
-    }
-    // Classic
-    else {
-      // Single
-      if (bchFamily.idxs.size() == 1) {
-        int idx = bchFamily.idxs[0];
-        buildTreeItem(mBchResults.benchmarks[idx], timeFactor, mBchResults.meta.onlyAggregate,
-                      topItem);
-        oneTopSelected = !unselected.contains(mBchResults.getBenchName(idx));
-        topItem->setData(0, Qt::UserRole, idx);
-      } else  // Family
-      {
-        for (int idx : bchFamily.idxs) {
-          QTreeWidgetItem* child = buildTreeItem(mBchResults.benchmarks[idx], timeFactor,
-                                                 mBchResults.meta.onlyAggregate);
-          bool selected = !unselected.contains(mBchResults.getBenchName(idx));
-          oneTopSelected |= selected;
-          allTopSelected &= selected;
-          child->setCheckState(0, selected ? Qt::Checked : Qt::Unchecked);
-          child->setData(0, Qt::UserRole, idx);
-          topItem->addChild(child);
-        }
-      }
-    }
-    anySelected |= oneTopSelected;
-    topItem->setCheckState(
-        0, oneTopSelected ? (allTopSelected ? Qt::Checked : Qt::PartiallyChecked) : Qt::Unchecked);
-    items.insert(0, topItem);
+  // Populate tree (rows formatted on display), or update rows matched by names
+  if (keepState)
+    mTreeModel->reloadResults(&mBchResults);
+  else {
+    mTreeModel->setResults(&mBchResults);
+    ui->treeView->setSortingEnabled(true);  // re-apply sorting
   }
-  ui->treeWidget->insertTopLevelItems(0, items);
-
-  ui->pushButtonPlot->setEnabled(anySelected);
+  ui->pushButtonPlot->setEnabled(mTreeModel->anyChecked());
+  ui->pushButtonDashboard->setEnabled(mTreeModel->anyChecked());
 
-  // Headers
-  QStringList labels = {"Benchmark", "Templates", "Arguments"};
-  if (!mBchResults.meta.hasAggregate) {
-    labels << "Real time (" + mBchResults.meta.time_unit + ")"
-           << "CPU time (" + mBchResults.meta.time_unit + ")";
-    if (mBchResults.meta.hasBytesSec)
-      labels << "Bytes/s (k)";
-    if (mBchResults.meta.hasItemsSec)
-      labels << "Items/s (k)";
-  } else {
-    if (!mBchResults.meta.onlyAggregate) {
-      labels << "Real min time (" + mBchResults.meta.time_unit + ")"
-             << "CPU min time (" + mBchResults.meta.time_unit + ")";
-    } else {
-      labels << "Real mean time (" + mBchResults.meta.time_unit + ")"
-             << "CPU mean time (" + mBchResults.meta.time_unit + ")";
-    }
-    if (mBchResults.meta.hasBytesSec)
-      labels << "Bytes/s min (k)";
-    if (mBchResults.meta.hasItemsSec)
-      labels << "Items/s min (k)";
+  mSearchIndex.build(&mBchResults);
+  applyFilter(!keepState);
+  if (!keepState) {
+    for (int iC = 0; iC < mTreeModel->columnCount(); ++iC)
+      ui->treeView->resizeColumnToContents(iC);  // visible rows only
   }
 
-  ui->treeWidget->setHeaderLabels(labels);
-
-  ui->treeWidget->expandAll();
-  for (int iC = 0; iC < ui->treeWidget->columnCount(); ++iC)
-    ui->treeWidget->resizeColumnToContents(iC);
-
   //
   // Chart options
   PlotChartType prevChartType = (PlotChartType)-1;
@@ -424,11 +295,18 @@ void ResultSelector::updateResults(bool clear, const QSet<QString> unselected) {
   }
   ui->comboBoxType->addItem("Bars", ChartBarType);
   ui->comboBoxType->addItem("HBars", ChartHBarType);
-  if (mBchResults.meta.hasAggregate && !mBchResults.meta.onlyAggregate)
+  if (mBchResults.meta.hasAggregate && !mBchResults.meta.onlyAggregate) {
     ui->comboBoxType->addItem("Boxes", ChartBoxType);
+    ui->comboBoxType->addItem("Violins", ChartViolinType);
+  }
   ui->comboBoxType->addItem("3D Bars", Chart3DBarsType);
   if (mBchResults.meta.maxArguments > 0 || mBchResults.meta.maxTemplates > 0)
     ui->comboBoxType->addItem("3D Surface", Chart3DSurfaceType);
+  if (mBchResults.meta.maxArguments > 0 || mBchResults.meta.maxTemplates > 0)
+    ui->comboBoxType->addItem("Heatmap", ChartHeatmapType);
+  ui->comboBoxType->addItem("History", ChartHistoryType);
+  if (mBchResults.meta.maxThreads > 1)
+    ui->comboBoxType->addItem("Scaling", ChartScalingType);
 
   // X-axis
   for (int i = 0; i < mBchResults.meta.maxArguments; ++i) {
@@ -460,7 +338,8 @@ void ResultSelector::updateResults(bool clear, const QSet<QString> unselected) {
     }
 
     PlotChartType chartType = (PlotChartType)ui->comboBoxType->currentData().toInt();
-    if (chartType == Chart3DBarsType || chartType == Chart3DSurfaceType)  // Any 3D charts
+    if (chartType == Chart3DBarsType || chartType == Chart3DSurfaceType ||
+        chartType == ChartHeatmapType)  // Any 2-parameter charts
       ui->comboBoxZ->setEnabled(true);
     else
       ui->comboBoxZ->setEnabled(false);
@@ -485,6 +364,9 @@ void ResultSelector::updateResults(bool clear, const QSet<QString> unselected) {
     if (chartIdx >= 0) {
       ui->comboBoxType->setCurrentIndex(chartIdx);
       updateComboBoxY();
+      if (prevChartType == ChartHistoryType ||
+          prevChartType == ChartScalingType)  // plotted over runs/threads
+        ui->comboBoxX->setEnabled(false);
     }
     // X
     if (prevXType >= 0) {
@@ -506,7 +388,8 @@ void ResultSelector::updateResults(bool clear, const QSet<QString> unselected) {
     }
     ui->comboBoxZ->setEnabled(ui->comboBoxX->isEnabled() &&
                               (prevChartType == Chart3DBarsType ||
-                               prevChartType == Chart3DSurfaceType));  // Any 3D charts
+                               prevChartType == Chart3DSurfaceType ||
+                               prevChartType == ChartHeatmapType));  // Any 2-parameter charts
   }
 
   // Reload
@@ -519,89 +402,46 @@ void ResultSelector::updateResults(bool clear, const QSet<QString> unselected) {
   ui->labelLastReload->setText("(Last: " + now.toString() + ")");
 }
 
-// Slots
-static void updateItemParentsState(QTreeWidgetItem* item) {
-  auto parent = item->parent();
-  if (parent == nullptr)
-    return;
-
-  bool allChecked = true, allUnchecked = true;
-  for (int idx = 0; (allChecked || allUnchecked) && idx < parent->childCount(); ++idx) {
-    allChecked &= parent->child(idx)->checkState(0) == Qt::Checked;
-    allUnchecked &= parent->child(idx)->checkState(0) == Qt::Unchecked;
-  }
-
-  if (allChecked)
-    parent->setCheckState(0, Qt::Checked);
-  else if (allUnchecked)
-    parent->setCheckState(0, Qt::Unchecked);
-  else
-    parent->setCheckState(0, Qt::PartiallyChecked);
-}
-
-static void updateItemChildrenState(QTreeWidgetItem* item) {
-  if (item->childCount() <= 0)
+void ResultSelector::applyFilter(bool expand) {
+  const QString query = ui->lineEditFilter->text();
+  QVector<int> bchIdxs;
+  QString errorMsg;
+  if (query.trimmed().isEmpty())
+    mTreeModel->clearFilter();
+  else if (!mSearchIndex.search(query, bchIdxs, errorMsg)) {
+    // Keep previous filter
+    ui->lineEditFilter->setStyleSheet("color: red");
+    QToolTip::showText(ui->lineEditFilter->mapToGlobal(QPoint(0, ui->lineEditFilter->height())),
+                       errorMsg, ui->lineEditFilter);
     return;
+  } else
+    mTreeModel->setFilter(bchIdxs);
+  ui->lineEditFilter->setStyleSheet(QString());
 
-  if (item->checkState(0) == Qt::Checked) {
-    for (int idx = 0; idx < item->childCount(); ++idx) {
-      item->child(idx)->setCheckState(0, Qt::Checked);
-    }
-  } else if (item->checkState(0) == Qt::Unchecked) {
-    for (int idx = 0; idx < item->childCount(); ++idx) {
-      item->child(idx)->setCheckState(0, Qt::Unchecked);
-    }
-  }
-  // Nothing if 'PartiallyChecked'
+  const qsizetype shownCount =
+      mTreeModel->isFiltered() ? bchIdxs.size() : mBchResults.benchmarks.size();
+  if (expand && shownCount <= kMaxExpandedBenchmarks)
+    ui->treeView->expandAll();
 }
 
-void ResultSelector::onItemChanged(QTreeWidgetItem* item, int /*column*/) {
-  if (item == nullptr)
-    return;
-
-  updateItemChildrenState(item);
-  updateItemParentsState(item);
-
+// Slots
+void ResultSelector::onItemsChanged() {
   // Disable plot button if no items selected
-  bool allUnchecked = true;
-  for (int i = 0; allUnchecked && i < ui->treeWidget->topLevelItemCount(); ++i)
-    allUnchecked &= ui->treeWidget->topLevelItem(i)->checkState(0) == Qt::Unchecked;
-
-  ui->pushButtonPlot->setEnabled(!allUnchecked);
+  ui->pushButtonPlot->setEnabled(mTreeModel->anyChecked());
+  ui->pushButtonDashboard->setEnabled(mTreeModel->anyChecked());
 }
 
-static QVector<int> getSelectedBenchmarks(const QTreeWidget* tree) {
-  QVector<int> resIdxs;
-
-  for (int i = 0; i < tree->topLevelItemCount(); ++i) {
-    QTreeWidgetItem* topItem = tree->topLevelItem(i);
-    if (topItem->childCount() <= 0) {
-      if (topItem->checkState(0) == Qt::Checked)
-        resIdxs.append(topItem->data(0, Qt::UserRole).toInt());
-    } else {
-      for (int j = 0; j < topItem->childCount(); ++j) {
-        QTreeWidgetItem* midItem = topItem->child(j);
-        if (midItem->childCount() <= 0) {
-          if (midItem->checkState(0) == Qt::Checked)
-            resIdxs.append(midItem->data(0, Qt::UserRole).toInt());
-        } else {
-          for (int k = 0; k < midItem->childCount(); ++k) {
-            QTreeWidgetItem* lowItem = midItem->child(k);
-            if (lowItem->checkState(0) == Qt::Checked)
-              resIdxs.append(lowItem->data(0, Qt::UserRole).toInt());
-          }
-        }
-      }
-    }
-  }
-
-  return resIdxs;
-}
+void ResultSelector::onFilterChanged() { applyFilter(); }
 
 void ResultSelector::onComboTypeChanged(int /*index*/) {
   PlotChartType chartType = (PlotChartType)ui->comboBoxType->currentData().toInt();
 
-  if (chartType == Chart3DBarsType || chartType == Chart3DSurfaceType)  // Any 3D charts
+  // History plotted over runs, scaling over threads
+  ui->comboBoxX->setEnabled(chartType != ChartHistoryType && chartType != ChartScalingType &&
+                            ui->comboBoxX->count() > 0);
+
+  if (chartType == Chart3DBarsType || chartType == Chart3DSurfaceType ||
+      chartType == ChartHeatmapType)  // Any 2-parameter charts
     ui->comboBoxZ->setEnabled(ui->comboBoxX->isEnabled());
   else
     ui->comboBoxZ->setEnabled(false);
@@ -688,7 +528,7 @@ void ResultSelector::onReloadClicked() {
   }
   // Load original
   QString errorMsg;
-  BenchResults newResults = ResultParser::parseJsonFile(mOrigFilename, errorMsg);
+  BenchResults newResults = ResultParser::parseResultsFile(mOrigFilename, errorMsg);
   if (newResults.benchmarks.size() <= 0) {
     QMessageBox::warning(this, "Reload benchmark results",
                          "Error parsing file: " + mOrigFilename + "\n" + errorMsg);
@@ -698,7 +538,7 @@ void ResultSelector::onReloadClicked() {
   // Load additionnals
   for (const auto& addFile : std::as_const(mAddFilenames)) {
     QString errorMsg;
-    BenchResults addResults = ResultParser::parseJsonFile(addFile.filename, errorMsg);
+    BenchResults addResults = ResultParser::parseResultsFile(addFile.filename, errorMsg);
     if (addResults.benchmarks.size() <= 0) {
       QMessageBox::warning(this, "Reload benchmark results",
                            "Error parsing file: " + addFile.filename + "\n" + errorMsg);
@@ -712,9 +552,8 @@ void ResultSelector::onReloadClicked() {
   }
 
   // Replace & update
-  auto unselected = getUnselectedBenchmarks(ui->treeWidget, mBchResults);
   mBchResults = newResults;
-  updateResults(true, unselected);
+  updateResults(true, true);
 
   // Update timestamp
   QDateTime today = QDateTime::currentDateTime();
@@ -722,14 +561,37 @@ void ResultSelector::onReloadClicked() {
   ui->labelLastReload->setText("(Last: " + now.toString() + ")");
 }
 
+void ResultSelector::onComboOutliersChanged(int /*index*/) {
+  const auto method = static_cast<OutlierMethod>(ui->comboBoxOutliers->currentData().toInt());
+  {
+    const QSignalBlocker blocker(ui->doubleSpinBoxOutliers);
+    ui->doubleSpinBoxOutliers->setEnabled(method != OutlierNone);
+    ui->doubleSpinBoxOutliers->setValue(getOutlierDefaultFactor(method));
+  }
+  onSpinOutliersChanged(ui->doubleSpinBoxOutliers->value());
+}
+
+void ResultSelector::onSpinOutliersChanged(double factor) {
+  OutlierFilter filter;
+  filter.method = static_cast<OutlierMethod>(ui->comboBoxOutliers->currentData().toInt());
+  if (filter.method != OutlierNone)
+    filter.factor = factor;
+  ResultParser::setOutlierFilter(filter);
+
+  // Filter applied at load time
+  if (!mOrigFilename.isEmpty())
+    onReloadClicked();
+}
+
 // File
 void ResultSelector::onNewClicked() {
-  QString fileName = QFileDialog::getOpenFileName(this, tr("Open benchmark results"), mWorkingDir,
-                                                  tr("Benchmark results (*.json)"));
+  QString fileName =
+      QFileDialog::getOpenFileName(this, tr("Open benchmark results"), mWorkingDir,
+                                   tr("Benchmark results (*.json *.csv *.txt *.gz *.zst)"));
 
   if (!fileName.isEmpty() && QFile::exists(fileName)) {
     QString errorMsg;
-    BenchResults newResults = ResultParser::parseJsonFile(fileName, errorMsg);
+    BenchResults newResults = ResultParser::parseResultsFile(fileName, errorMsg);
     if (newResults.benchmarks.size() <= 0) {
       QMessageBox::warning(this, "Open benchmark results",
                            "Error parsing file: " + fileName + "\n" + errorMsg);
@@ -737,16 +599,18 @@ void ResultSelector::onNewClicked() {
     }
     // Replace & upate
     mBchResults = newResults;
-    ui->treeWidget->sortByColumn(-1, Qt::SortOrder::AscendingOrder);  // reset sorting
+    ui->treeView->sortByColumn(-1, Qt::SortOrder::AscendingOrder);  // reset sorting
     updateResults(true);
 
     // Update UI
     ui->pushButtonAppend->setEnabled(true);
     ui->pushButtonOverwrite->setEnabled(true);
+    ui->pushButtonCompare->setEnabled(true);
     ui->pushButtonReload->setEnabled(true);
     ui->pushButtonSelectAll->setEnabled(true);
     ui->pushButtonSelectNone->setEnabled(true);
     ui->pushButtonPlot->setEnabled(true);
+    ui->pushButtonDashboard->setEnabled(true);
 
     // Save for reload
     mOrigFilename = fileName;
@@ -762,21 +626,21 @@ void ResultSelector::onNewClicked() {
 }
 
 void ResultSelector::onAppendClicked() {
-  QString fileName = QFileDialog::getOpenFileName(this, tr("Append benchmark results"), mWorkingDir,
-                                                  tr("Benchmark results (*.json)"));
+  QString fileName =
+      QFileDialog::getOpenFileName(this, tr("Append benchmark results"), mWorkingDir,
+                                   tr("Benchmark results (*.json *.csv *.txt *.gz *.zst)"));
 
   if (!fileName.isEmpty() && QFile::exists(fileName)) {
     QString errorMsg;
-    BenchResults newResults = ResultParser::parseJsonFile(fileName, errorMsg);
+    BenchResults newResults = ResultParser::parseResultsFile(fileName, errorMsg);
     if (newResults.benchmarks.size() <= 0) {
       QMessageBox::warning(this, "Open benchmark results",
                            "Error parsing file: " + fileName + "\n" + errorMsg);
       return;
     }
     // Append & upate
-    auto unselected = getUnselectedBenchmarks(ui->treeWidget, mBchResults);
     mBchResults.appendResults(newResults);
-    updateResults(true, unselected);
+    updateResults(true, true);
 
     // Save for reload
     mAddFilenames.append({fileName, true});
@@ -792,21 +656,21 @@ void ResultSelector::onAppendClicked() {
 }
 
 void ResultSelector::onOverwriteClicked() {
-  QString fileName = QFileDialog::getOpenFileName(this, tr("Overwrite benchmark results"),
-                                                  mWorkingDir, tr("Benchmark results (*.json)"));
+  QString fileName =
+      QFileDialog::getOpenFileName(this, tr("Overwrite benchmark results"), mWorkingDir,
+                                   tr("Benchmark results (*.json *.csv *.txt *.gz *.zst)"));
 
   if (!fileName.isEmpty() && QFile::exists(fileName)) {
     QString errorMsg;
-    BenchResults newResults = ResultParser::parseJsonFile(fileName, errorMsg);
+    BenchResults newResults = ResultParser::parseResultsFile(fileName, errorMsg);
     if (newResults.benchmarks.size() <= 0) {
       QMessageBox::warning(this, "Open benchmark results",
                            "Error parsing file: " + fileName + "\n" + errorMsg);
       return;
     }
     // Overwrite & upate
-    auto unselected = getUnselectedBenchmarks(ui->treeWidget, mBchResults);
     mBchResults.overwriteResults(newResults);
-    updateResults(true, unselected);
+    updateResults(true, true);
 
     // Save for reload
     mAddFilenames.append({fileName, false});
@@ -821,24 +685,45 @@ void ResultSelector::onOverwriteClicked() {
   }
 }
 
-// Selection
-void ResultSelector::onSelectAllClicked() {
-  for (int i = 0; i < ui->treeWidget->topLevelItemCount(); ++i) {
-    QTreeWidgetItem* topItem = ui->treeWidget->topLevelItem(i);
-    topItem->setCheckState(0, Qt::Checked);
-  }
-}
+void ResultSelector::onCompareClicked() {
+  QString fileName =
+      QFileDialog::getOpenFileName(this, tr("Compare benchmark results"), mWorkingDir,
+                                   tr("Benchmark results (*.json *.csv *.txt *.gz *.zst)"));
 
-void ResultSelector::onSelectNoneClicked() {
-  for (int i = 0; i < ui->treeWidget->topLevelItemCount(); ++i) {
-    QTreeWidgetItem* topItem = ui->treeWidget->topLevelItem(i);
-    topItem->setCheckState(0, Qt::Unchecked);
+  if (!fileName.isEmpty() && QFile::exists(fileName)) {
+    QString errorMsg;
+    BenchResults candResults = ResultParser::parseResultsFile(fileName, errorMsg);
+    if (candResults.benchmarks.size() <= 0) {
+      QMessageBox::warning(this, "Compare benchmark results",
+                           "Error parsing file: " + fileName + "\n" + errorMsg);
+      return;
+    }
+    // Current results as baseline, on selected Y-value
+    PlotValueType yType = (PlotValueType)ui->comboBoxY->currentData().toInt();
+    QWidget* widget =
+        new ComparisonWindow(mBchResults, candResults, yType, mOrigFilename, fileName);
+
+    // Default size
+    QSize newSize = widget->size();
+    QSize screenSize = QGuiApplication::primaryScreen()->size();
+    float scale = screenSize.height() * 0.5f / newSize.height();
+    if (scale > 1.f)
+      newSize *= scale;
+    widget->resize(newSize);
+    widget->show();
+
+    QFileInfo fileInfo(fileName);
+    mWorkingDir = fileInfo.absoluteDir().absolutePath();
   }
 }
 
+// Selection
+void ResultSelector::onSelectAllClicked() { mTreeModel->setAllChecked(true); }
+
+void ResultSelector::onSelectNoneClicked() { mTreeModel->setAllChecked(false); }
+
 // Plot
-void ResultSelector::onPlotClicked() {
-  // Params
+PlotParams ResultSelector::getPlotParams() const {
   PlotParams plotParams;
 
   plotParams.type = (PlotChartType)ui->comboBoxType->currentData().toInt();
@@ -862,8 +747,15 @@ void ResultSelector::onPlotClicked() {
     plotParams.zIdx = -1;
   }
 
+  return plotParams;
+}
+
+void ResultSelector::onPlotClicked() {
+  // Params
+  const PlotParams plotParams = getPlotParams();
+
   // Selected items
-  const auto& bchIdxs = getSelectedBenchmarks(ui->treeWidget);
+  const auto& bchIdxs = mTreeModel->selectedBenchmarks();
 
   //
   // Call plotter
@@ -894,6 +786,25 @@ void ResultSelector::onPlotClicked() {
       is3D = true;
       break;
     }
+    case ChartHistoryType: {
+      widget =
+          new PlotterHistoryChart(mBchResults, bchIdxs, plotParams, mOrigFilename, mAddFilenames);
+      break;
+    }
+    case ChartScalingType: {
+      widget =
+          new PlotterScalingChart(mBchResults, bchIdxs, plotParams, mOrigFilename, mAddFilenames);
+      break;
+    }
+    case ChartHeatmapType: {
+      widget = new PlotterHeatmap(mBchResults, bchIdxs, plotParams, mOrigFilename, mAddFilenames);
+      break;
+    }
+    case ChartViolinType: {
+      widget =
+          new PlotterViolinChart(mBchResults, bchIdxs, plotParams, mOrigFilename, mAddFilenames);
+      break;
+    }
   }
 
   if (widget) {
@@ -917,3 +828,29 @@ void ResultSelector::onPlotClicked() {
   } else
     qWarning() << "Unable to instantiate plot widget";
 }
+
+void ResultSelector::onDashboardClicked() {
+  const PlotParams plotParams = getPlotParams();
+  if (!DashboardWindow::isChartSupported(plotParams.type)) {
+    QMessageBox::warning(this, "Dashboard", "Chart type not available in dashboard");
+    return;
+  }
+
+  // One dashboard per results files
+  if (!mDashboard || !sameResultsFiles(mDashboard->origFilename(), mOrigFilename,
+                                       mDashboard->addFilenames(), mAddFilenames)) {
+    mDashboard = new DashboardWindow(mBchResults, mOrigFilename, mAddFilenames);
+
+    // Default size
+    QSize newSize = mDashboard->size();
+    QSize screenSize = QGuiApplication::primaryScreen()->size();
+    float scale = screenSize.height() * 0.75f / newSize.height();
+    if (scale > 1.f)
+      newSize *= scale;
+    mDashboard->resize(newSize);
+    mDashboard->show();
+  }
+  mDashboard->addChart(mBchResults, mTreeModel->selectedBenchmarks(), plotParams);
+  mDashboard->raise();
+  mDashboard->activateWindow();
+}
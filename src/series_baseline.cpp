@@ -0,0 +1,106 @@
+// Copyright 2019 Guillaume AUJAY. All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "series_baseline.h"
+
+#include <limits>
+
+// Key of series in family with container
+static QString getFamilyKey(const QString& familyKey, int containerIdx) {
+  return familyKey + '\n' + QString::number(containerIdx);
+}
+
+void SeriesBaseline::build(const BenchResults& bchResults, const QVector<BenchSubset>& subsets,
+                           const PlotParams& plotParams) {
+  const bool xIsArg = plotParams.xType == PlotArgumentType;
+
+  // X-keys of all points
+  QHash<QString, int> xKeys;
+  mPointKeys.clear();
+  mPointKeys.reserve(subsets.size());
+  for (const auto& subset : subsets) {
+    QVector<int> keys;
+    keys.reserve(subset.idxs.size());
+    for (int idx : subset.idxs) {
+      const QString xName = bchResults.getParamName(xIsArg, idx, plotParams.xIdx);
+      auto it = xKeys.constFind(xName);
+      if (it == xKeys.cend())
+        it = xKeys.insert(xName, xKeys.size());
+      keys.append(it.value());
+    }
+    mPointKeys.append(keys);
+  }
+
+  // Values aligned on X-keys
+  mKeyCount = xKeys.size();
+  mValues.fill(std::numeric_limits<double>::quiet_NaN(), subsets.size() * mKeyCount);
+  for (qsizetype seriesIdx = 0; seriesIdx < subsets.size(); ++seriesIdx) {
+    const auto& idxs = subsets[seriesIdx].idxs;
+    double* values = mValues.data() + seriesIdx * mKeyCount;
+    for (qsizetype pointIdx = 0; pointIdx < idxs.size(); ++pointIdx)
+      values[mPointKeys[seriesIdx][pointIdx]] =
+          getYPlotValue(bchResults.benchmarks[idxs[pointIdx]], plotParams.yType);
+  }
+
+  // JOMT series by family (name without "Family_Container" base name) and container
+  mContainers.clear();
+  mFamilyKeys.fill(QString(), subsets.size());
+  mFamilySeries.clear();
+  for (qsizetype seriesIdx = 0; seriesIdx < subsets.size(); ++seriesIdx) {
+    const auto& subset = subsets[seriesIdx];
+    if (subset.idxs.isEmpty())
+      continue;
+    const BenchData& bchData = bchResults.benchmarks[subset.idxs.constFirst()];
+    const QString& prefix = bchData.base_name;  // "JOMT_" already stripped by parser
+    if (bchData.container.isEmpty() || !subset.name.startsWith(prefix))
+      continue;
+
+    int containerIdx = mContainers.indexOf(bchData.container);
+    if (containerIdx < 0) {
+      containerIdx = mContainers.size();
+      mContainers.append(bchData.container);
+    }
+    mFamilyKeys[seriesIdx] = bchData.family + subset.name.sliced(prefix.size());
+    mFamilySeries.insert(getFamilyKey(mFamilyKeys[seriesIdx], containerIdx), seriesIdx);
+  }
+}
+
+QVector<int> SeriesBaseline::getReferences(BaselineKind kind, int refIdx) const {
+  QVector<int> refs(mPointKeys.size(), -1);
+  if (kind == BaselineSeries && refIdx >= 0 && refIdx < mPointKeys.size())
+    refs.fill(refIdx);
+  else if (kind == BaselineContainer && refIdx >= 0 && refIdx < mContainers.size()) {
+    for (qsizetype seriesIdx = 0; seriesIdx < refs.size(); ++seriesIdx)
+      if (!mFamilyKeys[seriesIdx].isNull())
+        refs[seriesIdx] = mFamilySeries.value(getFamilyKey(mFamilyKeys[seriesIdx], refIdx), -1);
+  }
+  return refs;
+}
+
+QVector<double> SeriesBaseline::getRatios(int seriesIdx, int refSeriesIdx) const {
+  const auto& keys = mPointKeys[seriesIdx];
+  QVector<double> ratios(keys.size(), std::numeric_limits<double>::quiet_NaN());
+  if (refSeriesIdx < 0 || refSeriesIdx >= mPointKeys.size())
+    return ratios;
+
+  const double* values = mValues.constData() + seriesIdx * mKeyCount;
+  const double* refValues = mValues.constData() + refSeriesIdx * mKeyCount;
+  for (qsizetype pointIdx = 0; pointIdx < keys.size(); ++pointIdx) {
+    const double value = values[keys[pointIdx]], refValue = refValues[keys[pointIdx]];
+    if (value > 0. && refValue > 0.)  // false for missing (NaN)
+      ratios[pointIdx] = value / refValue;
+  }
+  return ratios;
+}